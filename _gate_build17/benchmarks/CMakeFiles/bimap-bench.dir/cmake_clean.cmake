@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bimap-bench.dir/bimap_bench.cpp.o"
+  "CMakeFiles/bimap-bench.dir/bimap_bench.cpp.o.d"
+  "bimap-bench"
+  "bimap-bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bimap-bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,30 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/tests/bimap_tests.cpp" "tests/CMakeFiles/bimap-tests.dir/bimap_tests.cpp.o" "gcc" "tests/CMakeFiles/bimap-tests.dir/bimap_tests.cpp.o.d"
+  "/root/repo/tests/bimapparallel_tests.cpp" "tests/CMakeFiles/bimap-tests.dir/bimapparallel_tests.cpp.o" "gcc" "tests/CMakeFiles/bimap-tests.dir/bimapparallel_tests.cpp.o.d"
+  "/root/repo/tests/bimapstats_tests.cpp" "tests/CMakeFiles/bimap-tests.dir/bimapstats_tests.cpp.o" "gcc" "tests/CMakeFiles/bimap-tests.dir/bimapstats_tests.cpp.o.d"
+  "/root/repo/tests/concurrentbimap_tests.cpp" "tests/CMakeFiles/bimap-tests.dir/concurrentbimap_tests.cpp.o" "gcc" "tests/CMakeFiles/bimap-tests.dir/concurrentbimap_tests.cpp.o.d"
+  "/root/repo/tests/densekeybimap_tests.cpp" "tests/CMakeFiles/bimap-tests.dir/densekeybimap_tests.cpp.o" "gcc" "tests/CMakeFiles/bimap-tests.dir/densekeybimap_tests.cpp.o.d"
+  "/root/repo/tests/flatbimap_tests.cpp" "tests/CMakeFiles/bimap-tests.dir/flatbimap_tests.cpp.o" "gcc" "tests/CMakeFiles/bimap-tests.dir/flatbimap_tests.cpp.o.d"
+  "/root/repo/tests/mappedbimap_tests.cpp" "tests/CMakeFiles/bimap-tests.dir/mappedbimap_tests.cpp.o" "gcc" "tests/CMakeFiles/bimap-tests.dir/mappedbimap_tests.cpp.o.d"
+  "/root/repo/tests/snapshotbimap_tests.cpp" "tests/CMakeFiles/bimap-tests.dir/snapshotbimap_tests.cpp.o" "gcc" "tests/CMakeFiles/bimap-tests.dir/snapshotbimap_tests.cpp.o.d"
+  "/root/repo/tests/sortedvectorbimap_tests.cpp" "tests/CMakeFiles/bimap-tests.dir/sortedvectorbimap_tests.cpp.o" "gcc" "tests/CMakeFiles/bimap-tests.dir/sortedvectorbimap_tests.cpp.o.d"
+  "/root/repo/tests/staticbimap_tests.cpp" "tests/CMakeFiles/bimap-tests.dir/staticbimap_tests.cpp.o" "gcc" "tests/CMakeFiles/bimap-tests.dir/staticbimap_tests.cpp.o.d"
+  "/root/repo/tests/stringpoolbimap_tests.cpp" "tests/CMakeFiles/bimap-tests.dir/stringpoolbimap_tests.cpp.o" "gcc" "tests/CMakeFiles/bimap-tests.dir/stringpoolbimap_tests.cpp.o.d"
+  "/root/repo/tests/unorderedbimap_tests.cpp" "tests/CMakeFiles/bimap-tests.dir/unorderedbimap_tests.cpp.o" "gcc" "tests/CMakeFiles/bimap-tests.dir/unorderedbimap_tests.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
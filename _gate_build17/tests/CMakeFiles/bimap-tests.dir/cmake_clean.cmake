@@ -0,0 +1,33 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bimap-tests.dir/bimap_tests.cpp.o"
+  "CMakeFiles/bimap-tests.dir/bimap_tests.cpp.o.d"
+  "CMakeFiles/bimap-tests.dir/bimapparallel_tests.cpp.o"
+  "CMakeFiles/bimap-tests.dir/bimapparallel_tests.cpp.o.d"
+  "CMakeFiles/bimap-tests.dir/bimapstats_tests.cpp.o"
+  "CMakeFiles/bimap-tests.dir/bimapstats_tests.cpp.o.d"
+  "CMakeFiles/bimap-tests.dir/concurrentbimap_tests.cpp.o"
+  "CMakeFiles/bimap-tests.dir/concurrentbimap_tests.cpp.o.d"
+  "CMakeFiles/bimap-tests.dir/densekeybimap_tests.cpp.o"
+  "CMakeFiles/bimap-tests.dir/densekeybimap_tests.cpp.o.d"
+  "CMakeFiles/bimap-tests.dir/flatbimap_tests.cpp.o"
+  "CMakeFiles/bimap-tests.dir/flatbimap_tests.cpp.o.d"
+  "CMakeFiles/bimap-tests.dir/mappedbimap_tests.cpp.o"
+  "CMakeFiles/bimap-tests.dir/mappedbimap_tests.cpp.o.d"
+  "CMakeFiles/bimap-tests.dir/snapshotbimap_tests.cpp.o"
+  "CMakeFiles/bimap-tests.dir/snapshotbimap_tests.cpp.o.d"
+  "CMakeFiles/bimap-tests.dir/sortedvectorbimap_tests.cpp.o"
+  "CMakeFiles/bimap-tests.dir/sortedvectorbimap_tests.cpp.o.d"
+  "CMakeFiles/bimap-tests.dir/staticbimap_tests.cpp.o"
+  "CMakeFiles/bimap-tests.dir/staticbimap_tests.cpp.o.d"
+  "CMakeFiles/bimap-tests.dir/stringpoolbimap_tests.cpp.o"
+  "CMakeFiles/bimap-tests.dir/stringpoolbimap_tests.cpp.o.d"
+  "CMakeFiles/bimap-tests.dir/unorderedbimap_tests.cpp.o"
+  "CMakeFiles/bimap-tests.dir/unorderedbimap_tests.cpp.o.d"
+  "bimap-tests"
+  "bimap-tests.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bimap-tests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
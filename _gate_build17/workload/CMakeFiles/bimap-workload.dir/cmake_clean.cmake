@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bimap-workload.dir/bimap_workload.cpp.o"
+  "CMakeFiles/bimap-workload.dir/bimap_workload.cpp.o.d"
+  "CMakeFiles/bimap-workload.dir/workloadalloc.cpp.o"
+  "CMakeFiles/bimap-workload.dir/workloadalloc.cpp.o.d"
+  "bimap-workload"
+  "bimap-workload.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bimap-workload.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,389 @@
+#ifndef LCH_BENCHCOMMON_H
+#define LCH_BENCHCOMMON_H
+
+/*****************************/
+/* File documentations       */
+/*****************************/
+
+/*!
+   \file benchcommon.h
+   \brief Datasets and container adapters used by benchmarks.
+
+   Each container is driven through an adapter providing the same set
+   of static operations, so every benchmark is written once and
+   instantiated for every container and every type. \n
+   Baseline containers replace conflicting pairs on insertion,
+   like \c cmap containers do, so timings can be compared.
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "bimap.h"
+#include "flatbimap.h"
+#include "sortedvectorbimap.h"
+#include "unorderedbimap.h"
+
+#if BIMAP_BENCH_HAS_BOOST
+#include <boost/bimap.hpp>
+#include <boost/bimap/set_of.hpp>
+#include <boost/bimap/unordered_set_of.hpp>
+#endif
+
+namespace bench{
+
+/*****************************/
+/* Types generators          */
+/*****************************/
+
+/*!
+ * \brief Bijective mix of an index, so generated
+ * elements are unique but not sorted
+ */
+inline std::uint64_t mixIndex(std::uint64_t index)
+{
+    index += 0x9E3779B97F4A7C15ULL;
+    index = (index ^ (index >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    index = (index ^ (index >> 27)) * 0x94D049BB133111EBULL;
+    return index ^ (index >> 31);
+}
+
+struct TypeInt
+{
+    using type = int;
+    static const char* name() { return "int"; }
+    static type make(std::size_t index) { return static_cast<type>(index); }
+};
+
+struct TypeU64
+{
+    using type = std::uint64_t;
+    static const char* name() { return "u64"; }
+    static type make(std::size_t index) { return mixIndex(index); }
+};
+
+/*!
+ * \brief Strings fitting in small string buffer
+ */
+struct TypeShortString
+{
+    using type = std::string;
+    static const char* name() { return "str8"; }
+    static type make(std::size_t index)
+    {
+        static const char digits[] = "0123456789abcdef";
+
+        type str(1, 's');
+        do{
+            str.push_back(digits[index & 0xF]);
+            index >>= 4;
+        }while(index != 0);
+
+        return str;
+    }
+};
+
+/*!
+ * \brief Heap allocated strings sharing a long prefix,
+ * so comparisons have to go through it
+ */
+struct TypeLongString
+{
+    using type = std::string;
+    static const char* name() { return "str40"; }
+    static type make(std::size_t index) { return "bimap/benchmark/long/string/prefix/" + std::to_string(index); }
+};
+
+/*****************************/
+/* Datasets                  */
+/*****************************/
+
+/*!
+ * \brief Elements used by a benchmark
+ * \details
+ * - \c pairs: elements to insert, in random order
+ * - \c keys / \c values: elements of pairs, in another random order (used for hits)
+ * - \c missKeys / \c missValues: elements not in pairs (used for misses)
+ */
+template<class GenKey, class GenValue>
+struct Dataset
+{
+    using TypeKey = typename GenKey::type;
+    using TypeValue = typename GenValue::type;
+
+    explicit Dataset(std::size_t size);
+
+    std::vector<std::pair<TypeKey, TypeValue>> pairs;
+    std::vector<TypeKey> keys;
+    std::vector<TypeValue> values;
+    std::vector<TypeKey> missKeys;
+    std::vector<TypeValue> missValues;
+};
+
+template<class GenKey, class GenValue>
+Dataset<GenKey, GenValue>::Dataset(std::size_t size)
+{
+    std::mt19937_64 rng(size);
+
+    pairs.reserve(size);
+    for(std::size_t i = 0; i < size; ++i){
+        pairs.emplace_back(GenKey::make(i), GenValue::make(size - 1 - i));
+    }
+    std::shuffle(pairs.begin(), pairs.end(), rng);
+
+    std::vector<std::size_t> order(size);
+    for(std::size_t i = 0; i < size; ++i){
+        order[i] = i;
+    }
+    std::shuffle(order.begin(), order.end(), rng);
+
+    keys.reserve(size);
+    values.reserve(size);
+    missKeys.reserve(size);
+    missValues.reserve(size);
+    for(std::size_t i : order){
+        keys.push_back(pairs[i].first);
+        values.push_back(pairs[i].second);
+        missKeys.push_back(GenKey::make(size + i));
+        missValues.push_back(GenValue::make(size + i));
+    }
+}
+
+/*****************************/
+/* Adapters of containers    */
+/*****************************/
+
+/*!
+ * \brief Adapter of \c cmap containers
+ * \details
+ * Elements are built by inserting them one by one.
+ */
+template<class Container>
+struct AdapterCmap
+{
+    using TypeContainer = Container;
+    using TypeKey = typename Container::key_type;
+    using TypeValue = typename Container::mapped_type;
+
+    static constexpr bool fastErase = true;
+
+    static void build(Container &container, const std::vector<std::pair<TypeKey, TypeValue>> &pairs)
+    {
+        for(const auto &pair : pairs){
+            container.insert(pair.first, pair.second);
+        }
+    }
+
+    static void insert(Container &container, const TypeKey &key, const TypeValue &value)
+    {
+        container.insert(key, value);
+    }
+
+    static void erase(Container &container, const TypeKey &key)
+    {
+        container.erase(key);
+    }
+
+    static const TypeValue* findByKey(const Container &container, const TypeKey &key)
+    {
+        auto it = container.findByKey(key);
+        return it != container.cend() ? &it->second : nullptr;
+    }
+
+    static const TypeKey* findByValue(const Container &container, const TypeValue &value)
+    {
+        auto it = container.findByValue(value);
+        return it != container.cend() ? &it->first : nullptr;
+    }
+
+    template<class Func>
+    static void forEach(const Container &container, Func func)
+    {
+        for(auto it = container.cbegin(); it != container.cend(); ++it){
+            func(it->first, it->second);
+        }
+    }
+};
+
+/*!
+ * \brief Adapter of \c cmap containers providing reserve()
+ */
+template<class Container>
+struct AdapterCmapReserve : AdapterCmap<Container>
+{
+    using typename AdapterCmap<Container>::TypeKey;
+    using typename AdapterCmap<Container>::TypeValue;
+
+    static void build(Container &container, const std::vector<std::pair<TypeKey, TypeValue>> &pairs)
+    {
+        container.reserve(pairs.size());
+        AdapterCmap<Container>::build(container, pairs);
+    }
+};
+
+/*!
+ * \brief Adapter of \c cmap::SortedVectorBimap
+ * \details
+ * Elements are built at once and erasing is linear,
+ * so erase benchmark is skipped.
+ */
+template<class Container>
+struct AdapterCmapSorted : AdapterCmap<Container>
+{
+    using typename AdapterCmap<Container>::TypeKey;
+    using typename AdapterCmap<Container>::TypeValue;
+
+    static constexpr bool fastErase = false;
+
+    static void build(Container &container, const std::vector<std::pair<TypeKey, TypeValue>> &pairs)
+    {
+        container.assign(pairs.cbegin(), pairs.cend());
+    }
+};
+
+/*!
+ * \brief Bimap emulated by two maps, one for each side
+ */
+template<class MapLeft, class MapRight>
+struct PairOfMaps
+{
+    MapLeft left;
+    MapRight right;
+};
+
+template<class Container>
+struct AdapterPairOfMaps
+{
+    using TypeContainer = Container;
+    using TypeKey = typename decltype(Container::left)::key_type;
+    using TypeValue = typename decltype(Container::left)::mapped_type;
+
+    static constexpr bool fastErase = true;
+
+    static void build(Container &container, const std::vector<std::pair<TypeKey, TypeValue>> &pairs)
+    {
+        for(const auto &pair : pairs){
+            insert(container, pair.first, pair.second);
+        }
+    }
+
+    static void insert(Container &container, const TypeKey &key, const TypeValue &value)
+    {
+        /* Remove conflicting pairs */
+        auto itLeft = container.left.find(key);
+        if(itLeft != container.left.end()){
+            container.right.erase(itLeft->second);
+            container.left.erase(itLeft);
+        }
+
+        auto itRight = container.right.find(value);
+        if(itRight != container.right.end()){
+            container.left.erase(itRight->second);
+            container.right.erase(itRight);
+        }
+
+        container.left.emplace(key, value);
+        container.right.emplace(value, key);
+    }
+
+    static void erase(Container &container, const TypeKey &key)
+    {
+        auto it = container.left.find(key);
+        if(it != container.left.end()){
+            container.right.erase(it->second);
+            container.left.erase(it);
+        }
+    }
+
+    static const TypeValue* findByKey(const Container &container, const TypeKey &key)
+    {
+        auto it = container.left.find(key);
+        return it != container.left.end() ? &it->second : nullptr;
+    }
+
+    static const TypeKey* findByValue(const Container &container, const TypeValue &value)
+    {
+        auto it = container.right.find(value);
+        return it != container.right.end() ? &it->second : nullptr;
+    }
+
+    template<class Func>
+    static void forEach(const Container &container, Func func)
+    {
+        for(const auto &pair : container.left){
+            func(pair.first, pair.second);
+        }
+    }
+};
+
+#if BIMAP_BENCH_HAS_BOOST
+template<class Container>
+struct AdapterBoost
+{
+    using TypeContainer = Container;
+    using TypeKey = typename Container::left_key_type;
+    using TypeValue = typename Container::right_key_type;
+
+    static constexpr bool fastErase = true;
+
+    static void build(Container &container, const std::vector<std::pair<TypeKey, TypeValue>> &pairs)
+    {
+        for(const auto &pair : pairs){
+            insert(container, pair.first, pair.second);
+        }
+    }
+
+    static void insert(Container &container, const TypeKey &key, const TypeValue &value)
+    {
+        container.left.erase(key);
+        container.right.erase(value);
+        container.insert(typename Container::value_type(key, value));
+    }
+
+    static void erase(Container &container, const TypeKey &key)
+    {
+        container.left.erase(key);
+    }
+
+    static const TypeValue* findByKey(const Container &container, const TypeKey &key)
+    {
+        auto it = container.left.find(key);
+        return it != container.left.end() ? &it->second : nullptr;
+    }
+
+    static const TypeKey* findByValue(const Container &container, const TypeValue &value)
+    {
+        auto it = container.right.find(value);
+        return it != container.right.end() ? &it->second : nullptr;
+    }
+
+    template<class Func>
+    static void forEach(const Container &container, Func func)
+    {
+        for(const auto &pair : container.left){
+            func(pair.first, pair.second);
+        }
+    }
+};
+#endif
+
+template<class Container>
+constexpr bool AdapterCmap<Container>::fastErase;
+template<class Container>
+constexpr bool AdapterCmapSorted<Container>::fastErase;
+template<class Container>
+constexpr bool AdapterPairOfMaps<Container>::fastErase;
+#if BIMAP_BENCH_HAS_BOOST
+template<class Container>
+constexpr bool AdapterBoost<Container>::fastErase;
+#endif
+
+} // Namespace bench
+
+#endif // LCH_BENCHCOMMON_H
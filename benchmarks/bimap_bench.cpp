@@ -0,0 +1,326 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "benchcommon.h"
+
+/*****************************/
+/* Macro definitions         */
+/*****************************/
+
+/*!
+ * \brief Range of sizes used by benchmarks
+ * \details
+ * Sizes are multiplied by 10 from minimal to maximal size.
+ * Can be overriden at compile-time to shorten runs.
+ */
+#ifndef BIMAP_BENCH_SIZE_MIN
+#define BIMAP_BENCH_SIZE_MIN 1000
+#endif
+
+#ifndef BIMAP_BENCH_SIZE_MAX
+#define BIMAP_BENCH_SIZE_MAX 10000000
+#endif
+
+/*****************************/
+/* Namespace instructions    */
+/*****************************/
+
+using namespace bench;
+
+/*****************************/
+/* Benchmarks definitions    */
+/*****************************/
+
+/*!
+ * \brief Construct container from all pairs
+ */
+template<class Adapter, class GenKey, class GenValue>
+void benchBuild(benchmark::State &state)
+{
+    const std::size_t size = static_cast<std::size_t>(state.range(0));
+    const Dataset<GenKey, GenValue> data(size);
+
+    for(auto _ : state){
+        {
+            typename Adapter::TypeContainer container;
+            Adapter::build(container, data.pairs);
+            benchmark::ClobberMemory();
+
+            state.PauseTiming(); // Don't measure destruction
+        }
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+/*!
+ * \brief Copy-construct a filled container
+ */
+template<class Adapter, class GenKey, class GenValue>
+void benchCopy(benchmark::State &state)
+{
+    const std::size_t size = static_cast<std::size_t>(state.range(0));
+    const Dataset<GenKey, GenValue> data(size);
+
+    typename Adapter::TypeContainer reference;
+    Adapter::build(reference, data.pairs);
+
+    for(auto _ : state){
+        {
+            typename Adapter::TypeContainer container(reference);
+            benchmark::ClobberMemory();
+
+            state.PauseTiming(); // Don't measure destruction
+        }
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+/*!
+ * \brief Insert all pairs in a container already filled with them,
+ * so each insertion replace an existing pair
+ */
+template<class Adapter, class GenKey, class GenValue>
+void benchInsertExisting(benchmark::State &state)
+{
+    const std::size_t size = static_cast<std::size_t>(state.range(0));
+    const Dataset<GenKey, GenValue> data(size);
+
+    typename Adapter::TypeContainer container;
+    Adapter::build(container, data.pairs);
+
+    for(auto _ : state){
+        for(const auto &pair : data.pairs){
+            Adapter::insert(container, pair.first, pair.second);
+        }
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+/*!
+ * \brief Erase all pairs of a filled container
+ */
+template<class Adapter, class GenKey, class GenValue>
+void benchErase(benchmark::State &state)
+{
+    const std::size_t size = static_cast<std::size_t>(state.range(0));
+    const Dataset<GenKey, GenValue> data(size);
+
+    typename Adapter::TypeContainer reference;
+    Adapter::build(reference, data.pairs);
+
+    typename Adapter::TypeContainer container;
+    for(auto _ : state){
+        state.PauseTiming();
+        container = reference;
+        state.ResumeTiming();
+
+        for(const auto &key : data.keys){
+            Adapter::erase(container, key);
+        }
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+/*!
+ * \brief Perform one lookup by key per iteration, keys
+ * are picked from \c probes in random order
+ */
+template<class Adapter, class GenKey, class GenValue, bool hit>
+void benchFindKey(benchmark::State &state)
+{
+    const std::size_t size = static_cast<std::size_t>(state.range(0));
+    const Dataset<GenKey, GenValue> data(size);
+    const auto &probes = hit ? data.keys : data.missKeys;
+
+    typename Adapter::TypeContainer container;
+    Adapter::build(container, data.pairs);
+
+    std::size_t index = 0;
+    for(auto _ : state){
+        benchmark::DoNotOptimize(Adapter::findByKey(container, probes[index]));
+        if(++index == probes.size()){
+            index = 0;
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+/*!
+ * \brief Perform one lookup by value per iteration, values
+ * are picked from \c probes in random order
+ */
+template<class Adapter, class GenKey, class GenValue, bool hit>
+void benchFindValue(benchmark::State &state)
+{
+    const std::size_t size = static_cast<std::size_t>(state.range(0));
+    const Dataset<GenKey, GenValue> data(size);
+    const auto &probes = hit ? data.values : data.missValues;
+
+    typename Adapter::TypeContainer container;
+    Adapter::build(container, data.pairs);
+
+    std::size_t index = 0;
+    for(auto _ : state){
+        benchmark::DoNotOptimize(Adapter::findByValue(container, probes[index]));
+        if(++index == probes.size()){
+            index = 0;
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+/*!
+ * \brief Retrieve values of a batch of keys per iteration, with
+ * batched lookup API of \c cmap containers
+ */
+template<class Adapter, class GenKey, class GenValue>
+void benchGetValuesBatch(benchmark::State &state)
+{
+    const std::size_t size = static_cast<std::size_t>(state.range(0));
+    const std::size_t batch = std::min<std::size_t>(size, 4096);
+    const Dataset<GenKey, GenValue> data(size);
+
+    typename Adapter::TypeContainer container;
+    Adapter::build(container, data.pairs);
+
+    std::vector<typename Adapter::TypeValue> values(batch);
+    std::unique_ptr<bool[]> found(new bool[batch]);
+
+    std::size_t first = 0;
+    for(auto _ : state){
+        benchmark::DoNotOptimize(container.getValues(data.keys.data() + first, batch, values.data(), found.get()));
+        first = (first + batch + batch <= size) ? first + batch : 0;
+    }
+
+    state.SetItemsProcessed(state.iterations() * batch);
+}
+
+/*!
+ * \brief Iterate over all pairs of container
+ */
+template<class Adapter, class GenKey, class GenValue>
+void benchIterate(benchmark::State &state)
+{
+    using TypeKey = typename Adapter::TypeKey;
+    using TypeValue = typename Adapter::TypeValue;
+
+    const std::size_t size = static_cast<std::size_t>(state.range(0));
+    const Dataset<GenKey, GenValue> data(size);
+
+    typename Adapter::TypeContainer container;
+    Adapter::build(container, data.pairs);
+
+    for(auto _ : state){
+        Adapter::forEach(container, [](const TypeKey &key, const TypeValue &value){
+            benchmark::DoNotOptimize(key);
+            benchmark::DoNotOptimize(value);
+        });
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+}
+
+/*****************************/
+/* Benchmarks registration   */
+/*****************************/
+
+static void registerBench(const std::string &name, void (*func)(benchmark::State&))
+{
+    benchmark::RegisterBenchmark(name.c_str(), func)
+        ->RangeMultiplier(10)
+        ->Range(BIMAP_BENCH_SIZE_MIN, BIMAP_BENCH_SIZE_MAX);
+}
+
+/*!
+ * \brief Register all benchmarks of a container
+ * \details
+ * Benchmarks are named <tt>container/operation/key/value/size</tt>,
+ * so they can be selected with option \c --benchmark_filter.
+ */
+template<class Adapter, class GenKey, class GenValue>
+void registerContainer(const std::string &container)
+{
+    const std::string types = std::string("/") + GenKey::name() + "/" + GenValue::name();
+
+    registerBench(container + "/Build" + types, &benchBuild<Adapter, GenKey, GenValue>);
+    registerBench(container + "/Copy" + types, &benchCopy<Adapter, GenKey, GenValue>);
+    if(Adapter::fastErase){
+        registerBench(container + "/InsertExisting" + types, &benchInsertExisting<Adapter, GenKey, GenValue>);
+        registerBench(container + "/Erase" + types, &benchErase<Adapter, GenKey, GenValue>);
+    }
+    registerBench(container + "/GetValueHit" + types, &benchFindKey<Adapter, GenKey, GenValue, true>);
+    registerBench(container + "/GetValueMiss" + types, &benchFindKey<Adapter, GenKey, GenValue, false>);
+    registerBench(container + "/GetKeyHit" + types, &benchFindValue<Adapter, GenKey, GenValue, true>);
+    registerBench(container + "/GetKeyMiss" + types, &benchFindValue<Adapter, GenKey, GenValue, false>);
+    registerBench(container + "/Iterate" + types, &benchIterate<Adapter, GenKey, GenValue>);
+}
+
+/*!
+ * \brief Register benchmarks of APIs only provided by \c cmap containers
+ */
+template<class Adapter, class GenKey, class GenValue>
+void registerCmapContainer(const std::string &container)
+{
+    const std::string types = std::string("/") + GenKey::name() + "/" + GenValue::name();
+
+    registerContainer<Adapter, GenKey, GenValue>(container);
+    registerBench(container + "/GetValuesBatch" + types, &benchGetValuesBatch<Adapter, GenKey, GenValue>);
+}
+
+template<class GenKey, class GenValue>
+void registerTypes()
+{
+    using K = typename GenKey::type;
+    using V = typename GenValue::type;
+
+    registerCmapContainer<AdapterCmap<cmap::Bimap<K, V>>, GenKey, GenValue>("cmap::Bimap");
+    registerCmapContainer<AdapterCmapReserve<cmap::UnorderedBimap<K, V>>, GenKey, GenValue>("cmap::UnorderedBimap");
+    registerCmapContainer<AdapterCmapReserve<cmap::FlatBimap<K, V>>, GenKey, GenValue>("cmap::FlatBimap");
+    registerCmapContainer<AdapterCmapSorted<cmap::SortedVectorBimap<K, V>>, GenKey, GenValue>("cmap::SortedVectorBimap");
+
+    registerContainer<AdapterPairOfMaps<PairOfMaps<std::map<K, V>, std::map<V, K>>>, GenKey, GenValue>("std::map");
+    registerContainer<AdapterPairOfMaps<PairOfMaps<std::unordered_map<K, V>, std::unordered_map<V, K>>>, GenKey, GenValue>("std::unordered_map");
+
+#if BIMAP_BENCH_HAS_BOOST
+    using boost::bimaps::set_of;
+    using boost::bimaps::unordered_set_of;
+
+    registerContainer<AdapterBoost<boost::bimap<set_of<K>, set_of<V>>>, GenKey, GenValue>("boost::bimap");
+    registerContainer<AdapterBoost<boost::bimap<unordered_set_of<K>, unordered_set_of<V>>>, GenKey, GenValue>("boost::bimap_unordered");
+#endif
+}
+
+/*****************************/
+/* Main entry point          */
+/*****************************/
+
+int main(int argc, char **argv)
+{
+    registerTypes<TypeInt, TypeInt>();
+    registerTypes<TypeU64, TypeU64>();
+    registerTypes<TypeShortString, TypeShortString>();
+    registerTypes<TypeLongString, TypeLongString>();
+
+    benchmark::Initialize(&argc, argv);
+    if(benchmark::ReportUnrecognizedArguments(argc, argv)){
+        return 1;
+    }
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    return 0;
+}
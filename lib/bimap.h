@@ -16,8 +16,22 @@
    values (<b>O(log(n))</b>).
 
    \note
-   Note that to provide fast-lookup on both entities, memory usage is doubled, so use
-   this class <b>only</b> when you really need it.
+   Each pair is stored only once, inside a single node which is linked into
+   two intrusive red-black trees: one ordered by keys and one ordered by values.
+   So inserting an element only perform one allocation and keys/values are never
+   duplicated.
+
+   \note
+   Keys and values are ordered with \c CompareKey and \c CompareValue. When
+   compiled with at least C++14, both default to transparent \c std::less<>,
+   so lookups can be performed with any type comparable to stored ones
+   without constructing a temporary.
+
+   \note
+   Nodes are allocated with \c Allocator (rebound to the node type), so
+   \c cmap::PoolAllocator (see bimapallocator.h) or, with C++17,
+   \c std::pmr::polymorphic_allocator (see alias \c cmap::pmr::Bimap) can
+   be used to avoid one heap allocation per element.
 
    \note
    If you have dependency to \b Boost library (https://www.boost.org/), use
@@ -25,234 +39,3536 @@
    instead of this class.
 */
 
-#include <map>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "bimapcodec.h"
+#include "bimapcommon.h"
+#include "bimapstats.h"
+
+#if BIMAP_HAS_PMR
+#   include <memory_resource>
+#endif
+
+namespace cmap{
+
+/*****************************/
+/* Internal implementation   */
+/*****************************/
+
+namespace detail{
+
+/*!
+ * \brief Links of a node inside an intrusive red-black tree.
+ * \details
+ * Each tree owns an header hook: its \c parent is the root, its \c left
+ * is the leftmost node and its \c right is the rightmost node. The header
+ * is always red so it can be distinguished from the root (always black).
+ */
+struct BimapHook
+{
+    BimapHook *parent;
+    BimapHook *left;
+    BimapHook *right;
+    bool red;
+};
+
+/* Distinct hook types, so a node can be linked in both trees */
+struct BimapHookKey : BimapHook {};
+struct BimapHookValue : BimapHook {};
+
+/*!
+ * \brief Node shared by both trees of a bimap
+ */
+template<class TypeData>
+struct BimapNode : BimapHookKey, BimapHookValue
+{
+    using value_type = TypeData;
+
+    template<class... Args>
+    explicit BimapNode(Args&&... args) : BimapHookKey(), BimapHookValue(), data(std::forward<Args>(args)...) {}
+
+    TypeData data;
+};
+
+/* Extract keys used to order each tree */
+struct BimapKeyOfFirst
+{
+    template<class TypeData>
+    const typename TypeData::first_type& operator()(const TypeData &data) const { return data.first; }
+};
+
+struct BimapKeyOfSecond
+{
+    template<class TypeData>
+    const typename TypeData::second_type& operator()(const TypeData &data) const { return data.second; }
+};
+
+/*!
+ * \brief Returns number of nodes of the longest path from \c x to a leaf
+ */
+inline std::size_t bimapTreeHeight(const BimapHook *x)
+{
+    if(!x){
+        return 0;
+    }
+
+    const std::size_t left = bimapTreeHeight(x->left);
+    const std::size_t right = bimapTreeHeight(x->right);
+    return 1 + (left > right ? left : right);
+}
+
+inline void bimapTreeReset(BimapHook &header)
+{
+    header.parent = nullptr;
+    header.left = &header;
+    header.right = &header;
+    header.red = true;
+}
+
+inline BimapHook* bimapTreeMinimum(BimapHook *x)
+{
+    while(x->left){
+        x = x->left;
+    }
+    return x;
+}
+
+inline BimapHook* bimapTreeMaximum(BimapHook *x)
+{
+    while(x->right){
+        x = x->right;
+    }
+    return x;
+}
+
+inline BimapHook* bimapTreeIncrement(BimapHook *x)
+{
+    if(x->right){
+        return bimapTreeMinimum(x->right);
+    }
+
+    BimapHook *y = x->parent;
+    while(x == y->right){
+        x = y;
+        y = y->parent;
+    }
+
+    /* Handle case where root has no right child (header->right == root) */
+    if(x->right != y){
+        x = y;
+    }
+    return x;
+}
+
+inline BimapHook* bimapTreeDecrement(BimapHook *x)
+{
+    /* Decrementing end() (header) give rightmost node */
+    if(x->red && x->parent->parent == x){
+        return x->right;
+    }
+
+    if(x->left){
+        return bimapTreeMaximum(x->left);
+    }
+
+    BimapHook *y = x->parent;
+    while(x == y->left){
+        x = y;
+        y = y->parent;
+    }
+    return y;
+}
+
+inline void bimapTreeRotateLeft(BimapHook *x, BimapHook *&root)
+{
+    BimapHook *y = x->right;
+
+    x->right = y->left;
+    if(y->left){
+        y->left->parent = x;
+    }
+    y->parent = x->parent;
+
+    if(x == root){
+        root = y;
+    }else if(x == x->parent->left){
+        x->parent->left = y;
+    }else{
+        x->parent->right = y;
+    }
+
+    y->left = x;
+    x->parent = y;
+}
+
+inline void bimapTreeRotateRight(BimapHook *x, BimapHook *&root)
+{
+    BimapHook *y = x->left;
+
+    x->left = y->right;
+    if(y->right){
+        y->right->parent = x;
+    }
+    y->parent = x->parent;
+
+    if(x == root){
+        root = y;
+    }else if(x == x->parent->right){
+        x->parent->right = y;
+    }else{
+        x->parent->left = y;
+    }
+
+    y->right = x;
+    x->parent = y;
+}
+
+/*!
+ * \brief Link node \c x as a child of \c p and restore red-black properties
+ */
+inline void bimapTreeInsertAndRebalance(bool insertLeft, BimapHook *x, BimapHook *p, BimapHook &header)
+{
+    BimapHook *&root = header.parent;
+
+    x->parent = p;
+    x->left = nullptr;
+    x->right = nullptr;
+    x->red = true;
+
+    /* Link node and maintain leftmost/rightmost */
+    if(insertLeft){
+        p->left = x;
+        if(p == &header){
+            header.parent = x;
+            header.right = x;
+        }else if(p == header.left){
+            header.left = x;
+        }
+    }else{
+        p->right = x;
+        if(p == header.right){
+            header.right = x;
+        }
+    }
+
+    /* Rebalance */
+    while(x != root && x->parent->red){
+        BimapHook *const xpp = x->parent->parent;
+
+        if(x->parent == xpp->left){
+            BimapHook *const y = xpp->right;
+            if(y && y->red){
+                x->parent->red = false;
+                y->red = false;
+                xpp->red = true;
+                x = xpp;
+            }else{
+                if(x == x->parent->right){
+                    x = x->parent;
+                    bimapTreeRotateLeft(x, root);
+                }
+                x->parent->red = false;
+                xpp->red = true;
+                bimapTreeRotateRight(xpp, root);
+            }
+        }else{
+            BimapHook *const y = xpp->left;
+            if(y && y->red){
+                x->parent->red = false;
+                y->red = false;
+                xpp->red = true;
+                x = xpp;
+            }else{
+                if(x == x->parent->left){
+                    x = x->parent;
+                    bimapTreeRotateRight(x, root);
+                }
+                x->parent->red = false;
+                xpp->red = true;
+                bimapTreeRotateLeft(xpp, root);
+            }
+        }
+    }
+    root->red = false;
+}
+
+/*!
+ * \brief Unlink node \c z from tree and restore red-black properties
+ */
+inline void bimapTreeEraseAndRebalance(BimapHook *z, BimapHook &header)
+{
+    BimapHook *&root = header.parent;
+    BimapHook *&leftmost = header.left;
+    BimapHook *&rightmost = header.right;
+
+    BimapHook *y = z;
+    BimapHook *x = nullptr;
+    BimapHook *xParent = nullptr;
+
+    if(!y->left){
+        x = y->right;
+    }else if(!y->right){
+        x = y->left;
+    }else{
+        y = bimapTreeMinimum(y->right);
+        x = y->right;
+    }
+
+    if(y != z){
+        /* Relink y in place of z (y is z's successor) */
+        z->left->parent = y;
+        y->left = z->left;
+
+        if(y != z->right){
+            xParent = y->parent;
+            if(x){
+                x->parent = y->parent;
+            }
+            y->parent->left = x;
+            y->right = z->right;
+            z->right->parent = y;
+        }else{
+            xParent = y;
+        }
+
+        if(root == z){
+            root = y;
+        }else if(z->parent->left == z){
+            z->parent->left = y;
+        }else{
+            z->parent->right = y;
+        }
+        y->parent = z->parent;
+
+        std::swap(y->red, z->red);
+        y = z; // y now points to node to be actually removed
+    }else{
+        xParent = y->parent;
+        if(x){
+            x->parent = y->parent;
+        }
+
+        if(root == z){
+            root = x;
+        }else if(z->parent->left == z){
+            z->parent->left = x;
+        }else{
+            z->parent->right = x;
+        }
+
+        if(leftmost == z){
+            leftmost = z->right ? bimapTreeMinimum(x) : z->parent;
+        }
+        if(rightmost == z){
+            rightmost = z->left ? bimapTreeMaximum(x) : z->parent;
+        }
+    }
+
+    if(y->red){
+        return;
+    }
+
+    /* Removed node was black: fix double black */
+    while(x != root && (!x || !x->red)){
+        if(x == xParent->left){
+            BimapHook *w = xParent->right;
+            if(w->red){
+                w->red = false;
+                xParent->red = true;
+                bimapTreeRotateLeft(xParent, root);
+                w = xParent->right;
+            }
+
+            if((!w->left || !w->left->red) && (!w->right || !w->right->red)){
+                w->red = true;
+                x = xParent;
+                xParent = xParent->parent;
+            }else{
+                if(!w->right || !w->right->red){
+                    w->left->red = false;
+                    w->red = true;
+                    bimapTreeRotateRight(w, root);
+                    w = xParent->right;
+                }
+                w->red = xParent->red;
+                xParent->red = false;
+                if(w->right){
+                    w->right->red = false;
+                }
+                bimapTreeRotateLeft(xParent, root);
+                break;
+            }
+        }else{
+            BimapHook *w = xParent->left;
+            if(w->red){
+                w->red = false;
+                xParent->red = true;
+                bimapTreeRotateRight(xParent, root);
+                w = xParent->left;
+            }
+
+            if((!w->right || !w->right->red) && (!w->left || !w->left->red)){
+                w->red = true;
+                x = xParent;
+                xParent = xParent->parent;
+            }else{
+                if(!w->left || !w->left->red){
+                    w->right->red = false;
+                    w->red = true;
+                    bimapTreeRotateLeft(w, root);
+                    w = xParent->left;
+                }
+                w->red = xParent->red;
+                xParent->red = false;
+                if(w->left){
+                    w->left->red = false;
+                }
+                bimapTreeRotateRight(xParent, root);
+                break;
+            }
+        }
+    }
+
+    if(x){
+        x->red = false;
+    }
+}
+
+/*!
+ * \brief Put node \c x at the exact place of node \c z
+ * \details
+ * No rebalancing is needed, \c x must have a key equivalent to
+ * the one of \c z, which is left unlinked.
+ */
+inline void bimapTreeReplace(BimapHook *z, BimapHook *x, BimapHook &header)
+{
+    x->parent = z->parent;
+    x->left = z->left;
+    x->right = z->right;
+    x->red = z->red;
+
+    /* Update links pointing to z */
+    if(header.parent == z){
+        header.parent = x;
+    }else if(z->parent->left == z){
+        z->parent->left = x;
+    }else{
+        z->parent->right = x;
+    }
+
+    if(x->left){
+        x->left->parent = x;
+    }
+    if(x->right){
+        x->right->parent = x;
+    }
+
+    if(header.left == z){
+        header.left = x;
+    }
+    if(header.right == z){
+        header.right = x;
+    }
+}
+
+/*!
+ * \brief Exchange content of two tree headers
+ */
+inline void bimapTreeSwap(BimapHook &lhs, BimapHook &rhs)
+{
+    std::swap(lhs, rhs);
+
+    /* Restore links pointing to headers */
+    BimapHook *headers[] = {&lhs, &rhs};
+    for(BimapHook *header : headers){
+        if(header->parent){
+            header->parent->parent = header;
+        }else{
+            bimapTreeReset(*header);
+        }
+    }
+}
+
+/*!
+ * \brief Intrusive red-black tree of bimap nodes
+ * \details
+ * This class doesn't own nodes, it only manage links of \c TypeHook
+ * part of each node. Nodes are ordered with \c TypeCompare applied on
+ * keys extracted with \c TypeKeyOf.
+ */
+template<class TypeNode, class TypeHook, class TypeKeyOf, class TypeCompare>
+class BimapTree : private TypeCompare
+{
+public:
+    explicit BimapTree(const TypeCompare &compare = TypeCompare()) : TypeCompare(compare) { bimapTreeReset(m_header); }
+    BimapTree(const BimapTree &other) = delete;
+    BimapTree& operator=(const BimapTree &other) = delete;
+
+public:
+    static BimapHook* toHook(TypeNode *node) { return static_cast<TypeHook*>(node); }
+    static TypeNode* toNode(BimapHook *hook) { return static_cast<TypeNode*>(static_cast<TypeHook*>(hook)); }
+
+    BimapHook* header() const { return const_cast<BimapHook*>(&m_header); }
+    BimapHook* root() const { return m_header.parent; }
+    BimapHook* leftmost() const { return m_header.left; }
+    BimapHook* rightmost() const { return m_header.right; }
+
+    const TypeCompare& compare() const { return *this; }
+
+    void reset() { bimapTreeReset(m_header); }
+    void swap(BimapTree &other)
+    {
+        using std::swap;
+        swap(static_cast<TypeCompare&>(*this), static_cast<TypeCompare&>(other));
+        bimapTreeSwap(m_header, other.m_header);
+    }
+
+    template<class T>
+    BimapHook* lowerBound(const T &key) const
+    {
+        BimapHook *x = root();
+        BimapHook *y = header();
+        while(x){
+            if(!less(keyOf(x), key)){
+                y = x;
+                x = x->left;
+            }else{
+                x = x->right;
+            }
+        }
+        return y;
+    }
+
+    std::size_t height() const
+    {
+        return bimapTreeHeight(root());
+    }
+
+    template<class T>
+    BimapHook* upperBound(const T &key) const
+    {
+        BimapHook *x = root();
+        BimapHook *y = header();
+        while(x){
+            if(less(key, keyOf(x))){
+                y = x;
+                x = x->left;
+            }else{
+                x = x->right;
+            }
+        }
+        return y;
+    }
+
+    /*!
+     * \brief Returns lower bound of \c key and the following node
+     * if it is equivalent to \c key (keys are unique)
+     */
+    template<class T>
+    std::pair<BimapHook*, BimapHook*> equalRange(const T &key) const
+    {
+        BimapHook *first = lowerBound(key);
+        if(first == header() || less(key, keyOf(first))){
+            return std::make_pair(first, first);
+        }
+        return std::make_pair(first, bimapTreeIncrement(first));
+    }
+
+    template<class T>
+    BimapHook* find(const T &key) const
+    {
+        BimapHook *y = lowerBound(key);
+        if(y == header() || less(key, keyOf(y))){
+            return header();
+        }
+        return y;
+    }
+
+    /*!
+     * \brief Search several keys at once
+     * \details
+     * Keys are searched by groups of \c BimapBatchWidth: all searches of
+     * a group descend the tree one level at a time and prefetch their next
+     * node, so cache misses of independent searches overlap.
+     *
+     * \param found
+     * Array of \c count hooks, set to \c nullptr if key is not found.
+     */
+    template<class T>
+    void findBatch(const T *keys, std::size_t count, BimapHook **found) const
+    {
+        BimapHook *cursors[BimapBatchWidth];
+        BimapHook *bounds[BimapBatchWidth];
+
+        for(std::size_t first = 0; first < count; first += BimapBatchWidth){
+            const std::size_t width = std::min(BimapBatchWidth, count - first);
+            const T *group = keys + first;
+
+            for(std::size_t i = 0; i < width; ++i){
+                cursors[i] = root();
+                bounds[i] = header();
+            }
+
+            bool active = root() != nullptr;
+            while(active){
+                active = false;
+                for(std::size_t i = 0; i < width; ++i){
+                    BimapHook *x = cursors[i];
+                    if(!x){
+                        continue;
+                    }
+
+                    if(!less(keyOf(x), group[i])){
+                        bounds[i] = x;
+                        x = x->left;
+                    }else{
+                        x = x->right;
+                    }
+
+                    if(x){
+                        bimapPrefetch(x);
+                        bimapPrefetch(&keyOf(x));
+                        active = true;
+                    }
+                    cursors[i] = x;
+                }
+            }
+
+            for(std::size_t i = 0; i < width; ++i){
+                BimapHook *y = bounds[i];
+                found[first + i] = (y == header() || less(group[i], keyOf(y))) ? nullptr : y;
+            }
+        }
+    }
+
+    /*!
+     * \brief Find position where a node with \c key could be linked
+     * \return
+     * Returns \c nullptr if an equivalent key is already linked (stored
+     * in \c found), otherwise returns parent where to link node (and
+     * side to use in \c insertLeft).
+     */
+    template<class T>
+    BimapHook* insertPosition(const T &key, bool &insertLeft, BimapHook *&found) const
+    {
+        BimapHook *x = root();
+        BimapHook *y = header();
+        bool comp = true;
+
+        while(x){
+            y = x;
+            comp = less(key, keyOf(x));
+            x = comp ? x->left : x->right;
+        }
+
+        BimapHook *j = y;
+        if(comp){
+            if(j == leftmost()){
+                insertLeft = true;
+                return y;
+            }
+            j = bimapTreeDecrement(j);
+        }
+
+        if(less(keyOf(j), key)){
+            insertLeft = (y == header() || less(key, keyOf(y)));
+            return y;
+        }
+
+        found = j;
+        return nullptr;
+    }
+
+    /*!
+     * \brief Same as insertPosition(), but first check if \c key
+     * can be linked after rightmost node
+     * \details
+     * Linking keys sorted in ascending order then costs a single
+     * comparison instead of a full descent.
+     */
+    template<class T>
+    BimapHook* insertPositionHint(const T &key, bool &insertLeft, BimapHook *&found) const
+    {
+        if(root() && less(keyOf(rightmost()), key)){
+            insertLeft = false;
+            return rightmost();
+        }
+        return insertPosition(key, insertLeft, found);
+    }
+
+    /*!
+     * \brief Link \c count nodes sorted by keys in linear time
+     * \details
+     * Tree must be empty and keys must be unique. Each node becomes
+     * the middle of its range, so every path holds the same number of
+     * black nodes when nodes of the only incomplete level are red: no
+     * rebalancing is needed.
+     */
+    void build(TypeNode *const *nodes, std::size_t count)
+    {
+        reset();
+        if(count == 0){
+            return;
+        }
+
+        std::size_t completeLevels = 0;
+        while((std::size_t(2) << completeLevels) <= count + 1){
+            ++completeLevels;
+        }
+
+        m_header.parent = buildRange(nodes, 0, count, header(), 0, completeLevels);
+        m_header.left = toHook(nodes[0]);
+        m_header.right = toHook(nodes[count - 1]);
+    }
+
+    void link(TypeNode *node, BimapHook *parent, bool insertLeft)
+    {
+        bimapTreeInsertAndRebalance(insertLeft, toHook(node), parent, m_header);
+    }
+
+    /*!
+     * \brief Link node just before \c hint (\c header() to link it
+     * as last node)
+     * \details
+     * No comparison is performed, caller must ensure that order is respected.
+     */
+    void linkBefore(TypeNode *node, BimapHook *hint)
+    {
+        if(hint == header()){
+            root() ? link(node, rightmost(), false) : link(node, header(), true);
+        }else if(!hint->left){
+            link(node, hint, true);
+        }else{
+            link(node, bimapTreeDecrement(hint), false);
+        }
+    }
+
+    /*!
+     * \brief Link \c count nodes sorted by keys, none of them being
+     * equivalent to a linked key
+     * \details
+     * When a key falls before successor of previous node, node is linked
+     * there without any descent (as hinted insertions of \c std::map),
+     * so a run of keys falling between two linked ones only costs one
+     * comparison per node.
+     */
+    void linkSorted(TypeNode *const *nodes, std::size_t count)
+    {
+        BimapHook *next = nullptr;
+        for(std::size_t i = 0; i < count; ++i){
+            const auto &key = TypeKeyOf()(nodes[i]->data);
+            if(next && (next == header() || less(key, keyOf(next)))){
+                linkBefore(nodes[i], next);
+            }else{
+                bool insertLeft = false;
+                BimapHook *found = nullptr;
+                BimapHook *parent = insertPosition(key, insertLeft, found);
+                link(nodes[i], parent, insertLeft);
+            }
+            next = bimapTreeIncrement(toHook(nodes[i]));
+        }
+    }
+
+    void unlink(TypeNode *node)
+    {
+        bimapTreeEraseAndRebalance(toHook(node), m_header);
+    }
+
+    void replace(TypeNode *oldNode, TypeNode *newNode)
+    {
+        bimapTreeReplace(toHook(oldNode), toHook(newNode), m_header);
+    }
+
+private:
+    static auto keyOf(BimapHook *hook) -> decltype(TypeKeyOf()(toNode(hook)->data))
+    {
+        return TypeKeyOf()(toNode(hook)->data);
+    }
+
+    static BimapHook* buildRange(TypeNode *const *nodes, std::size_t first, std::size_t last, BimapHook *parent, std::size_t depth, std::size_t redDepth)
+    {
+        if(first == last){
+            return nullptr;
+        }
+
+        const std::size_t middle = first + (last - first) / 2;
+        BimapHook *x = toHook(nodes[middle]);
+        x->parent = parent;
+        x->red = (depth == redDepth);
+        x->left = buildRange(nodes, first, middle, x, depth + 1, redDepth);
+        x->right = buildRange(nodes, middle + 1, last, x, depth + 1, redDepth);
+
+        return x;
+    }
+
+    template<class T1, class T2>
+    bool less(const T1 &lhs, const T2 &rhs) const
+    {
+        return TypeCompare::operator()(lhs, rhs);
+    }
+
+private:
+    BimapHook m_header;
+};
+
+/*!
+ * \brief Bidirectional iterator over one tree of a bimap
+ * \details
+ * Iterated elements are constant since keys and values are both
+ * used to order nodes.
+ */
+template<class TypeNode, class TypeHook>
+class BimapIterator
+{
+public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = typename TypeNode::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type*;
+    using reference = const value_type&;
+
+public:
+    BimapIterator() : m_hook(nullptr) {}
+    explicit BimapIterator(BimapHook *hook) : m_hook(hook) {}
+
+public:
+    reference operator*() const { return node()->data; }
+    pointer operator->() const { return &node()->data; }
+
+    BimapIterator& operator++() { m_hook = bimapTreeIncrement(m_hook); return *this; }
+    BimapIterator operator++(int) { BimapIterator tmp = *this; ++*this; return tmp; }
+    BimapIterator& operator--() { m_hook = bimapTreeDecrement(m_hook); return *this; }
+    BimapIterator operator--(int) { BimapIterator tmp = *this; --*this; return tmp; }
+
+    friend bool operator==(const BimapIterator &lhs, const BimapIterator &rhs) { return lhs.m_hook == rhs.m_hook; }
+    friend bool operator!=(const BimapIterator &lhs, const BimapIterator &rhs) { return lhs.m_hook != rhs.m_hook; }
+
+public:
+    TypeNode* node() const { return static_cast<TypeNode*>(static_cast<TypeHook*>(m_hook)); }
+    BimapHook* hook() const { return m_hook; }
+
+private:
+    BimapHook *m_hook;
+};
+
+} // Namespace detail
+
+/*****************************/
+/* Class definitions         */
+/*****************************/
+
+template<class TypeKey, class TypeValue, class CompareKey = detail::BimapLess<TypeKey>, class CompareValue = detail::BimapLess<TypeValue>,
+         class Allocator = std::allocator<std::pair<const TypeKey, TypeValue>>>
+class Bimap
+{
+public:
+    using key_type = TypeKey;
+    using mapped_type = TypeValue;
+    using value_type = std::pair<const TypeKey, TypeValue>;
+    using size_type = std::size_t;
+
+    using key_compare = CompareKey;
+    using value_compare = CompareValue;
+    using allocator_type = Allocator;
+
+private:
+    using _TypeNode = std::pair<TypeKey, TypeValue>; // Used to implement std::initializer_list<T> support
+
+    using _Node = detail::BimapNode<value_type>;
+    using _AllocNode = typename std::allocator_traits<Allocator>::template rebind_alloc<_Node>;
+    using _AllocTraits = std::allocator_traits<_AllocNode>;
+    using _ContainerKey = detail::BimapTree<_Node, detail::BimapHookKey, detail::BimapKeyOfFirst, CompareKey>;
+    using _ContainerValue = detail::BimapTree<_Node, detail::BimapHookValue, detail::BimapKeyOfSecond, CompareValue>;
+
+public:
+    using iterator = detail::BimapIterator<_Node, detail::BimapHookKey>;
+    using const_iterator = iterator;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    using value_iterator = detail::BimapIterator<_Node, detail::BimapHookValue>;
+    using reverse_value_iterator = std::reverse_iterator<value_iterator>;
+
+    /*!
+     * \brief View of bimap ordered by values
+     * \details
+     * Iterated elements are the same <tt>(key, value)</tt> pairs than those
+     * of the bimap, ordered by values. View doesn't copy anything, it stays
+     * valid as long as the bimap exists.
+     */
+    class ValueView
+    {
+        friend class Bimap;
+
+    public:
+        value_iterator begin() const { return value_iterator(m_bimap->m_mapInversed.leftmost()); }
+        value_iterator end() const { return value_iterator(m_bimap->m_mapInversed.header()); }
+        reverse_value_iterator rbegin() const { return reverse_value_iterator(end()); }
+        reverse_value_iterator rend() const { return reverse_value_iterator(begin()); }
+
+        bool empty() const { return m_bimap->empty(); }
+        std::size_t size() const { return m_bimap->size(); }
+
+        template<class V>
+        value_iterator find(const V &value) const { return value_iterator(m_bimap->m_mapInversed.find(value)); }
+        template<class V>
+        value_iterator lowerBound(const V &value) const { return m_bimap->lowerBoundValue(value); }
+        template<class V>
+        value_iterator upperBound(const V &value) const { return m_bimap->upperBoundValue(value); }
+        template<class V>
+        std::pair<value_iterator, value_iterator> equalRange(const V &value) const { return m_bimap->equalRangeValue(value); }
+
+    private:
+        explicit ValueView(const Bimap *bimap) : m_bimap(bimap) {}
+
+    private:
+        const Bimap *m_bimap;
+    };
+
+    /*!
+     * \brief Node extracted from a bimap
+     * \details
+     * A node handle owns an element which is not linked into any bimap,
+     * it can be inserted into another bimap (with an equal allocator)
+     * without allocating or copying anything. Element is destroyed with
+     * the handle if it has not been inserted.
+     *
+     * \sa extract(), insert(node_type&&)
+     */
+    class NodeHandle
+    {
+        friend class Bimap;
+
+    public:
+        NodeHandle() noexcept : m_node(nullptr) {}
+        NodeHandle(NodeHandle &&other) noexcept : m_node(nullptr) { take(other); }
+        ~NodeHandle() { reset(); }
+
+        NodeHandle& operator=(NodeHandle &&other) noexcept
+        {
+            if(this != &other){
+                reset();
+                take(other);
+            }
+            return *this;
+        }
+
+        NodeHandle(const NodeHandle &other) = delete;
+        NodeHandle& operator=(const NodeHandle &other) = delete;
+
+    public:
+        bool empty() const noexcept { return m_node == nullptr; }
+        explicit operator bool() const noexcept { return m_node != nullptr; }
+
+        const TypeKey& key() const { return m_node->data.first; }
+        const TypeValue& value() const { return m_node->data.second; }
+        TypeValue& value() { return m_node->data.second; }
+
+        Allocator getAllocator() const { return Allocator(m_alloc); }
+
+    private:
+        NodeHandle(_Node *node, const _AllocNode &alloc) : m_node(node) { ::new(static_cast<void*>(&m_alloc)) _AllocNode(alloc); }
+
+        /* Give up ownership of node, handle become empty */
+        _Node* release() noexcept
+        {
+            _Node *node = m_node;
+            m_alloc.~_AllocNode();
+            m_node = nullptr;
+            return node;
+        }
+
+        void take(NodeHandle &other) noexcept
+        {
+            if(other.m_node){
+                ::new(static_cast<void*>(&m_alloc)) _AllocNode(std::move(other.m_alloc));
+                m_node = other.release();
+            }
+        }
+
+        void reset() noexcept
+        {
+            if(m_node){
+                _AllocTraits::destroy(m_alloc, m_node);
+                _AllocTraits::deallocate(m_alloc, m_node, 1);
+                release();
+            }
+        }
+
+    private:
+        _Node *m_node;
+
+        /* Only constructed when handle is not empty, allocators may not be default constructible */
+        union{
+            _AllocNode m_alloc;
+        };
+    };
+
+    using node_type = NodeHandle;
+
+    class Journal;
+
+    /*!
+     * \brief Set of changes applied at once by apply()
+     * \details
+     * Changes are only collected: conflicts() reports which ones can't be
+     * applied, and nothing is modified until apply() is called.
+     */
+    class Patch
+    {
+
+    public:
+        enum class Operation : std::uint8_t
+        {
+            Insert, /**< Insert a new pair, key must not exist */
+            Erase,  /**< Erase pair of an existing key */
+            Assign  /**< Replace value of an existing key */
+        };
+
+        struct Change
+        {
+            Operation operation;
+            TypeKey key;
+            TypeValue value; /**< Default constructed value for Operation::Erase */
+        };
+
+        struct Conflict
+        {
+            PatchConflict reason;
+            std::size_t change; /**< Index of change in changes() */
+        };
+
+    public:
+        void insert(const TypeKey &key, const TypeValue &value) { m_changes.push_back(Change{Operation::Insert, key, value}); }
+        void insert(TypeKey &&key, TypeValue &&value) { m_changes.push_back(Change{Operation::Insert, std::move(key), std::move(value)}); }
+        void erase(const TypeKey &key) { m_changes.push_back(Change{Operation::Erase, key, TypeValue()}); }
+        void assign(const TypeKey &key, const TypeValue &value) { m_changes.push_back(Change{Operation::Assign, key, value}); }
+        void assign(TypeKey &&key, TypeValue &&value) { m_changes.push_back(Change{Operation::Assign, std::move(key), std::move(value)}); }
+
+        bool empty() const noexcept { return m_changes.empty(); }
+        std::size_t size() const noexcept { return m_changes.size(); }
+        void clear() noexcept { m_changes.clear(); }
+
+        const std::vector<Change>& changes() const noexcept { return m_changes; }
+
+    private:
+        friend class Journal;
+
+        std::vector<Change> m_changes;
+    };
+
+    /*!
+     * \brief Patches applied to a bimap, numbered by versions
+     * \details
+     * Patch of version \c v brings a bimap from version \c v to
+     * <tt>v + 1</tt>. A replica at version \c v only needs patches
+     * recorded since \c v (see serialize() and Bimap::replay()) instead
+     * of a full snapshot.
+     */
+    class Journal
+    {
+
+    public:
+        explicit Journal(std::uint64_t version = 0) : m_firstVersion(version) {}
+
+    public:
+        std::uint64_t firstVersion() const noexcept { return m_firstVersion; }
+        std::uint64_t version() const noexcept { return m_firstVersion + m_patches.size(); }
+
+        const Patch& patch(std::uint64_t version) const
+        {
+            if(version < m_firstVersion || version - m_firstVersion >= m_patches.size()){
+                throw std::out_of_range("cmap::Bimap::Journal::patch");
+            }
+            return m_patches[static_cast<std::size_t>(version - m_firstVersion)];
+        }
+
+        void record(const Patch &patch) { m_patches.push_back(patch); }
+        void trim(std::uint64_t version);
+
+        void serialize(std::ostream &out, std::uint64_t since) const;
+        void serialize(std::vector<unsigned char> &buffer, std::uint64_t since) const;
+        void deserialize(std::istream &in);
+        std::size_t deserialize(const void *data, std::size_t size);
+
+    private:
+        template<class Sink>
+        void serializeTo(Sink &sink, std::uint64_t since) const;
+        template<class Source>
+        void deserializeFrom(Source &source);
+
+    private:
+        std::uint64_t m_firstVersion;
+        std::vector<Patch> m_patches;
+    };
+
+public:
+    Bimap();
+    explicit Bimap(const CompareKey &compareKey, const CompareValue &compareValue = CompareValue(), const Allocator &alloc = Allocator());
+    explicit Bimap(const Allocator &alloc);
+    Bimap(const std::initializer_list<_TypeNode> &args, const Allocator &alloc = Allocator());
+
+    template<class InputIt, detail::BimapEnablePairIterator<InputIt> = 0>
+    Bimap(InputIt first, InputIt last,
+          const CompareKey &compareKey = CompareKey(), const CompareValue &compareValue = CompareValue(), const Allocator &alloc = Allocator());
+
+    Bimap(const Bimap &other);
+    Bimap(const Bimap &other, const Allocator &alloc);
+    Bimap(Bimap &&other);
+    ~Bimap();
+
+    Bimap& operator=(const Bimap &other);
+    Bimap& operator=(Bimap &&other);
+
+public:
+    bool empty() const;
+    std::size_t size() const;
+    std::size_t maxSize() const;
+
+    void clear();
+    void insert(const TypeKey &key, const TypeValue &value);
+    void insert(TypeKey &&key, TypeValue &&value);
+    void erase(const TypeKey &key);
+    void eraseByValue(const TypeValue &value);
+    iterator erase(const_iterator first, const_iterator last);
+    value_iterator erase(value_iterator first, value_iterator last);
+    template<class Predicate>
+    std::size_t eraseIf(Predicate pred);
+    void swap(Bimap &other);
+
+    node_type extract(const TypeKey &key);
+    node_type extract(const_iterator position);
+    std::pair<iterator, bool> insert(node_type &&node);
+    void merge(Bimap &other);
+    void merge(Bimap &&other);
+
+    template<class InputIt, detail::BimapEnablePairIterator<InputIt> = 0>
+    std::size_t insert(InputIt first, InputIt last);
+    template<class InputIt, class Executor>
+    void assign(InputIt first, InputIt last, Executor &executor);
+
+    const TypeValue& getValue(const TypeKey &key) const;
+    const TypeKey& getKey(const TypeValue &value) const;
+
+    template<class K, class C = CompareKey, detail::BimapEnableTransparent<C> = 0>
+    const TypeValue& getValue(const K &key) const;
+    template<class V, class C = CompareValue, detail::BimapEnableTransparent<C> = 0>
+    const TypeKey& getKey(const V &value) const;
+
+    const_iterator findByKey(const TypeKey &key) const;
+    const_iterator findByValue(const TypeValue &value) const;
+    bool containsKey(const TypeKey &key) const;
+    bool containsValue(const TypeValue &value) const;
+
+    template<class K, class C = CompareKey, detail::BimapEnableTransparent<C> = 0>
+    const_iterator findByKey(const K &key) const;
+    template<class V, class C = CompareValue, detail::BimapEnableTransparent<C> = 0>
+    const_iterator findByValue(const V &value) const;
+    template<class K, class C = CompareKey, detail::BimapEnableTransparent<C> = 0>
+    bool containsKey(const K &key) const;
+    template<class V, class C = CompareValue, detail::BimapEnableTransparent<C> = 0>
+    bool containsValue(const V &value) const;
+
+    const_iterator lowerBoundKey(const TypeKey &key) const;
+    const_iterator upperBoundKey(const TypeKey &key) const;
+    std::pair<const_iterator, const_iterator> equalRangeKey(const TypeKey &key) const;
+    value_iterator lowerBoundValue(const TypeValue &value) const;
+    value_iterator upperBoundValue(const TypeValue &value) const;
+    std::pair<value_iterator, value_iterator> equalRangeValue(const TypeValue &value) const;
+
+    template<class K, class C = CompareKey, detail::BimapEnableTransparent<C> = 0>
+    const_iterator lowerBoundKey(const K &key) const;
+    template<class K, class C = CompareKey, detail::BimapEnableTransparent<C> = 0>
+    const_iterator upperBoundKey(const K &key) const;
+    template<class K, class C = CompareKey, detail::BimapEnableTransparent<C> = 0>
+    std::pair<const_iterator, const_iterator> equalRangeKey(const K &key) const;
+    template<class V, class C = CompareValue, detail::BimapEnableTransparent<C> = 0>
+    value_iterator lowerBoundValue(const V &value) const;
+    template<class V, class C = CompareValue, detail::BimapEnableTransparent<C> = 0>
+    value_iterator upperBoundValue(const V &value) const;
+    template<class V, class C = CompareValue, detail::BimapEnableTransparent<C> = 0>
+    std::pair<value_iterator, value_iterator> equalRangeValue(const V &value) const;
+
+    ValueView byValue() const;
+
+    std::size_t getValues(const TypeKey *keys, std::size_t count, TypeValue *values, bool *found = nullptr) const;
+    std::size_t getKeys(const TypeValue *values, std::size_t count, TypeKey *keys, bool *found = nullptr) const;
+
+    template<class... Args>
+    std::pair<iterator, bool> emplace(Args&&... args);
+    std::pair<iterator, bool> tryInsert(const TypeKey &key, const TypeValue &value);
+    std::pair<iterator, bool> tryInsert(TypeKey &&key, TypeValue &&value);
+
+    std::pair<iterator, bool> insertOrAssign(const TypeKey &key, const TypeValue &value);
+    std::pair<iterator, bool> insertOrAssign(TypeKey &&key, TypeValue &&value);
+    std::pair<iterator, bool> replace(const TypeKey &key, const TypeValue &value, ReplacePolicy policy);
+    std::pair<iterator, bool> replace(TypeKey &&key, TypeValue &&value, ReplacePolicy policy);
+
+    void serialize(std::ostream &out) const;
+    void serialize(std::vector<unsigned char> &buffer) const;
+    void deserialize(std::istream &in);
+    std::size_t deserialize(const void *data, std::size_t size);
+
+    std::vector<typename Patch::Conflict> conflicts(const Patch &patch) const;
+    void apply(const Patch &patch, Journal *journal = nullptr);
+    std::uint64_t replay(const Journal &journal, std::uint64_t version);
+
+    CompareKey keyComp() const;
+    CompareValue valueComp() const;
+    Allocator getAllocator() const;
+
+    BimapMemoryUsage memoryUsage() const;
+    std::size_t keyTreeHeight() const;
+    std::size_t valueTreeHeight() const;
+
+#if defined(BIMAP_ENABLE_STATS)
+    BimapStats& stats() const;
+#endif
+
+private:
+    void insert(_TypeNode &&node);
+    void insert(const _TypeNode &node);
+
+    template<class K, class V>
+    std::pair<iterator, bool> tryInsertPair(K &&key, V &&value, bool sortedHint = false);
+    template<class K, class V>
+    std::pair<iterator, bool> replacePair(K &&key, V &&value, bool overwriteLeft, bool overwriteRight, bool &inserted);
+
+    template<class... Args>
+    _Node* createNode(Args&&... args);
+    void destroyNode(_Node *node);
+    void destroyTree(detail::BimapHook *hook);
+
+    template<class InputIt>
+    std::vector<_Node*> createNodes(InputIt first, InputIt last);
+    bool buildTrees(std::vector<_Node*> nodes, bool rejectDuplicates);
+    template<class Executor>
+    bool buildTrees(std::vector<_Node*> nodes, bool rejectDuplicates, Executor &executor);
+
+    template<class Sink>
+    void serializeTo(Sink &sink) const;
+    template<class Source>
+    void deserializeFrom(Source &source);
+
+    std::vector<typename Patch::Conflict> checkPatch(const Patch &patch, std::vector<std::size_t> &order, std::vector<_Node*> &existing) const;
+
+    void insertNode(_Node *node);
+    std::pair<iterator, bool> linkNode(_Node *node, bool sortedHint = false);
+    std::pair<iterator, bool> tryLinkNode(_Node *node, bool sortedHint = false);
+    void unlinkNode(_Node *node);
+    _Node* detachNode(_Node *node);
+
+public:
+    iterator begin();
+    const_iterator cbegin() const;
+    reverse_iterator rbegin();
+    const_reverse_iterator crbegin() const;
+    iterator end();
+    const_iterator cend() const;
+    reverse_iterator rend();
+    const_reverse_iterator crend() const;
+
+private:
+    _ContainerKey m_map;
+    _ContainerValue m_mapInversed;
+    std::size_t m_size;
+
+    _AllocNode m_alloc;
+
+#if defined(BIMAP_ENABLE_STATS)
+    mutable BimapStats m_stats;
+#endif
+};
+
+#if BIMAP_HAS_PMR
+namespace pmr{
+
+/*!
+ * \brief Alias of \c cmap::Bimap allocating its nodes from a
+ * \c std::pmr::memory_resource
+ *
+ * <b>Example: </b>
+ * \code{.cpp}
+    std::pmr::monotonic_buffer_resource arena;
+    cmap::pmr::Bimap<int, int> bimap(&arena);
+ * \endcode
+ */
+template<class TypeKey, class TypeValue, class CompareKey = detail::BimapLess<TypeKey>, class CompareValue = detail::BimapLess<TypeValue>>
+using Bimap = cmap::Bimap<TypeKey, TypeValue, CompareKey, CompareValue, std::pmr::polymorphic_allocator<std::pair<const TypeKey, TypeValue>>>;
+
+} // Namespace pmr
+#endif
+
+/*
+ * Functions implementations
+ * Class use template and methods cannot be defined in .cpp file.
+ * See https://isocpp.org/wiki/faq/templates#separate-template-fn-defn-from-decl
+ */
+
+#define BIMAP_TEMPLATE template<class TypeKey, class TypeValue, class CompareKey, class CompareValue, class Allocator>
+#define BIMAP_CLASS Bimap<TypeKey, TypeValue, CompareKey, CompareValue, Allocator>
+
+/*!
+ * \brief Construct empty bimap
+ */
+BIMAP_TEMPLATE
+BIMAP_CLASS::Bimap() : Bimap(CompareKey())
+{
+    /* Nothing to do */
+}
+
+/*!
+ * \brief Construct empty bimap
+ *
+ * \param compareKey
+ * Comparison function used to order keys.
+ * \param compareValue
+ * Comparison function used to order values.
+ * \param alloc
+ * Allocator used to allocate nodes.
+ */
+BIMAP_TEMPLATE
+BIMAP_CLASS::Bimap(const CompareKey &compareKey, const CompareValue &compareValue, const Allocator &alloc) :
+    m_map(compareKey), m_mapInversed(compareValue), m_size(0), m_alloc(alloc)
+{
+    /* Nothing to do, both trees are constructed empty */
+}
+
+/*!
+ * \brief Construct empty bimap using allocator \c alloc
+ */
+BIMAP_TEMPLATE
+BIMAP_CLASS::Bimap(const Allocator &alloc) : Bimap(CompareKey(), CompareValue(), alloc)
+{
+    /* Nothing to do */
+}
+
+/*!
+ * \brief Construct bimap with \c std::initializer_list
+ * \param args
+ * List to use to construct bimap.
+ *
+ * <b>Example: </b>
+ * \code{.c}
+    const cmap::Bimap<int, std::string> m_mapNumberToString =
+    {
+        {1, "ONE"},
+        {2, "TWO"},
+        {3, "THREE"}
+    };
+ * \endcode
+ */
+BIMAP_TEMPLATE
+BIMAP_CLASS::Bimap(const std::initializer_list<_TypeNode> &args, const Allocator &alloc) : Bimap(CompareKey(), CompareValue(), alloc)
+{
+    for(auto it=args.begin(); it != args.end(); ++it){
+        insert(*it);
+    }
+}
+
+/*!
+ * \brief Construct bimap from a range of pairs
+ * \details
+ * Unlike insert(), duplicated keys or values are not silently replaced:
+ * they are rejected and no element is kept. \n
+ * Pairs are sorted once per side (skipped if already sorted) and both
+ * trees are then built in linear time, without any rebalancing.
+ *
+ * \param first, last
+ * Range of pairs (\c first is the key, \c second the value).
+ * \param compareKey
+ * Comparison function used to order keys.
+ * \param compareValue
+ * Comparison function used to order values.
+ * \param alloc
+ * Allocator used to allocate nodes.
+ *
+ * \throw std::invalid_argument
+ * Throw if range contains duplicated keys or values.
+ */
+BIMAP_TEMPLATE
+template<class InputIt, detail::BimapEnablePairIterator<InputIt>>
+BIMAP_CLASS::Bimap(InputIt first, InputIt last, const CompareKey &compareKey, const CompareValue &compareValue, const Allocator &alloc) :
+    Bimap(compareKey, compareValue, alloc)
+{
+    buildTrees(createNodes(first, last), true);
+}
+
+/*!
+ * \brief Copy constructor
+ * \details
+ * Each node of \c other is duplicated, only one allocation
+ * is performed per element.
+ */
+BIMAP_TEMPLATE
+BIMAP_CLASS::Bimap(const Bimap &other) :
+    Bimap(other, Allocator(_AllocTraits::select_on_container_copy_construction(other.m_alloc)))
+{
+    /* Nothing to do */
+}
+
+/*!
+ * \brief Copy constructor using allocator \c alloc
+ */
+BIMAP_TEMPLATE
+BIMAP_CLASS::Bimap(const Bimap &other, const Allocator &alloc) : Bimap(other.keyComp(), other.valueComp(), alloc)
+{
+    try{
+        for(auto it = other.cbegin(); it != other.cend(); ++it){
+            /* Elements are unique and ordered, link at end of key tree */
+            _Node *node = createNode(*it);
+            m_map.link(node, m_map.rightmost(), m_map.rightmost() == m_map.header());
+
+            bool left = false;
+            detail::BimapHook *found = nullptr;
+            detail::BimapHook *parent = m_mapInversed.insertPosition(node->data.second, left, found);
+            m_mapInversed.link(node, parent, left);
+            ++m_size;
+        }
+    }catch(...){
+        clear();
+        throw;
+    }
+}
+
+/*!
+ * \brief Move constructor
+ * \details
+ * Nodes are stolen from \c other, which is left empty.
+ */
+BIMAP_TEMPLATE
+BIMAP_CLASS::Bimap(Bimap &&other) : Bimap(other.keyComp(), other.valueComp(), other.getAllocator())
+{
+    swap(other);
+}
+
+/*!
+ * \brief Destroy bimap and all its elements
+ */
+BIMAP_TEMPLATE
+BIMAP_CLASS::~Bimap()
+{
+    clear();
+}
+
+/*!
+ * \brief Copy assignment operator
+ * \details
+ * Allocator of \c other is only used if it propagates on
+ * copy assignment.
+ */
+BIMAP_TEMPLATE
+BIMAP_CLASS &BIMAP_CLASS::operator=(const Bimap &other)
+{
+    if(this != &other){
+        const bool propagate = _AllocTraits::propagate_on_container_copy_assignment::value;
+        Bimap tmp(other, propagate ? other.getAllocator() : getAllocator());
+
+        /* Nodes of tmp must be released by the allocator which created them */
+        clear();
+        detail::bimapAssignAllocator(m_alloc, tmp.m_alloc, typename _AllocTraits::propagate_on_container_copy_assignment());
+        swap(tmp);
+    }
+    return *this;
+}
+
+/*!
+ * \brief Move assignment operator
+ * \details
+ * Nodes are stolen from \c other, except if allocators doesn't
+ * propagate on move assignment and are not equal: elements are
+ * then copied with current allocator.
+ */
+BIMAP_TEMPLATE
+BIMAP_CLASS &BIMAP_CLASS::operator=(Bimap &&other)
+{
+    if(this != &other){
+        clear();
+
+        if(_AllocTraits::propagate_on_container_move_assignment::value || m_alloc == other.m_alloc){
+            detail::bimapAssignAllocator(m_alloc, other.m_alloc, typename _AllocTraits::propagate_on_container_move_assignment());
+            swap(other);
+        }else{
+            Bimap tmp(other, getAllocator());
+            swap(tmp);
+            other.clear();
+        }
+    }
+    return *this;
+}
+
+/*!
+ * \brief Checks whether the container is empty
+ *
+ * \return
+ * Returns \c true if the container is empty, \c false otherwise
+ */
+BIMAP_TEMPLATE
+bool BIMAP_CLASS::empty() const
+{
+    return m_size == 0;
+}
+
+/*!
+ * \brief Returns the number of elements
+ *
+ * \return
+ * The number of elements in the container
+ */
+BIMAP_TEMPLATE
+std::size_t BIMAP_CLASS::size() const
+{
+    return m_size;
+}
+
+/*!
+ * \brief Returns the maximum possible number of elements
+ *
+ * \return
+ * Maximum number of elements
+ */
+BIMAP_TEMPLATE
+std::size_t BIMAP_CLASS::maxSize() const
+{
+    return std::numeric_limits<std::size_t>::max() / sizeof(_Node);
+}
+
+/*!
+ * \brief Clears the contents
+ * \details
+ * Erases all elements from the container. After this call, size() returns zero. \n
+ * Invalidates any references, pointers, or iterators referring to contained elements. Any past-the-end iterator remains valid.
+ */
+BIMAP_TEMPLATE
+void BIMAP_CLASS::clear()
+{
+    /* Nodes are shared, only walk key tree to release them */
+    destroyTree(m_map.root());
+
+    m_map.reset();
+    m_mapInversed.reset();
+    m_size = 0;
+}
+
+/*!
+ * \brief Insert item to bimap
+ *
+ * \param key
+ * Key of element, if key already exist, it will be replaced.
+ * \param value
+ * Value associated to the key, if value is already associated
+ * to another key, this association will be removed.
+ */
+BIMAP_TEMPLATE
+void BIMAP_CLASS::insert(const TypeKey &key, const TypeValue &value)
+{
+    insertNode(createNode(key, value));
+}
+
+/*!
+ * \overload
+ * \details
+ * Key and value are moved into the new element.
+ */
+BIMAP_TEMPLATE
+void BIMAP_CLASS::insert(TypeKey &&key, TypeValue &&value)
+{
+    insertNode(createNode(std::move(key), std::move(value)));
+}
+
+/*!
+ * \overload
+ */
+BIMAP_TEMPLATE
+void BIMAP_CLASS::insert(_TypeNode &&node)
+{
+    insert(std::move(node.first), std::move(node.second));
+}
+
+/*!
+ * \overload
+ */
+BIMAP_TEMPLATE
+void BIMAP_CLASS::insert(const _TypeNode &node)
+{
+    insert(node.first, node.second);
+}
+
+/*!
+ * \brief Insert a range of pairs
+ * \details
+ * Pairs are inserted like with tryInsert(): a pair whose key or value
+ * already exists (in bimap or earlier in range) is skipped instead of
+ * replacing existing elements. \n
+ * When bimap is empty and range has no duplicates, both trees are built
+ * in linear time (after sorting each side, skipped if already sorted).
+ * Otherwise, pairs are linked one by one and pairs sorted by ascending
+ * keys only cost one key comparison.
+ *
+ * \param first, last
+ * Range of pairs (\c first is the key, \c second the value).
+ * \return
+ * Returns number of inserted pairs, so duplicates are reported by
+ * comparing it with the range size.
+ */
+BIMAP_TEMPLATE
+template<class InputIt, detail::BimapEnablePairIterator<InputIt>>
+std::size_t BIMAP_CLASS::insert(InputIt first, InputIt last)
+{
+    if(!empty()){
+        std::size_t inserted = 0;
+        for(; first != last; ++first){
+            inserted += tryInsertPair(first->first, first->second, true).second ? 1 : 0;
+        }
+        return inserted;
+    }
+
+    const std::vector<_Node*> nodes = createNodes(first, last);
+    if(buildTrees(nodes, false)){
+        BIMAP_STATS_RECORD_COUNT(m_stats, Insert, m_size);
+        return m_size;
+    }
+
+    /* Duplicates: keep first pairs, in order of range */
+    std::size_t index = 0;
+    try{
+        for(; index < nodes.size(); ++index){
+            linkNode(nodes[index], true);
+        }
+    }catch(...){
+        for(; index < nodes.size(); ++index){
+            destroyNode(nodes[index]);
+        }
+        throw;
+    }
+    return m_size;
+}
+
+/*!
+ * \brief Replace content of bimap by a range of pairs, using
+ * tasks of \c executor
+ * \details
+ * Like range constructor, duplicated keys or values are rejected. \n
+ * Nodes are allocated by calling thread, then each side is sorted
+ * with all tasks of \c executor and both trees are built at the
+ * same time (see bimapparallel.h for executors).
+ *
+ * \param first, last
+ * Range of pairs (\c first is the key, \c second the value).
+ * \param executor
+ * Executor running tasks, \c cmap::BimapThreadExecutor for example.
+ *
+ * \throw std::invalid_argument
+ * Throw if range contains duplicated keys or values, bimap is
+ * left unchanged.
+ */
+BIMAP_TEMPLATE
+template<class InputIt, class Executor>
+void BIMAP_CLASS::assign(InputIt first, InputIt last, Executor &executor)
+{
+    Bimap other(keyComp(), valueComp(), getAllocator());
+    other.buildTrees(other.createNodes(first, last), true, executor);
+
+    swap(other);
+    BIMAP_STATS_RECORD_COUNT(m_stats, Insert, m_size);
+}
+
+/*!
+ * \brief Use to erase an element
+ *
+ * \param key
+ * Key of element to erase, if key doesn't exist, this
+ * method do nothing.
+ */
+BIMAP_TEMPLATE
+void BIMAP_CLASS::erase(const TypeKey &key)
+{
+    /* Verify that key exists */
+    detail::BimapHook *hook = m_map.find(key);
+    if(hook == m_map.header()){
+        return;
+    }
+
+    /* Remove item from both trees */
+    unlinkNode(_ContainerKey::toNode(hook));
+    BIMAP_STATS_RECORD(m_stats, Erase);
+}
+
+/*!
+ * \brief Use to erase an element by its value
+ * \details
+ * Only value tree is searched.
+ *
+ * \param value
+ * Value of element to erase, if value doesn't exist, this
+ * method do nothing.
+ */
+BIMAP_TEMPLATE
+void BIMAP_CLASS::eraseByValue(const TypeValue &value)
+{
+    detail::BimapHook *hook = m_mapInversed.find(value);
+    if(hook == m_mapInversed.header()){
+        return;
+    }
+
+    unlinkNode(_ContainerValue::toNode(hook));
+    BIMAP_STATS_RECORD(m_stats, Erase);
+}
+
+/*!
+ * \brief Erase elements in range <tt>[first, last)</tt>, ordered by keys
+ * \details
+ * Erasing all elements releases nodes without any rebalancing (as clear()).
+ *
+ * \return
+ * Returns iterator following last erased element.
+ */
+BIMAP_TEMPLATE
+typename BIMAP_CLASS::iterator BIMAP_CLASS::erase(const_iterator first, const_iterator last)
+{
+    if(first == cbegin() && last == cend()){
+        BIMAP_STATS_RECORD_COUNT(m_stats, Erase, m_size);
+        clear();
+        return end();
+    }
+
+    while(first != last){
+        _Node *node = first.node();
+        ++first;
+        unlinkNode(node);
+        BIMAP_STATS_RECORD(m_stats, Erase);
+    }
+    return last;
+}
+
+/*!
+ * \overload
+ * \details
+ * Range is ordered by values (see byValue()).
+ */
+BIMAP_TEMPLATE
+typename BIMAP_CLASS::value_iterator BIMAP_CLASS::erase(value_iterator first, value_iterator last)
+{
+    if(first == value_iterator(m_mapInversed.leftmost()) && last == value_iterator(m_mapInversed.header())){
+        BIMAP_STATS_RECORD_COUNT(m_stats, Erase, m_size);
+        clear();
+        return value_iterator(m_mapInversed.header());
+    }
+
+    while(first != last){
+        _Node *node = first.node();
+        ++first;
+        unlinkNode(node);
+        BIMAP_STATS_RECORD(m_stats, Erase);
+    }
+    return last;
+}
+
+/*!
+ * \brief Erase all elements satisfying \c pred
+ * \details
+ * \c pred is called once per element, in key order, with the pair
+ * of element. Remaining elements are then relinked in a single linear
+ * pass over each tree (as bulk construction), instead of rebalancing
+ * trees after each erasure: purging many elements costs <b>O(n)</b>. \n
+ * Bimap is left unchanged if \c pred throws.
+ *
+ * \return
+ * Returns number of erased elements.
+ */
+BIMAP_TEMPLATE
+template<class Predicate>
+std::size_t BIMAP_CLASS::eraseIf(Predicate pred)
+{
+    std::vector<_Node*> removed;
+    std::vector<_Node*> keptByKey;
+    for(auto it = cbegin(); it != cend(); ++it){
+        (pred(*it) ? removed : keptByKey).push_back(it.node());
+    }
+    if(removed.empty()){
+        return 0;
+    }
+
+    std::vector<_Node*> keptByValue;
+    keptByValue.reserve(keptByKey.size());
+
+    /* Key links are rebuilt anyway: a null parent marks erased nodes (linked ones always have one) */
+    for(_Node *node : removed){
+        _ContainerKey::toHook(node)->parent = nullptr;
+    }
+    for(auto it = value_iterator(m_mapInversed.leftmost()); it != value_iterator(m_mapInversed.header()); ++it){
+        if(_ContainerKey::toHook(it.node())->parent){
+            keptByValue.push_back(it.node());
+        }
+    }
+
+    m_map.build(keptByKey.data(), keptByKey.size());
+    m_mapInversed.build(keptByValue.data(), keptByValue.size());
+    m_size = keptByKey.size();
+
+    for(_Node *node : removed){
+        destroyNode(node);
+    }
+
+    BIMAP_STATS_RECORD_COUNT(m_stats, Erase, removed.size());
+    return removed.size();
+}
+
+/*!
+ * \brief Exchanges the contents of the container with those of \c other
+ * \details
+ * Does not invoke any move, copy, or swap operations on individual elements. \n
+ * Allocators are only exchanged if they propagate on swap, otherwise
+ * they must be equal (like for standard containers).
+ */
+BIMAP_TEMPLATE
+void BIMAP_CLASS::swap(Bimap &other)
+{
+    using std::swap;
+
+    m_map.swap(other.m_map);
+    m_mapInversed.swap(other.m_mapInversed);
+    swap(m_size, other.m_size);
+    detail::bimapSwapAllocator(m_alloc, other.m_alloc, typename _AllocTraits::propagate_on_container_swap());
+}
+
+/*!
+ * \brief Unlink element of \c key and returns a node handle owning it
+ * \details
+ * Element is neither copied nor moved: it can be inserted into
+ * another bimap with insert(node_type&&), without allocating.
+ *
+ * \return
+ * Returns handle owning extracted element, handle is empty if
+ * \c key doesn't exist.
+ */
+BIMAP_TEMPLATE
+typename BIMAP_CLASS::node_type BIMAP_CLASS::extract(const TypeKey &key)
+{
+    detail::BimapHook *hook = m_map.find(key);
+    if(hook == m_map.header()){
+        return node_type();
+    }
+
+    BIMAP_STATS_RECORD(m_stats, Erase);
+    return node_type(detachNode(_ContainerKey::toNode(hook)), m_alloc);
+}
+
+/*!
+ * \overload
+ * \details
+ * \c position must be a valid dereferenceable iterator of this bimap.
+ */
+BIMAP_TEMPLATE
+typename BIMAP_CLASS::node_type BIMAP_CLASS::extract(const_iterator position)
+{
+    BIMAP_STATS_RECORD(m_stats, Erase);
+    return node_type(detachNode(position.node()), m_alloc);
+}
+
+/*!
+ * \brief Insert element owned by a node handle
+ * \details
+ * Node is linked into both trees, nothing is allocated or copied.
+ * Allocator of \c node must be equal to the one of this bimap. \n
+ * Like tryInsert(), existing elements are never replaced: when key or
+ * value already exist, \c node keeps ownership of its element.
+ *
+ * \return
+ * Returns a pair consisting of an iterator to the inserted element (or to
+ * the element that prevented the insertion) and a boolean set to \c true
+ * if insertion took place. Iterator is \c end() if \c node is empty.
+ */
+BIMAP_TEMPLATE
+std::pair<typename BIMAP_CLASS::iterator, bool> BIMAP_CLASS::insert(node_type &&node)
+{
+    if(node.empty()){
+        return std::make_pair(end(), false);
+    }
+
+    const auto result = tryLinkNode(node.m_node);
+    if(result.second){
+        node.release();
+        BIMAP_STATS_RECORD(m_stats, Insert);
+    }
+    return result;
+}
+
+/*!
+ * \brief Move elements of \c other into this bimap
+ * \details
+ * Each element of \c other whose key and value don't exist in this
+ * bimap is unlinked from \c other and linked into this bimap, without
+ * allocating, copying or moving elements. Conflicting elements stay in
+ * \c other. \n
+ * Allocator of \c other must be equal to the one of this bimap.
+ */
+BIMAP_TEMPLATE
+void BIMAP_CLASS::merge(Bimap &other)
+{
+    if(&other == this){
+        return;
+    }
+
+    /* Elements are visited by ascending keys */
+    detail::BimapHook *hook = other.m_map.leftmost();
+    while(hook != other.m_map.header()){
+        _Node *node = _ContainerKey::toNode(hook);
+        hook = detail::bimapTreeIncrement(hook);
+
+        bool leftKey = false;
+        bool leftValue = false;
+        detail::BimapHook *found = nullptr;
+
+        detail::BimapHook *parentKey = m_map.insertPositionHint(node->data.first, leftKey, found);
+        if(!parentKey){
+            continue;
+        }
+
+        detail::BimapHook *parentValue = m_mapInversed.insertPosition(node->data.second, leftValue, found);
+        if(!parentValue){
+            continue;
+        }
+
+        other.detachNode(node);
+        m_map.link(node, parentKey, leftKey);
+        m_mapInversed.link(node, parentValue, leftValue);
+        ++m_size;
+
+        BIMAP_STATS_RECORD(other.m_stats, Erase);
+        BIMAP_STATS_RECORD(m_stats, Insert);
+    }
+}
+
+/*!
+ * \overload
+ */
+BIMAP_TEMPLATE
+void BIMAP_CLASS::merge(Bimap &&other)
+{
+    merge(other);
+}
+
+/*!
+ * \brief Use to retrieve value by key
+ *
+ * \param key
+ * Key of element to get.
+ * \return
+ * Return value associated to key.
+ *
+ * \throw std::out_of_range
+ * Throw if key cannot be found
+ */
+BIMAP_TEMPLATE
+const TypeValue &BIMAP_CLASS::getValue(const TypeKey &key) const
+{
+    BIMAP_STATS_LOOKUP_BEGIN(m_stats);
+    detail::BimapHook *hook = m_map.find(key);
+    BIMAP_STATS_LOOKUP_END(m_stats, hook != m_map.header());
+    if(hook == m_map.header()){
+        throw std::out_of_range("cmap::Bimap::getValue");
+    }
+
+    return _ContainerKey::toNode(hook)->data.second;
+}
+
+/*!
+ * \brief Use to retrieve key by value
+ *
+ * \param value
+ * Value to use to retrieve key element.
+ * \return
+ * Return key associated to value.
+ *
+ * \throw std::out_of_range
+ * Throw if value cannot be found
+ */
+BIMAP_TEMPLATE
+const TypeKey &BIMAP_CLASS::getKey(const TypeValue &value) const
+{
+    BIMAP_STATS_LOOKUP_BEGIN(m_stats);
+    detail::BimapHook *hook = m_mapInversed.find(value);
+    BIMAP_STATS_LOOKUP_END(m_stats, hook != m_mapInversed.header());
+    if(hook == m_mapInversed.header()){
+        throw std::out_of_range("cmap::Bimap::getKey");
+    }
+
+    return _ContainerValue::toNode(hook)->data.first;
+}
+
+/*!
+ * \brief Use to retrieve value by an object comparable to keys
+ * \details
+ * This overload is only available when \c CompareKey is transparent
+ * (which is the case by default with C++14), so no temporary key is
+ * constructed to perform the lookup.
+ *
+ * \param key
+ * Object comparable to keys.
+ * \return
+ * Return value associated to key.
+ *
+ * \throw std::out_of_range
+ * Throw if key cannot be found
+ */
+BIMAP_TEMPLATE
+template<class K, class C, detail::BimapEnableTransparent<C>>
+const TypeValue &BIMAP_CLASS::getValue(const K &key) const
+{
+    BIMAP_STATS_LOOKUP_BEGIN(m_stats);
+    detail::BimapHook *hook = m_map.find(key);
+    BIMAP_STATS_LOOKUP_END(m_stats, hook != m_map.header());
+    if(hook == m_map.header()){
+        throw std::out_of_range("cmap::Bimap::getValue");
+    }
+
+    return _ContainerKey::toNode(hook)->data.second;
+}
+
+/*!
+ * \brief Use to retrieve key by an object comparable to values
+ * \details
+ * This overload is only available when \c CompareValue is transparent
+ * (which is the case by default with C++14), so no temporary value is
+ * constructed to perform the lookup.
+ *
+ * \param value
+ * Object comparable to values.
+ * \return
+ * Return key associated to value.
+ *
+ * \throw std::out_of_range
+ * Throw if value cannot be found
+ */
+BIMAP_TEMPLATE
+template<class V, class C, detail::BimapEnableTransparent<C>>
+const TypeKey &BIMAP_CLASS::getKey(const V &value) const
+{
+    BIMAP_STATS_LOOKUP_BEGIN(m_stats);
+    detail::BimapHook *hook = m_mapInversed.find(value);
+    BIMAP_STATS_LOOKUP_END(m_stats, hook != m_mapInversed.header());
+    if(hook == m_mapInversed.header()){
+        throw std::out_of_range("cmap::Bimap::getKey");
+    }
+
+    return _ContainerValue::toNode(hook)->data.first;
+}
+
+/*!
+ * \brief Use to search an element by key
+ * \details
+ * Unlike getValue(), this method never throw: a missing key
+ * cost the same than a found one.
+ *
+ * \param key
+ * Key of element to search.
+ * \return
+ * Return iterator to element, equal to \c cend() if key cannot be found.
+ */
+BIMAP_TEMPLATE
+typename BIMAP_CLASS::const_iterator BIMAP_CLASS::findByKey(const TypeKey &key) const
+{
+    return const_iterator(m_map.find(key));
+}
+
+/*!
+ * \brief Use to search an element by value
+ * \details
+ * Unlike getKey(), this method never throw: a missing value
+ * cost the same than a found one.
+ *
+ * \param value
+ * Value of element to search.
+ * \return
+ * Return iterator to element, equal to \c cend() if value cannot be found.
+ */
+BIMAP_TEMPLATE
+typename BIMAP_CLASS::const_iterator BIMAP_CLASS::findByValue(const TypeValue &value) const
+{
+    detail::BimapHook *hook = m_mapInversed.find(value);
+    if(hook == m_mapInversed.header()){
+        return cend();
+    }
+
+    return const_iterator(_ContainerKey::toHook(_ContainerValue::toNode(hook)));
+}
+
+/*!
+ * \brief Checks if bimap contains an element with key \c key
+ *
+ * \param key
+ * Key of element to search.
+ * \return
+ * Returns \c true if key exists, \c false otherwise.
+ */
+BIMAP_TEMPLATE
+bool BIMAP_CLASS::containsKey(const TypeKey &key) const
+{
+    return findByKey(key) != cend();
+}
+
+/*!
+ * \brief Checks if bimap contains an element with value \c value
+ *
+ * \param value
+ * Value of element to search.
+ * \return
+ * Returns \c true if value exists, \c false otherwise.
+ */
+BIMAP_TEMPLATE
+bool BIMAP_CLASS::containsValue(const TypeValue &value) const
+{
+    return findByValue(value) != cend();
+}
+
+/*!
+ * \brief Use to search an element by an object comparable to keys
+ * \details
+ * This overload is only available when \c CompareKey is transparent.
+ *
+ * \param key
+ * Object comparable to keys.
+ * \return
+ * Return iterator to element, equal to \c cend() if key cannot be found.
+ */
+BIMAP_TEMPLATE
+template<class K, class C, detail::BimapEnableTransparent<C>>
+typename BIMAP_CLASS::const_iterator BIMAP_CLASS::findByKey(const K &key) const
+{
+    return const_iterator(m_map.find(key));
+}
+
+/*!
+ * \brief Use to search an element by an object comparable to values
+ * \details
+ * This overload is only available when \c CompareValue is transparent.
+ *
+ * \param value
+ * Object comparable to values.
+ * \return
+ * Return iterator to element, equal to \c cend() if value cannot be found.
+ */
+BIMAP_TEMPLATE
+template<class V, class C, detail::BimapEnableTransparent<C>>
+typename BIMAP_CLASS::const_iterator BIMAP_CLASS::findByValue(const V &value) const
+{
+    detail::BimapHook *hook = m_mapInversed.find(value);
+    if(hook == m_mapInversed.header()){
+        return cend();
+    }
+
+    return const_iterator(_ContainerKey::toHook(_ContainerValue::toNode(hook)));
+}
+
+/*!
+ * \brief Checks if bimap contains an element with key
+ * equivalent to \c key
+ * \details
+ * This overload is only available when \c CompareKey is transparent.
+ */
+BIMAP_TEMPLATE
+template<class K, class C, detail::BimapEnableTransparent<C>>
+bool BIMAP_CLASS::containsKey(const K &key) const
+{
+    return findByKey(key) != cend();
+}
+
+/*!
+ * \brief Checks if bimap contains an element with value
+ * equivalent to \c value
+ * \details
+ * This overload is only available when \c CompareValue is transparent.
+ */
+BIMAP_TEMPLATE
+template<class V, class C, detail::BimapEnableTransparent<C>>
+bool BIMAP_CLASS::containsValue(const V &value) const
+{
+    return findByValue(value) != cend();
+}
+
+/*!
+ * \brief Returns an iterator to the first element whose key is
+ * not less than \c key
+ * \details
+ * Range scans over keys cost <b>O(log(n) + k)</b>, \c k being the
+ * number of visited elements.
+ *
+ * \return
+ * Iterator to the element, \c cend() if all keys are less than \c key.
+ */
+BIMAP_TEMPLATE
+typename BIMAP_CLASS::const_iterator BIMAP_CLASS::lowerBoundKey(const TypeKey &key) const
+{
+    return const_iterator(m_map.lowerBound(key));
+}
+
+/*!
+ * \brief Returns an iterator to the first element whose key is
+ * greater than \c key
+ *
+ * \return
+ * Iterator to the element, \c cend() if no key is greater than \c key.
+ */
+BIMAP_TEMPLATE
+typename BIMAP_CLASS::const_iterator BIMAP_CLASS::upperBoundKey(const TypeKey &key) const
+{
+    return const_iterator(m_map.upperBound(key));
+}
+
+/*!
+ * \brief Returns range of elements whose key is equivalent to \c key
+ * \details
+ * Keys are unique, so range contains at most one element.
+ */
+BIMAP_TEMPLATE
+std::pair<typename BIMAP_CLASS::const_iterator, typename BIMAP_CLASS::const_iterator> BIMAP_CLASS::equalRangeKey(const TypeKey &key) const
+{
+    const auto range = m_map.equalRange(key);
+    return std::make_pair(const_iterator(range.first), const_iterator(range.second));
+}
+
+/*!
+ * \brief Returns an iterator (ordered by values) to the first element
+ * whose value is not less than \c value
+ * \details
+ * Returned iterator walks elements by values, from the value tree:
+ * range scans over values cost <b>O(log(n) + k)</b>, \c k being
+ * the number of visited elements, without copying anything.
+ *
+ * \return
+ * Iterator to the element, <tt>byValue().end()</tt> if all values
+ * are less than \c value.
+ *
+ * \sa byValue()
+ */
+BIMAP_TEMPLATE
+typename BIMAP_CLASS::value_iterator BIMAP_CLASS::lowerBoundValue(const TypeValue &value) const
+{
+    return value_iterator(m_mapInversed.lowerBound(value));
+}
+
+/*!
+ * \brief Returns an iterator (ordered by values) to the first element
+ * whose value is greater than \c value
+ *
+ * \return
+ * Iterator to the element, <tt>byValue().end()</tt> if no value
+ * is greater than \c value.
+ */
+BIMAP_TEMPLATE
+typename BIMAP_CLASS::value_iterator BIMAP_CLASS::upperBoundValue(const TypeValue &value) const
+{
+    return value_iterator(m_mapInversed.upperBound(value));
+}
+
+/*!
+ * \brief Returns range (ordered by values) of elements whose value
+ * is equivalent to \c value
+ * \details
+ * Values are unique, so range contains at most one element.
+ */
+BIMAP_TEMPLATE
+std::pair<typename BIMAP_CLASS::value_iterator, typename BIMAP_CLASS::value_iterator> BIMAP_CLASS::equalRangeValue(const TypeValue &value) const
+{
+    const auto range = m_mapInversed.equalRange(value);
+    return std::make_pair(value_iterator(range.first), value_iterator(range.second));
+}
+
+/*!
+ * \overload
+ * \details
+ * This overload is only available when \c CompareKey is transparent.
+ */
+BIMAP_TEMPLATE
+template<class K, class C, detail::BimapEnableTransparent<C>>
+typename BIMAP_CLASS::const_iterator BIMAP_CLASS::lowerBoundKey(const K &key) const
+{
+    return const_iterator(m_map.lowerBound(key));
+}
+
+/*!
+ * \overload
+ * \details
+ * This overload is only available when \c CompareKey is transparent.
+ */
+BIMAP_TEMPLATE
+template<class K, class C, detail::BimapEnableTransparent<C>>
+typename BIMAP_CLASS::const_iterator BIMAP_CLASS::upperBoundKey(const K &key) const
+{
+    return const_iterator(m_map.upperBound(key));
+}
+
+/*!
+ * \overload
+ * \details
+ * This overload is only available when \c CompareKey is transparent.
+ */
+BIMAP_TEMPLATE
+template<class K, class C, detail::BimapEnableTransparent<C>>
+std::pair<typename BIMAP_CLASS::const_iterator, typename BIMAP_CLASS::const_iterator> BIMAP_CLASS::equalRangeKey(const K &key) const
+{
+    const auto range = m_map.equalRange(key);
+    return std::make_pair(const_iterator(range.first), const_iterator(range.second));
+}
+
+/*!
+ * \overload
+ * \details
+ * This overload is only available when \c CompareValue is transparent,
+ * for example to scan all strings sharing a prefix with a \c std::string_view.
+ */
+BIMAP_TEMPLATE
+template<class V, class C, detail::BimapEnableTransparent<C>>
+typename BIMAP_CLASS::value_iterator BIMAP_CLASS::lowerBoundValue(const V &value) const
+{
+    return value_iterator(m_mapInversed.lowerBound(value));
+}
+
+/*!
+ * \overload
+ * \details
+ * This overload is only available when \c CompareValue is transparent.
+ */
+BIMAP_TEMPLATE
+template<class V, class C, detail::BimapEnableTransparent<C>>
+typename BIMAP_CLASS::value_iterator BIMAP_CLASS::upperBoundValue(const V &value) const
+{
+    return value_iterator(m_mapInversed.upperBound(value));
+}
+
+/*!
+ * \overload
+ * \details
+ * This overload is only available when \c CompareValue is transparent.
+ */
+BIMAP_TEMPLATE
+template<class V, class C, detail::BimapEnableTransparent<C>>
+std::pair<typename BIMAP_CLASS::value_iterator, typename BIMAP_CLASS::value_iterator> BIMAP_CLASS::equalRangeValue(const V &value) const
+{
+    const auto range = m_mapInversed.equalRange(value);
+    return std::make_pair(value_iterator(range.first), value_iterator(range.second));
+}
+
+/*!
+ * \brief Returns a view of bimap ordered by values
+ * \details
+ * Nothing is copied: view iterates over the tree used to search
+ * values.
+ *
+ * <b>Example: </b>
+ * \code{.cpp}
+    for(const auto &pair : bimap.byValue()){
+        useKey(pair.first);
+    }
+ * \endcode
+ */
+BIMAP_TEMPLATE
+typename BIMAP_CLASS::ValueView BIMAP_CLASS::byValue() const
+{
+    return ValueView(this);
+}
+
+/*!
+ * \brief Retrieve values of several keys at once
+ * \details
+ * Searches are interleaved: keys are processed by groups descending
+ * the tree together, so memory latency of each search is hidden by the
+ * others. Prefer this method to a loop of getValue() for large batches. \n
+ * Misses are reported in \c found instead of throwing, elements of
+ * \c values matching a missing key are left untouched.
+ *
+ * \param keys
+ * Array of \c count keys to search.
+ * \param count
+ * Number of keys to search.
+ * \param values
+ * Array of \c count elements, receiving value associated to each key.
+ * \param found
+ * Array of \c count booleans set to \c true if key has been found,
+ * can be \c nullptr.
+ * \return
+ * Returns number of keys found.
+ */
+BIMAP_TEMPLATE
+std::size_t BIMAP_CLASS::getValues(const TypeKey *keys, std::size_t count, TypeValue *values, bool *found) const
+{
+    detail::BimapHook *hooks[detail::BimapBatchWidth];
+    std::size_t nbFound = 0;
+
+    for(std::size_t first = 0; first < count; first += detail::BimapBatchWidth){
+        const std::size_t width = std::min(detail::BimapBatchWidth, count - first);
+        m_map.findBatch(keys + first, width, hooks);
+
+        for(std::size_t i = 0; i < width; ++i){
+            if(hooks[i]){
+                values[first + i] = _ContainerKey::toNode(hooks[i])->data.second;
+                ++nbFound;
+            }
+            if(found){
+                found[first + i] = hooks[i] != nullptr;
+            }
+        }
+    }
+
+    return nbFound;
+}
+
+/*!
+ * \brief Retrieve keys of several values at once
+ * \details
+ * Reverse direction of getValues().
+ *
+ * \param values
+ * Array of \c count values to search.
+ * \param count
+ * Number of values to search.
+ * \param keys
+ * Array of \c count elements, receiving key associated to each value.
+ * \param found
+ * Array of \c count booleans set to \c true if value has been found,
+ * can be \c nullptr.
+ * \return
+ * Returns number of values found.
+ */
+BIMAP_TEMPLATE
+std::size_t BIMAP_CLASS::getKeys(const TypeValue *values, std::size_t count, TypeKey *keys, bool *found) const
+{
+    detail::BimapHook *hooks[detail::BimapBatchWidth];
+    std::size_t nbFound = 0;
+
+    for(std::size_t first = 0; first < count; first += detail::BimapBatchWidth){
+        const std::size_t width = std::min(detail::BimapBatchWidth, count - first);
+        m_mapInversed.findBatch(values + first, width, hooks);
+
+        for(std::size_t i = 0; i < width; ++i){
+            if(hooks[i]){
+                keys[first + i] = _ContainerValue::toNode(hooks[i])->data.first;
+                ++nbFound;
+            }
+            if(found){
+                found[first + i] = hooks[i] != nullptr;
+            }
+        }
+    }
+
+    return nbFound;
+}
+
+/*!
+ * \brief Construct element in-place if neither its key nor
+ * its value already exist
+ * \details
+ * Element is constructed from \c args (like \c std::pair constructors)
+ * then linked, unlike insert(), existing elements are never replaced.
+ * If insertion fails, constructed element is destroyed.
+ *
+ * \param args
+ * Arguments to forward to the constructor of the element.
+ * \return
+ * Returns a pair consisting of an iterator to the inserted element (or to
+ * the element that prevented the insertion, element with same key has precedence)
+ * and a boolean set to \c true if insertion took place.
+ */
+BIMAP_TEMPLATE
+template<class... Args>
+std::pair<typename BIMAP_CLASS::iterator, bool> BIMAP_CLASS::emplace(Args&&... args)
+{
+    return linkNode(createNode(std::forward<Args>(args)...));
+}
+
+/*!
+ * \brief Insert element if neither its key nor its value
+ * already exist
+ * \details
+ * Unlike emplace(), no element is constructed when insertion
+ * fails, so arguments are never copied (or moved) in this case.
+ *
+ * \param key
+ * Key of element.
+ * \param value
+ * Value associated to the key.
+ * \return
+ * Returns a pair consisting of an iterator to the inserted element (or to
+ * the element that prevented the insertion, element with same key has precedence)
+ * and a boolean set to \c true if insertion took place.
+ */
+BIMAP_TEMPLATE
+std::pair<typename BIMAP_CLASS::iterator, bool> BIMAP_CLASS::tryInsert(const TypeKey &key, const TypeValue &value)
+{
+    return tryInsertPair(key, value);
+}
+
+/*!
+ * \overload
+ * \details
+ * Key and value are moved only if insertion took place.
+ */
+BIMAP_TEMPLATE
+std::pair<typename BIMAP_CLASS::iterator, bool> BIMAP_CLASS::tryInsert(TypeKey &&key, TypeValue &&value)
+{
+    return tryInsertPair(std::move(key), std::move(value));
+}
+
+/*!
+ * \brief Insert element, or assign value of existing key
+ * \details
+ * Like insert(), both sides are kept consistent: if \c value was
+ * associated to another key, this association is removed. \n
+ * But when \c key already exists, its element is reused and only its
+ * value is assigned, a single search is performed on each side.
+ *
+ * \param key
+ * Key of element.
+ * \param value
+ * Value to associate to the key.
+ * \return
+ * Returns a pair consisting of an iterator to the element and a
+ * boolean set to \c true if key was inserted, \c false if assigned.
+ */
+BIMAP_TEMPLATE
+std::pair<typename BIMAP_CLASS::iterator, bool> BIMAP_CLASS::insertOrAssign(const TypeKey &key, const TypeValue &value)
+{
+    bool inserted = false;
+    auto result = replacePair(key, value, true, true, inserted);
+    return std::make_pair(result.first, inserted);
+}
+
+/*!
+ * \overload
+ */
+BIMAP_TEMPLATE
+std::pair<typename BIMAP_CLASS::iterator, bool> BIMAP_CLASS::insertOrAssign(TypeKey &&key, TypeValue &&value)
+{
+    bool inserted = false;
+    auto result = replacePair(std::move(key), std::move(value), true, true, inserted);
+    return std::make_pair(result.first, inserted);
+}
+
+/*!
+ * \brief Insert pair, resolving conflicts with existing
+ * elements according to \c policy
+ * \details
+ * A single search is performed on each side, elements are
+ * reused when possible.
+ *
+ * \param key
+ * Key of element.
+ * \param value
+ * Value to associate to the key.
+ * \param policy
+ * Policy to apply when \c key or \c value already exist.
+ * \return
+ * Returns a pair consisting of an iterator to the element (or to the
+ * element which caused the rejection) and a boolean set to \c true
+ * if bimap now contains the pair.
+ *
+ * \sa insert(), insertOrAssign(), tryInsert()
+ */
+BIMAP_TEMPLATE
+std::pair<typename BIMAP_CLASS::iterator, bool> BIMAP_CLASS::replace(const TypeKey &key, const TypeValue &value, ReplacePolicy policy)
+{
+    bool inserted = false;
+    return replacePair(key, value, policy == ReplacePolicy::OverwriteLeft, policy == ReplacePolicy::OverwriteRight, inserted);
+}
+
+/*!
+ * \overload
+ * \details
+ * Key and value are moved only if they are used.
+ */
+BIMAP_TEMPLATE
+std::pair<typename BIMAP_CLASS::iterator, bool> BIMAP_CLASS::replace(TypeKey &&key, TypeValue &&value, ReplacePolicy policy)
+{
+    bool inserted = false;
+    return replacePair(std::move(key), std::move(value), policy == ReplacePolicy::OverwriteLeft, policy == ReplacePolicy::OverwriteRight, inserted);
+}
+
+/*!
+ * \brief Write all pairs to \c out
+ * \details
+ * Pairs are encoded in key order with cmap::BimapCodec (see bimapcodec.h)
+ * after a small header, and written by chunks of fixed size: no copy of
+ * the bimap is built, whatever its size.
+ *
+ * \param out
+ * Stream to write to (opened in binary mode).
+ *
+ * \throw std::runtime_error
+ * Throw if stream cannot be written.
+ *
+ * \sa deserialize()
+ */
+BIMAP_TEMPLATE
+void BIMAP_CLASS::serialize(std::ostream &out) const
+{
+    detail::BimapStreamSink sink(out);
+    serializeTo(sink);
+}
+
+/*!
+ * \overload
+ * \details
+ * Serialized pairs are appended to \c buffer.
+ */
+BIMAP_TEMPLATE
+void BIMAP_CLASS::serialize(std::vector<unsigned char> &buffer) const
+{
+    detail::BimapBufferSink sink(buffer);
+    serializeTo(sink);
+}
+
+/*!
+ * \brief Replace content of bimap by pairs read from \c in
+ * \details
+ * Pairs written by serialize() are directly decoded into nodes, and both
+ * trees are built in linear time (pairs are already sorted by keys). Only
+ * serialized bytes are consumed from \c in. \n
+ * Bimap is left unchanged if an exception is thrown.
+ *
+ * \param in
+ * Stream to read from (opened in binary mode).
+ *
+ * \throw std::runtime_error
+ * Throw if data are truncated, have not been written by serialize()
+ * or have been written by an host of another byte order.
+ * \throw std::invalid_argument
+ * Throw if decoded keys or values are duplicated.
+ */
+BIMAP_TEMPLATE
+void BIMAP_CLASS::deserialize(std::istream &in)
+{
+    detail::BimapStreamSource source(in);
+    deserializeFrom(source);
+}
+
+/*!
+ * \overload
+ * \details
+ * Pairs are read from buffer \c data of \c size bytes.
+ *
+ * \return
+ * Returns number of bytes consumed from \c data.
+ */
+BIMAP_TEMPLATE
+std::size_t BIMAP_CLASS::deserialize(const void *data, std::size_t size)
+{
+    detail::BimapBufferSource source(data, size);
+    deserializeFrom(source);
+
+    return source.consumed();
+}
+
+/*!
+ * \brief Returns changes of \c patch which prevent it to be applied
+ * \details
+ * Whole patch is checked against current content: a conflict in either
+ * direction is reported for each change which can't be applied. A value
+ * can be moved to another key by the same patch, as long as its current
+ * key is erased or reassigned.
+ *
+ * \return
+ * Returns conflicts ordered by index of change, empty if \c patch
+ * can be applied.
+ *
+ * \sa apply()
+ */
+BIMAP_TEMPLATE
+std::vector<typename BIMAP_CLASS::Patch::Conflict> BIMAP_CLASS::conflicts(const Patch &patch) const
+{
+    std::vector<std::size_t> order;
+    std::vector<_Node*> existing;
+    return checkPatch(patch, order, existing);
+}
+
+/*!
+ * \brief Apply all changes of \c patch at once
+ * \details
+ * Changes are sorted, then new nodes are linked in a single pass over
+ * each tree: a node falling before successor of previous one is linked
+ * without any descent. \n
+ * Bimap is left unchanged if an exception is thrown.
+ *
+ * \param patch
+ * Changes to apply.
+ * \param journal
+ * If not \c nullptr, \c patch is recorded into it.
+ *
+ * \throw std::invalid_argument
+ * Throw if \c patch has conflicts (see conflicts()).
+ */
+BIMAP_TEMPLATE
+void BIMAP_CLASS::apply(const Patch &patch, Journal *journal)
+{
+    using Operation = typename Patch::Operation;
+    const auto &changes = patch.changes();
+
+    std::vector<std::size_t> order;
+    std::vector<_Node*> existing;
+    if(!checkPatch(patch, order, existing).empty()){
+        throw std::invalid_argument("cmap::Bimap::apply: conflicting patch");
+    }
+
+    /* Everything which may throw is done before trees are modified */
+    std::vector<_Node*> nodes;
+    std::vector<_Node*> nodesByValue;
+    nodes.reserve(changes.size());
+    try{
+        for(std::size_t index : order){
+            if(changes[index].operation != Operation::Erase){
+                nodes.push_back(nullptr);
+                nodes.back() = createNode(changes[index].key, changes[index].value);
+            }
+        }
+
+        const CompareValue &compValue = m_mapInversed.compare();
+        nodesByValue = nodes;
+        std::sort(nodesByValue.begin(), nodesByValue.end(), [&compValue](const _Node *lhs, const _Node *rhs){
+            return compValue(lhs->data.second, rhs->data.second);
+        });
+
+        if(journal){
+            journal->record(patch);
+        }
+    }catch(...){
+        for(_Node *node : nodes){
+            if(node){
+                destroyNode(node);
+            }
+        }
+        throw;
+    }
+
+    for(_Node *node : existing){
+        if(node){
+            destroyNode(detachNode(node));
+        }
+    }
+
+    m_map.linkSorted(nodes.data(), nodes.size());
+    m_mapInversed.linkSorted(nodesByValue.data(), nodesByValue.size());
+    m_size += nodes.size();
+
+#if defined(BIMAP_ENABLE_STATS)
+    const std::size_t nbAssigned = std::count_if(changes.cbegin(), changes.cend(), [](const typename Patch::Change &change){
+        return change.operation == Operation::Assign;
+    });
+    BIMAP_STATS_RECORD_COUNT(m_stats, Insert, nodes.size() - nbAssigned);
+    BIMAP_STATS_RECORD_COUNT(m_stats, Overwrite, nbAssigned);
+    BIMAP_STATS_RECORD_COUNT(m_stats, Erase, changes.size() - nodes.size());
+#endif
+}
+
+/*!
+ * \brief Apply patches of \c journal to bring bimap from
+ * \c version to <tt>journal.version()</tt>
+ * \details
+ * If a patch can't be applied, previous ones stay applied: bimap was
+ * not at \c version, or has been modified outside of patches.
+ *
+ * \return
+ * Returns version reached, <tt>journal.version()</tt>.
+ *
+ * \throw std::out_of_range
+ * Throw if \c journal doesn't hold patches since \c version.
+ * \throw std::invalid_argument
+ * Throw if a patch has conflicts.
+ */
+BIMAP_TEMPLATE
+std::uint64_t BIMAP_CLASS::replay(const Journal &journal, std::uint64_t version)
+{
+    if(version < journal.firstVersion() || version > journal.version()){
+        throw std::out_of_range("cmap::Bimap::replay");
+    }
+
+    for(; version < journal.version(); ++version){
+        apply(journal.patch(version));
+    }
+    return version;
+}
+
+/*!
+ * \brief Forget patches before \c version
+ * \details
+ * Replicas older than \c version must then be synchronized with
+ * a full snapshot.
+ */
+BIMAP_TEMPLATE
+void BIMAP_CLASS::Journal::trim(std::uint64_t version)
+{
+    if(version <= m_firstVersion){
+        return;
+    }
+
+    const std::uint64_t count = std::min<std::uint64_t>(version - m_firstVersion, m_patches.size());
+    m_patches.erase(m_patches.begin(), m_patches.begin() + static_cast<std::ptrdiff_t>(count));
+    m_firstVersion += count;
+}
+
+/*!
+ * \brief Write patches recorded since \c since to \c out
+ * \details
+ * Changes are encoded with cmap::BimapCodec (see bimapcodec.h), as
+ * pairs of Bimap::serialize().
+ *
+ * \throw std::out_of_range
+ * Throw if patches before \c since have been trimmed, or if \c since
+ * is after version().
+ * \throw std::runtime_error
+ * Throw if stream cannot be written.
+ */
+BIMAP_TEMPLATE
+void BIMAP_CLASS::Journal::serialize(std::ostream &out, std::uint64_t since) const
+{
+    detail::BimapStreamSink sink(out);
+    serializeTo(sink, since);
+}
+
+/*!
+ * \overload
+ * \details
+ * Serialized patches are appended to \c buffer.
+ */
+BIMAP_TEMPLATE
+void BIMAP_CLASS::Journal::serialize(std::vector<unsigned char> &buffer, std::uint64_t since) const
+{
+    detail::BimapBufferSink sink(buffer);
+    serializeTo(sink, since);
+}
 
-namespace cmap{
+/*!
+ * \brief Replace content of journal by patches read from \c in
+ * \details
+ * firstVersion() becomes version passed to serialize(). \n
+ * Journal is left unchanged if an exception is thrown.
+ *
+ * \throw std::runtime_error
+ * Throw if data are truncated, have not been written by serialize()
+ * or have been written by an host of another byte order.
+ */
+BIMAP_TEMPLATE
+void BIMAP_CLASS::Journal::deserialize(std::istream &in)
+{
+    detail::BimapStreamSource source(in);
+    deserializeFrom(source);
+}
 
-/* Functions definitions */
-template<class TypeKey, class TypeValue>
-class Bimap
+/*!
+ * \overload
+ * \details
+ * Patches are read from buffer \c data of \c size bytes.
+ *
+ * \return
+ * Returns number of bytes consumed from \c data.
+ */
+BIMAP_TEMPLATE
+std::size_t BIMAP_CLASS::Journal::deserialize(const void *data, std::size_t size)
 {
-private:
-    using _ContainerKey = std::map<TypeKey, TypeValue>;
-    using _ContainerValue = std::map<TypeValue, TypeKey>;
+    detail::BimapBufferSource source(data, size);
+    deserializeFrom(source);
 
-    using _TypeNode = std::pair<TypeKey, TypeValue>; // Used to implement std::initializer_list<T> support
+    return source.consumed();
+}
 
-public:
-    using iterator = typename _ContainerKey::iterator;
-    using const_iterator = typename _ContainerKey::const_iterator;
-    using reverse_iterator = typename _ContainerKey::reverse_iterator;
-    using const_reverse_iterator = typename _ContainerKey::const_reverse_iterator;
+BIMAP_TEMPLATE
+template<class Sink>
+void BIMAP_CLASS::Journal::serializeTo(Sink &sink, std::uint64_t since) const
+{
+    if(since < m_firstVersion || since > version()){
+        throw std::out_of_range("cmap::Bimap::Journal::serialize");
+    }
 
-public:
-    Bimap();
-    Bimap(const std::initializer_list<_TypeNode> &args);
+    detail::BimapSerialHeader::encode(sink, version() - since, detail::BimapSerialHeader::KindJournal);
+    BimapCodec<std::uint64_t>::encode(sink, since);
+    for(std::uint64_t v = since; v < version(); ++v){
+        const Patch &patch = m_patches[static_cast<std::size_t>(v - m_firstVersion)];
+        BimapCodec<std::uint64_t>::encode(sink, patch.size());
 
-public:
-    bool empty() const;
-    std::size_t size() const;
-    std::size_t maxSize() const;
+        for(const typename Patch::Change &change : patch.changes()){
+            BimapCodec<typename Patch::Operation>::encode(sink, change.operation);
+            BimapCodec<TypeKey>::encode(sink, change.key);
+            if(change.operation != Patch::Operation::Erase){
+                BimapCodec<TypeValue>::encode(sink, change.value);
+            }
+        }
+    }
+    sink.flush();
+}
 
-    void clear();
-    void insert(const TypeKey &key, const TypeValue &value);
-    void erase(const TypeKey &key);
+BIMAP_TEMPLATE
+template<class Source>
+void BIMAP_CLASS::Journal::deserializeFrom(Source &source)
+{
+    /* Don't trust counts to reserve memory, data may be corrupted */
+    constexpr std::uint64_t reserveMax = 1 << 16;
+    const std::uint64_t count = detail::BimapSerialHeader::decode(source, detail::BimapSerialHeader::KindJournal);
 
-    const TypeValue& getValue(const TypeKey &key) const;
-    const TypeKey& getKey(const TypeValue &value) const;
+    std::uint64_t firstVersion = 0;
+    BimapCodec<std::uint64_t>::decode(source, firstVersion);
 
-private:
-    void insert(_TypeNode &&node);
-    void insert(const _TypeNode &node);
+    std::vector<Patch> patches;
+    patches.reserve(static_cast<std::size_t>(count < reserveMax ? count : reserveMax));
+    for(std::uint64_t i = 0; i < count; ++i){
+        std::uint64_t nbChanges = 0;
+        BimapCodec<std::uint64_t>::decode(source, nbChanges);
 
-public:
-    iterator begin();
-    const_iterator cbegin() const;
-    reverse_iterator rbegin();
-    const_reverse_iterator crbegin() const;
-    iterator end();
-    const_iterator cend() const;
-    reverse_iterator rend();
-    const_reverse_iterator crend() const;
+        patches.emplace_back();
+        std::vector<typename Patch::Change> &changes = patches.back().m_changes;
+        changes.reserve(static_cast<std::size_t>(nbChanges < reserveMax ? nbChanges : reserveMax));
+        for(std::uint64_t j = 0; j < nbChanges; ++j){
+            changes.push_back(typename Patch::Change{Patch::Operation::Insert, TypeKey(), TypeValue()});
+            typename Patch::Change &change = changes.back();
 
-private:
-    _ContainerKey m_map;
-    _ContainerValue m_mapInversed;
-};
+            BimapCodec<typename Patch::Operation>::decode(source, change.operation);
+            if(change.operation > Patch::Operation::Assign){
+                throw std::runtime_error("cmap: invalid serialized journal");
+            }
+            BimapCodec<TypeKey>::decode(source, change.key);
+            if(change.operation != Patch::Operation::Erase){
+                BimapCodec<TypeValue>::decode(source, change.value);
+            }
+        }
+    }
 
-/*
- * Functions implementations
- * Class use template and methods cannot be defined in .cpp file.
- * See https://isocpp.org/wiki/faq/templates#separate-template-fn-defn-from-decl
+    m_firstVersion = firstVersion;
+    m_patches.swap(patches);
+}
+
+/*!
+ * \brief Returns function used to compare keys
  */
+BIMAP_TEMPLATE
+CompareKey BIMAP_CLASS::keyComp() const
+{
+    return m_map.compare();
+}
 
 /*!
- * \brief Construct empty bimap
+ * \brief Returns function used to compare values
  */
-template<class TypeKey, class TypeValue>
-Bimap<TypeKey, TypeValue>::Bimap()
+BIMAP_TEMPLATE
+CompareValue BIMAP_CLASS::valueComp() const
 {
-    clear();
+    return m_mapInversed.compare();
 }
 
 /*!
- * \brief Construct bimap with \c std::initializer_list
- * \param args
- * List to use to construct bimap.
- *
- * <b>Example: </b>
- * \code{.c}
-    const cmap::Bimap<int, std::string> m_mapNumberToString =
-    {
-        {1, "ONE"},
-        {2, "TWO"},
-        {3, "THREE"}
-    };
- * \endcode
+ * \brief Returns allocator associated with the container
  */
-template<class TypeKey, class TypeValue>
-Bimap<TypeKey, TypeValue>::Bimap(const std::initializer_list<_TypeNode> &args)
+BIMAP_TEMPLATE
+Allocator BIMAP_CLASS::getAllocator() const
 {
-    for(auto it=args.begin(); it != args.end(); ++it){
-        insert(*it);
-    }
+    return Allocator(m_alloc);
 }
 
 /*!
- * \brief Checks whether the container is empty
- *
- * \return
- * Returns \c true if the container is empty, \c false otherwise
+ * \brief Returns memory owned by bimap
+ * \details
+ * Each element is stored in a single node, which holds links of
+ * both trees (reported as indexes) and the pair. Nothing is
+ * reserved in advance, so \c unused is always \c 0.
  */
-template<class TypeKey, class TypeValue>
-bool Bimap<TypeKey, TypeValue>::empty() const
+BIMAP_TEMPLATE
+BimapMemoryUsage BIMAP_CLASS::memoryUsage() const
 {
-    return m_map.empty();
+    constexpr std::size_t padding = sizeof(_Node) - sizeof(detail::BimapHookKey) - sizeof(detail::BimapHookValue) - sizeof(value_type);
+
+    BimapMemoryUsage usage;
+    usage.indexKey = m_size * sizeof(detail::BimapHookKey);
+    usage.indexValue = m_size * sizeof(detail::BimapHookValue);
+    usage.payload = m_size * sizeof(value_type);
+    usage.overhead = m_size * (padding + BimapAllocationOverhead);
+    usage.unused = 0;
+
+    return usage;
 }
 
 /*!
- * \brief Returns the number of elements
+ * \brief Returns height of tree used to search keys
+ * \details
+ * Trees are balanced, so height is at most <tt>2 * log2(n + 1)</tt>
+ * (each lookup visits at most that many nodes). Tree is walked to
+ * compute it, so complexity is <b>O(n)</b>.
  *
  * \return
- * The number of elements in the container
+ * Number of nodes of the longest path, \c 0 if bimap is empty.
  */
-template<class TypeKey, class TypeValue>
-std::size_t Bimap<TypeKey, TypeValue>::size() const
+BIMAP_TEMPLATE
+std::size_t BIMAP_CLASS::keyTreeHeight() const
 {
-    return m_map.size();
+    return m_map.height();
 }
 
 /*!
- * \brief Returns the maximum possible number of elements
+ * \brief Returns height of tree used to search values
+ * \sa keyTreeHeight()
+ */
+BIMAP_TEMPLATE
+std::size_t BIMAP_CLASS::valueTreeHeight() const
+{
+    return m_mapInversed.height();
+}
+
+#if defined(BIMAP_ENABLE_STATS)
+/*!
+ * \brief Returns statistics of lookups and updates of bimap
+ * \details
+ * Only available when \c BIMAP_ENABLE_STATS is defined.
  *
- * \return
- * Maximum number of elements
+ * \sa bimapstats.h
  */
-template<class TypeKey, class TypeValue>
-std::size_t Bimap<TypeKey, TypeValue>::maxSize() const
+BIMAP_TEMPLATE
+BimapStats& BIMAP_CLASS::stats() const
 {
-    return m_map.max_size();
+    return m_stats;
 }
+#endif
 
 /*!
- * \brief Clears the contents
+ * \brief Link a new element built from \c key and \c value if
+ * they do not conflict with existing elements
  * \details
- * Erases all elements from the container. After this call, size() returns zero. \n
- * Invalidates any references, pointers, or iterators referring to contained elements. Any past-the-end iterator remains valid.
+ * Insertion positions are searched once per tree and reused to
+ * link the node, which is only allocated if both searches succeed.
  */
-template<class TypeKey, class TypeValue>
-void Bimap<TypeKey, TypeValue>::clear()
+BIMAP_TEMPLATE
+template<class K, class V>
+std::pair<typename BIMAP_CLASS::iterator, bool> BIMAP_CLASS::tryInsertPair(K &&key, V &&value, bool sortedHint)
 {
-    m_map.clear();
-    m_mapInversed.clear();
+    bool leftKey = false;
+    bool leftValue = false;
+    detail::BimapHook *found = nullptr;
+
+    detail::BimapHook *parentKey = sortedHint ? m_map.insertPositionHint(key, leftKey, found) : m_map.insertPosition(key, leftKey, found);
+    if(!parentKey){
+        return std::make_pair(iterator(found), false);
+    }
+
+    detail::BimapHook *parentValue = m_mapInversed.insertPosition(value, leftValue, found);
+    if(!parentValue){
+        return std::make_pair(iterator(_ContainerKey::toHook(_ContainerValue::toNode(found))), false);
+    }
+
+    _Node *node = createNode(std::forward<K>(key), std::forward<V>(value));
+    m_map.link(node, parentKey, leftKey);
+    m_mapInversed.link(node, parentValue, leftValue);
+    ++m_size;
+    BIMAP_STATS_RECORD(m_stats, Insert);
+
+    return std::make_pair(iterator(_ContainerKey::toHook(node)), true);
 }
 
 /*!
- * \brief Insert item to bimap
+ * \brief Insert pair built from \c key and \c value, overwriting
+ * conflicting sides when allowed
+ * \details
+ * Each tree is searched once, results are then reused as insertion
+ * hints:
+ * - A new key always require a new node (keys are constants), when
+ * value already exists, new node take the place of the old one in
+ * values tree.
+ * - An existing key keep its node, which is moved in values tree
+ * (just before the lower bound of \c value, or at the place of the
+ * element owning this value).
  *
- * \param key
- * Key of element, if key already exist, it will be replaced.
- * \param value
- * Value associated to the key
+ * \param overwriteLeft
+ * Allow to replace the key associated to \c value.
+ * \param overwriteRight
+ * Allow to replace the value associated to \c key.
+ * \param inserted
+ * Set to \c true if a new key has been inserted.
+ */
+BIMAP_TEMPLATE
+template<class K, class V>
+std::pair<typename BIMAP_CLASS::iterator, bool> BIMAP_CLASS::replacePair(K &&key, V &&value, bool overwriteLeft, bool overwriteRight, bool &inserted)
+{
+    inserted = false;
+
+    bool leftKey = false;
+    bool leftValue = false;
+    detail::BimapHook *foundKey = nullptr;
+    detail::BimapHook *foundValue = nullptr;
+
+    detail::BimapHook *parentKey = m_map.insertPosition(key, leftKey, foundKey);
+    detail::BimapHook *parentValue = m_mapInversed.insertPosition(value, leftValue, foundValue);
+
+    _Node *nodeKey = parentKey ? nullptr : _ContainerKey::toNode(foundKey);
+    _Node *nodeValue = parentValue ? nullptr : _ContainerValue::toNode(foundValue);
+
+    /* Apply policy */
+    if(nodeKey && nodeKey == nodeValue){
+        return std::make_pair(iterator(foundKey), true);
+    }
+    if(nodeKey && !overwriteRight){
+        return std::make_pair(iterator(foundKey), false);
+    }
+    if(nodeValue && !overwriteLeft){
+        return std::make_pair(iterator(_ContainerKey::toHook(nodeValue)), false);
+    }
+
+    /* New key: link a new node */
+    if(!nodeKey){
+        _Node *node = createNode(std::forward<K>(key), std::forward<V>(value));
+        m_map.link(node, parentKey, leftKey);
+
+        if(nodeValue){
+            m_mapInversed.replace(nodeValue, node);
+            m_map.unlink(nodeValue);
+            destroyNode(nodeValue);
+            BIMAP_STATS_RECORD(m_stats, Overwrite);
+        }else{
+            m_mapInversed.link(node, parentValue, leftValue);
+            ++m_size;
+            BIMAP_STATS_RECORD(m_stats, Insert);
+        }
+
+        inserted = true;
+        return std::make_pair(iterator(_ContainerKey::toHook(node)), true);
+    }
+
+    /* Existing key: find where node must be moved before modifying anything */
+    detail::BimapHook *hint = nullptr;
+    if(!nodeValue){
+        hint = leftValue ? parentValue : detail::bimapTreeIncrement(parentValue);
+        if(hint == _ContainerValue::toHook(nodeKey)){
+            hint = detail::bimapTreeIncrement(hint);
+        }
+    }
+
+    /* Trees are only relinked, so if assignment fails, element can still be removed */
+    try{
+        nodeKey->data.second = std::forward<V>(value);
+    }catch(...){
+        unlinkNode(nodeKey);
+        throw;
+    }
+
+    m_mapInversed.unlink(nodeKey);
+    if(nodeValue){
+        m_mapInversed.replace(nodeValue, nodeKey);
+        m_map.unlink(nodeValue);
+        destroyNode(nodeValue);
+        --m_size;
+    }else{
+        m_mapInversed.linkBefore(nodeKey, hint);
+    }
+    BIMAP_STATS_RECORD(m_stats, Overwrite);
+
+    return std::make_pair(iterator(foundKey), true);
+}
+
+/*!
+ * \brief Allocate and construct a node
+ * \details
+ * Node is not linked to any tree.
  */
-template<class TypeKey, class TypeValue>
-void Bimap<TypeKey, TypeValue>::insert(const TypeKey &key, const TypeValue &value)
+BIMAP_TEMPLATE
+template<class... Args>
+typename BIMAP_CLASS::_Node* BIMAP_CLASS::createNode(Args&&... args)
 {
-    m_map[key] = value;
-    m_mapInversed[value] = key;
+    _Node *node = _AllocTraits::allocate(m_alloc, 1);
+    try{
+        _AllocTraits::construct(m_alloc, node, std::forward<Args>(args)...);
+    }catch(...){
+        _AllocTraits::deallocate(m_alloc, node, 1);
+        throw;
+    }
+    return node;
 }
 
 /*!
- * \overload
+ * \brief Destroy and deallocate a node
+ * \details
+ * Node must be unlinked from both trees.
  */
-template<class TypeKey, class TypeValue>
-void Bimap<TypeKey, TypeValue>::insert(_TypeNode &&node)
+BIMAP_TEMPLATE
+void BIMAP_CLASS::destroyNode(_Node *node)
 {
-    insert(node.first, node.second);
+    _AllocTraits::destroy(m_alloc, node);
+    _AllocTraits::deallocate(m_alloc, node, 1);
 }
 
 /*!
- * \overload
+ * \brief Destroy all nodes of key subtree starting at \c hook
+ * \details
+ * No rebalancing is performed, trees must be reset afterward.
  */
-template<class TypeKey, class TypeValue>
-void Bimap<TypeKey, TypeValue>::insert(const _TypeNode &node)
+BIMAP_TEMPLATE
+void BIMAP_CLASS::destroyTree(detail::BimapHook *hook)
 {
-    insert(node.first, node.second);
+    while(hook){
+        destroyTree(hook->right);
+
+        detail::BimapHook *left = hook->left;
+        destroyNode(_ContainerKey::toNode(hook));
+        hook = left;
+    }
 }
 
 /*!
- * \brief Use to erase an element
- *
- * \param key
- * Key of element to erase, if key doesn't exist, this
- * method do nothing.
+ * \brief Create unlinked nodes from a range of pairs
+ * \details
+ * If a construction fails, already created nodes are destroyed.
  */
-template<class TypeKey, class TypeValue>
-void Bimap<TypeKey, TypeValue>::erase(const TypeKey &key)
+BIMAP_TEMPLATE
+template<class InputIt>
+std::vector<typename BIMAP_CLASS::_Node*> BIMAP_CLASS::createNodes(InputIt first, InputIt last)
 {
-    /* Verify that key exists */
-    auto it = m_map.find(key);
-    if(it == m_map.cend()){
-        return;
+    std::vector<_Node*> nodes;
+    try{
+        for(; first != last; ++first){
+            nodes.push_back(nullptr);
+            nodes.back() = createNode(first->first, first->second);
+        }
+    }catch(...){
+        for(_Node *node : nodes){
+            if(node){
+                destroyNode(node);
+            }
+        }
+        throw;
     }
 
-    /* Remove item from both maps */
-    m_mapInversed.erase(it->second);
-    m_map.erase(it);
+    return nodes;
 }
 
 /*!
- * \brief Use to retrieve value by key
+ * \brief Link unlinked \c nodes into both empty trees in linear time
+ * \overload
+ * \details
+ * Nodes are sorted and linked by calling thread.
+ */
+BIMAP_TEMPLATE
+bool BIMAP_CLASS::buildTrees(std::vector<_Node*> nodes, bool rejectDuplicates)
+{
+    detail::BimapInlineExecutor executor;
+    return buildTrees(std::move(nodes), rejectDuplicates, executor);
+}
+
+/*!
+ * \brief Link unlinked \c nodes into both empty trees in linear time
+ * \details
+ * Nodes are sorted by keys and a copy of them by values (sorts are
+ * skipped when nodes are already ordered), using all tasks of
+ * \c executor for each side. Both trees are then built at the same
+ * time from sorted nodes. \n
+ * \c nodes is taken by value and sorted in place, callers needing
+ * original order keep their own copy.
  *
- * \param key
- * Key of element to get.
+ * \param rejectDuplicates
+ * Set to \c true to destroy all nodes and throw if a key or a value is
+ * duplicated, otherwise nodes are left unlinked and \c false is returned.
+ * \param executor
+ * Executor running tasks (see bimapparallel.h).
  * \return
- * Return value associated to key.
+ * Returns \c true if nodes have been linked.
  *
- * \throw std::out_of_range
- * Throw if key cannot be found
+ * \throw std::invalid_argument
+ * Throw if \c rejectDuplicates is set and a key or a value is duplicated.
+ */
+BIMAP_TEMPLATE
+template<class Executor>
+bool BIMAP_CLASS::buildTrees(std::vector<_Node*> nodes, bool rejectDuplicates, Executor &executor)
+{
+    const CompareKey &compareKey = m_map.compare();
+    const CompareValue &compareValue = m_mapInversed.compare();
+    const auto lessKey = [&compareKey](const _Node *lhs, const _Node *rhs){ return compareKey(lhs->data.first, rhs->data.first); };
+    const auto lessValue = [&compareValue](const _Node *lhs, const _Node *rhs){ return compareValue(lhs->data.second, rhs->data.second); };
+
+    const char *duplicated = nullptr;
+    try{
+        detail::bimapParallelSort(executor, nodes.begin(), nodes.end(), lessKey);
+        if(std::adjacent_find(nodes.begin(), nodes.end(), [&lessKey](const _Node *lhs, const _Node *rhs){ return !lessKey(lhs, rhs); }) != nodes.end()){
+            duplicated = "cmap::Bimap: duplicated key";
+        }else{
+            std::vector<_Node*> nodesByValue(nodes);
+            detail::bimapParallelSort(executor, nodesByValue.begin(), nodesByValue.end(), lessValue);
+            if(std::adjacent_find(nodesByValue.begin(), nodesByValue.end(), [&lessValue](const _Node *lhs, const _Node *rhs){ return !lessValue(lhs, rhs); }) != nodesByValue.end()){
+                duplicated = "cmap::Bimap: duplicated value";
+            }else{
+                /* Each tree only writes its own hooks of nodes */
+                executor.run(2, [&](std::size_t side){
+                    if(side == 0){
+                        m_map.build(nodes.data(), nodes.size());
+                    }else{
+                        m_mapInversed.build(nodesByValue.data(), nodesByValue.size());
+                    }
+                });
+                m_size = nodes.size();
+            }
+        }
+    }catch(...){
+        m_map.reset();
+        m_mapInversed.reset();
+        for(_Node *node : nodes){
+            destroyNode(node);
+        }
+        throw;
+    }
+
+    if(!duplicated){
+        return true;
+    }
+
+    if(rejectDuplicates){
+        for(_Node *node : nodes){
+            destroyNode(node);
+        }
+        throw std::invalid_argument(duplicated);
+    }
+    return false;
+}
+
+BIMAP_TEMPLATE
+template<class Sink>
+void BIMAP_CLASS::serializeTo(Sink &sink) const
+{
+    detail::BimapSerialHeader::encode(sink, m_size);
+    for(auto it = cbegin(); it != cend(); ++it){
+        BimapCodec<TypeKey>::encode(sink, it->first);
+        BimapCodec<TypeValue>::encode(sink, it->second);
+    }
+    sink.flush();
+}
+
+BIMAP_TEMPLATE
+template<class Source>
+void BIMAP_CLASS::deserializeFrom(Source &source)
+{
+    /* Don't trust count to reserve memory, data may be corrupted */
+    constexpr std::uint64_t reserveMax = 1 << 20;
+    const std::uint64_t count = detail::BimapSerialHeader::decode(source);
+
+    Bimap other(keyComp(), valueComp(), getAllocator());
+    std::vector<_Node*> nodes;
+    nodes.reserve(static_cast<std::size_t>(count < reserveMax ? count : reserveMax));
+
+    try{
+        for(std::uint64_t i = 0; i < count; ++i){
+            TypeKey key;
+            TypeValue value;
+            BimapCodec<TypeKey>::decode(source, key);
+            BimapCodec<TypeValue>::decode(source, value);
+
+            nodes.push_back(nullptr);
+            nodes.back() = other.createNode(std::move(key), std::move(value));
+        }
+    }catch(...){
+        for(_Node *node : nodes){
+            if(node){
+                other.destroyNode(node);
+            }
+        }
+        throw;
+    }
+
+    other.buildTrees(std::move(nodes), true);
+    swap(other);
+}
+
+/*!
+ * \brief Check changes of \c patch against current content
+ * \details
+ * \c order receives indexes of changes sorted by keys, and \c existing
+ * the node currently holding key of each of them (in same order), or
+ * \c nullptr.
+ */
+BIMAP_TEMPLATE
+std::vector<typename BIMAP_CLASS::Patch::Conflict> BIMAP_CLASS::checkPatch(const Patch &patch, std::vector<std::size_t> &order, std::vector<_Node*> &existing) const
+{
+    using Operation = typename Patch::Operation;
+    using Conflict = typename Patch::Conflict;
+
+    const auto &changes = patch.changes();
+    const CompareKey &compKey = m_map.compare();
+    const CompareValue &compValue = m_mapInversed.compare();
+    std::vector<Conflict> result;
+
+    order.resize(changes.size());
+    for(std::size_t i = 0; i < order.size(); ++i){
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t lhs, std::size_t rhs){
+        return compKey(changes[lhs].key, changes[rhs].key);
+    });
+
+    /* Each key is changed once, and must exist unless it is inserted */
+    existing.assign(changes.size(), nullptr);
+    for(std::size_t i = 0; i < order.size(); ++i){
+        const auto &change = changes[order[i]];
+        if(i > 0 && !compKey(changes[order[i - 1]].key, change.key)){
+            result.push_back(Conflict{PatchConflict::DuplicatedKey, order[i]});
+            continue;
+        }
+
+        detail::BimapHook *hook = m_map.find(change.key);
+        if(hook != m_map.header()){
+            existing[i] = _ContainerKey::toNode(hook);
+        }
+
+        if(change.operation == Operation::Insert && existing[i]){
+            result.push_back(Conflict{PatchConflict::KeyExists, order[i]});
+        }else if(change.operation != Operation::Insert && !existing[i]){
+            result.push_back(Conflict{PatchConflict::KeyMissing, order[i]});
+        }
+    }
+
+    /* Each value is set once, and must not belong to a key left unchanged */
+    std::vector<std::size_t> orderValues;
+    for(std::size_t i = 0; i < changes.size(); ++i){
+        if(changes[i].operation != Operation::Erase){
+            orderValues.push_back(i);
+        }
+    }
+    std::stable_sort(orderValues.begin(), orderValues.end(), [&](std::size_t lhs, std::size_t rhs){
+        return compValue(changes[lhs].value, changes[rhs].value);
+    });
+
+    for(std::size_t i = 0; i < orderValues.size(); ++i){
+        const auto &change = changes[orderValues[i]];
+        if(i > 0 && !compValue(changes[orderValues[i - 1]].value, change.value)){
+            result.push_back(Conflict{PatchConflict::DuplicatedValue, orderValues[i]});
+            continue;
+        }
+
+        detail::BimapHook *hook = m_mapInversed.find(change.value);
+        if(hook != m_mapInversed.header()){
+            const TypeKey &owner = _ContainerValue::toNode(hook)->data.first;
+            auto it = std::lower_bound(order.cbegin(), order.cend(), owner, [&](std::size_t index, const TypeKey &key){
+                return compKey(changes[index].key, key);
+            });
+            if(it == order.cend() || compKey(owner, changes[*it].key)){
+                result.push_back(Conflict{PatchConflict::ValueExists, orderValues[i]});
+            }
+        }
+    }
+
+    std::stable_sort(result.begin(), result.end(), [](const Conflict &lhs, const Conflict &rhs){
+        return lhs.change < rhs.change;
+    });
+    return result;
+}
+
+/*!
+ * \brief Link node into both trees, replacing elements which
+ * conflict with it
  */
-template<class TypeKey, class TypeValue>
-const TypeValue &Bimap<TypeKey, TypeValue>::getValue(const TypeKey &key) const
+BIMAP_TEMPLATE
+void BIMAP_CLASS::insertNode(_Node *node)
 {
-    return m_map.at(key);
+    /* Remove entries which conflict with new pair */
+    bool overwritten = false;
+    detail::BimapHook *hook = m_map.find(node->data.first);
+    if(hook != m_map.header()){
+        unlinkNode(_ContainerKey::toNode(hook));
+        overwritten = true;
+    }
+
+    hook = m_mapInversed.find(node->data.second);
+    if(hook != m_mapInversed.header()){
+        unlinkNode(_ContainerValue::toNode(hook));
+        overwritten = true;
+    }
+
+    /* Cannot fail anymore */
+    tryLinkNode(node);
+    if(overwritten){
+        BIMAP_STATS_RECORD(m_stats, Overwrite);
+    }else{
+        BIMAP_STATS_RECORD(m_stats, Insert);
+    }
 }
 
 /*!
- * \brief Use to retrieve key by value
+ * \brief Link node into both trees
+ * \details
+ * Key and value of \c node must not already exist in bimap,
+ * node is destroyed if that's not the case.
  *
- * \param value
- * Value to use to retrieve key element.
+ * \param sortedHint
+ * Set to \c true when nodes are expected to be linked by
+ * ascending keys (see BimapTree::insertPositionHint()).
  * \return
- * Return key associated to value.
+ * Returns iterator to linked node (or to the conflicting element)
+ * and \c true if node has been linked.
+ */
+BIMAP_TEMPLATE
+std::pair<typename BIMAP_CLASS::iterator, bool> BIMAP_CLASS::linkNode(_Node *node, bool sortedHint)
+{
+    const auto result = tryLinkNode(node, sortedHint);
+    if(!result.second){
+        destroyNode(node);
+    }else{
+        BIMAP_STATS_RECORD(m_stats, Insert);
+    }
+    return result;
+}
+
+/*!
+ * \brief Link node into both trees if neither its key nor
+ * its value already exist
+ * \details
+ * Unlike linkNode(), node is left unlinked (and owned by caller)
+ * when insertion fails.
+ */
+BIMAP_TEMPLATE
+std::pair<typename BIMAP_CLASS::iterator, bool> BIMAP_CLASS::tryLinkNode(_Node *node, bool sortedHint)
+{
+    bool leftKey = false;
+    bool leftValue = false;
+    detail::BimapHook *found = nullptr;
+
+    detail::BimapHook *parentKey = sortedHint ? m_map.insertPositionHint(node->data.first, leftKey, found) : m_map.insertPosition(node->data.first, leftKey, found);
+    if(!parentKey){
+        return std::make_pair(iterator(found), false);
+    }
+
+    detail::BimapHook *parentValue = m_mapInversed.insertPosition(node->data.second, leftValue, found);
+    if(!parentValue){
+        return std::make_pair(iterator(_ContainerKey::toHook(_ContainerValue::toNode(found))), false);
+    }
+
+    m_map.link(node, parentKey, leftKey);
+    m_mapInversed.link(node, parentValue, leftValue);
+    ++m_size;
+
+    return std::make_pair(iterator(_ContainerKey::toHook(node)), true);
+}
+
+/*!
+ * \brief Unlink node from both trees and destroy it
+ */
+BIMAP_TEMPLATE
+void BIMAP_CLASS::unlinkNode(_Node *node)
+{
+    destroyNode(detachNode(node));
+}
+
+/*!
+ * \brief Unlink node from both trees, without destroying it
  *
- * \throw std::out_of_range
- * Throw if value cannot be found
+ * \return
+ * Returns \c node, now owned by caller.
  */
-template<class TypeKey, class TypeValue>
-const TypeKey &Bimap<TypeKey, TypeValue>::getKey(const TypeValue &value) const
+BIMAP_TEMPLATE
+typename BIMAP_CLASS::_Node* BIMAP_CLASS::detachNode(_Node *node)
 {
-    return m_mapInversed.at(value);
+    m_map.unlink(node);
+    m_mapInversed.unlink(node);
+    --m_size;
+
+    return node;
 }
 
 /*!
@@ -262,10 +3578,10 @@ const TypeKey &Bimap<TypeKey, TypeValue>::getKey(const TypeValue &value) const
  * Iterator to the first element. \n
  * If the map is empty, the returned iterator will be equal to \c end().
  */
-template<class TypeKey, class TypeValue>
-typename Bimap<TypeKey, TypeValue>::iterator Bimap<TypeKey, TypeValue>::begin()
+BIMAP_TEMPLATE
+typename BIMAP_CLASS::iterator BIMAP_CLASS::begin()
 {
-    return m_map.begin();
+    return iterator(m_map.leftmost());
 }
 
 /*!
@@ -275,10 +3591,10 @@ typename Bimap<TypeKey, TypeValue>::iterator Bimap<TypeKey, TypeValue>::begin()
  * Iterator to the first element. \n
  * If the map is empty, the returned iterator will be equal to \c cend().
  */
-template<class TypeKey, class TypeValue>
-typename Bimap<TypeKey, TypeValue>::const_iterator Bimap<TypeKey, TypeValue>::cbegin() const
+BIMAP_TEMPLATE
+typename BIMAP_CLASS::const_iterator BIMAP_CLASS::cbegin() const
 {
-    return m_map.cbegin();
+    return const_iterator(m_map.leftmost());
 }
 
 /*!
@@ -291,10 +3607,10 @@ typename Bimap<TypeKey, TypeValue>::const_iterator Bimap<TypeKey, TypeValue>::cb
  * Reverse iterator to the first element. \n
  * If the map is empty, the returned iterator is equal to \c rend().
  */
-template<class TypeKey, class TypeValue>
-typename Bimap<TypeKey, TypeValue>::reverse_iterator Bimap<TypeKey, TypeValue>::rbegin()
+BIMAP_TEMPLATE
+typename BIMAP_CLASS::reverse_iterator BIMAP_CLASS::rbegin()
 {
-    return m_map.rbegin();
+    return reverse_iterator(end());
 }
 
 /*!
@@ -307,10 +3623,10 @@ typename Bimap<TypeKey, TypeValue>::reverse_iterator Bimap<TypeKey, TypeValue>::
  * Reverse iterator to the first element. \n
  * If the map is empty, the returned iterator is equal to \c crend().
  */
-template<class TypeKey, class TypeValue>
-typename Bimap<TypeKey, TypeValue>::const_reverse_iterator Bimap<TypeKey, TypeValue>::crbegin() const
+BIMAP_TEMPLATE
+typename BIMAP_CLASS::const_reverse_iterator BIMAP_CLASS::crbegin() const
 {
-    return m_map.crbegin();
+    return const_reverse_iterator(cend());
 }
 
 /*!
@@ -319,10 +3635,10 @@ typename Bimap<TypeKey, TypeValue>::const_reverse_iterator Bimap<TypeKey, TypeVa
  * \return
  * Iterator to the element following the last element.
  */
-template<class TypeKey, class TypeValue>
-typename Bimap<TypeKey, TypeValue>::iterator Bimap<TypeKey, TypeValue>::end()
+BIMAP_TEMPLATE
+typename BIMAP_CLASS::iterator BIMAP_CLASS::end()
 {
-    return m_map.end();
+    return iterator(m_map.header());
 }
 
 /*!
@@ -331,10 +3647,10 @@ typename Bimap<TypeKey, TypeValue>::iterator Bimap<TypeKey, TypeValue>::end()
  * \return
  * Iterator to the element following the last element.
  */
-template<class TypeKey, class TypeValue>
-typename Bimap<TypeKey, TypeValue>::const_iterator Bimap<TypeKey, TypeValue>::cend() const
+BIMAP_TEMPLATE
+typename BIMAP_CLASS::const_iterator BIMAP_CLASS::cend() const
 {
-    return m_map.cend();
+    return const_iterator(m_map.header());
 }
 
 /*!
@@ -346,10 +3662,10 @@ typename Bimap<TypeKey, TypeValue>::const_iterator Bimap<TypeKey, TypeValue>::ce
  * \return
  * Reverse iterator to the element following the last element.
  */
-template<class TypeKey, class TypeValue>
-typename Bimap<TypeKey, TypeValue>::reverse_iterator Bimap<TypeKey, TypeValue>::rend()
+BIMAP_TEMPLATE
+typename BIMAP_CLASS::reverse_iterator BIMAP_CLASS::rend()
 {
-    return m_map.rend();
+    return reverse_iterator(begin());
 }
 
 /*!
@@ -361,12 +3677,15 @@ typename Bimap<TypeKey, TypeValue>::reverse_iterator Bimap<TypeKey, TypeValue>::
  * \return
  * Reverse iterator to the element following the last element.
  */
-template<class TypeKey, class TypeValue>
-typename Bimap<TypeKey, TypeValue>::const_reverse_iterator Bimap<TypeKey, TypeValue>::crend() const
+BIMAP_TEMPLATE
+typename BIMAP_CLASS::const_reverse_iterator BIMAP_CLASS::crend() const
 {
-    return m_map.crend();
+    return const_reverse_iterator(cbegin());
 }
 
+#undef BIMAP_TEMPLATE
+#undef BIMAP_CLASS
+
 } // Namespace cmap
 
 #endif // LCH_BIMAP_H
@@ -0,0 +1,369 @@
+#ifndef LCH_BIMAPALLOCATOR_H
+#define LCH_BIMAPALLOCATOR_H
+
+/*****************************/
+/* File documentations       */
+/*****************************/
+
+/*!
+   \file bimapallocator.h
+   \brief Allocators which can be used with node-based bimaps.
+
+   Node-based bimaps (\c cmap::Bimap and \c cmap::UnorderedBimap) perform
+   one allocation per element. Using \c cmap::PoolAllocator, nodes are carved
+   from large chunks owned by a \c cmap::NodePool, so building or destroying a
+   bimap only performs a handful of allocations.
+
+   <b>Example: </b>
+   \code{.cpp}
+    cmap::NodePool pool;
+    cmap::Bimap<int, int, std::less<int>, std::less<int>, cmap::PoolAllocator<std::pair<const int, int>>> bimap(pool);
+   \endcode
+*/
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+/**********************************
+ * Over-aligned types need aligned
+ * operator new, added by C++17
+ *********************************/
+#if defined(__cpp_aligned_new)
+#   define BIMAP_HAS_ALIGNED_NEW 1
+#else
+#   define BIMAP_HAS_ALIGNED_NEW 0  /**< Equal to \c 1 when aligned <tt>operator new</tt> is available */
+#endif
+
+namespace cmap{
+
+/*****************************/
+/* Functions definitions     */
+/*****************************/
+
+namespace detail{
+
+/*!
+ * \brief Allocate memory with <tt>::operator new</tt>, using its
+ * aligned version when \c alignment exceeds default one
+ *
+ * \throw std::bad_alloc
+ * Throw if memory cannot be allocated, or if \c alignment cannot
+ * be honoured (aligned <tt>operator new</tt> unavailable).
+ */
+inline void* bimapAllocateBytes(std::size_t size, std::size_t alignment)
+{
+#if BIMAP_HAS_ALIGNED_NEW
+    if(alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__){
+        return ::operator new(size, std::align_val_t(alignment));
+    }
+#else
+    if(alignment > alignof(std::max_align_t)){
+        throw std::bad_alloc();
+    }
+#endif
+    return ::operator new(size);
+}
+
+/*!
+ * \brief Release memory returned by bimapAllocateBytes()
+ */
+inline void bimapDeallocateBytes(void *ptr, std::size_t alignment) noexcept
+{
+#if BIMAP_HAS_ALIGNED_NEW
+    if(alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__){
+        ::operator delete(ptr, std::align_val_t(alignment));
+        return;
+    }
+#else
+    (void)alignment;
+#endif
+    ::operator delete(ptr);
+}
+
+} // Namespace detail
+
+/*****************************/
+/* Class definitions         */
+/*****************************/
+
+/*!
+ * \brief Pool of fixed-size memory blocks
+ * \details
+ * Block size is set by the first allocation, so a pool is meant to
+ * serve nodes of a single container type (it can be shared by several
+ * containers of this type). Blocks are carved from chunks of
+ * \c blocksPerChunk blocks and released blocks are reused, chunks are
+ * only freed when pool is destroyed or released. \n
+ * Requests which doesn't fit a block are forwarded to <tt>::operator new</tt>
+ * (aligned version for over-aligned requests).
+ *
+ * \warning
+ * This class isn't thread-safe.
+ */
+class NodePool
+{
+public:
+    explicit NodePool(std::size_t blocksPerChunk = 1024);
+    ~NodePool();
+
+    NodePool(const NodePool &other) = delete;
+    NodePool& operator=(const NodePool &other) = delete;
+
+public:
+    void* allocate(std::size_t size, std::size_t alignment);
+    void deallocate(void *ptr, std::size_t size, std::size_t alignment);
+
+    void release();
+
+    std::size_t blockSize() const;
+    std::size_t chunkCount() const;
+
+private:
+    struct Block
+    {
+        Block *next;
+    };
+
+    struct alignas(std::max_align_t) Chunk
+    {
+        Chunk *next;
+    };
+
+private:
+    bool fitBlock(std::size_t size, std::size_t alignment) const;
+    void grow();
+
+private:
+    std::size_t m_blocksPerChunk;
+    std::size_t m_blockSize;
+    std::size_t m_nbChunks;
+
+    Chunk *m_chunks;
+    Block *m_free;
+    char *m_cursor;
+    char *m_end;
+};
+
+/*!
+ * \brief Allocator using a \c cmap::NodePool
+ * \details
+ * Only single objects are allocated from the pool, arrays are
+ * forwarded to <tt>::operator new</tt>. Allocators are equal if
+ * they use the same pool and they propagate on copy, move and swap. \n
+ * Over-aligned types require aligned <tt>operator new</tt> (C++17).
+ */
+template<class T>
+class PoolAllocator
+{
+    static_assert(BIMAP_HAS_ALIGNED_NEW || alignof(T) <= alignof(std::max_align_t), "cmap::PoolAllocator: over-aligned types need aligned operator new (C++17)");
+
+public:
+    using value_type = T;
+
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+public:
+    PoolAllocator(NodePool &pool) noexcept : m_pool(&pool) {}
+
+    template<class U>
+    PoolAllocator(const PoolAllocator<U> &other) noexcept : m_pool(other.pool()) {}
+
+public:
+    T* allocate(std::size_t n)
+    {
+        if(n == 1){
+            return static_cast<T*>(m_pool->allocate(sizeof(T), alignof(T)));
+        }
+        if(n > max_size()){
+            throw std::bad_array_new_length();
+        }
+        return static_cast<T*>(detail::bimapAllocateBytes(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T *ptr, std::size_t n)
+    {
+        if(n == 1){
+            m_pool->deallocate(ptr, sizeof(T), alignof(T));
+        }else{
+            detail::bimapDeallocateBytes(ptr, alignof(T));
+        }
+    }
+
+    std::size_t max_size() const noexcept { return std::numeric_limits<std::size_t>::max() / sizeof(T); }
+
+    NodePool* pool() const noexcept { return m_pool; }
+
+    template<class U>
+    friend bool operator==(const PoolAllocator &lhs, const PoolAllocator<U> &rhs) noexcept { return lhs.pool() == rhs.pool(); }
+    template<class U>
+    friend bool operator!=(const PoolAllocator &lhs, const PoolAllocator<U> &rhs) noexcept { return lhs.pool() != rhs.pool(); }
+
+private:
+    NodePool *m_pool;
+};
+
+/*****************************/
+/* Functions definitions     */
+/*****************************/
+
+/*!
+ * \brief Construct an empty pool
+ * \details
+ * No memory is allocated until first allocation.
+ *
+ * \param blocksPerChunk
+ * Number of blocks allocated at once when pool is exhausted.
+ */
+inline NodePool::NodePool(std::size_t blocksPerChunk) :
+    m_blocksPerChunk(blocksPerChunk > 0 ? blocksPerChunk : 1), m_blockSize(0), m_nbChunks(0),
+    m_chunks(nullptr), m_free(nullptr), m_cursor(nullptr), m_end(nullptr)
+{
+    /* Nothing to do */
+}
+
+/*!
+ * \brief Destroy pool and free all its chunks
+ * \warning
+ * Containers using this pool must be destroyed before.
+ */
+inline NodePool::~NodePool()
+{
+    release();
+}
+
+/*!
+ * \brief Allocate memory
+ *
+ * \param size
+ * Size in bytes of memory to allocate.
+ * \param alignment
+ * Alignment required.
+ * \return
+ * Returns pointer to allocated memory.
+ *
+ * \throw std::bad_alloc
+ * Throw if a new chunk cannot be allocated, or if an over-aligned
+ * request cannot be honoured (aligned <tt>operator new</tt> unavailable).
+ */
+inline void* NodePool::allocate(std::size_t size, std::size_t alignment)
+{
+    /* Size blocks on first request */
+    if(m_blockSize == 0 && alignment <= alignof(std::max_align_t)){
+        const std::size_t align = alignof(std::max_align_t);
+        m_blockSize = (std::max(size, sizeof(Block)) + align - 1) / align * align;
+    }
+
+    if(!fitBlock(size, alignment)){
+        return detail::bimapAllocateBytes(size, alignment);
+    }
+
+    /* Reuse released blocks first */
+    if(m_free){
+        Block *block = m_free;
+        m_free = block->next;
+        return block;
+    }
+
+    if(m_cursor == m_end){
+        grow();
+    }
+
+    void *ptr = m_cursor;
+    m_cursor += m_blockSize;
+    return ptr;
+}
+
+/*!
+ * \brief Release memory previously returned by allocate()
+ * \details
+ * Memory is kept by pool and reused by next allocations.
+ *
+ * \param ptr
+ * Pointer to release.
+ * \param size
+ * Size used when memory was allocated.
+ * \param alignment
+ * Alignment used when memory was allocated.
+ */
+inline void NodePool::deallocate(void *ptr, std::size_t size, std::size_t alignment)
+{
+    if(!fitBlock(size, alignment)){
+        detail::bimapDeallocateBytes(ptr, alignment);
+        return;
+    }
+
+    Block *block = static_cast<Block*>(ptr);
+    block->next = m_free;
+    m_free = block;
+}
+
+/*!
+ * \brief Free all chunks at once
+ * \details
+ * Block size is kept, so pool can be reused by containers of the same type.
+ *
+ * \warning
+ * All memory allocated from this pool is released, containers
+ * using it must have been destroyed before.
+ */
+inline void NodePool::release()
+{
+    while(m_chunks){
+        Chunk *next = m_chunks->next;
+        ::operator delete(m_chunks);
+        m_chunks = next;
+    }
+
+    m_nbChunks = 0;
+    m_free = nullptr;
+    m_cursor = nullptr;
+    m_end = nullptr;
+}
+
+/*!
+ * \brief Returns size of blocks
+ * \return
+ * Returns \c 0 if no allocation has been performed yet.
+ */
+inline std::size_t NodePool::blockSize() const
+{
+    return m_blockSize;
+}
+
+/*!
+ * \brief Returns number of chunks currently allocated
+ */
+inline std::size_t NodePool::chunkCount() const
+{
+    return m_nbChunks;
+}
+
+inline bool NodePool::fitBlock(std::size_t size, std::size_t alignment) const
+{
+    return size <= m_blockSize && alignment <= alignof(std::max_align_t);
+}
+
+/*!
+ * \brief Allocate a new chunk and use it for next allocations
+ */
+inline void NodePool::grow()
+{
+    void *memory = ::operator new(sizeof(Chunk) + m_blockSize * m_blocksPerChunk);
+
+    Chunk *chunk = static_cast<Chunk*>(memory);
+    chunk->next = m_chunks;
+    m_chunks = chunk;
+    ++m_nbChunks;
+
+    m_cursor = static_cast<char*>(memory) + sizeof(Chunk);
+    m_end = m_cursor + m_blockSize * m_blocksPerChunk;
+}
+
+} // Namespace cmap
+
+#endif // LCH_BIMAPALLOCATOR_H
@@ -0,0 +1,301 @@
+#ifndef LCH_BIMAPCODEC_H
+#define LCH_BIMAPCODEC_H
+
+/*****************************/
+/* File documentations       */
+/*****************************/
+
+/*!
+   \file bimapcodec.h
+   \brief Codecs used to serialize elements of bimaps.
+
+   Each serialized type needs a specialization of \c cmap::BimapCodec,
+   providing \c encode() and \c decode() which exchange raw bytes with a
+   \em sink and a \em source. Codecs are provided for trivially copyable
+   types (bytes are copied as is, so byte order of hosts must match) and
+   for \c std::basic_string (length-prefixed).
+
+   <b>Example: </b>
+   \code{.cpp}
+    template<>
+    struct cmap::BimapCodec<Point>
+    {
+        template<class Sink>
+        static void encode(Sink &sink, const Point &point)
+        {
+            BimapCodec<double>::encode(sink, point.x);
+            BimapCodec<double>::encode(sink, point.y);
+        }
+
+        template<class Source>
+        static void decode(Source &source, Point &point)
+        {
+            BimapCodec<double>::decode(source, point.x);
+            BimapCodec<double>::decode(source, point.y);
+        }
+    };
+   \endcode
+
+   Sinks provide <tt>write(const void *data, std::size_t size)</tt> and
+   sources provide <tt>read(void *data, std::size_t size)</tt>, which
+   throw if data cannot be exchanged.
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace cmap{
+
+/*****************************/
+/* Public helpers            */
+/*****************************/
+
+/*!
+ * \brief Codec of elements of type \c T
+ * \details
+ * Primary template is not defined, specialize it to serialize
+ * other types.
+ */
+template<class T, class Enable = void>
+struct BimapCodec;
+
+/*!
+ * \brief Codec of trivially copyable types: bytes are copied as is
+ */
+template<class T>
+struct BimapCodec<T, typename std::enable_if<std::is_trivially_copyable<T>::value>::type>
+{
+    template<class Sink>
+    static void encode(Sink &sink, const T &value)
+    {
+        sink.write(&value, sizeof(T));
+    }
+
+    template<class Source>
+    static void decode(Source &source, T &value)
+    {
+        source.read(&value, sizeof(T));
+    }
+};
+
+/*!
+ * \brief Codec of strings: a 64-bits length followed by characters
+ * \details
+ * Characters are decoded by chunks, so a corrupted length cannot
+ * allocate more memory than available data.
+ */
+template<class Char, class Traits, class Alloc>
+struct BimapCodec<std::basic_string<Char, Traits, Alloc>>
+{
+    using TypeString = std::basic_string<Char, Traits, Alloc>;
+
+    template<class Sink>
+    static void encode(Sink &sink, const TypeString &str)
+    {
+        const std::uint64_t length = str.size();
+        BimapCodec<std::uint64_t>::encode(sink, length);
+        sink.write(str.data(), str.size() * sizeof(Char));
+    }
+
+    template<class Source>
+    static void decode(Source &source, TypeString &str)
+    {
+        std::uint64_t length = 0;
+        BimapCodec<std::uint64_t>::decode(source, length);
+
+        constexpr std::uint64_t chunk = 4096;
+        str.clear();
+        while(length != 0){
+            const std::size_t count = static_cast<std::size_t>(length < chunk ? length : chunk);
+            const std::size_t offset = str.size();
+
+            str.resize(offset + count);
+            source.read(&str[offset], count * sizeof(Char));
+            length -= count;
+        }
+    }
+};
+
+/*****************************/
+/* Internal implementation   */
+/*****************************/
+
+namespace detail{
+
+constexpr std::size_t BimapStreamChunkSize = 64 * 1024;
+
+/*!
+ * \brief Sink writing to an output stream by chunks
+ * \details
+ * Small writes are gathered in a fixed-size buffer, \c flush() must
+ * be called once all data have been written.
+ */
+class BimapStreamSink
+{
+public:
+    explicit BimapStreamSink(std::ostream &out) : m_out(out), m_buffer(BimapStreamChunkSize), m_used(0) {}
+
+public:
+    void write(const void *data, std::size_t size)
+    {
+        if(size > m_buffer.size() - m_used){
+            flush();
+            if(size >= m_buffer.size()){
+                put(data, size);
+                return;
+            }
+        }
+
+        std::memcpy(m_buffer.data() + m_used, data, size);
+        m_used += size;
+    }
+
+    void flush()
+    {
+        put(m_buffer.data(), m_used);
+        m_used = 0;
+    }
+
+private:
+    void put(const void *data, std::size_t size)
+    {
+        const std::streamsize count = static_cast<std::streamsize>(size);
+        if(!m_out || m_out.rdbuf()->sputn(static_cast<const char*>(data), count) != count){
+            m_out.setstate(std::ios_base::badbit);
+            throw std::runtime_error("cmap: cannot write serialized bimap");
+        }
+    }
+
+private:
+    std::ostream &m_out;
+    std::vector<char> m_buffer;
+    std::size_t m_used;
+};
+
+/*!
+ * \brief Sink appending to a buffer
+ */
+class BimapBufferSink
+{
+public:
+    explicit BimapBufferSink(std::vector<unsigned char> &buffer) : m_buffer(buffer) {}
+
+public:
+    void write(const void *data, std::size_t size)
+    {
+        const unsigned char *bytes = static_cast<const unsigned char*>(data);
+        m_buffer.insert(m_buffer.end(), bytes, bytes + size);
+    }
+
+    void flush() {}
+
+private:
+    std::vector<unsigned char> &m_buffer;
+};
+
+/*!
+ * \brief Source reading from an input stream
+ * \details
+ * Only requested bytes are consumed from stream (which is already
+ * buffered), so data following a serialized bimap stay available.
+ */
+class BimapStreamSource
+{
+public:
+    explicit BimapStreamSource(std::istream &in) : m_in(in) {}
+
+public:
+    void read(void *data, std::size_t size)
+    {
+        const std::streamsize count = static_cast<std::streamsize>(size);
+        if(!m_in || m_in.rdbuf()->sgetn(static_cast<char*>(data), count) != count){
+            m_in.setstate(std::ios_base::failbit | std::ios_base::eofbit);
+            throw std::runtime_error("cmap: truncated serialized bimap");
+        }
+    }
+
+private:
+    std::istream &m_in;
+};
+
+/*!
+ * \brief Source reading from a buffer
+ */
+class BimapBufferSource
+{
+public:
+    BimapBufferSource(const void *data, std::size_t size) : m_data(static_cast<const unsigned char*>(data)), m_size(size), m_pos(0) {}
+
+public:
+    void read(void *data, std::size_t size)
+    {
+        if(size > m_size - m_pos){
+            throw std::runtime_error("cmap: truncated serialized bimap");
+        }
+
+        std::memcpy(data, m_data + m_pos, size);
+        m_pos += size;
+    }
+
+    std::size_t consumed() const { return m_pos; }
+
+private:
+    const unsigned char *m_data;
+    std::size_t m_size;
+    std::size_t m_pos;
+};
+
+/*!
+ * \brief Header preceding serialized pairs
+ * \details
+ * Header is written with native byte order, \c endianness allow
+ * to detect data written by an host of another byte order.
+ */
+struct BimapSerialHeader
+{
+    static constexpr std::uint32_t Magic = 0x53424D43; // "CMBS" on little-endian hosts
+    static constexpr std::uint32_t Version = 1;
+    static constexpr std::uint32_t Endianness = 0x01020304;
+
+    /* Kind of serialized content, so a journal can't be decoded as a bimap */
+    static constexpr std::uint32_t KindBimap = 0;
+    static constexpr std::uint32_t KindJournal = 1;
+
+    template<class Sink>
+    static void encode(Sink &sink, std::uint64_t count, std::uint32_t kind = KindBimap)
+    {
+        const std::uint32_t fields[] = {Magic, Version, Endianness, kind};
+        sink.write(fields, sizeof(fields));
+        BimapCodec<std::uint64_t>::encode(sink, count);
+    }
+
+    template<class Source>
+    static std::uint64_t decode(Source &source, std::uint32_t kind = KindBimap)
+    {
+        std::uint32_t fields[4];
+        source.read(fields, sizeof(fields));
+        if(fields[0] != Magic || fields[2] != Endianness || fields[3] != kind){
+            throw std::runtime_error("cmap: invalid serialized bimap (or written with another byte order)");
+        }
+        if(fields[1] != Version){
+            throw std::runtime_error("cmap: unsupported version of serialized bimap");
+        }
+
+        std::uint64_t count = 0;
+        BimapCodec<std::uint64_t>::decode(source, count);
+        return count;
+    }
+};
+
+} // Namespace detail
+
+} // Namespace cmap
+
+#endif // LCH_BIMAPCODEC_H
@@ -0,0 +1,410 @@
+#ifndef LCH_BIMAPCOMMON_H
+#define LCH_BIMAPCOMMON_H
+
+/*****************************/
+/* File documentations       */
+/*****************************/
+
+/*!
+   \file bimapcommon.h
+   \brief Definitions shared by all bimap containers.
+
+   This file doesn't depend on build configuration, so it can be copied
+   along with any container header when library is used as \em header-only.
+*/
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**********************************
+ * C++ standard detection
+ * MSVC doesn't update __cplusplus
+ * unless /Zc:__cplusplus is used
+ *********************************/
+#if defined(_MSVC_LANG)
+#   define BIMAP_CPLUSPLUS _MSVC_LANG
+#else
+#   define BIMAP_CPLUSPLUS __cplusplus
+#endif
+
+#define BIMAP_HAS_CPP14 (BIMAP_CPLUSPLUS >= 201402L)  /**< Equal to \c 1 when compiled with at least C++14 standard */
+#define BIMAP_HAS_CPP17 (BIMAP_CPLUSPLUS >= 201703L)  /**< Equal to \c 1 when compiled with at least C++17 standard */
+
+/* Polymorphic allocators may be missing from C++17 libraries (libc++ < 16) */
+#if BIMAP_HAS_CPP17 && defined(__has_include)
+#   if __has_include(<memory_resource>)
+#       define BIMAP_HAS_PMR 1
+#   endif
+#endif
+#ifndef BIMAP_HAS_PMR
+#   define BIMAP_HAS_PMR 0  /**< Equal to \c 1 when \c std::pmr allocators are available */
+#endif
+
+#if BIMAP_HAS_CPP17
+#   include <string>
+#   include <string_view>
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#   include <intrin.h>
+#   include <xmmintrin.h>
+#endif
+
+/**********************************
+ * SIMD instructions used to probe groups
+ * of metadata bytes of hash tables.
+ * SSE2 and NEON are part of x86-64 and AArch64
+ * baselines, so no runtime check is needed.
+ * Define BIMAP_DISABLE_SIMD to use portable code.
+ *********************************/
+#if !defined(BIMAP_DISABLE_SIMD)
+#   if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#       define BIMAP_HAS_SSE2 1
+#       include <emmintrin.h>
+#   elif defined(__ARM_NEON) && (defined(__aarch64__) || defined(_M_ARM64))
+#       define BIMAP_HAS_NEON 1
+#       include <arm_neon.h>
+#   endif
+#endif
+#ifndef BIMAP_HAS_SSE2
+#   define BIMAP_HAS_SSE2 0  /**< Equal to \c 1 when SSE2 instructions are used */
+#endif
+#ifndef BIMAP_HAS_NEON
+#   define BIMAP_HAS_NEON 0  /**< Equal to \c 1 when NEON instructions are used */
+#endif
+
+namespace cmap{
+
+/*****************************/
+/* Public helpers            */
+/*****************************/
+
+/*!
+ * \brief Behaviour of \c replace() methods when the new pair
+ * conflicts with existing elements
+ * \details
+ * For all policies, nothing is done if the pair (\em left being the key
+ * and \em right the value) already exists.
+ */
+enum class ReplacePolicy
+{
+    Reject,         /**< Pair is only inserted if neither its key nor its value already exist */
+    OverwriteLeft,  /**< If value already exists, its key is replaced. Rejected if key already exists */
+    OverwriteRight  /**< If key already exists, its value is replaced. Rejected if value already exists */
+};
+
+/*!
+ * \brief Reason preventing a change of a patch to be applied
+ * \details
+ * Patches are checked as a whole before being applied: erasing or
+ * reassigning a key frees its value for other changes of same patch.
+ */
+enum class PatchConflict
+{
+    DuplicatedKey,      /**< Key is already changed by a previous change of patch */
+    DuplicatedValue,    /**< Value is already set by a previous change of patch */
+    KeyExists,          /**< Inserted key already exists */
+    KeyMissing,         /**< Erased or assigned key doesn't exist */
+    ValueExists         /**< Value already belongs to a key not changed by patch */
+};
+
+/*!
+ * \brief Memory owned by a bimap, in bytes
+ * \details
+ * Only memory owned by the container is reported: memory owned by
+ * elements themselves (like characters of long strings) is not. \n
+ * Allocator bookkeeping can't be known, \c overhead estimates it
+ * to \c cmap::BimapAllocationOverhead bytes per allocation (which is
+ * the usual cost of \c malloc()), plus padding of internal structures.
+ *
+ * \sa memoryUsage() of each container
+ */
+struct BimapMemoryUsage
+{
+    std::size_t indexKey;   /**< Bytes used to search elements by keys */
+    std::size_t indexValue; /**< Bytes used to search elements by values */
+    std::size_t payload;    /**< Bytes of stored pairs */
+    std::size_t overhead;   /**< Estimated allocator bookkeeping and padding */
+    std::size_t unused;     /**< Bytes reserved but not used yet (free slots or capacity of arrays) */
+
+    std::size_t total() const { return indexKey + indexValue + payload + overhead + unused; }
+};
+
+/*!
+ * \brief Estimated bookkeeping bytes of an allocation, used
+ * by \c cmap::BimapMemoryUsage
+ */
+constexpr std::size_t BimapAllocationOverhead = 2 * sizeof(void*);
+
+#if BIMAP_HAS_CPP17
+/*!
+ * \brief Transparent hash function for strings
+ * \details
+ * Can hash any type convertible to \c std::string_view (\c std::string,
+ * <tt>const char*</tt>...) with the same result, so hash-based bimaps
+ * can be searched without building temporary strings. \n
+ * Use it with \c std::equal_to<> as equality predicate.
+ *
+ * <b>Example: </b>
+ * \code{.cpp}
+    cmap::UnorderedBimap<int, std::string, std::hash<int>, std::equal_to<int>, cmap::StringHash, std::equal_to<>> bimap;
+    bimap.getKey(std::string_view("ONE")); // No std::string is constructed
+ * \endcode
+ */
+struct StringHash
+{
+    using is_transparent = void;
+
+    std::size_t operator()(std::string_view str) const { return std::hash<std::string_view>()(str); }
+};
+#endif
+
+/*****************************/
+/* Internal implementation   */
+/*****************************/
+
+namespace detail{
+
+/*!
+ * \brief Default comparison function used by ordered bimaps
+ * \details
+ * When available (C++14), transparent \c std::less<> is used, so
+ * lookups can be performed with any type comparable to stored ones.
+ */
+#if BIMAP_HAS_CPP14
+template<class T>
+using BimapLess = std::less<>;
+#else
+template<class T>
+using BimapLess = std::less<T>;
+#endif
+
+template<class... Ts>
+struct BimapVoid
+{
+    using type = void;
+};
+
+/*!
+ * \brief Check if function object \c T define \c is_transparent
+ */
+template<class T, class = void>
+struct BimapIsTransparent : std::false_type {};
+
+template<class T>
+struct BimapIsTransparent<T, typename BimapVoid<typename T::is_transparent>::type> : std::true_type {};
+
+/*!
+ * \brief Used to enable heterogeneous lookup overloads
+ * when all functions objects are transparent
+ */
+template<class T1, class T2 = T1>
+using BimapEnableTransparent = typename std::enable_if<BimapIsTransparent<T1>::value && BimapIsTransparent<T2>::value, int>::type;
+
+/*!
+ * \brief Check if \c It is an iterator of pairs (elements
+ * providing \c first and \c second)
+ */
+template<class It, class = void>
+struct BimapIsPairIterator : std::false_type {};
+
+template<class It>
+struct BimapIsPairIterator<It, typename BimapVoid<typename std::iterator_traits<It>::iterator_category,
+                                                  decltype((*std::declval<It&>()).first),
+                                                  decltype((*std::declval<It&>()).second)>::type> : std::true_type {};
+
+/*!
+ * \brief Used to enable range overloads only for iterators of pairs,
+ * so calls with two arguments of same type (like two string literals)
+ * keep using element overloads
+ */
+template<class It>
+using BimapEnablePairIterator = typename std::enable_if<BimapIsPairIterator<It>::value, int>::type;
+
+/*!
+ * \brief Helpers used to propagate allocators of node-based
+ * bimaps, according to their \c propagate_on_container_* traits
+ */
+template<class T>
+inline void bimapAssignAllocator(T &lhs, const T &rhs, std::true_type) { lhs = rhs; }
+template<class T>
+inline void bimapAssignAllocator(T&, const T&, std::false_type) {}
+
+template<class T>
+inline void bimapSwapAllocator(T &lhs, T &rhs, std::true_type) { using std::swap; swap(lhs, rhs); }
+template<class T>
+inline void bimapSwapAllocator(T&, T&, std::false_type) {}
+
+/*!
+ * \brief Size used to pad data written by different threads,
+ * so they never share a cache line
+ */
+constexpr std::size_t BimapCacheLineSize = 64;
+
+/*!
+ * \brief Number of lookups interleaved by batched lookups
+ * (\c getValues() and \c getKeys())
+ */
+constexpr std::size_t BimapBatchWidth = 16;
+
+/*!
+ * \brief Hint processor to load memory at \c ptr in cache
+ * \details
+ * Used by batched lookups to overlap cache misses of
+ * independent searches. Do nothing on unknown compilers.
+ */
+inline void bimapPrefetch(const void *ptr)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(ptr);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_prefetch(static_cast<const char*>(ptr), _MM_HINT_T0);
+#else
+    (void)ptr;
+#endif
+}
+
+/*!
+ * \brief Returns index of lowest bit set of \c mask
+ * \details
+ * \c mask must not be \c 0.
+ */
+inline unsigned bimapLowestBit(std::uint32_t mask)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#elif defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<unsigned>(index);
+#else
+    unsigned index = 0;
+    while(!(mask & 1u)){
+        mask >>= 1;
+        ++index;
+    }
+    return index;
+#endif
+}
+
+/*!
+ * \brief Count one more element reached after \c length probes
+ * in a probe-length \c histogram (index \c 0 is used by length \c 1)
+ */
+inline void bimapHistogramAdd(std::vector<std::size_t> &histogram, std::size_t length)
+{
+    if(histogram.size() < length){
+        histogram.resize(length, 0);
+    }
+    ++histogram[length - 1];
+}
+
+/*!
+ * \brief Mix bits of an hash
+ * \details
+ * Tables sizes are always a power of two, this finalizer make sure
+ * that weak hashes (like \c std::hash of integers, which is often the
+ * identity) still use all buckets.
+ */
+inline std::size_t bimapHashMix(std::size_t hash)
+{
+#if SIZE_MAX > UINT32_MAX
+    hash ^= hash >> 33;
+    hash *= UINT64_C(0xff51afd7ed558ccd);
+    hash ^= hash >> 33;
+#else
+    hash ^= hash >> 16;
+    hash *= UINT32_C(0x85ebca6b);
+    hash ^= hash >> 13;
+#endif
+    return hash;
+}
+
+/*!
+ * \brief Minimal number of elements handled by each task of
+ * parallel algorithms, smaller ranges are not worth a thread
+ */
+constexpr std::size_t BimapParallelGrain = 4096;
+
+/*!
+ * \brief Executor running all tasks in calling thread
+ * \details
+ * Used by sequential bulk builds, which share their code with
+ * parallel ones (see bimapparallel.h for requirements of executors).
+ */
+struct BimapInlineExecutor
+{
+    std::size_t concurrency() const { return 1; }
+
+    template<class Func>
+    void run(std::size_t count, const Func &func) const
+    {
+        for(std::size_t i = 0; i < count; ++i){
+            func(i);
+        }
+    }
+};
+
+/*!
+ * \brief Number of tasks used to process \c count elements
+ * with \c concurrency workers
+ */
+inline std::size_t bimapParallelTasks(std::size_t count, std::size_t concurrency)
+{
+    const std::size_t tasks = std::min(count / BimapParallelGrain, concurrency);
+    return tasks > 1 ? tasks : 1;
+}
+
+/*!
+ * \brief Sort range with tasks of \c executor
+ * \details
+ * Range is split in one chunk per task, chunks are sorted
+ * concurrently and then merged pairwise (last merge is performed
+ * by a single task). Sort is skipped if range is already sorted.
+ */
+template<class Executor, class RandomIt, class Compare>
+void bimapParallelSort(Executor &executor, RandomIt first, RandomIt last, Compare comp)
+{
+    if(std::is_sorted(first, last, comp)){
+        return;
+    }
+
+    const std::size_t count = static_cast<std::size_t>(last - first);
+    const std::size_t tasks = bimapParallelTasks(count, executor.concurrency());
+    if(tasks == 1){
+        std::sort(first, last, comp);
+        return;
+    }
+
+    std::vector<std::size_t> bounds(tasks + 1);
+    for(std::size_t i = 0; i <= tasks; ++i){
+        bounds[i] = count / tasks * i + std::min(i, count % tasks);
+    }
+
+    executor.run(tasks, [&](std::size_t i){
+        std::sort(first + bounds[i], first + bounds[i + 1], comp);
+    });
+
+    for(std::size_t width = 1; width < tasks; width *= 2){
+        executor.run((tasks + 2 * width - 1) / (2 * width), [&](std::size_t i){
+            const std::size_t low = 2 * width * i;
+            const std::size_t middle = std::min(low + width, tasks);
+            const std::size_t high = std::min(low + 2 * width, tasks);
+            if(middle < high){
+                std::inplace_merge(first + bounds[low], first + bounds[middle], first + bounds[high], comp);
+            }
+        });
+    }
+}
+
+} // Namespace detail
+
+} // Namespace cmap
+
+#endif // LCH_BIMAPCOMMON_H
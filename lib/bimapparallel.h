@@ -0,0 +1,254 @@
+#ifndef LCH_BIMAPPARALLEL_H
+#define LCH_BIMAPPARALLEL_H
+
+/*****************************/
+/* File documentations       */
+/*****************************/
+
+/*!
+   \file bimapparallel.h
+   \brief Executors and parallel batched lookups of bimaps.
+
+   Bulk builds (\c assign() of \c cmap::Bimap, \c cmap::FlatBimap and
+   \c cmap::SortedVectorBimap) and batched lookups (\c cmap::parallelGetValues()
+   and \c cmap::parallelGetKeys()) split their work in tasks run by an
+   \em executor supplied by caller. An executor is any object providing:
+   - <tt>std::size_t concurrency() const</tt>: number of tasks which may run at the same time
+   - <tt>template<class Func> void run(std::size_t count, const Func &func)</tt>:
+   call <tt>func(i)</tt> for each \c i in <tt>[0, count)</tt>, possibly
+   concurrently, and return once all calls are done (rethrowing an
+   exception thrown by one of them, if any).
+
+   \c cmap::BimapThreadExecutor is a simple implementation, an existing
+   thread pool only needs a thin adapter to be used instead. \n
+   Tasks call hash and comparison functions of containers concurrently,
+   those must allow it (as for concurrent lookups).
+
+   <b>Example: </b>
+   \code{.cpp}
+    cmap::BimapThreadExecutor executor;
+
+    cmap::FlatBimap<std::uint64_t, std::string> bimap;
+    bimap.assign(pairs.cbegin(), pairs.cend(), executor);
+
+    std::vector<std::string> values(keys.size());
+    cmap::parallelGetValues(executor, bimap, keys.data(), keys.size(), values.data());
+   \endcode
+*/
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "bimapcommon.h"
+
+namespace cmap{
+
+/*****************************/
+/* Class definitions         */
+/*****************************/
+
+/*!
+ * \brief Executor running tasks on threads started by each run()
+ * \details
+ * Calling thread takes part in tasks, so <tt>concurrency() - 1</tt>
+ * threads are started at most. Starting threads costs a few
+ * microseconds, which is negligible compared to bulk operations
+ * this executor is meant for.
+ */
+class BimapThreadExecutor
+{
+
+public:
+    explicit BimapThreadExecutor(std::size_t threads = 0);
+
+public:
+    std::size_t concurrency() const;
+
+    template<class Func>
+    void run(std::size_t count, const Func &func) const;
+
+private:
+    std::size_t m_threads;
+};
+
+/*!
+ * \brief Construct executor
+ *
+ * \param threads
+ * Maximum number of tasks running at the same time. \n
+ * Use \c 0 to use number of hardware threads.
+ */
+inline BimapThreadExecutor::BimapThreadExecutor(std::size_t threads) :
+    m_threads(threads)
+{
+    if(m_threads == 0){
+        m_threads = std::thread::hardware_concurrency();
+    }
+    if(m_threads == 0){
+        m_threads = 1;
+    }
+}
+
+/*!
+ * \brief Returns maximum number of tasks running at the same time
+ */
+inline std::size_t BimapThreadExecutor::concurrency() const
+{
+    return m_threads;
+}
+
+/*!
+ * \brief Call \c func for each index of <tt>[0, count)</tt>
+ * \details
+ * Tasks are dispatched one by one to threads. If a task throws,
+ * remaining tasks are skipped and first exception is rethrown once all
+ * threads have stopped. \n
+ * If a thread cannot be started, tasks are performed by already
+ * started ones.
+ */
+template<class Func>
+void BimapThreadExecutor::run(std::size_t count, const Func &func) const
+{
+    std::atomic<std::size_t> next(0);
+    std::exception_ptr error;
+    std::mutex mutexError;
+
+    const auto worker = [&](){
+        for(std::size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)){
+            try{
+                func(i);
+            }catch(...){
+                std::lock_guard<std::mutex> lock(mutexError);
+                if(!error){
+                    error = std::current_exception();
+                }
+                next.store(count);
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    const std::size_t workers = std::min(count, m_threads);
+    if(workers > 1){
+        threads.reserve(workers - 1);
+        try{
+            while(threads.size() < workers - 1){
+                threads.emplace_back(worker);
+            }
+        }catch(const std::system_error&){
+            /* Run with threads already started */
+        }
+    }
+
+    worker();
+    for(std::thread &thread : threads){
+        thread.join();
+    }
+
+    if(error){
+        std::rethrow_exception(error);
+    }
+}
+
+/*****************************/
+/* Functions definitions     */
+/*****************************/
+
+namespace detail{
+
+/*!
+ * \brief Split a batch of \c count lookups between tasks of \c executor
+ * \details
+ * \c lookup is called with range of each task and returns number of
+ * elements found in it.
+ */
+template<class Executor, class Lookup>
+std::size_t bimapParallelLookup(Executor &executor, std::size_t count, const Lookup &lookup)
+{
+    const std::size_t tasks = bimapParallelTasks(count, executor.concurrency());
+    if(tasks == 1){
+        return lookup(0, count);
+    }
+
+    std::atomic<std::size_t> nbFound(0);
+    executor.run(tasks, [&](std::size_t i){
+        const std::size_t first = count / tasks * i + std::min(i, count % tasks);
+        const std::size_t last = first + count / tasks + (i < count % tasks ? 1 : 0);
+        nbFound.fetch_add(lookup(first, last), std::memory_order_relaxed);
+    });
+    return nbFound.load();
+}
+
+} // Namespace detail
+
+/*!
+ * \brief Retrieve values of several keys at once, using
+ * tasks of \c executor
+ * \details
+ * Keys are split in contiguous ranges, each one searched with
+ * \c getValues() of \c bimap. Batches smaller than a few thousands
+ * keys are searched by calling thread only. \n
+ * \c bimap must not be modified during lookups.
+ *
+ * \param executor
+ * Executor running tasks.
+ * \param bimap
+ * Container to search, any bimap providing \c getValues().
+ * \param keys
+ * Array of \c count keys to search.
+ * \param count
+ * Number of keys.
+ * \param values
+ * Array of \c count values, each one is set if its key has been found.
+ * \param found
+ * Array of \c count booleans set to \c true if key has been found,
+ * can be \c nullptr.
+ * \return
+ * Returns number of keys found.
+ */
+template<class Executor, class Container, class K, class V>
+std::size_t parallelGetValues(Executor &executor, const Container &bimap, const K *keys, std::size_t count, V *values, bool *found = nullptr)
+{
+    return detail::bimapParallelLookup(executor, count, [&](std::size_t first, std::size_t last){
+        return bimap.getValues(keys + first, last - first, values + first, found ? found + first : nullptr);
+    });
+}
+
+/*!
+ * \brief Retrieve keys of several values at once, using
+ * tasks of \c executor
+ * \details
+ * Reverse direction of parallelGetValues().
+ *
+ * \param executor
+ * Executor running tasks.
+ * \param bimap
+ * Container to search, any bimap providing \c getKeys().
+ * \param values
+ * Array of \c count values to search.
+ * \param count
+ * Number of values.
+ * \param keys
+ * Array of \c count keys, each one is set if its value has been found.
+ * \param found
+ * Array of \c count booleans set to \c true if value has been found,
+ * can be \c nullptr.
+ * \return
+ * Returns number of values found.
+ */
+template<class Executor, class Container, class V, class K>
+std::size_t parallelGetKeys(Executor &executor, const Container &bimap, const V *values, std::size_t count, K *keys, bool *found = nullptr)
+{
+    return detail::bimapParallelLookup(executor, count, [&](std::size_t first, std::size_t last){
+        return bimap.getKeys(values + first, last - first, keys + first, found ? found + first : nullptr);
+    });
+}
+
+} // Namespace cmap
+
+#endif // LCH_BIMAPPARALLEL_H
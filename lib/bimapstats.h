@@ -0,0 +1,313 @@
+#ifndef LCH_BIMAPSTATS_H
+#define LCH_BIMAPSTATS_H
+
+/*****************************/
+/* File documentations       */
+/*****************************/
+
+/*!
+   \file bimapstats.h
+   \brief Optional statistics of lookups and updates of bimaps.
+
+   Statistics are compiled out by default. When \c BIMAP_ENABLE_STATS is
+   defined (option \c EXT_OPT_BIMAP_STATS of the library), each storage
+   engine (\c cmap::Bimap, \c cmap::UnorderedBimap, \c cmap::FlatBimap,
+   \c cmap::SortedVectorBimap, \c cmap::DenseKeyBimap and
+   \c cmap::StringPoolBimap) owns a \c cmap::BimapStats, available
+   through \c stats(), counting:
+   - Hits and misses of \c getValue() and \c getKey()
+   - Insertions adding a new element, and those overwriting existing elements
+   - Erased elements
+
+   Counters are spread over cache-line padded slots, each thread updating
+   its own slot, so threads reading the same bimap don't contend on them.
+   Latency of lookups can also be sampled (see \c cmap::BimapStats::setLatencySampling()).
+
+   <b>Example: </b>
+   \code{.cpp}
+    bimap.stats().setLatencySampling(64); // Time one lookup out of 64
+
+    const cmap::BimapStatsSnapshot snapshot = bimap.stats().snapshot();
+    exportGauge("bimap_miss_rate", snapshot.missRate());
+    exportGauge("bimap_p99_ns", snapshot.latencyPercentile(0.99));
+   \endcode
+*/
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "bimapcommon.h"
+
+/**********************************
+ * Hooks used by containers, which
+ * do nothing unless statistics are
+ * enabled
+ *********************************/
+#if defined(BIMAP_ENABLE_STATS)
+#   define BIMAP_STATS_LOOKUP_BEGIN(stats)      const std::uint64_t bimapStatsStart = (stats).lookupBegin()
+#   define BIMAP_STATS_LOOKUP_END(stats, hit)   (stats).lookupEnd(bimapStatsStart, hit)
+#   define BIMAP_STATS_RECORD(stats, event)     (stats).record##event(1)
+#   define BIMAP_STATS_RECORD_COUNT(stats, event, count) (stats).record##event(count)
+#else
+#   define BIMAP_STATS_LOOKUP_BEGIN(stats)      ((void)0)
+#   define BIMAP_STATS_LOOKUP_END(stats, hit)   ((void)0)
+#   define BIMAP_STATS_RECORD(stats, event)     ((void)0)
+#   define BIMAP_STATS_RECORD_COUNT(stats, event, count) ((void)0)
+#endif
+
+namespace cmap{
+
+/*****************************/
+/* Public helpers            */
+/*****************************/
+
+/*!
+ * \brief Values of statistics of a bimap at a given time
+ * \details
+ * Snapshots of several bimaps (or of several processes) can be
+ * combined with merge().
+ */
+struct BimapStatsSnapshot
+{
+    static constexpr std::size_t LatencyBuckets = 24; /**< Last bucket counts lookups of at least 2^23 ns (about 8 ms) */
+
+    std::uint64_t hits;         /**< Number of successful lookups */
+    std::uint64_t misses;       /**< Number of lookups of missing elements */
+    std::uint64_t inserts;      /**< Number of insertions adding a new element */
+    std::uint64_t overwrites;   /**< Number of insertions replacing or modifying existing elements */
+    std::uint64_t erases;       /**< Number of erased elements */
+
+    /*! Sampled latencies of lookups: bucket \c i counts lookups which
+     * took between 2^(i-1) (\c 0 for first bucket) and 2^i nanoseconds */
+    std::uint64_t latencies[LatencyBuckets];
+
+    BimapStatsSnapshot() : hits(0), misses(0), inserts(0), overwrites(0), erases(0), latencies() {}
+
+    void merge(const BimapStatsSnapshot &other)
+    {
+        hits += other.hits;
+        misses += other.misses;
+        inserts += other.inserts;
+        overwrites += other.overwrites;
+        erases += other.erases;
+        for(std::size_t i = 0; i < LatencyBuckets; ++i){
+            latencies[i] += other.latencies[i];
+        }
+    }
+
+    std::uint64_t lookups() const { return hits + misses; }
+    double missRate() const { return lookups() > 0 ? static_cast<double>(misses) / static_cast<double>(lookups()) : 0.0; }
+
+    std::uint64_t samples() const
+    {
+        std::uint64_t count = 0;
+        for(std::uint64_t bucket : latencies){
+            count += bucket;
+        }
+        return count;
+    }
+
+    /*!
+     * \brief Returns upper bound (in nanoseconds) of bucket holding
+     * the latency percentile \c ratio (between \c 0 and \c 1)
+     * \return
+     * Upper bound of bucket, \c 0 if no latency has been sampled.
+     */
+    std::uint64_t latencyPercentile(double ratio) const
+    {
+        const std::uint64_t count = samples();
+        if(count == 0){
+            return 0;
+        }
+
+        const double rank = ratio * static_cast<double>(count);
+        std::uint64_t seen = 0;
+        for(std::size_t i = 0; i < LatencyBuckets; ++i){
+            seen += latencies[i];
+            if(seen > 0 && static_cast<double>(seen) >= rank){
+                return std::uint64_t(1) << i;
+            }
+        }
+        return std::uint64_t(1) << (LatencyBuckets - 1);
+    }
+};
+
+/*****************************/
+/* Internal implementation   */
+/*****************************/
+
+namespace detail{
+
+/*!
+ * \brief Returns a number identifying calling thread, assigned
+ * on first call
+ */
+inline std::size_t bimapStatsThreadId()
+{
+    static std::atomic<std::size_t> next(0);
+    thread_local const std::size_t id = next.fetch_add(1, std::memory_order_relaxed);
+    return id;
+}
+
+/*!
+ * \brief Returns \c true if calling thread should time its
+ * current lookup, one lookup out of \c period is timed
+ */
+inline bool bimapStatsSample(std::uint32_t period)
+{
+    thread_local std::uint32_t countdown = 0;
+    if(countdown == 0){
+        countdown = period;
+        return true;
+    }
+    --countdown;
+    return false;
+}
+
+} // Namespace detail
+
+/*****************************/
+/* Class definitions         */
+/*****************************/
+
+/*!
+ * \brief Counters of lookups and updates of a bimap
+ * \details
+ * Most operations only increment a counter of the slot of calling
+ * thread (slots are padded, so threads never share a cache line while
+ * there are less threads than slots). Lookups are only timed when
+ * latency sampling is enabled, and only for sampled lookups.
+ *
+ * Copies have the sampling period of the original statistics, but
+ * their own (initially null) counters: statistics belong to a container
+ * instance.
+ */
+class BimapStats
+{
+public:
+    static constexpr std::size_t SlotCount = 16;
+
+public:
+    BimapStats() : m_sampling(0) {}
+    BimapStats(const BimapStats &other) : m_sampling(other.latencySampling()) {}
+    BimapStats& operator=(const BimapStats &other)
+    {
+        setLatencySampling(other.latencySampling());
+        return *this;
+    }
+
+public:
+    /*!
+     * \brief Time one lookup out of \c period, \c 0 (default) disables sampling
+     */
+    void setLatencySampling(std::uint32_t period) { m_sampling.store(period, std::memory_order_relaxed); }
+    std::uint32_t latencySampling() const { return m_sampling.load(std::memory_order_relaxed); }
+
+    /*!
+     * \brief Returns sum of counters of all slots
+     * \details
+     * Counters are read while they may still be incremented, so
+     * snapshot may be slightly behind of concurrent operations.
+     */
+    BimapStatsSnapshot snapshot() const
+    {
+        BimapStatsSnapshot result;
+        for(const Slot &slot : m_slots){
+            result.hits += slot.hits.load(std::memory_order_relaxed);
+            result.misses += slot.misses.load(std::memory_order_relaxed);
+            result.inserts += slot.inserts.load(std::memory_order_relaxed);
+            result.overwrites += slot.overwrites.load(std::memory_order_relaxed);
+            result.erases += slot.erases.load(std::memory_order_relaxed);
+            for(std::size_t i = 0; i < BimapStatsSnapshot::LatencyBuckets; ++i){
+                result.latencies[i] += slot.latencies[i].load(std::memory_order_relaxed);
+            }
+        }
+        return result;
+    }
+
+    void reset()
+    {
+        for(Slot &slot : m_slots){
+            slot.hits.store(0, std::memory_order_relaxed);
+            slot.misses.store(0, std::memory_order_relaxed);
+            slot.inserts.store(0, std::memory_order_relaxed);
+            slot.overwrites.store(0, std::memory_order_relaxed);
+            slot.erases.store(0, std::memory_order_relaxed);
+            for(std::atomic<std::uint64_t> &bucket : slot.latencies){
+                bucket.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+public:
+    /*!
+     * \brief Called by containers before a lookup
+     * \return
+     * Time at which lookup started if it is sampled, \c 0 otherwise.
+     */
+    std::uint64_t lookupBegin() const
+    {
+        const std::uint32_t period = latencySampling();
+        if(period == 0 || !detail::bimapStatsSample(period - 1)){
+            return 0;
+        }
+        return now();
+    }
+
+    /*!
+     * \brief Called by containers after a lookup
+     */
+    void lookupEnd(std::uint64_t start, bool hit) const
+    {
+        const Slot &current = slot();
+        increment(hit ? current.hits : current.misses);
+
+        if(start != 0){
+            const std::uint64_t elapsed = now() - start;
+
+            std::size_t bucket = 0;
+            while(bucket < BimapStatsSnapshot::LatencyBuckets - 1 && (std::uint64_t(1) << bucket) < elapsed){
+                ++bucket;
+            }
+            increment(current.latencies[bucket]);
+        }
+    }
+
+    void recordInsert(std::uint64_t count) const { increment(slot().inserts, count); }
+    void recordOverwrite(std::uint64_t count) const { increment(slot().overwrites, count); }
+    void recordErase(std::uint64_t count) const { increment(slot().erases, count); }
+
+private:
+    /* Counters are only incremented through const methods, since lookups are const */
+    struct Slot
+    {
+        mutable std::atomic<std::uint64_t> hits{0};
+        mutable std::atomic<std::uint64_t> misses{0};
+        mutable std::atomic<std::uint64_t> inserts{0};
+        mutable std::atomic<std::uint64_t> overwrites{0};
+        mutable std::atomic<std::uint64_t> erases{0};
+        mutable std::atomic<std::uint64_t> latencies[BimapStatsSnapshot::LatencyBuckets] = {};
+
+        char padding[detail::BimapCacheLineSize];
+    };
+
+    const Slot& slot() const { return m_slots[detail::bimapStatsThreadId() % SlotCount]; }
+
+    static void increment(std::atomic<std::uint64_t> &counter, std::uint64_t count = 1) { counter.fetch_add(count, std::memory_order_relaxed); }
+
+    static std::uint64_t now()
+    {
+        const auto elapsed = std::chrono::steady_clock::now().time_since_epoch();
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) | 1;
+    }
+
+private:
+    Slot m_slots[SlotCount];
+    std::atomic<std::uint32_t> m_sampling;
+};
+
+} // Namespace cmap
+
+#endif // LCH_BIMAPSTATS_H
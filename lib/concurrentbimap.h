@@ -0,0 +1,791 @@
+#ifndef LCH_CONCURRENTBIMAP_H
+#define LCH_CONCURRENTBIMAP_H
+
+/*****************************/
+/* Class documentations      */
+/*****************************/
+
+/*!
+   \class cmap::ConcurrentBimap
+   \brief Class use to provide a thread-safe bi-directional map.
+
+   Keys and values are spread over a fixed number of shards, selected by
+   their hashes: each shard owns a table of keys (for keys hashing to it)
+   and a table of values (for values hashing to it), protected by its own
+   reader/writer lock. Lookups only lock the shard of the searched element
+   in shared mode, so readers of different shards never touch the same
+   cache line, and readers of the same shard don't block each other.
+
+   Writers lock, in exclusive mode and always in increasing order, every
+   shard impacted by the operation (shards of the key, of the value and of
+   conflicting elements) before modifying anything. So both directions of
+   a pair are updated atomically: readers never see one side updated
+   without the other.
+
+   \note
+   Because elements may be modified by other threads at any time, this
+   class doesn't provide iterators and lookups return copies. Use
+   forEach() to visit a consistent snapshot of all elements.
+
+   \note
+   Shared locks use \c std::shared_mutex (C++17) or \c std::shared_timed_mutex
+   (C++14). With C++11, shards are protected by a \c std::mutex, so readers
+   of the same shard are serialized.
+
+   \sa cmap::UnorderedBimap
+*/
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+#include "bimapcommon.h"
+
+#if BIMAP_HAS_CPP14
+#   include <shared_mutex>
+#endif
+
+namespace cmap{
+
+/*****************************/
+/* Internal implementation   */
+/*****************************/
+
+namespace detail{
+
+#if BIMAP_HAS_CPP17
+using BimapSharedMutex = std::shared_mutex;
+#elif BIMAP_HAS_CPP14
+using BimapSharedMutex = std::shared_timed_mutex;
+#else
+/*!
+ * \brief Fallback of shared mutex, shared owners are exclusive
+ */
+class BimapSharedMutex
+{
+public:
+    void lock() { m_mutex.lock(); }
+    void unlock() { m_mutex.unlock(); }
+    void lock_shared() { m_mutex.lock(); }
+    void unlock_shared() { m_mutex.unlock(); }
+
+private:
+    std::mutex m_mutex;
+};
+#endif
+
+/*!
+ * \brief RAII owner of a shared lock (\c std::shared_lock is C++14)
+ */
+class BimapSharedGuard
+{
+public:
+    explicit BimapSharedGuard(BimapSharedMutex &mutex) : m_mutex(mutex) { m_mutex.lock_shared(); }
+    ~BimapSharedGuard() { m_mutex.unlock_shared(); }
+
+    BimapSharedGuard(const BimapSharedGuard &other) = delete;
+    BimapSharedGuard& operator=(const BimapSharedGuard &other) = delete;
+
+private:
+    BimapSharedMutex &m_mutex;
+};
+
+/*!
+ * \brief Shard of a concurrent bimap
+ * \details
+ * Shards are padded so that locks of two shards never share
+ * a cache line.
+ */
+template<class TypeKey, class TypeValue, class HashKey, class EqualKey, class HashValue, class EqualValue>
+struct ConcurrentBimapShard
+{
+    mutable BimapSharedMutex mutex;
+    std::unordered_map<TypeKey, TypeValue, HashKey, EqualKey> keys;
+    std::unordered_map<TypeValue, TypeKey, HashValue, EqualValue> values;
+
+    char padding[BimapCacheLineSize];
+};
+
+/*!
+ * \brief Set of shards locked in exclusive mode by a writer
+ * \details
+ * Shards are always locked in increasing order, so writers
+ * cannot deadlock. A writer needs at most four shards: those of
+ * the key and the value, and those of both conflicting elements.
+ */
+template<class Shard>
+class ConcurrentBimapLocks
+{
+public:
+    explicit ConcurrentBimapLocks(Shard *shards) : m_shards(shards), m_count(0), m_locked(false) {}
+    ~ConcurrentBimapLocks() { unlock(); }
+
+    ConcurrentBimapLocks(const ConcurrentBimapLocks &other) = delete;
+    ConcurrentBimapLocks& operator=(const ConcurrentBimapLocks &other) = delete;
+
+public:
+    bool contains(std::size_t shard) const
+    {
+        return std::find(m_indexes, m_indexes + m_count, shard) != m_indexes + m_count;
+    }
+
+    void add(std::size_t shard)
+    {
+        if(!contains(shard)){
+            std::size_t *pos = std::upper_bound(m_indexes, m_indexes + m_count, shard);
+            std::copy_backward(pos, m_indexes + m_count, m_indexes + m_count + 1);
+            *pos = shard;
+            ++m_count;
+        }
+    }
+
+    void reset()
+    {
+        unlock();
+        m_count = 0;
+    }
+
+    void lock()
+    {
+        for(std::size_t i = 0; i < m_count; ++i){
+            m_shards[m_indexes[i]].mutex.lock();
+        }
+        m_locked = true;
+    }
+
+    void unlock()
+    {
+        if(m_locked){
+            for(std::size_t i = m_count; i > 0; --i){
+                m_shards[m_indexes[i - 1]].mutex.unlock();
+            }
+            m_locked = false;
+        }
+    }
+
+private:
+    Shard *m_shards;
+    std::size_t m_indexes[4];
+    std::size_t m_count;
+    bool m_locked;
+};
+
+} // Namespace detail
+
+/*****************************/
+/* Class definitions         */
+/*****************************/
+
+template<class TypeKey, class TypeValue,
+         class HashKey = std::hash<TypeKey>, class EqualKey = std::equal_to<TypeKey>,
+         class HashValue = std::hash<TypeValue>, class EqualValue = std::equal_to<TypeValue>>
+class ConcurrentBimap
+{
+public:
+    using key_type = TypeKey;
+    using mapped_type = TypeValue;
+    using value_type = std::pair<const TypeKey, TypeValue>;
+    using size_type = std::size_t;
+
+    using hasher_key = HashKey;
+    using key_equal = EqualKey;
+    using hasher_value = HashValue;
+    using value_equal = EqualValue;
+
+    static constexpr std::size_t DefaultShardCount = 64;
+
+private:
+    using _TypeNode = std::pair<TypeKey, TypeValue>; // Used to implement std::initializer_list<T> support
+
+    using _Shard = detail::ConcurrentBimapShard<TypeKey, TypeValue, HashKey, EqualKey, HashValue, EqualValue>;
+    using _Locks = detail::ConcurrentBimapLocks<_Shard>;
+
+public:
+    ConcurrentBimap();
+    explicit ConcurrentBimap(std::size_t shardCount,
+                             const HashKey &hashKey = HashKey(), const EqualKey &equalKey = EqualKey(),
+                             const HashValue &hashValue = HashValue(), const EqualValue &equalValue = EqualValue());
+    ConcurrentBimap(const std::initializer_list<_TypeNode> &args);
+
+    ConcurrentBimap(const ConcurrentBimap &other) = delete;
+    ConcurrentBimap& operator=(const ConcurrentBimap &other) = delete;
+
+public:
+    bool empty() const;
+    std::size_t size() const;
+    std::size_t shardCount() const;
+
+    void clear();
+    void insert(const TypeKey &key, const TypeValue &value);
+    void insert(TypeKey &&key, TypeValue &&value);
+    bool tryInsert(const TypeKey &key, const TypeValue &value);
+    bool tryInsert(TypeKey &&key, TypeValue &&value);
+    bool erase(const TypeKey &key);
+
+    TypeValue getValue(const TypeKey &key) const;
+    TypeKey getKey(const TypeValue &value) const;
+
+    bool tryGetValue(const TypeKey &key, TypeValue &value) const;
+    bool tryGetKey(const TypeValue &value, TypeKey &key) const;
+    bool containsKey(const TypeKey &key) const;
+    bool containsValue(const TypeValue &value) const;
+
+    template<class Func>
+    void forEach(Func func) const;
+
+private:
+    template<class K, class V>
+    void insertPair(K &&key, V &&value);
+    template<class K, class V>
+    bool tryInsertPair(K &&key, V &&value);
+
+    template<class K, class V>
+    void linkPair(_Shard &shardKey, _Shard &shardValue, K &&key, V &&value);
+
+    std::size_t shardKey(const TypeKey &key) const;
+    std::size_t shardValue(const TypeValue &value) const;
+
+    void lockAllShared() const;
+    void unlockAllShared() const;
+
+private:
+    std::unique_ptr<_Shard[]> m_shards;
+    std::size_t m_nbShards;
+
+    HashKey m_hashKey;
+    HashValue m_hashValue;
+    EqualValue m_equalValue;
+};
+
+/*
+ * Functions implementations
+ * Class use template and methods cannot be defined in .cpp file.
+ * See https://isocpp.org/wiki/faq/templates#separate-template-fn-defn-from-decl
+ */
+
+#define CONCURRENTBIMAP_TEMPLATE template<class TypeKey, class TypeValue, class HashKey, class EqualKey, class HashValue, class EqualValue>
+#define CONCURRENTBIMAP_CLASS ConcurrentBimap<TypeKey, TypeValue, HashKey, EqualKey, HashValue, EqualValue>
+
+CONCURRENTBIMAP_TEMPLATE
+constexpr std::size_t CONCURRENTBIMAP_CLASS::DefaultShardCount;
+
+/*!
+ * \brief Construct empty concurrent bimap using
+ * \c DefaultShardCount shards
+ */
+CONCURRENTBIMAP_TEMPLATE
+CONCURRENTBIMAP_CLASS::ConcurrentBimap() : ConcurrentBimap(DefaultShardCount)
+{
+    /* Nothing to do */
+}
+
+/*!
+ * \brief Construct empty concurrent bimap
+ *
+ * \param shardCount
+ * Number of shards to use, rounded up to a power of two. More shards
+ * reduce contention between threads but make size(), clear() and
+ * forEach() more expensive. Number of shards cannot be changed later.
+ * \param hashKey, equalKey
+ * Hash and comparison functions used for keys.
+ * \param hashValue, equalValue
+ * Hash and comparison functions used for values.
+ */
+CONCURRENTBIMAP_TEMPLATE
+CONCURRENTBIMAP_CLASS::ConcurrentBimap(std::size_t shardCount,
+                                       const HashKey &hashKey, const EqualKey &equalKey,
+                                       const HashValue &hashValue, const EqualValue &equalValue) :
+    m_nbShards(1), m_hashKey(hashKey), m_hashValue(hashValue), m_equalValue(equalValue)
+{
+    while(m_nbShards < shardCount){
+        m_nbShards <<= 1;
+    }
+
+    m_shards.reset(new _Shard[m_nbShards]);
+    for(std::size_t i = 0; i < m_nbShards; ++i){
+        m_shards[i].keys = decltype(_Shard::keys)(0, hashKey, equalKey);
+        m_shards[i].values = decltype(_Shard::values)(0, hashValue, equalValue);
+    }
+}
+
+/*!
+ * \brief Construct concurrent bimap with \c std::initializer_list
+ * \param args
+ * List to use to construct concurrent bimap.
+ *
+ * <b>Example: </b>
+ * \code{.c}
+    cmap::ConcurrentBimap<int, std::string> m_mapNumberToString =
+    {
+        {1, "ONE"},
+        {2, "TWO"},
+        {3, "THREE"}
+    };
+ * \endcode
+ */
+CONCURRENTBIMAP_TEMPLATE
+CONCURRENTBIMAP_CLASS::ConcurrentBimap(const std::initializer_list<_TypeNode> &args) : ConcurrentBimap()
+{
+    for(auto it = args.begin(); it != args.end(); ++it){
+        insert(it->first, it->second);
+    }
+}
+
+/*!
+ * \brief Checks whether the container is empty
+ *
+ * \return
+ * Returns \c true if the container is empty, \c false otherwise
+ */
+CONCURRENTBIMAP_TEMPLATE
+bool CONCURRENTBIMAP_CLASS::empty() const
+{
+    return size() == 0;
+}
+
+/*!
+ * \brief Returns the number of elements
+ * \details
+ * All shards are locked in shared mode, so returned size
+ * is consistent but can be outdated as soon as it is returned.
+ *
+ * \return
+ * The number of elements in the container
+ */
+CONCURRENTBIMAP_TEMPLATE
+std::size_t CONCURRENTBIMAP_CLASS::size() const
+{
+    lockAllShared();
+
+    std::size_t count = 0;
+    for(std::size_t i = 0; i < m_nbShards; ++i){
+        count += m_shards[i].keys.size();
+    }
+
+    unlockAllShared();
+    return count;
+}
+
+/*!
+ * \brief Returns the number of shards
+ */
+CONCURRENTBIMAP_TEMPLATE
+std::size_t CONCURRENTBIMAP_CLASS::shardCount() const
+{
+    return m_nbShards;
+}
+
+/*!
+ * \brief Clears the contents
+ * \details
+ * All shards are locked at once, so other threads see
+ * either all elements or none of them.
+ */
+CONCURRENTBIMAP_TEMPLATE
+void CONCURRENTBIMAP_CLASS::clear()
+{
+    for(std::size_t i = 0; i < m_nbShards; ++i){
+        m_shards[i].mutex.lock();
+    }
+
+    for(std::size_t i = 0; i < m_nbShards; ++i){
+        m_shards[i].keys.clear();
+        m_shards[i].values.clear();
+    }
+
+    for(std::size_t i = m_nbShards; i > 0; --i){
+        m_shards[i - 1].mutex.unlock();
+    }
+}
+
+/*!
+ * \brief Insert item to concurrent bimap
+ * \details
+ * Pair and removal of conflicting pairs are visible
+ * at once to other threads.
+ *
+ * \param key
+ * Key of element, if key already exist, it will be replaced.
+ * \param value
+ * Value associated to the key, if value is already associated
+ * to another key, this association will be removed.
+ */
+CONCURRENTBIMAP_TEMPLATE
+void CONCURRENTBIMAP_CLASS::insert(const TypeKey &key, const TypeValue &value)
+{
+    insertPair(key, value);
+}
+
+/*!
+ * \brief Insert item to concurrent bimap by moving key and value
+ * \sa insert(const TypeKey &key, const TypeValue &value)
+ */
+CONCURRENTBIMAP_TEMPLATE
+void CONCURRENTBIMAP_CLASS::insert(TypeKey &&key, TypeValue &&value)
+{
+    insertPair(std::move(key), std::move(value));
+}
+
+/*!
+ * \brief Insert item only if neither key nor value exist
+ *
+ * \return
+ * Returns \c true if pair has been inserted, \c false otherwise.
+ */
+CONCURRENTBIMAP_TEMPLATE
+bool CONCURRENTBIMAP_CLASS::tryInsert(const TypeKey &key, const TypeValue &value)
+{
+    return tryInsertPair(key, value);
+}
+
+/*!
+ * \brief Insert item only if neither key nor value exist, by moving them
+ * \sa tryInsert(const TypeKey &key, const TypeValue &value)
+ */
+CONCURRENTBIMAP_TEMPLATE
+bool CONCURRENTBIMAP_CLASS::tryInsert(TypeKey &&key, TypeValue &&value)
+{
+    return tryInsertPair(std::move(key), std::move(value));
+}
+
+/*!
+ * \brief Remove element from concurrent bimap
+ *
+ * \param key
+ * Key of element to remove.
+ * \return
+ * Returns \c true if an element has been removed.
+ */
+CONCURRENTBIMAP_TEMPLATE
+bool CONCURRENTBIMAP_CLASS::erase(const TypeKey &key)
+{
+    const std::size_t idxKey = shardKey(key);
+
+    _Locks locks(m_shards.get());
+    locks.add(idxKey);
+
+    while(true){
+        locks.lock();
+
+        _Shard &shard = m_shards[idxKey];
+        auto it = shard.keys.find(key);
+        if(it == shard.keys.end()){
+            return false;
+        }
+
+        /* Shard of value is only known once key is found */
+        const std::size_t idxValue = shardValue(it->second);
+        if(!locks.contains(idxValue)){
+            locks.reset();
+            locks.add(idxKey);
+            locks.add(idxValue);
+            continue;
+        }
+
+        m_shards[idxValue].values.erase(it->second);
+        shard.keys.erase(it);
+        return true;
+    }
+}
+
+/*!
+ * \brief Use to retrieve value by key
+ *
+ * \param key
+ * Key to use to retrieve value element.
+ * \return
+ * Return a copy of value associated to key.
+ *
+ * \throw std::out_of_range
+ * Throw if key cannot be found
+ */
+CONCURRENTBIMAP_TEMPLATE
+TypeValue CONCURRENTBIMAP_CLASS::getValue(const TypeKey &key) const
+{
+    const _Shard &shard = m_shards[shardKey(key)];
+    detail::BimapSharedGuard guard(shard.mutex);
+
+    auto it = shard.keys.find(key);
+    if(it == shard.keys.end()){
+        throw std::out_of_range("cmap::ConcurrentBimap::getValue");
+    }
+
+    return it->second;
+}
+
+/*!
+ * \brief Use to retrieve key by value
+ *
+ * \param value
+ * Value to use to retrieve key element.
+ * \return
+ * Return a copy of key associated to value.
+ *
+ * \throw std::out_of_range
+ * Throw if value cannot be found
+ */
+CONCURRENTBIMAP_TEMPLATE
+TypeKey CONCURRENTBIMAP_CLASS::getKey(const TypeValue &value) const
+{
+    const _Shard &shard = m_shards[shardValue(value)];
+    detail::BimapSharedGuard guard(shard.mutex);
+
+    auto it = shard.values.find(value);
+    if(it == shard.values.end()){
+        throw std::out_of_range("cmap::ConcurrentBimap::getKey");
+    }
+
+    return it->second;
+}
+
+/*!
+ * \brief Retrieve value by key without throwing
+ *
+ * \param key
+ * Key to use to retrieve value element.
+ * \param value
+ * Assigned to value associated to key when found, untouched otherwise.
+ * \return
+ * Returns \c true if key has been found.
+ */
+CONCURRENTBIMAP_TEMPLATE
+bool CONCURRENTBIMAP_CLASS::tryGetValue(const TypeKey &key, TypeValue &value) const
+{
+    const _Shard &shard = m_shards[shardKey(key)];
+    detail::BimapSharedGuard guard(shard.mutex);
+
+    auto it = shard.keys.find(key);
+    if(it == shard.keys.end()){
+        return false;
+    }
+
+    value = it->second;
+    return true;
+}
+
+/*!
+ * \brief Retrieve key by value without throwing
+ *
+ * \param value
+ * Value to use to retrieve key element.
+ * \param key
+ * Assigned to key associated to value when found, untouched otherwise.
+ * \return
+ * Returns \c true if value has been found.
+ */
+CONCURRENTBIMAP_TEMPLATE
+bool CONCURRENTBIMAP_CLASS::tryGetKey(const TypeValue &value, TypeKey &key) const
+{
+    const _Shard &shard = m_shards[shardValue(value)];
+    detail::BimapSharedGuard guard(shard.mutex);
+
+    auto it = shard.values.find(value);
+    if(it == shard.values.end()){
+        return false;
+    }
+
+    key = it->second;
+    return true;
+}
+
+/*!
+ * \brief Checks if concurrent bimap contains key
+ */
+CONCURRENTBIMAP_TEMPLATE
+bool CONCURRENTBIMAP_CLASS::containsKey(const TypeKey &key) const
+{
+    const _Shard &shard = m_shards[shardKey(key)];
+    detail::BimapSharedGuard guard(shard.mutex);
+
+    return shard.keys.find(key) != shard.keys.end();
+}
+
+/*!
+ * \brief Checks if concurrent bimap contains value
+ */
+CONCURRENTBIMAP_TEMPLATE
+bool CONCURRENTBIMAP_CLASS::containsValue(const TypeValue &value) const
+{
+    const _Shard &shard = m_shards[shardValue(value)];
+    detail::BimapSharedGuard guard(shard.mutex);
+
+    return shard.values.find(value) != shard.values.end();
+}
+
+/*!
+ * \brief Visit all elements
+ * \details
+ * All shards are locked in shared mode during the visit, so visited
+ * elements are a consistent snapshot of the container. Elements are
+ * visited in an unspecified order.
+ *
+ * \param func
+ * Function called with <tt>(const TypeKey&, const TypeValue&)</tt>
+ * for each element.
+ *
+ * \warning
+ * \c func must not call any method of the container, shards are
+ * already locked.
+ */
+CONCURRENTBIMAP_TEMPLATE
+template<class Func>
+void CONCURRENTBIMAP_CLASS::forEach(Func func) const
+{
+    lockAllShared();
+
+    try{
+        for(std::size_t i = 0; i < m_nbShards; ++i){
+            for(const auto &pair : m_shards[i].keys){
+                func(pair.first, pair.second);
+            }
+        }
+    }catch(...){
+        unlockAllShared();
+        throw;
+    }
+
+    unlockAllShared();
+}
+
+/*!
+ * \brief Insert pair, removing conflicting pairs
+ * \details
+ * Shards of conflicting pairs are only known once shards of key
+ * and value are locked. If they are not already locked, all locks
+ * are released and acquired again in order, conflicts are then
+ * searched again since they may have changed meanwhile.
+ */
+CONCURRENTBIMAP_TEMPLATE
+template<class K, class V>
+void CONCURRENTBIMAP_CLASS::insertPair(K &&key, V &&value)
+{
+    const std::size_t idxKey = shardKey(key);
+    const std::size_t idxValue = shardValue(value);
+
+    _Locks locks(m_shards.get());
+    locks.add(idxKey);
+    locks.add(idxValue);
+
+    while(true){
+        locks.lock();
+
+        _Shard &shardK = m_shards[idxKey];
+        _Shard &shardV = m_shards[idxValue];
+        auto itKey = shardK.keys.find(key);
+        auto itValue = shardV.values.find(value);
+
+        /* Pair already exists */
+        if(itKey != shardK.keys.end() && m_equalValue(itKey->second, value)){
+            return;
+        }
+
+        const bool hasKey = itKey != shardK.keys.end();
+        const bool hasValue = itValue != shardV.values.end();
+        const std::size_t idxOldValue = hasKey ? shardValue(itKey->second) : idxValue;
+        const std::size_t idxOldKey = hasValue ? shardKey(itValue->second) : idxKey;
+
+        if(!locks.contains(idxOldValue) || !locks.contains(idxOldKey)){
+            locks.reset();
+            locks.add(idxKey);
+            locks.add(idxValue);
+            locks.add(idxOldValue);
+            locks.add(idxOldKey);
+            continue;
+        }
+
+        /* Remove stale reverse entries */
+        if(hasKey){
+            m_shards[idxOldValue].values.erase(itKey->second);
+            shardK.keys.erase(itKey);
+        }
+        if(hasValue){
+            m_shards[idxOldKey].keys.erase(itValue->second);
+            shardV.values.erase(itValue);
+        }
+
+        linkPair(shardK, shardV, std::forward<K>(key), std::forward<V>(value));
+        return;
+    }
+}
+
+CONCURRENTBIMAP_TEMPLATE
+template<class K, class V>
+bool CONCURRENTBIMAP_CLASS::tryInsertPair(K &&key, V &&value)
+{
+    const std::size_t idxKey = shardKey(key);
+    const std::size_t idxValue = shardValue(value);
+
+    _Locks locks(m_shards.get());
+    locks.add(idxKey);
+    locks.add(idxValue);
+    locks.lock();
+
+    _Shard &shardK = m_shards[idxKey];
+    _Shard &shardV = m_shards[idxValue];
+    if(shardK.keys.find(key) != shardK.keys.end() || shardV.values.find(value) != shardV.values.end()){
+        return false;
+    }
+
+    linkPair(shardK, shardV, std::forward<K>(key), std::forward<V>(value));
+    return true;
+}
+
+/*!
+ * \brief Add pair to tables of both directions
+ * \details
+ * Both shards must be locked in exclusive mode and neither
+ * key nor value must exist.
+ */
+CONCURRENTBIMAP_TEMPLATE
+template<class K, class V>
+void CONCURRENTBIMAP_CLASS::linkPair(_Shard &shardK, _Shard &shardV, K &&key, V &&value)
+{
+    auto itKey = shardK.keys.emplace(key, value).first;
+    try{
+        shardV.values.emplace(std::forward<V>(value), std::forward<K>(key));
+    }catch(...){
+        shardK.keys.erase(itKey);
+        throw;
+    }
+}
+
+CONCURRENTBIMAP_TEMPLATE
+std::size_t CONCURRENTBIMAP_CLASS::shardKey(const TypeKey &key) const
+{
+    return detail::bimapHashMix(m_hashKey(key)) & (m_nbShards - 1);
+}
+
+CONCURRENTBIMAP_TEMPLATE
+std::size_t CONCURRENTBIMAP_CLASS::shardValue(const TypeValue &value) const
+{
+    return detail::bimapHashMix(m_hashValue(value)) & (m_nbShards - 1);
+}
+
+CONCURRENTBIMAP_TEMPLATE
+void CONCURRENTBIMAP_CLASS::lockAllShared() const
+{
+    for(std::size_t i = 0; i < m_nbShards; ++i){
+        m_shards[i].mutex.lock_shared();
+    }
+}
+
+CONCURRENTBIMAP_TEMPLATE
+void CONCURRENTBIMAP_CLASS::unlockAllShared() const
+{
+    for(std::size_t i = m_nbShards; i > 0; --i){
+        m_shards[i - 1].mutex.unlock_shared();
+    }
+}
+
+#undef CONCURRENTBIMAP_TEMPLATE
+#undef CONCURRENTBIMAP_CLASS
+
+} // Namespace cmap
+
+#endif // LCH_CONCURRENTBIMAP_H
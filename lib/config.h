@@ -0,0 +1,9 @@
+#ifndef BIMAP_CONFIG_H
+#define BIMAP_CONFIG_H
+
+#define BIMAP_VERSION "1.0.0"
+#define BIMAP_VERSION_MAJOR "1"
+#define BIMAP_VERSION_MINOR "0"
+#define BIMAP_VERSION_PATCH "0"
+
+#endif // BIMAP_CONFIG_H
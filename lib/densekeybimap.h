@@ -0,0 +1,1174 @@
+#ifndef LCH_DENSEKEYBIMAP_H
+#define LCH_DENSEKEYBIMAP_H
+
+/*****************************/
+/* Class documentations      */
+/*****************************/
+
+/*!
+   \class cmap::DenseKeyBimap
+   \brief Class use to provide bi-directional map with small
+   dense integer keys.
+
+   This class provide the same interface than cmap::FlatBimap, for keys
+   which are integers (or enumerations) of a small contiguous range, like
+   identifiers from \c 0 to \c N. Values are stored in an array directly
+   indexed by keys, along with a bitmap of used keys: searching by key is a
+   single load (no hash nor comparison). Only values are indexed by an
+   open-addressing hash table of 32-bits keys (the one used by
+   cmap::FlatBimap), so lookups by value have an average complexity of
+   <b>O(1)</b>.
+
+   \note
+   Array is as large as the highest key ever inserted (see shrinkToFit()),
+   so memory use depends on range of keys, not on number of elements.
+   Negative keys and keys greater than \c 2^32-2 are rejected with
+   \c std::out_of_range. \n
+   Values must be default constructible: unused slots of array hold a
+   default constructed value, which is also assigned to erased slots
+   (to release their resources). \n
+   Iteration visits used slots in order of keys, dereferenced iterators
+   are pairs of a key and a reference to its value.
+
+   \sa cmap::FlatBimap
+*/
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "bimapcommon.h"
+#include "bimapstats.h"
+#include "flatbimap.h"
+
+namespace cmap{
+
+/*****************************/
+/* Internal implementation   */
+/*****************************/
+
+namespace detail{
+
+/*!
+ * \brief Integer type used to convert dense keys: underlying type
+ * of enumerations, key type itself otherwise
+ */
+template<class TypeKey>
+using DenseKeyInteger = typename std::conditional<std::is_enum<TypeKey>::value, std::underlying_type<TypeKey>, std::common_type<TypeKey>>::type::type;
+
+/*!
+ * \brief Convert an integer key to an array index, negative
+ * keys are converted to the maximum index
+ */
+template<class T>
+inline std::uint64_t bimapDenseIndex(T key, std::true_type) { return key < T(0) ? std::numeric_limits<std::uint64_t>::max() : static_cast<std::uint64_t>(key); }
+template<class T>
+inline std::uint64_t bimapDenseIndex(T key, std::false_type) { return static_cast<std::uint64_t>(key); }
+
+/*!
+ * \brief Iterator over used slots of a dense key bimap
+ * \details
+ * Dereferenced iterator is a pair of a key (rebuilt from index of
+ * slot) and a reference to the value stored in the slot.
+ */
+template<class TypeKey, class TypeValue>
+class DenseKeyBimapIterator
+{
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::pair<TypeKey, TypeValue>;
+    using difference_type = std::ptrdiff_t;
+    using reference = std::pair<TypeKey, const TypeValue&>;
+
+    struct pointer
+    {
+        reference ref;
+        const reference* operator->() const { return &ref; }
+    };
+
+public:
+    DenseKeyBimapIterator() : m_values(nullptr), m_occupied(nullptr), m_index(0), m_end(0) {}
+    DenseKeyBimapIterator(const TypeValue *values, const std::uint32_t *occupied, std::size_t index, std::size_t end) :
+        m_values(values), m_occupied(occupied), m_index(index), m_end(end)
+    {
+        skipUnused();
+    }
+
+public:
+    reference operator*() const { return reference(static_cast<TypeKey>(m_index), m_values[m_index]); }
+    pointer operator->() const { return pointer{**this}; }
+
+    DenseKeyBimapIterator& operator++()
+    {
+        ++m_index;
+        skipUnused();
+        return *this;
+    }
+
+    DenseKeyBimapIterator operator++(int)
+    {
+        DenseKeyBimapIterator tmp(*this);
+        ++(*this);
+        return tmp;
+    }
+
+    bool operator==(const DenseKeyBimapIterator &other) const { return m_index == other.m_index; }
+    bool operator!=(const DenseKeyBimapIterator &other) const { return m_index != other.m_index; }
+
+private:
+    /* Jump to next used slot, one word of bitmap at a time */
+    void skipUnused()
+    {
+        while(m_index < m_end){
+            const std::uint32_t word = m_occupied[m_index / 32] >> (m_index % 32);
+            if(word != 0){
+                m_index += bimapLowestBit(word);
+                return;
+            }
+            m_index += 32 - m_index % 32;
+        }
+        m_index = m_end;
+    }
+
+private:
+    const TypeValue *m_values;
+    const std::uint32_t *m_occupied;
+    std::size_t m_index;
+    std::size_t m_end;
+};
+
+} // Namespace detail
+
+/*****************************/
+/* Class definitions         */
+/*****************************/
+
+template<class TypeKey, class TypeValue, class HashValue = std::hash<TypeValue>, class EqualValue = std::equal_to<TypeValue>>
+class DenseKeyBimap
+{
+    static_assert(std::is_integral<TypeKey>::value || std::is_enum<TypeKey>::value, "cmap::DenseKeyBimap keys must be integers or enumerations");
+    static_assert(std::is_default_constructible<TypeValue>::value, "cmap::DenseKeyBimap values must be default constructible");
+
+public:
+    using key_type = TypeKey;
+    using mapped_type = TypeValue;
+    using value_type = std::pair<TypeKey, TypeValue>;
+    using size_type = std::size_t;
+
+    using hasher_value = HashValue;
+    using value_equal = EqualValue;
+
+private:
+    using _TypeNode = std::pair<TypeKey, TypeValue>; // Used to implement std::initializer_list<T> support
+    using _TypeInteger = detail::DenseKeyInteger<TypeKey>;
+
+    using _ContainerValues = std::vector<TypeValue>;
+    using _ContainerBitmap = std::vector<std::uint32_t>;
+    using _ContainerIndex = detail::FlatBimapIndex<std::uint32_t>;
+    using _TypeSlot = typename _ContainerIndex::TypeSlot;
+
+    static constexpr std::size_t NoIndex = std::numeric_limits<std::uint32_t>::max();
+
+public:
+    using iterator = detail::DenseKeyBimapIterator<TypeKey, TypeValue>;
+    using const_iterator = iterator;
+
+public:
+    DenseKeyBimap();
+    explicit DenseKeyBimap(std::size_t count, const HashValue &hashValue = HashValue(), const EqualValue &equalValue = EqualValue());
+    DenseKeyBimap(const std::initializer_list<_TypeNode> &args);
+
+public:
+    bool empty() const;
+    std::size_t size() const;
+    std::size_t maxSize() const;
+
+    void clear();
+    void insert(const TypeKey &key, const TypeValue &value);
+    void insert(TypeKey &&key, TypeValue &&value);
+    void erase(const TypeKey &key);
+    void swap(DenseKeyBimap &other);
+
+    const TypeValue& getValue(const TypeKey &key) const;
+    TypeKey getKey(const TypeValue &value) const;
+
+    template<class V, class H = HashValue, class E = EqualValue, detail::BimapEnableTransparent<H, E> = 0>
+    TypeKey getKey(const V &value) const;
+
+    const_iterator findByKey(const TypeKey &key) const;
+    const_iterator findByValue(const TypeValue &value) const;
+    bool containsKey(const TypeKey &key) const;
+    bool containsValue(const TypeValue &value) const;
+
+    template<class V, class H = HashValue, class E = EqualValue, detail::BimapEnableTransparent<H, E> = 0>
+    const_iterator findByValue(const V &value) const;
+    template<class V, class H = HashValue, class E = EqualValue, detail::BimapEnableTransparent<H, E> = 0>
+    bool containsValue(const V &value) const;
+
+    template<class... Args>
+    std::pair<iterator, bool> emplace(Args&&... args);
+    std::pair<iterator, bool> tryInsert(const TypeKey &key, const TypeValue &value);
+    std::pair<iterator, bool> tryInsert(TypeKey &&key, TypeValue &&value);
+
+    std::pair<iterator, bool> insertOrAssign(const TypeKey &key, const TypeValue &value);
+    std::pair<iterator, bool> insertOrAssign(TypeKey &&key, TypeValue &&value);
+    std::pair<iterator, bool> replace(const TypeKey &key, const TypeValue &value, ReplacePolicy policy);
+    std::pair<iterator, bool> replace(TypeKey &&key, TypeValue &&value, ReplacePolicy policy);
+
+public:
+    std::size_t capacity() const;
+    std::size_t keyRange() const;
+
+    void reserve(std::size_t count);
+    void reserveKeys(std::size_t count);
+    void shrinkToFit();
+
+    HashValue hashFunctionValue() const;
+
+    BimapMemoryUsage memoryUsage() const;
+
+#if defined(BIMAP_ENABLE_STATS)
+    BimapStats& stats() const;
+#endif
+
+private:
+    void insert(_TypeNode &&node);
+    void insert(const _TypeNode &node);
+
+    template<class K, class V>
+    std::pair<iterator, bool> tryInsertPair(K &&key, V &&value);
+    template<class K, class V>
+    std::pair<iterator, bool> replacePair(K &&key, V &&value, bool overwriteLeft, bool overwriteRight, bool &inserted);
+
+    static std::size_t indexOf(const TypeKey &key);
+    static std::size_t checkedIndexOf(const TypeKey &key);
+
+    bool isUsed(std::size_t index) const;
+    iterator iteratorAt(std::size_t index) const;
+
+    template<class V>
+    std::size_t hashValue(const V &value) const;
+    template<class V>
+    std::size_t findPosValue(const V &value, std::size_t hash) const;
+
+    template<class V>
+    void assignAt(std::size_t index, V &&value);
+    void eraseAt(std::size_t index, std::size_t posValue);
+    void prepareInsert();
+    void rebuildIndex(std::size_t capacity);
+
+public:
+    iterator begin();
+    const_iterator cbegin() const;
+    iterator end();
+    const_iterator cend() const;
+
+private:
+    _ContainerValues m_values;
+    _ContainerBitmap m_occupied;
+    _ContainerIndex m_index;
+    std::size_t m_size;
+
+    HashValue m_hashValue;
+    EqualValue m_equalValue;
+
+#if defined(BIMAP_ENABLE_STATS)
+    mutable BimapStats m_stats;
+#endif
+};
+
+/*
+ * Functions implementations
+ * Class use template and methods cannot be defined in .cpp file.
+ * See https://isocpp.org/wiki/faq/templates#separate-template-fn-defn-from-decl
+ */
+
+#define DENSEKEYBIMAP_TEMPLATE template<class TypeKey, class TypeValue, class HashValue, class EqualValue>
+#define DENSEKEYBIMAP_CLASS DenseKeyBimap<TypeKey, TypeValue, HashValue, EqualValue>
+
+DENSEKEYBIMAP_TEMPLATE constexpr std::size_t DENSEKEYBIMAP_CLASS::NoIndex;
+
+/*!
+ * \brief Construct empty dense key bimap
+ * \details
+ * No memory is allocated until first insertion.
+ */
+DENSEKEYBIMAP_TEMPLATE
+DENSEKEYBIMAP_CLASS::DenseKeyBimap() : DenseKeyBimap(0)
+{
+    /* Nothing to do */
+}
+
+/*!
+ * \brief Construct empty dense key bimap
+ *
+ * \param count
+ * Number of elements to reserve space for in index of values
+ * (see reserveKeys() to reserve array of keys).
+ * \param hashValue, equalValue
+ * Hash and comparison functions used for values.
+ */
+DENSEKEYBIMAP_TEMPLATE
+DENSEKEYBIMAP_CLASS::DenseKeyBimap(std::size_t count, const HashValue &hashValue, const EqualValue &equalValue) :
+    m_size(0), m_hashValue(hashValue), m_equalValue(equalValue)
+{
+    if(count > 0){
+        reserve(count);
+    }
+}
+
+/*!
+ * \brief Construct dense key bimap with \c std::initializer_list
+ * \param args
+ * List to use to construct dense key bimap.
+ *
+ * <b>Example: </b>
+ * \code{.c}
+    const cmap::DenseKeyBimap<int, std::string> m_mapNumberToString =
+    {
+        {1, "ONE"},
+        {2, "TWO"},
+        {3, "THREE"}
+    };
+ * \endcode
+ */
+DENSEKEYBIMAP_TEMPLATE
+DENSEKEYBIMAP_CLASS::DenseKeyBimap(const std::initializer_list<_TypeNode> &args) : DenseKeyBimap(args.size())
+{
+    for(auto it=args.begin(); it != args.end(); ++it){
+        insert(*it);
+    }
+}
+
+/*!
+ * \brief Checks whether the container is empty
+ *
+ * \return
+ * Returns \c true if the container is empty, \c false otherwise
+ */
+DENSEKEYBIMAP_TEMPLATE
+bool DENSEKEYBIMAP_CLASS::empty() const
+{
+    return m_size == 0;
+}
+
+/*!
+ * \brief Returns the number of elements
+ *
+ * \return
+ * The number of elements in the container.
+ */
+DENSEKEYBIMAP_TEMPLATE
+std::size_t DENSEKEYBIMAP_CLASS::size() const
+{
+    return m_size;
+}
+
+/*!
+ * \brief Returns the maximum number of elements
+ * \details
+ * Keys are stored as 32-bits indexes in index of values.
+ */
+DENSEKEYBIMAP_TEMPLATE
+std::size_t DENSEKEYBIMAP_CLASS::maxSize() const
+{
+    return std::min<std::size_t>(NoIndex, m_values.max_size());
+}
+
+/*!
+ * \brief Erases all elements from the container
+ * \details
+ * Array of keys and index of values keep their capacity.
+ */
+DENSEKEYBIMAP_TEMPLATE
+void DENSEKEYBIMAP_CLASS::clear()
+{
+    m_values.clear();
+    m_occupied.clear();
+    m_index.clear();
+    m_size = 0;
+}
+
+/*!
+ * \brief Insert item to dense key bimap
+ *
+ * \param key
+ * Key of element, if key already exist, it will be replaced.
+ * \param value
+ * Value associated to the key, if value is already associated
+ * to another key, this association will be removed.
+ *
+ * \throw std::out_of_range
+ * Throw if key is negative or greater than \c 2^32-2
+ */
+DENSEKEYBIMAP_TEMPLATE
+void DENSEKEYBIMAP_CLASS::insert(const TypeKey &key, const TypeValue &value)
+{
+    bool inserted = false;
+    replacePair(key, value, true, true, inserted);
+}
+
+/*!
+ * \overload
+ * \details
+ * Value is moved into its slot.
+ */
+DENSEKEYBIMAP_TEMPLATE
+void DENSEKEYBIMAP_CLASS::insert(TypeKey &&key, TypeValue &&value)
+{
+    bool inserted = false;
+    replacePair(std::move(key), std::move(value), true, true, inserted);
+}
+
+/*!
+ * \brief Use to erase an element
+ * \details
+ * Slot of key is reset to a default constructed value, array
+ * of keys is never shrunk (see shrinkToFit()).
+ *
+ * \param key
+ * Key of element to erase, if key doesn't exist, this
+ * method do nothing.
+ */
+DENSEKEYBIMAP_TEMPLATE
+void DENSEKEYBIMAP_CLASS::erase(const TypeKey &key)
+{
+    const std::size_t index = indexOf(key);
+    if(!isUsed(index)){
+        return;
+    }
+
+    eraseAt(index, m_index.findIndex(hashValue(m_values[index]), static_cast<_TypeSlot>(index)));
+    BIMAP_STATS_RECORD(m_stats, Erase);
+}
+
+/*!
+ * \brief Exchanges the contents of the container with those of \c other
+ * \details
+ * Does not invoke any move, copy, or swap operations on individual elements.
+ */
+DENSEKEYBIMAP_TEMPLATE
+void DENSEKEYBIMAP_CLASS::swap(DenseKeyBimap &other)
+{
+    using std::swap;
+
+    m_values.swap(other.m_values);
+    m_occupied.swap(other.m_occupied);
+    m_index.swap(other.m_index);
+    swap(m_size, other.m_size);
+    swap(m_hashValue, other.m_hashValue);
+    swap(m_equalValue, other.m_equalValue);
+}
+
+/*!
+ * \brief Use to retrieve value by key
+ * \details
+ * Key is directly used as index of array of values.
+ *
+ * \param key
+ * Key of element to get.
+ * \return
+ * Return value associated to key.
+ *
+ * \throw std::out_of_range
+ * Throw if key cannot be found
+ */
+DENSEKEYBIMAP_TEMPLATE
+const TypeValue &DENSEKEYBIMAP_CLASS::getValue(const TypeKey &key) const
+{
+    BIMAP_STATS_LOOKUP_BEGIN(m_stats);
+    const std::size_t index = indexOf(key);
+    BIMAP_STATS_LOOKUP_END(m_stats, isUsed(index));
+    if(!isUsed(index)){
+        throw std::out_of_range("cmap::DenseKeyBimap::getValue");
+    }
+
+    return m_values[index];
+}
+
+/*!
+ * \brief Use to retrieve key by value
+ * \details
+ * Keys are not stored (they are indexes of values), so they
+ * are returned by value.
+ *
+ * \param value
+ * Value to use to retrieve key element.
+ * \return
+ * Return key associated to value.
+ *
+ * \throw std::out_of_range
+ * Throw if value cannot be found
+ */
+DENSEKEYBIMAP_TEMPLATE
+TypeKey DENSEKEYBIMAP_CLASS::getKey(const TypeValue &value) const
+{
+    BIMAP_STATS_LOOKUP_BEGIN(m_stats);
+    const std::size_t pos = findPosValue(value, hashValue(value));
+    BIMAP_STATS_LOOKUP_END(m_stats, pos != _ContainerIndex::NoPos);
+    if(pos == _ContainerIndex::NoPos){
+        throw std::out_of_range("cmap::DenseKeyBimap::getKey");
+    }
+
+    return static_cast<TypeKey>(m_index.slotAt(pos));
+}
+
+/*!
+ * \brief Use to retrieve key by an object comparable to values
+ * \details
+ * This overload is only available when \c HashValue and \c EqualValue
+ * are transparent, so no temporary value is constructed to perform
+ * the lookup.
+ *
+ * \param value
+ * Object comparable to values.
+ * \return
+ * Return key associated to value.
+ *
+ * \throw std::out_of_range
+ * Throw if value cannot be found
+ */
+DENSEKEYBIMAP_TEMPLATE
+template<class V, class H, class E, detail::BimapEnableTransparent<H, E>>
+TypeKey DENSEKEYBIMAP_CLASS::getKey(const V &value) const
+{
+    BIMAP_STATS_LOOKUP_BEGIN(m_stats);
+    const std::size_t pos = findPosValue(value, hashValue(value));
+    BIMAP_STATS_LOOKUP_END(m_stats, pos != _ContainerIndex::NoPos);
+    if(pos == _ContainerIndex::NoPos){
+        throw std::out_of_range("cmap::DenseKeyBimap::getKey");
+    }
+
+    return static_cast<TypeKey>(m_index.slotAt(pos));
+}
+
+/*!
+ * \brief Use to search an element by key
+ * \details
+ * Unlike getValue(), this method never throw.
+ *
+ * \param key
+ * Key of element to search.
+ * \return
+ * Returns iterator to element, \c cend() if not found.
+ */
+DENSEKEYBIMAP_TEMPLATE
+typename DENSEKEYBIMAP_CLASS::const_iterator DENSEKEYBIMAP_CLASS::findByKey(const TypeKey &key) const
+{
+    const std::size_t index = indexOf(key);
+    return isUsed(index) ? iteratorAt(index) : cend();
+}
+
+/*!
+ * \brief Use to search an element by value
+ * \details
+ * Unlike getKey(), this method never throw.
+ *
+ * \param value
+ * Value of element to search.
+ * \return
+ * Returns iterator to element, \c cend() if not found.
+ */
+DENSEKEYBIMAP_TEMPLATE
+typename DENSEKEYBIMAP_CLASS::const_iterator DENSEKEYBIMAP_CLASS::findByValue(const TypeValue &value) const
+{
+    const std::size_t pos = findPosValue(value, hashValue(value));
+    return pos != _ContainerIndex::NoPos ? iteratorAt(m_index.slotAt(pos)) : cend();
+}
+
+/*!
+ * \brief Checks if container contains element with specific key
+ */
+DENSEKEYBIMAP_TEMPLATE
+bool DENSEKEYBIMAP_CLASS::containsKey(const TypeKey &key) const
+{
+    return isUsed(indexOf(key));
+}
+
+/*!
+ * \brief Checks if container contains element with specific value
+ */
+DENSEKEYBIMAP_TEMPLATE
+bool DENSEKEYBIMAP_CLASS::containsValue(const TypeValue &value) const
+{
+    return findPosValue(value, hashValue(value)) != _ContainerIndex::NoPos;
+}
+
+/*!
+ * \overload
+ * \details
+ * Only available when \c HashValue and \c EqualValue are transparent.
+ */
+DENSEKEYBIMAP_TEMPLATE
+template<class V, class H, class E, detail::BimapEnableTransparent<H, E>>
+typename DENSEKEYBIMAP_CLASS::const_iterator DENSEKEYBIMAP_CLASS::findByValue(const V &value) const
+{
+    const std::size_t pos = findPosValue(value, hashValue(value));
+    return pos != _ContainerIndex::NoPos ? iteratorAt(m_index.slotAt(pos)) : cend();
+}
+
+/*!
+ * \overload
+ * \details
+ * Only available when \c HashValue and \c EqualValue are transparent.
+ */
+DENSEKEYBIMAP_TEMPLATE
+template<class V, class H, class E, detail::BimapEnableTransparent<H, E>>
+bool DENSEKEYBIMAP_CLASS::containsValue(const V &value) const
+{
+    return findPosValue(value, hashValue(value)) != _ContainerIndex::NoPos;
+}
+
+/*!
+ * \brief Construct element in-place if neither its key nor its
+ * value already exist
+ *
+ * \param args
+ * Arguments to forward to the constructor of the element.
+ * \return
+ * Returns a pair consisting of an iterator to the inserted element (or to
+ * the element that prevented the insertion, element with same key has precedence)
+ * and a boolean set to \c true if insertion took place.
+ */
+DENSEKEYBIMAP_TEMPLATE
+template<class... Args>
+std::pair<typename DENSEKEYBIMAP_CLASS::iterator, bool> DENSEKEYBIMAP_CLASS::emplace(Args&&... args)
+{
+    value_type pair(std::forward<Args>(args)...);
+    return tryInsertPair(std::move(pair.first), std::move(pair.second));
+}
+
+/*!
+ * \brief Insert element if neither its key nor its value
+ * already exist
+ *
+ * \param key
+ * Key of element.
+ * \param value
+ * Value associated to the key.
+ * \return
+ * Returns a pair consisting of an iterator to the inserted element (or to
+ * the element that prevented the insertion, element with same key has precedence)
+ * and a boolean set to \c true if insertion took place.
+ *
+ * \throw std::out_of_range
+ * Throw if key is negative or greater than \c 2^32-2
+ */
+DENSEKEYBIMAP_TEMPLATE
+std::pair<typename DENSEKEYBIMAP_CLASS::iterator, bool> DENSEKEYBIMAP_CLASS::tryInsert(const TypeKey &key, const TypeValue &value)
+{
+    return tryInsertPair(key, value);
+}
+
+/*!
+ * \overload
+ * \details
+ * Value is moved only if insertion took place.
+ */
+DENSEKEYBIMAP_TEMPLATE
+std::pair<typename DENSEKEYBIMAP_CLASS::iterator, bool> DENSEKEYBIMAP_CLASS::tryInsert(TypeKey &&key, TypeValue &&value)
+{
+    return tryInsertPair(std::move(key), std::move(value));
+}
+
+/*!
+ * \brief Insert element, or assign value of existing key
+ * \details
+ * Like insert(), both sides are kept consistent: if \c value was
+ * associated to another key, this association is removed.
+ *
+ * \param key
+ * Key of element.
+ * \param value
+ * Value to associate to the key.
+ * \return
+ * Returns a pair consisting of an iterator to the element and a
+ * boolean set to \c true if key was inserted, \c false if assigned.
+ */
+DENSEKEYBIMAP_TEMPLATE
+std::pair<typename DENSEKEYBIMAP_CLASS::iterator, bool> DENSEKEYBIMAP_CLASS::insertOrAssign(const TypeKey &key, const TypeValue &value)
+{
+    bool inserted = false;
+    auto result = replacePair(key, value, true, true, inserted);
+    return std::make_pair(result.first, inserted);
+}
+
+/*!
+ * \overload
+ */
+DENSEKEYBIMAP_TEMPLATE
+std::pair<typename DENSEKEYBIMAP_CLASS::iterator, bool> DENSEKEYBIMAP_CLASS::insertOrAssign(TypeKey &&key, TypeValue &&value)
+{
+    bool inserted = false;
+    auto result = replacePair(std::move(key), std::move(value), true, true, inserted);
+    return std::make_pair(result.first, inserted);
+}
+
+/*!
+ * \brief Insert pair, resolving conflicts with existing
+ * elements according to \c policy
+ *
+ * \param key
+ * Key of element.
+ * \param value
+ * Value to associate to the key.
+ * \param policy
+ * Policy to apply when \c key or \c value already exist.
+ * \return
+ * Returns a pair consisting of an iterator to the element (or to the
+ * element which caused the rejection) and a boolean set to \c true
+ * if bimap now contains the pair.
+ *
+ * \sa insert(), insertOrAssign(), tryInsert()
+ */
+DENSEKEYBIMAP_TEMPLATE
+std::pair<typename DENSEKEYBIMAP_CLASS::iterator, bool> DENSEKEYBIMAP_CLASS::replace(const TypeKey &key, const TypeValue &value, ReplacePolicy policy)
+{
+    bool inserted = false;
+    return replacePair(key, value, policy == ReplacePolicy::OverwriteLeft, policy == ReplacePolicy::OverwriteRight, inserted);
+}
+
+/*!
+ * \overload
+ * \details
+ * Value is moved only if it is used.
+ */
+DENSEKEYBIMAP_TEMPLATE
+std::pair<typename DENSEKEYBIMAP_CLASS::iterator, bool> DENSEKEYBIMAP_CLASS::replace(TypeKey &&key, TypeValue &&value, ReplacePolicy policy)
+{
+    bool inserted = false;
+    return replacePair(std::move(key), std::move(value), policy == ReplacePolicy::OverwriteLeft, policy == ReplacePolicy::OverwriteRight, inserted);
+}
+
+/*!
+ * \brief Returns number of slots of index of values
+ *
+ * \return
+ * Number of slots, up to 7/8 of them can be used before table grows.
+ */
+DENSEKEYBIMAP_TEMPLATE
+std::size_t DENSEKEYBIMAP_CLASS::capacity() const
+{
+    return m_index.capacity();
+}
+
+/*!
+ * \brief Returns size of array of keys: one more than the highest
+ * key stored since last clear() or shrinkToFit()
+ */
+DENSEKEYBIMAP_TEMPLATE
+std::size_t DENSEKEYBIMAP_CLASS::keyRange() const
+{
+    return m_values.size();
+}
+
+/*!
+ * \brief Reserve index of values for at least \c count elements
+ */
+DENSEKEYBIMAP_TEMPLATE
+void DENSEKEYBIMAP_CLASS::reserve(std::size_t count)
+{
+    const std::size_t required = _ContainerIndex::capacityFor(count);
+    if(required > capacity()){
+        rebuildIndex(required);
+    }
+}
+
+/*!
+ * \brief Reserve array of keys for keys from \c 0 to \c count - 1
+ * \details
+ * Avoid reallocations of array while inserting keys of a known range.
+ */
+DENSEKEYBIMAP_TEMPLATE
+void DENSEKEYBIMAP_CLASS::reserveKeys(std::size_t count)
+{
+    m_values.reserve(count);
+    m_occupied.reserve((count + 31) / 32);
+}
+
+/*!
+ * \brief Release unused memory
+ * \details
+ * Array of keys is truncated after the highest used key, and index
+ * of values is rebuilt with the smallest capacity holding all
+ * elements.
+ */
+DENSEKEYBIMAP_TEMPLATE
+void DENSEKEYBIMAP_CLASS::shrinkToFit()
+{
+    std::size_t range = m_values.size();
+    while(range > 0 && !isUsed(range - 1)){
+        --range;
+    }
+
+    m_values.resize(range);
+    m_values.shrink_to_fit();
+    m_occupied.resize((range + 31) / 32);
+    m_occupied.shrink_to_fit();
+
+    rebuildIndex(m_size > 0 ? _ContainerIndex::capacityFor(m_size) : 0);
+}
+
+/*!
+ * \brief Returns the function used to hash values
+ */
+DENSEKEYBIMAP_TEMPLATE
+HashValue DENSEKEYBIMAP_CLASS::hashFunctionValue() const
+{
+    return m_hashValue;
+}
+
+/*!
+ * \brief Returns memory owned by bimap
+ * \details
+ * Array of values is the payload, bitmap of used keys is the index of
+ * keys and index of values is the hash table (a metadata byte and a
+ * 32-bits key per slot). Unused slots of array (including holes
+ * between keys) and free slots of hash table are reported in \c unused.
+ */
+DENSEKEYBIMAP_TEMPLATE
+BimapMemoryUsage DENSEKEYBIMAP_CLASS::memoryUsage() const
+{
+    constexpr std::size_t slotSize = sizeof(std::int8_t) + sizeof(_TypeSlot);
+    const std::size_t nbArrays = (m_values.capacity() > 0) + (m_occupied.capacity() > 0) + 2 * (m_index.capacity() > 0);
+
+    BimapMemoryUsage usage;
+    usage.indexKey = m_occupied.size() * sizeof(std::uint32_t);
+    usage.indexValue = m_index.size() * slotSize;
+    usage.payload = m_size * sizeof(TypeValue);
+    usage.overhead = nbArrays * BimapAllocationOverhead;
+    usage.unused = (m_values.capacity() - m_size) * sizeof(TypeValue)
+                 + (m_occupied.capacity() - m_occupied.size()) * sizeof(std::uint32_t)
+                 + (m_index.capacity() - m_index.size()) * slotSize;
+
+    return usage;
+}
+
+#if defined(BIMAP_ENABLE_STATS)
+/*!
+ * \brief Returns statistics of lookups and updates of bimap
+ * \details
+ * Only available when \c BIMAP_ENABLE_STATS is defined.
+ *
+ * \sa bimapstats.h
+ */
+DENSEKEYBIMAP_TEMPLATE
+BimapStats& DENSEKEYBIMAP_CLASS::stats() const
+{
+    return m_stats;
+}
+#endif
+
+/*!
+ * \brief Use to insert item by pair format
+ * \details
+ * Used by \c std::initializer_list constructor.
+ */
+DENSEKEYBIMAP_TEMPLATE
+void DENSEKEYBIMAP_CLASS::insert(_TypeNode &&node)
+{
+    insert(std::move(node.first), std::move(node.second));
+}
+
+/*!
+ * \overload
+ */
+DENSEKEYBIMAP_TEMPLATE
+void DENSEKEYBIMAP_CLASS::insert(const _TypeNode &node)
+{
+    insert(node.first, node.second);
+}
+
+/*!
+ * \brief Insert pair built from \c key and \c value if
+ * they do not conflict with existing elements
+ */
+DENSEKEYBIMAP_TEMPLATE
+template<class K, class V>
+std::pair<typename DENSEKEYBIMAP_CLASS::iterator, bool> DENSEKEYBIMAP_CLASS::tryInsertPair(K &&key, V &&value)
+{
+    const std::size_t index = checkedIndexOf(key);
+    if(isUsed(index)){
+        return std::make_pair(iteratorAt(index), false);
+    }
+
+    const std::size_t hv = hashValue(value);
+    const std::size_t pos = findPosValue(value, hv);
+    if(pos != _ContainerIndex::NoPos){
+        return std::make_pair(iteratorAt(m_index.slotAt(pos)), false);
+    }
+
+    prepareInsert();
+
+    assignAt(index, std::forward<V>(value));
+    m_index.insert(hv, static_cast<_TypeSlot>(index));
+    BIMAP_STATS_RECORD(m_stats, Insert);
+
+    return std::make_pair(iteratorAt(index), true);
+}
+
+/*!
+ * \brief Insert pair built from \c key and \c value, overwriting
+ * conflicting sides when allowed
+ * \details
+ * Slot of key is assigned in place. A pair which owned \c value
+ * under another key is erased.
+ *
+ * \param overwriteLeft
+ * Allow to replace the key associated to \c value.
+ * \param overwriteRight
+ * Allow to replace the value associated to \c key.
+ * \param inserted
+ * Set to \c true if a new key has been inserted.
+ */
+DENSEKEYBIMAP_TEMPLATE
+template<class K, class V>
+std::pair<typename DENSEKEYBIMAP_CLASS::iterator, bool> DENSEKEYBIMAP_CLASS::replacePair(K &&key, V &&value, bool overwriteLeft, bool overwriteRight, bool &inserted)
+{
+    inserted = false;
+    const std::size_t index = checkedIndexOf(key);
+
+    /* Done first: index table is rebuilt if it is full, invalidating positions */
+    prepareInsert();
+
+    const std::size_t hv = hashValue(value);
+    const std::size_t posValue = findPosValue(value, hv);
+
+    const bool hasKey = isUsed(index);
+    const bool hasValue = posValue != _ContainerIndex::NoPos;
+    const std::size_t indexValue = hasValue ? m_index.slotAt(posValue) : 0;
+
+    /* Apply policy */
+    if(hasKey && hasValue && index == indexValue){
+        return std::make_pair(iteratorAt(index), true);
+    }
+    if(hasKey && !overwriteRight){
+        return std::make_pair(iteratorAt(index), false);
+    }
+    if(hasValue && !overwriteLeft){
+        return std::make_pair(iteratorAt(indexValue), false);
+    }
+
+    /* Remove pair which owned value, then reference value from slot of key */
+    if(hasValue){
+        eraseAt(indexValue, posValue);
+    }
+
+    if(hasKey){
+        const std::size_t posOld = m_index.findIndex(hashValue(m_values[index]), static_cast<_TypeSlot>(index));
+        eraseAt(index, posOld);
+    }
+    inserted = !hasKey;
+
+    assignAt(index, std::forward<V>(value));
+    m_index.insert(hv, static_cast<_TypeSlot>(index));
+
+    if(hasKey || hasValue){
+        BIMAP_STATS_RECORD(m_stats, Overwrite);
+    }else{
+        BIMAP_STATS_RECORD(m_stats, Insert);
+    }
+
+    return std::make_pair(iteratorAt(index), true);
+}
+
+/*!
+ * \brief Returns index of slot of \c key
+ * \return
+ * Index of slot, \c NoIndex if key cannot be stored (negative or
+ * too large).
+ */
+DENSEKEYBIMAP_TEMPLATE
+std::size_t DENSEKEYBIMAP_CLASS::indexOf(const TypeKey &key)
+{
+    const std::uint64_t index = detail::bimapDenseIndex(static_cast<_TypeInteger>(key), std::is_signed<_TypeInteger>());
+    return index < NoIndex ? static_cast<std::size_t>(index) : NoIndex;
+}
+
+/*!
+ * \brief Returns index of slot of \c key
+ *
+ * \throw std::out_of_range
+ * Throw if key cannot be stored.
+ */
+DENSEKEYBIMAP_TEMPLATE
+std::size_t DENSEKEYBIMAP_CLASS::checkedIndexOf(const TypeKey &key)
+{
+    const std::size_t index = indexOf(key);
+    if(index == NoIndex){
+        throw std::out_of_range("cmap::DenseKeyBimap::insert");
+    }
+    return index;
+}
+
+/*!
+ * \brief Returns \c true if slot \c index holds an element
+ */
+DENSEKEYBIMAP_TEMPLATE
+bool DENSEKEYBIMAP_CLASS::isUsed(std::size_t index) const
+{
+    return index < m_values.size() && ((m_occupied[index / 32] >> (index % 32)) & 1u) != 0;
+}
+
+DENSEKEYBIMAP_TEMPLATE
+typename DENSEKEYBIMAP_CLASS::iterator DENSEKEYBIMAP_CLASS::iteratorAt(std::size_t index) const
+{
+    return iterator(m_values.data(), m_occupied.data(), index, m_values.size());
+}
+
+DENSEKEYBIMAP_TEMPLATE
+template<class V>
+std::size_t DENSEKEYBIMAP_CLASS::hashValue(const V &value) const
+{
+    return detail::bimapHashMix(m_hashValue(value));
+}
+
+DENSEKEYBIMAP_TEMPLATE
+template<class V>
+std::size_t DENSEKEYBIMAP_CLASS::findPosValue(const V &value, std::size_t hash) const
+{
+    return m_index.find(hash, [this, &value](_TypeSlot index){
+        return m_equalValue(m_values[index], value);
+    });
+}
+
+/*!
+ * \brief Store \c value in slot \c index, which must be unused
+ * \details
+ * Array and bitmap are extended when \c index is beyond them.
+ */
+DENSEKEYBIMAP_TEMPLATE
+template<class V>
+void DENSEKEYBIMAP_CLASS::assignAt(std::size_t index, V &&value)
+{
+    if(index >= m_values.size()){
+        m_occupied.resize(index / 32 + 1, 0);
+        m_values.resize(index + 1);
+    }
+
+    m_values[index] = std::forward<V>(value);
+    m_occupied[index / 32] |= std::uint32_t(1) << (index % 32);
+    ++m_size;
+}
+
+/*!
+ * \brief Erase element stored in slot \c index
+ * \details
+ * \c posValue is the position of slot referencing element into
+ * index of values.
+ */
+DENSEKEYBIMAP_TEMPLATE
+void DENSEKEYBIMAP_CLASS::eraseAt(std::size_t index, std::size_t posValue)
+{
+    m_index.eraseAt(posValue);
+    m_occupied[index / 32] &= ~(std::uint32_t(1) << (index % 32));
+    --m_size;
+
+    m_values[index] = TypeValue();
+}
+
+/*!
+ * \brief Make sure one more element can be referenced by index of values
+ *
+ * \throw std::length_error
+ * Throw if container is full
+ */
+DENSEKEYBIMAP_TEMPLATE
+void DENSEKEYBIMAP_CLASS::prepareInsert()
+{
+    if(size() >= maxSize()){
+        throw std::length_error("cmap::DenseKeyBimap::insert");
+    }
+
+    if(m_index.growthLeft() > 0){
+        return;
+    }
+
+    /* Grow table, or only purge deleted slots if they are sparse enough */
+    const std::size_t required = _ContainerIndex::capacityFor(size() + 1);
+    rebuildIndex(required > capacity() / 2 ? std::max(required, 2 * capacity()) : capacity());
+}
+
+/*!
+ * \brief Rebuild index of values with \c capacity slots
+ */
+DENSEKEYBIMAP_TEMPLATE
+void DENSEKEYBIMAP_CLASS::rebuildIndex(std::size_t capacity)
+{
+    _ContainerIndex index;
+    if(capacity > 0){
+        index.reset(capacity);
+    }
+
+    for(auto it = cbegin(); it != cend(); ++it){
+        const std::size_t key = indexOf(it->first);
+        index.insert(hashValue(m_values[key]), static_cast<_TypeSlot>(key));
+    }
+
+    m_index.swap(index);
+}
+
+/*!
+ * \brief Returns an iterator to the beginning
+ *
+ * \return
+ * Iterator to the element with the smallest key. \n
+ * If the map is empty, the returned iterator will be equal to \c end().
+ */
+DENSEKEYBIMAP_TEMPLATE
+typename DENSEKEYBIMAP_CLASS::iterator DENSEKEYBIMAP_CLASS::begin()
+{
+    return cbegin();
+}
+
+/*!
+ * \brief Returns a constant iterator to the beginning
+ *
+ * \return
+ * Iterator to the element with the smallest key. \n
+ * If the map is empty, the returned iterator will be equal to \c cend().
+ */
+DENSEKEYBIMAP_TEMPLATE
+typename DENSEKEYBIMAP_CLASS::const_iterator DENSEKEYBIMAP_CLASS::cbegin() const
+{
+    return iteratorAt(0);
+}
+
+/*!
+ * \brief Returns an iterator to the end
+ *
+ * \return
+ * Iterator to the element following the last element.
+ */
+DENSEKEYBIMAP_TEMPLATE
+typename DENSEKEYBIMAP_CLASS::iterator DENSEKEYBIMAP_CLASS::end()
+{
+    return cend();
+}
+
+/*!
+ * \brief Returns a constant iterator to the end
+ *
+ * \return
+ * Iterator to the element following the last element.
+ */
+DENSEKEYBIMAP_TEMPLATE
+typename DENSEKEYBIMAP_CLASS::const_iterator DENSEKEYBIMAP_CLASS::cend() const
+{
+    return iteratorAt(m_values.size());
+}
+
+#undef DENSEKEYBIMAP_TEMPLATE
+#undef DENSEKEYBIMAP_CLASS
+
+} // Namespace cmap
+
+#endif // LCH_DENSEKEYBIMAP_H
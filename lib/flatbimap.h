@@ -0,0 +1,2123 @@
+#ifndef LCH_FLATBIMAP_H
+#define LCH_FLATBIMAP_H
+
+/*****************************/
+/* Class documentations      */
+/*****************************/
+
+/*!
+   \class cmap::BasicFlatBimap
+   \brief Class use to provide flat bi-directional map support.
+
+   This class provide the same interface than cmap::Bimap but all pairs are
+   stored in a single contiguous array. Both directions are indexed by an
+   open-addressing hash table which only store indexes into that array
+   (plus one metadata byte per slot), so lookups have an average complexity of
+   <b>O(1)</b> and typically touch one or two cache lines.
+
+   \note
+   Layout of index tables is selected at compile time by policies, without
+   any runtime dispatch: \c StoragePolicy (copies of small elements held
+   inline in slots, see cmap::FlatBimapStoragePolicy), \c IndexPolicy
+   (width of indexes, see cmap::FlatBimapIndexPolicy) and \c AllocPolicy
+   (alignment of tables, see cmap::FlatBimapAllocPolicy). \n
+   \c cmap::FlatBimap is an alias using defaults deduced from types of
+   keys and values.
+
+   \note
+   Metadata bytes are organised in groups of \c 16 slots: each byte hold
+   either a special marker (empty or deleted slot) or the 7 lowest bits of
+   element hash, so most mismatches are rejected without reading the pair. \n
+   Erasing an element move the last pair into its place: erase is <b>O(1)</b>
+   but invalidate iterators, pointers and references to the last element.
+
+   \note
+   Number of elements is limited by type of indexes (\c 2^32-1 by default).
+
+   \sa cmap::Bimap, cmap::UnorderedBimap
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "bimapcommon.h"
+#include "bimapstats.h"
+
+namespace cmap{
+
+/*****************************/
+/* Internal implementation   */
+/*****************************/
+
+namespace detail{
+
+/*!
+ * \brief Match control bytes of a group of 16 slots
+ * \details
+ * Each method returns a mask where bit \c i is set when
+ * slot \c i of group matches. \n
+ * Group is compared at once with SSE2 or NEON instructions
+ * when available (see \c BIMAP_HAS_SSE2 and \c BIMAP_HAS_NEON),
+ * one byte at a time otherwise.
+ */
+struct FlatBimapGroup
+{
+    /*!
+     * \brief Slots whose control byte is equal to \c h2
+     */
+    static std::uint32_t match(const std::int8_t *ctrl, std::int8_t h2)
+    {
+#if BIMAP_HAS_SSE2
+        const __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(h2))));
+#elif BIMAP_HAS_NEON
+        return movemask(vceqq_s8(vld1q_s8(ctrl), vdupq_n_s8(h2)));
+#else
+        std::uint32_t mask = 0;
+        for(unsigned i = 0; i < 16; ++i){
+            mask |= static_cast<std::uint32_t>(ctrl[i] == h2) << i;
+        }
+        return mask;
+#endif
+    }
+
+    /*!
+     * \brief Slots which are empty or deleted (control byte is negative)
+     */
+    static std::uint32_t matchFree(const std::int8_t *ctrl)
+    {
+#if BIMAP_HAS_SSE2
+        return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))));
+#elif BIMAP_HAS_NEON
+        return movemask(vcltzq_s8(vld1q_s8(ctrl)));
+#else
+        std::uint32_t mask = 0;
+        for(unsigned i = 0; i < 16; ++i){
+            mask |= static_cast<std::uint32_t>(ctrl[i] < 0) << i;
+        }
+        return mask;
+#endif
+    }
+
+#if BIMAP_HAS_NEON
+private:
+    static std::uint32_t movemask(uint8x16_t bytes)
+    {
+        static const std::uint8_t weights[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+
+        const uint8x16_t bits = vandq_u8(bytes, vld1q_u8(weights));
+        return static_cast<std::uint32_t>(vaddv_u8(vget_low_u8(bits))) | (static_cast<std::uint32_t>(vaddv_u8(vget_high_u8(bits))) << 8);
+    }
+#endif
+};
+
+/*!
+ * \brief Allocator aligning arrays on \c Alignment bytes
+ * \details
+ * Alignments not greater than the one of \c std::max_align_t are already
+ * provided by \c operator \c new. Larger ones are obtained by allocating
+ * \c Alignment more bytes, address returned by \c operator \c new is
+ * stored just before aligned array.
+ */
+template<class T, std::size_t Alignment>
+class FlatBimapAlignedAllocator
+{
+    static constexpr bool OverAligned = Alignment > alignof(std::max_align_t);
+
+public:
+    using value_type = T;
+
+    template<class U>
+    struct rebind
+    {
+        using other = FlatBimapAlignedAllocator<U, Alignment>;
+    };
+
+public:
+    FlatBimapAlignedAllocator() noexcept {}
+    template<class U>
+    FlatBimapAlignedAllocator(const FlatBimapAlignedAllocator<U, Alignment>&) noexcept {}
+
+public:
+    T* allocate(std::size_t n)
+    {
+        if(!OverAligned){
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+        }
+        if(n > (std::numeric_limits<std::size_t>::max() - Alignment) / sizeof(T)){
+            throw std::bad_alloc();
+        }
+
+        char *raw = static_cast<char*>(::operator new(n * sizeof(T) + Alignment));
+        char *aligned = raw + (Alignment - reinterpret_cast<std::uintptr_t>(raw) % Alignment);
+        reinterpret_cast<void**>(aligned)[-1] = raw;
+
+        return reinterpret_cast<T*>(aligned);
+    }
+
+    void deallocate(T *ptr, std::size_t)
+    {
+        ::operator delete(OverAligned ? reinterpret_cast<void**>(ptr)[-1] : ptr);
+    }
+
+    friend bool operator==(const FlatBimapAlignedAllocator&, const FlatBimapAlignedAllocator&) noexcept { return true; }
+    friend bool operator!=(const FlatBimapAlignedAllocator&, const FlatBimapAlignedAllocator&) noexcept { return false; }
+};
+
+/*!
+ * \brief Check if elements of type \c T are stored inline by default
+ * (see cmap::FlatBimapDefaultStorage)
+ */
+template<class T>
+struct FlatBimapInlinable : std::integral_constant<bool, std::is_trivially_copyable<T>::value && std::is_default_constructible<T>::value && sizeof(T) <= sizeof(std::uint32_t)>
+{
+};
+
+/*!
+ * \brief Slot of an index table of cmap::BasicFlatBimap
+ * \details
+ * Slot holds index of a pair, and a copy of its element when
+ * \c Inline is \c true. item() returns element to compare: either
+ * the copy, or \c stored (element read from pairs array).
+ */
+template<class TypeIndex, class T, bool Inline>
+struct FlatBimapSlot
+{
+    FlatBimapSlot() : index(0) {}
+    FlatBimapSlot(TypeIndex i, const T&) : index(i) {}
+
+    const T& item(const T &stored) const { return stored; }
+
+    TypeIndex index;
+};
+
+template<class TypeIndex, class T>
+struct FlatBimapSlot<TypeIndex, T, true>
+{
+    FlatBimapSlot() : index(0), copy() {}
+    FlatBimapSlot(TypeIndex i, const T &item) : index(i), copy(item) {}
+
+    /* Stored element is never read, only the reference is formed */
+    const T& item(const T&) const { return copy; }
+
+    TypeIndex index;
+    T copy;
+};
+
+/*!
+ * \brief Access index held by a slot: slots are either plain
+ * indexes or cmap::detail::FlatBimapSlot
+ */
+template<class TypeSlot>
+struct FlatBimapSlotTraits
+{
+    using TypeIndex = TypeSlot;
+
+    static TypeIndex index(const TypeSlot &slot) { return slot; }
+    static void setIndex(TypeSlot &slot, TypeIndex index) { slot = index; }
+};
+
+template<class I, class T, bool Inline>
+struct FlatBimapSlotTraits<FlatBimapSlot<I, T, Inline>>
+{
+    using TypeIndex = I;
+
+    static TypeIndex index(const FlatBimapSlot<I, T, Inline> &slot) { return slot.index; }
+    static void setIndex(FlatBimapSlot<I, T, Inline> &slot, TypeIndex index) { slot.index = index; }
+};
+
+/*!
+ * \brief Open-addressing table of indexes
+ * \details
+ * Table doesn't store elements: each slot only hold an index into
+ * an external array, callers provide a predicate to compare elements
+ * referenced by those indexes. \n
+ * Slots are probed by groups of \c FlatBimapIndex::GroupWidth, probing
+ * stop on first group containing an empty slot. \n
+ * Arrays of control bytes and slots are aligned on \c Alignment bytes
+ * (\c 0 to use default alignment).
+ */
+template<class Slot, std::size_t Alignment = 0>
+class FlatBimapIndex
+{
+    using _Traits = FlatBimapSlotTraits<Slot>;
+
+public:
+    using TypeSlot = Slot;
+    using TypeIndex = typename _Traits::TypeIndex;
+
+    static constexpr std::size_t GroupWidth = 16;
+    static constexpr std::size_t NoPos = std::numeric_limits<std::size_t>::max();
+
+    static constexpr std::int8_t CtrlEmpty = -128;
+    static constexpr std::int8_t CtrlDeleted = -2;
+
+public:
+    FlatBimapIndex() : m_size(0), m_growthLeft(0) {}
+
+public:
+    std::size_t capacity() const { return m_ctrl.size(); }
+    std::size_t size() const { return m_size; }
+    std::size_t growthLeft() const { return m_growthLeft; }
+
+    static std::size_t capacityFor(std::size_t count)
+    {
+        std::size_t capacity = GroupWidth;
+        while(capacity - capacity / 8 < count){
+            capacity <<= 1;
+        }
+        return capacity;
+    }
+
+    /*!
+     * \brief Reset table to \c capacity empty slots
+     * \details
+     * \c capacity must be a power of two and multiple of \c GroupWidth
+     */
+    void reset(std::size_t capacity)
+    {
+        m_ctrl.assign(capacity, CtrlEmpty);
+        m_slots.assign(capacity, TypeSlot());
+        m_size = 0;
+        m_growthLeft = capacity - capacity / 8;
+    }
+
+    void clear()
+    {
+        reset(capacity());
+    }
+
+    /*!
+     * \brief Search slot referencing an element equal to the searched one
+     * \param hash
+     * Mixed hash of searched element.
+     * \param eq
+     * Predicate called with an index, returns \c true if referenced
+     * element is equal to the searched one.
+     * \return
+     * Returns position of slot, \c NoPos if not found.
+     */
+    template<class Pred>
+    std::size_t find(std::size_t hash, Pred eq) const
+    {
+        if(m_size == 0){
+            return NoPos;
+        }
+
+        const std::int8_t h2 = ctrlHash(hash);
+        const std::size_t mask = groupMask();
+        std::size_t group = groupStart(hash);
+
+        for(std::size_t probe = 1; ; ++probe){
+            const std::size_t base = group * GroupWidth;
+            const std::int8_t *ctrl = &m_ctrl[base];
+
+            for(std::uint32_t matches = FlatBimapGroup::match(ctrl, h2); matches != 0; matches &= matches - 1){
+                const std::size_t pos = base + bimapLowestBit(matches);
+                if(eq(m_slots[pos])){
+                    return pos;
+                }
+            }
+
+            if(FlatBimapGroup::match(ctrl, CtrlEmpty) != 0 || probe > mask){
+                return NoPos;
+            }
+            group = (group + probe) & mask;
+        }
+    }
+
+    /*!
+     * \brief Prefetch first group probed for \c hash
+     */
+    void prefetch(std::size_t hash) const
+    {
+        if(m_size != 0){
+            const std::size_t base = groupStart(hash) * GroupWidth;
+            bimapPrefetch(&m_ctrl[base]);
+            bimapPrefetch(&m_slots[base]);
+        }
+    }
+
+    /*!
+     * \brief Returns index referenced by first slot of first
+     * probed group matching \c hash, \c NoPos if none
+     * \details
+     * Used to prefetch the most likely element before searching.
+     */
+    std::size_t candidate(std::size_t hash) const
+    {
+        if(m_size == 0){
+            return NoPos;
+        }
+
+        const std::int8_t h2 = ctrlHash(hash);
+        const std::size_t base = groupStart(hash) * GroupWidth;
+        const std::uint32_t matches = FlatBimapGroup::match(&m_ctrl[base], h2);
+        return matches != 0 ? _Traits::index(m_slots[base + bimapLowestBit(matches)]) : NoPos;
+    }
+
+    /*!
+     * \brief Returns number of groups probed to find slot referencing \c index
+     * \details
+     * \c index must be referenced by table.
+     */
+    std::size_t probeLength(std::size_t hash, TypeIndex index) const
+    {
+        const std::size_t pos = findIndex(hash, index);
+        const std::size_t mask = groupMask();
+        std::size_t group = groupStart(hash);
+
+        std::size_t probe = 1;
+        while(group != pos / GroupWidth){
+            group = (group + probe) & mask;
+            ++probe;
+        }
+        return probe;
+    }
+
+    /*!
+     * \brief Search slot referencing \c index
+     * \return
+     * Returns position of slot, \c NoPos if not found.
+     */
+    std::size_t findIndex(std::size_t hash, TypeIndex index) const
+    {
+        return find(hash, [index](const TypeSlot &slot){ return _Traits::index(slot) == index; });
+    }
+
+    /*!
+     * \brief Reference \c index in table
+     * \details
+     * Table must have some growth left and element must not already
+     * be referenced.
+     */
+    void insert(std::size_t hash, const TypeSlot &slot)
+    {
+        const std::size_t mask = groupMask();
+        std::size_t group = groupStart(hash);
+
+        for(std::size_t probe = 1; ; ++probe){
+            const std::size_t base = group * GroupWidth;
+
+            const std::uint32_t frees = FlatBimapGroup::matchFree(&m_ctrl[base]);
+            if(frees != 0){
+                const std::size_t pos = base + bimapLowestBit(frees);
+                if(m_ctrl[pos] == CtrlEmpty){
+                    --m_growthLeft;
+                }
+                m_ctrl[pos] = ctrlHash(hash);
+                m_slots[pos] = slot;
+                ++m_size;
+                return;
+            }
+            group = (group + probe) & mask;
+        }
+    }
+
+    /*!
+     * \brief Release slot at \c pos
+     * \details
+     * If the group of slot still has an empty slot, no probe sequence
+     * ever continued past it, so slot can be marked \em empty instead
+     * of \em deleted.
+     */
+    void eraseAt(std::size_t pos)
+    {
+        const std::size_t base = pos - pos % GroupWidth;
+        if(FlatBimapGroup::match(&m_ctrl[base], CtrlEmpty) != 0){
+            m_ctrl[pos] = CtrlEmpty;
+            ++m_growthLeft;
+        }else{
+            m_ctrl[pos] = CtrlDeleted;
+        }
+        --m_size;
+    }
+
+    const TypeSlot& slotAt(std::size_t pos) const
+    {
+        return m_slots[pos];
+    }
+
+    void setIndexAt(std::size_t pos, TypeIndex index)
+    {
+        _Traits::setIndex(m_slots[pos], index);
+    }
+
+    void swap(FlatBimapIndex &other)
+    {
+        m_ctrl.swap(other.m_ctrl);
+        m_slots.swap(other.m_slots);
+        std::swap(m_size, other.m_size);
+        std::swap(m_growthLeft, other.m_growthLeft);
+    }
+
+private:
+    static std::int8_t ctrlHash(std::size_t hash) { return static_cast<std::int8_t>(hash & 0x7F); }
+
+    std::size_t groupMask() const { return capacity() / GroupWidth - 1; }
+    std::size_t groupStart(std::size_t hash) const { return (hash >> 7) & groupMask(); }
+
+private:
+    std::vector<std::int8_t, FlatBimapAlignedAllocator<std::int8_t, Alignment>> m_ctrl;
+    std::vector<TypeSlot, FlatBimapAlignedAllocator<TypeSlot, Alignment>> m_slots;
+    std::size_t m_size;
+    std::size_t m_growthLeft;
+};
+
+template<class Slot, std::size_t Alignment> constexpr std::size_t FlatBimapIndex<Slot, Alignment>::GroupWidth;
+template<class Slot, std::size_t Alignment> constexpr std::size_t FlatBimapIndex<Slot, Alignment>::NoPos;
+template<class Slot, std::size_t Alignment> constexpr std::int8_t FlatBimapIndex<Slot, Alignment>::CtrlEmpty;
+template<class Slot, std::size_t Alignment> constexpr std::int8_t FlatBimapIndex<Slot, Alignment>::CtrlDeleted;
+
+} // Namespace detail
+
+/*****************************/
+/* Layout policies           */
+/*****************************/
+
+/*!
+ * \brief Storage policy of cmap::BasicFlatBimap
+ * \details
+ * When \c InlineKeys (or \c InlineValues) is \c true, each slot of the
+ * index table of keys (or values) also holds a copy of its element:
+ * probing compares that copy instead of reading pairs array. Type of
+ * inline elements must be trivially copyable and default constructible.
+ */
+template<bool InlineKeys, bool InlineValues>
+struct FlatBimapStoragePolicy
+{
+    static constexpr bool InlineKey = InlineKeys;
+    static constexpr bool InlineValue = InlineValues;
+};
+
+/*!
+ * \brief Default storage policy of cmap::BasicFlatBimap
+ * \details
+ * Trivially copyable elements no larger than a 32-bits index are stored
+ * inline, so slots are at most twice larger.
+ */
+template<class TypeKey, class TypeValue>
+using FlatBimapDefaultStorage = FlatBimapStoragePolicy<detail::FlatBimapInlinable<TypeKey>::value, detail::FlatBimapInlinable<TypeValue>::value>;
+
+/*!
+ * \brief Index policy of cmap::BasicFlatBimap
+ * \details
+ * \c TypeIndex is the unsigned type of indexes held by slots, it limits
+ * maxSize(): 32-bits indexes halve size of slots compared to 64-bits ones,
+ * but limit number of elements to \c 2^32-1.
+ */
+template<class TypeIndex>
+struct FlatBimapIndexPolicy
+{
+    static_assert(std::is_unsigned<TypeIndex>::value, "cmap::FlatBimapIndexPolicy: index must be an unsigned integer type");
+
+    using Index = TypeIndex;
+};
+
+/*!
+ * \brief Allocation policy of cmap::BasicFlatBimap
+ * \details
+ * Arrays of index tables are aligned on \c Alignment bytes. With default
+ * alignment of \c 64 bytes (a cache line on most hosts), each group of
+ * 16 slots starts on a cache line, so it spans <tt>16 * sizeof(slot) / 64</tt>
+ * lines and never one more: a group of 4-bytes slots (32-bits indexes only)
+ * fills one line, a group of 8-bytes slots (32-bits indexes with an inline
+ * copy of a 4-bytes element, default for \c int pairs) fills two.
+ */
+template<std::size_t Alignment>
+struct FlatBimapAllocPolicy
+{
+    static_assert(Alignment != 0 && (Alignment & (Alignment - 1)) == 0, "cmap::FlatBimapAllocPolicy: alignment must be a power of two");
+
+    static constexpr std::size_t Align = Alignment;
+};
+
+/*****************************/
+/* Class definitions         */
+/*****************************/
+
+template<class TypeKey, class TypeValue,
+         class StoragePolicy = FlatBimapDefaultStorage<TypeKey, TypeValue>,
+         class IndexPolicy = FlatBimapIndexPolicy<std::uint32_t>,
+         class AllocPolicy = FlatBimapAllocPolicy<64>,
+         class HashKey = std::hash<TypeKey>, class EqualKey = std::equal_to<TypeKey>,
+         class HashValue = std::hash<TypeValue>, class EqualValue = std::equal_to<TypeValue>>
+class BasicFlatBimap
+{
+public:
+    using key_type = TypeKey;
+    using mapped_type = TypeValue;
+    using value_type = std::pair<TypeKey, TypeValue>;
+    using size_type = std::size_t;
+
+    using hasher_key = HashKey;
+    using key_equal = EqualKey;
+    using hasher_value = HashValue;
+    using value_equal = EqualValue;
+
+    using storage_policy = StoragePolicy;
+    using index_policy = IndexPolicy;
+    using alloc_policy = AllocPolicy;
+
+private:
+    using _TypeNode = std::pair<TypeKey, TypeValue>; // Used to implement std::initializer_list<T> support
+
+    using _TypeIndex = typename IndexPolicy::Index;
+    using _SlotKey = detail::FlatBimapSlot<_TypeIndex, TypeKey, StoragePolicy::InlineKey>;
+    using _SlotValue = detail::FlatBimapSlot<_TypeIndex, TypeValue, StoragePolicy::InlineValue>;
+
+    using _ContainerData = std::vector<value_type>;
+    using _ContainerIndexKey = detail::FlatBimapIndex<_SlotKey, AllocPolicy::Align>;
+    using _ContainerIndexValue = detail::FlatBimapIndex<_SlotValue, AllocPolicy::Align>;
+
+public:
+    using iterator = typename _ContainerData::const_iterator;
+    using const_iterator = iterator;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+public:
+    BasicFlatBimap();
+    explicit BasicFlatBimap(std::size_t count,
+                            const HashKey &hashKey = HashKey(), const EqualKey &equalKey = EqualKey(),
+                            const HashValue &hashValue = HashValue(), const EqualValue &equalValue = EqualValue());
+    BasicFlatBimap(const std::initializer_list<_TypeNode> &args);
+
+public:
+    bool empty() const;
+    std::size_t size() const;
+    std::size_t maxSize() const;
+
+    void clear();
+    void insert(const TypeKey &key, const TypeValue &value);
+    void insert(TypeKey &&key, TypeValue &&value);
+    void erase(const TypeKey &key);
+    void swap(BasicFlatBimap &other);
+
+    template<class InputIt, class Executor>
+    void assign(InputIt first, InputIt last, Executor &executor);
+
+    const TypeValue& getValue(const TypeKey &key) const;
+    const TypeKey& getKey(const TypeValue &value) const;
+
+    template<class K, class H = HashKey, class E = EqualKey, detail::BimapEnableTransparent<H, E> = 0>
+    const TypeValue& getValue(const K &key) const;
+    template<class V, class H = HashValue, class E = EqualValue, detail::BimapEnableTransparent<H, E> = 0>
+    const TypeKey& getKey(const V &value) const;
+
+    const_iterator findByKey(const TypeKey &key) const;
+    const_iterator findByValue(const TypeValue &value) const;
+    bool containsKey(const TypeKey &key) const;
+    bool containsValue(const TypeValue &value) const;
+
+    template<class K, class H = HashKey, class E = EqualKey, detail::BimapEnableTransparent<H, E> = 0>
+    const_iterator findByKey(const K &key) const;
+    template<class V, class H = HashValue, class E = EqualValue, detail::BimapEnableTransparent<H, E> = 0>
+    const_iterator findByValue(const V &value) const;
+    template<class K, class H = HashKey, class E = EqualKey, detail::BimapEnableTransparent<H, E> = 0>
+    bool containsKey(const K &key) const;
+    template<class V, class H = HashValue, class E = EqualValue, detail::BimapEnableTransparent<H, E> = 0>
+    bool containsValue(const V &value) const;
+
+    std::size_t getValues(const TypeKey *keys, std::size_t count, TypeValue *values, bool *found = nullptr) const;
+    std::size_t getKeys(const TypeValue *values, std::size_t count, TypeKey *keys, bool *found = nullptr) const;
+
+    template<class... Args>
+    std::pair<iterator, bool> emplace(Args&&... args);
+    std::pair<iterator, bool> tryInsert(const TypeKey &key, const TypeValue &value);
+    std::pair<iterator, bool> tryInsert(TypeKey &&key, TypeValue &&value);
+
+    std::pair<iterator, bool> insertOrAssign(const TypeKey &key, const TypeValue &value);
+    std::pair<iterator, bool> insertOrAssign(TypeKey &&key, TypeValue &&value);
+    std::pair<iterator, bool> replace(const TypeKey &key, const TypeValue &value, ReplacePolicy policy);
+    std::pair<iterator, bool> replace(TypeKey &&key, TypeValue &&value, ReplacePolicy policy);
+
+public:
+    std::size_t capacity() const;
+    float loadFactor() const;
+
+    void reserve(std::size_t count);
+    void rehash(std::size_t count);
+    void shrinkToFit();
+
+    HashKey hashFunctionKey() const;
+    HashValue hashFunctionValue() const;
+
+    BimapMemoryUsage memoryUsage() const;
+    std::vector<std::size_t> probeHistogramKey() const;
+    std::vector<std::size_t> probeHistogramValue() const;
+
+#if defined(BIMAP_ENABLE_STATS)
+    BimapStats& stats() const;
+#endif
+
+private:
+    void insert(_TypeNode &&node);
+    void insert(const _TypeNode &node);
+
+    template<class K, class V>
+    void insertPair(K &&key, V &&value);
+    template<class K, class V>
+    std::pair<iterator, bool> tryInsertPair(K &&key, V &&value);
+    template<class K, class V>
+    std::pair<iterator, bool> replacePair(K &&key, V &&value, bool overwriteLeft, bool overwriteRight, bool &inserted);
+
+    template<class K>
+    std::size_t hashKey(const K &key) const;
+    template<class V>
+    std::size_t hashValue(const V &value) const;
+
+    template<class K>
+    std::size_t findPosKey(const K &key, std::size_t hash) const;
+    template<class V>
+    std::size_t findPosValue(const V &value, std::size_t hash) const;
+
+    void eraseAt(std::size_t index, std::size_t posKey, std::size_t posValue);
+    void prepareInsert();
+    void rebuildIndexes(std::size_t capacity);
+    template<class Executor>
+    void buildIndexes(Executor &executor);
+
+public:
+    iterator begin();
+    const_iterator cbegin() const;
+    reverse_iterator rbegin();
+    const_reverse_iterator crbegin() const;
+    iterator end();
+    const_iterator cend() const;
+    reverse_iterator rend();
+    const_reverse_iterator crend() const;
+
+private:
+    _ContainerData m_data;
+    _ContainerIndexKey m_indexKey;
+    _ContainerIndexValue m_indexValue;
+
+    HashKey m_hashKey;
+    EqualKey m_equalKey;
+    HashValue m_hashValue;
+    EqualValue m_equalValue;
+
+#if defined(BIMAP_ENABLE_STATS)
+    mutable BimapStats m_stats;
+#endif
+};
+
+/*!
+ * \brief Flat bimap using default layout policies
+ * \details
+ * Layout is selected at compile time from types of keys and values
+ * (see cmap::FlatBimapDefaultStorage), with 32-bits indexes and index
+ * tables aligned on 64 bytes.
+ */
+template<class TypeKey, class TypeValue,
+         class HashKey = std::hash<TypeKey>, class EqualKey = std::equal_to<TypeKey>,
+         class HashValue = std::hash<TypeValue>, class EqualValue = std::equal_to<TypeValue>>
+using FlatBimap = BasicFlatBimap<TypeKey, TypeValue,
+                                 FlatBimapDefaultStorage<TypeKey, TypeValue>, FlatBimapIndexPolicy<std::uint32_t>, FlatBimapAllocPolicy<64>,
+                                 HashKey, EqualKey, HashValue, EqualValue>;
+
+/*
+ * Functions implementations
+ * Class use template and methods cannot be defined in .cpp file.
+ * See https://isocpp.org/wiki/faq/templates#separate-template-fn-defn-from-decl
+ */
+
+#define FLATBIMAP_TEMPLATE template<class TypeKey, class TypeValue, class StoragePolicy, class IndexPolicy, class AllocPolicy, class HashKey, class EqualKey, class HashValue, class EqualValue>
+#define FLATBIMAP_CLASS BasicFlatBimap<TypeKey, TypeValue, StoragePolicy, IndexPolicy, AllocPolicy, HashKey, EqualKey, HashValue, EqualValue>
+
+/*!
+ * \brief Construct empty flat bimap
+ * \details
+ * Nothing is allocated until first insertion.
+ */
+FLATBIMAP_TEMPLATE
+FLATBIMAP_CLASS::BasicFlatBimap() : BasicFlatBimap(0)
+{
+    /* Nothing to do */
+}
+
+/*!
+ * \brief Construct empty flat bimap
+ *
+ * \param count
+ * Number of elements to reserve space for.
+ * \param hashKey, equalKey
+ * Hash and comparison functions used for keys.
+ * \param hashValue, equalValue
+ * Hash and comparison functions used for values.
+ */
+FLATBIMAP_TEMPLATE
+FLATBIMAP_CLASS::BasicFlatBimap(std::size_t count,
+                                const HashKey &hashKey, const EqualKey &equalKey,
+                                const HashValue &hashValue, const EqualValue &equalValue) :
+    m_hashKey(hashKey), m_equalKey(equalKey), m_hashValue(hashValue), m_equalValue(equalValue)
+{
+    if(count > 0){
+        reserve(count);
+    }
+}
+
+/*!
+ * \brief Construct flat bimap with \c std::initializer_list
+ * \param args
+ * List to use to construct flat bimap.
+ *
+ * <b>Example: </b>
+ * \code{.c}
+    const cmap::FlatBimap<int, std::string> m_mapNumberToString =
+    {
+        {1, "ONE"},
+        {2, "TWO"},
+        {3, "THREE"}
+    };
+ * \endcode
+ */
+FLATBIMAP_TEMPLATE
+FLATBIMAP_CLASS::BasicFlatBimap(const std::initializer_list<_TypeNode> &args) : BasicFlatBimap(args.size())
+{
+    for(auto it=args.begin(); it != args.end(); ++it){
+        insert(*it);
+    }
+}
+
+/*!
+ * \brief Checks whether the container is empty
+ *
+ * \return
+ * Returns \c true if the container is empty, \c false otherwise
+ */
+FLATBIMAP_TEMPLATE
+bool FLATBIMAP_CLASS::empty() const
+{
+    return m_data.empty();
+}
+
+/*!
+ * \brief Returns the number of elements
+ *
+ * \return
+ * The number of elements in the container
+ */
+FLATBIMAP_TEMPLATE
+std::size_t FLATBIMAP_CLASS::size() const
+{
+    return m_data.size();
+}
+
+/*!
+ * \brief Returns the maximum possible number of elements
+ *
+ * \return
+ * Maximum number of elements
+ */
+FLATBIMAP_TEMPLATE
+std::size_t FLATBIMAP_CLASS::maxSize() const
+{
+    return std::min<std::size_t>(m_data.max_size(), std::numeric_limits<_TypeIndex>::max());
+}
+
+/*!
+ * \brief Clears the contents
+ * \details
+ * Erases all elements from the container. After this call, size() returns zero. \n
+ * Allocated memory is kept, so capacity() is unchanged.
+ */
+FLATBIMAP_TEMPLATE
+void FLATBIMAP_CLASS::clear()
+{
+    m_data.clear();
+    m_indexKey.clear();
+    m_indexValue.clear();
+}
+
+/*!
+ * \brief Insert item to flat bimap
+ *
+ * \param key
+ * Key of element, if key already exist, it will be replaced.
+ * \param value
+ * Value associated to the key, if value is already associated
+ * to another key, this association will be removed.
+ */
+FLATBIMAP_TEMPLATE
+void FLATBIMAP_CLASS::insert(const TypeKey &key, const TypeValue &value)
+{
+    insertPair(key, value);
+}
+
+/*!
+ * \overload
+ * \details
+ * Key and value are moved into the new element.
+ */
+FLATBIMAP_TEMPLATE
+void FLATBIMAP_CLASS::insert(TypeKey &&key, TypeValue &&value)
+{
+    insertPair(std::move(key), std::move(value));
+}
+
+/*!
+ * \overload
+ */
+FLATBIMAP_TEMPLATE
+void FLATBIMAP_CLASS::insert(_TypeNode &&node)
+{
+    insert(std::move(node.first), std::move(node.second));
+}
+
+/*!
+ * \overload
+ */
+FLATBIMAP_TEMPLATE
+void FLATBIMAP_CLASS::insert(const _TypeNode &node)
+{
+    insert(node.first, node.second);
+}
+
+/*!
+ * \brief Use to erase an element
+ * \details
+ * Last element is moved into place of erased one, so iterators,
+ * pointers and references to the last element are invalidated.
+ *
+ * \param key
+ * Key of element to erase, if key doesn't exist, this
+ * method do nothing.
+ */
+FLATBIMAP_TEMPLATE
+void FLATBIMAP_CLASS::erase(const TypeKey &key)
+{
+    const std::size_t posKey = findPosKey(key, hashKey(key));
+    if(posKey == _ContainerIndexKey::NoPos){
+        return;
+    }
+
+    const _TypeIndex index = m_indexKey.slotAt(posKey).index;
+    eraseAt(index, posKey, m_indexValue.findIndex(hashValue(m_data[index].second), index));
+    BIMAP_STATS_RECORD(m_stats, Erase);
+}
+
+/*!
+ * \brief Exchanges the contents of the container with those of \c other
+ * \details
+ * Does not invoke any move, copy, or swap operations on individual elements.
+ */
+FLATBIMAP_TEMPLATE
+void FLATBIMAP_CLASS::swap(BasicFlatBimap &other)
+{
+    using std::swap;
+
+    m_data.swap(other.m_data);
+    m_indexKey.swap(other.m_indexKey);
+    m_indexValue.swap(other.m_indexValue);
+    swap(m_hashKey, other.m_hashKey);
+    swap(m_equalKey, other.m_equalKey);
+    swap(m_hashValue, other.m_hashValue);
+    swap(m_equalValue, other.m_equalValue);
+}
+
+/*!
+ * \brief Replace content of flat bimap by a range of pairs, using
+ * tasks of \c executor
+ * \details
+ * Pairs are copied by calling thread, then hashed concurrently and both
+ * index tables are built at the same time (see bimapparallel.h for
+ * executors). \n
+ * Unlike insert(), duplicated keys or values are not silently replaced:
+ * they are rejected and no element is kept.
+ *
+ * \param first, last
+ * Range of pairs (\c first is the key, \c second the value).
+ * \param executor
+ * Executor running tasks, \c cmap::BimapThreadExecutor for example.
+ *
+ * \throw std::invalid_argument
+ * Throw if range contains duplicated keys or values, flat bimap
+ * is left unchanged.
+ * \throw std::length_error
+ * Throw if range is larger than maxSize()
+ */
+FLATBIMAP_TEMPLATE
+template<class InputIt, class Executor>
+void FLATBIMAP_CLASS::assign(InputIt first, InputIt last, Executor &executor)
+{
+    BasicFlatBimap other(0, m_hashKey, m_equalKey, m_hashValue, m_equalValue);
+    other.m_data.assign(first, last);
+    if(other.m_data.size() > maxSize()){
+        throw std::length_error("cmap::FlatBimap::assign");
+    }
+    other.buildIndexes(executor);
+
+    m_data.swap(other.m_data);
+    m_indexKey.swap(other.m_indexKey);
+    m_indexValue.swap(other.m_indexValue);
+    BIMAP_STATS_RECORD_COUNT(m_stats, Insert, m_data.size());
+}
+
+/*!
+ * \brief Use to retrieve value by key
+ *
+ * \param key
+ * Key of element to get.
+ * \return
+ * Return value associated to key.
+ *
+ * \throw std::out_of_range
+ * Throw if key cannot be found
+ */
+FLATBIMAP_TEMPLATE
+const TypeValue &FLATBIMAP_CLASS::getValue(const TypeKey &key) const
+{
+    BIMAP_STATS_LOOKUP_BEGIN(m_stats);
+    const std::size_t pos = findPosKey(key, hashKey(key));
+    BIMAP_STATS_LOOKUP_END(m_stats, pos != _ContainerIndexKey::NoPos);
+    if(pos == _ContainerIndexKey::NoPos){
+        throw std::out_of_range("cmap::FlatBimap::getValue");
+    }
+
+    return m_data[m_indexKey.slotAt(pos).index].second;
+}
+
+/*!
+ * \brief Use to retrieve key by value
+ *
+ * \param value
+ * Value to use to retrieve key element.
+ * \return
+ * Return key associated to value.
+ *
+ * \throw std::out_of_range
+ * Throw if value cannot be found
+ */
+FLATBIMAP_TEMPLATE
+const TypeKey &FLATBIMAP_CLASS::getKey(const TypeValue &value) const
+{
+    BIMAP_STATS_LOOKUP_BEGIN(m_stats);
+    const std::size_t pos = findPosValue(value, hashValue(value));
+    BIMAP_STATS_LOOKUP_END(m_stats, pos != _ContainerIndexValue::NoPos);
+    if(pos == _ContainerIndexValue::NoPos){
+        throw std::out_of_range("cmap::FlatBimap::getKey");
+    }
+
+    return m_data[m_indexValue.slotAt(pos).index].first;
+}
+
+/*!
+ * \brief Use to retrieve value by an object comparable to keys
+ * \details
+ * This overload is only available when both \c HashKey and \c EqualKey
+ * are transparent (see cmap::StringHash), so no temporary key is
+ * constructed to perform the lookup.
+ *
+ * \param key
+ * Object comparable to keys, its hash must be equal to the hash of
+ * the equivalent key.
+ * \return
+ * Return value associated to key.
+ *
+ * \throw std::out_of_range
+ * Throw if key cannot be found
+ */
+FLATBIMAP_TEMPLATE
+template<class K, class H, class E, detail::BimapEnableTransparent<H, E>>
+const TypeValue &FLATBIMAP_CLASS::getValue(const K &key) const
+{
+    BIMAP_STATS_LOOKUP_BEGIN(m_stats);
+    const std::size_t pos = findPosKey(key, hashKey(key));
+    BIMAP_STATS_LOOKUP_END(m_stats, pos != _ContainerIndexKey::NoPos);
+    if(pos == _ContainerIndexKey::NoPos){
+        throw std::out_of_range("cmap::FlatBimap::getValue");
+    }
+
+    return m_data[m_indexKey.slotAt(pos).index].second;
+}
+
+/*!
+ * \brief Use to retrieve key by an object comparable to values
+ * \details
+ * This overload is only available when both \c HashValue and \c EqualValue
+ * are transparent (see cmap::StringHash), so no temporary value is
+ * constructed to perform the lookup.
+ *
+ * \param value
+ * Object comparable to values, its hash must be equal to the hash of
+ * the equivalent value.
+ * \return
+ * Return key associated to value.
+ *
+ * \throw std::out_of_range
+ * Throw if value cannot be found
+ */
+FLATBIMAP_TEMPLATE
+template<class V, class H, class E, detail::BimapEnableTransparent<H, E>>
+const TypeKey &FLATBIMAP_CLASS::getKey(const V &value) const
+{
+    BIMAP_STATS_LOOKUP_BEGIN(m_stats);
+    const std::size_t pos = findPosValue(value, hashValue(value));
+    BIMAP_STATS_LOOKUP_END(m_stats, pos != _ContainerIndexValue::NoPos);
+    if(pos == _ContainerIndexValue::NoPos){
+        throw std::out_of_range("cmap::FlatBimap::getKey");
+    }
+
+    return m_data[m_indexValue.slotAt(pos).index].first;
+}
+
+/*!
+ * \brief Use to search an element by key
+ * \details
+ * Unlike getValue(), this method never throw: a missing key
+ * cost the same than a found one.
+ *
+ * \param key
+ * Key of element to search.
+ * \return
+ * Return iterator to element, equal to \c cend() if key cannot be found.
+ */
+FLATBIMAP_TEMPLATE
+typename FLATBIMAP_CLASS::const_iterator FLATBIMAP_CLASS::findByKey(const TypeKey &key) const
+{
+    const std::size_t pos = findPosKey(key, hashKey(key));
+    if(pos == _ContainerIndexKey::NoPos){
+        return cend();
+    }
+
+    return m_data.cbegin() + m_indexKey.slotAt(pos).index;
+}
+
+/*!
+ * \brief Use to search an element by value
+ * \details
+ * Unlike getKey(), this method never throw: a missing value
+ * cost the same than a found one.
+ *
+ * \param value
+ * Value of element to search.
+ * \return
+ * Return iterator to element, equal to \c cend() if value cannot be found.
+ */
+FLATBIMAP_TEMPLATE
+typename FLATBIMAP_CLASS::const_iterator FLATBIMAP_CLASS::findByValue(const TypeValue &value) const
+{
+    const std::size_t pos = findPosValue(value, hashValue(value));
+    if(pos == _ContainerIndexValue::NoPos){
+        return cend();
+    }
+
+    return m_data.cbegin() + m_indexValue.slotAt(pos).index;
+}
+
+/*!
+ * \brief Checks if bimap contains an element with key \c key
+ *
+ * \param key
+ * Key of element to search.
+ * \return
+ * Returns \c true if key exists, \c false otherwise.
+ */
+FLATBIMAP_TEMPLATE
+bool FLATBIMAP_CLASS::containsKey(const TypeKey &key) const
+{
+    return findByKey(key) != cend();
+}
+
+/*!
+ * \brief Checks if bimap contains an element with value \c value
+ *
+ * \param value
+ * Value of element to search.
+ * \return
+ * Returns \c true if value exists, \c false otherwise.
+ */
+FLATBIMAP_TEMPLATE
+bool FLATBIMAP_CLASS::containsValue(const TypeValue &value) const
+{
+    return findByValue(value) != cend();
+}
+
+/*!
+ * \brief Use to search an element by an object comparable to keys
+ * \details
+ * This overload is only available when both \c HashKey and \c EqualKey are transparent.
+ *
+ * \param key
+ * Object comparable to keys.
+ * \return
+ * Return iterator to element, equal to \c cend() if key cannot be found.
+ */
+FLATBIMAP_TEMPLATE
+template<class K, class H, class E, detail::BimapEnableTransparent<H, E>>
+typename FLATBIMAP_CLASS::const_iterator FLATBIMAP_CLASS::findByKey(const K &key) const
+{
+    const std::size_t pos = findPosKey(key, hashKey(key));
+    if(pos == _ContainerIndexKey::NoPos){
+        return cend();
+    }
+
+    return m_data.cbegin() + m_indexKey.slotAt(pos).index;
+}
+
+/*!
+ * \brief Use to search an element by an object comparable to values
+ * \details
+ * This overload is only available when both \c HashValue and \c EqualValue are transparent.
+ *
+ * \param value
+ * Object comparable to values.
+ * \return
+ * Return iterator to element, equal to \c cend() if value cannot be found.
+ */
+FLATBIMAP_TEMPLATE
+template<class V, class H, class E, detail::BimapEnableTransparent<H, E>>
+typename FLATBIMAP_CLASS::const_iterator FLATBIMAP_CLASS::findByValue(const V &value) const
+{
+    const std::size_t pos = findPosValue(value, hashValue(value));
+    if(pos == _ContainerIndexValue::NoPos){
+        return cend();
+    }
+
+    return m_data.cbegin() + m_indexValue.slotAt(pos).index;
+}
+
+/*!
+ * \brief Checks if bimap contains an element with key
+ * equivalent to \c key
+ * \details
+ * This overload is only available when both \c HashKey and \c EqualKey are transparent.
+ */
+FLATBIMAP_TEMPLATE
+template<class K, class H, class E, detail::BimapEnableTransparent<H, E>>
+bool FLATBIMAP_CLASS::containsKey(const K &key) const
+{
+    return findByKey(key) != cend();
+}
+
+/*!
+ * \brief Checks if bimap contains an element with value
+ * equivalent to \c value
+ * \details
+ * This overload is only available when both \c HashValue and \c EqualValue are transparent.
+ */
+FLATBIMAP_TEMPLATE
+template<class V, class H, class E, detail::BimapEnableTransparent<H, E>>
+bool FLATBIMAP_CLASS::containsValue(const V &value) const
+{
+    return findByValue(value) != cend();
+}
+
+/*!
+ * \brief Retrieve values of several keys at once
+ * \details
+ * Searches are interleaved: keys are processed by groups, each stage
+ * (hashing, loading metadata, loading pair) prefetches memory needed by the
+ * next one for all keys of the group, so cache misses overlap. Prefer
+ * this method to a loop of getValue() for large batches. \n
+ * Misses are reported in \c found instead of throwing, elements of
+ * \c values matching a missing key are left untouched.
+ *
+ * \param keys
+ * Array of \c count keys to search.
+ * \param count
+ * Number of keys to search.
+ * \param values
+ * Array of \c count elements, receiving value associated to each key.
+ * \param found
+ * Array of \c count booleans set to \c true if key has been found,
+ * can be \c nullptr.
+ * \return
+ * Returns number of keys found.
+ */
+FLATBIMAP_TEMPLATE
+std::size_t FLATBIMAP_CLASS::getValues(const TypeKey *keys, std::size_t count, TypeValue *values, bool *found) const
+{
+    std::size_t hashes[detail::BimapBatchWidth];
+    std::size_t nbFound = 0;
+
+    for(std::size_t first = 0; first < count; first += detail::BimapBatchWidth){
+        const std::size_t width = std::min(detail::BimapBatchWidth, count - first);
+        const TypeKey *group = keys + first;
+
+        /* Stage 1: hash all elements and prefetch their first group */
+        for(std::size_t i = 0; i < width; ++i){
+            hashes[i] = hashKey(group[i]);
+            m_indexKey.prefetch(hashes[i]);
+        }
+
+        /* Stage 2: prefetch most likely pairs */
+        for(std::size_t i = 0; i < width; ++i){
+            const std::size_t candidate = m_indexKey.candidate(hashes[i]);
+            if(candidate != _ContainerIndexKey::NoPos){
+                detail::bimapPrefetch(&m_data[candidate]);
+            }
+        }
+
+        /* Stage 3: search */
+        for(std::size_t i = 0; i < width; ++i){
+            const std::size_t pos = findPosKey(group[i], hashes[i]);
+            const bool isFound = pos != _ContainerIndexKey::NoPos;
+
+            if(isFound){
+                values[first + i] = m_data[m_indexKey.slotAt(pos).index].second;
+                ++nbFound;
+            }
+            if(found){
+                found[first + i] = isFound;
+            }
+        }
+    }
+
+    return nbFound;
+}
+
+/*!
+ * \brief Retrieve keys of several values at once
+ * \details
+ * Reverse direction of getValues().
+ *
+ * \param values
+ * Array of \c count values to search.
+ * \param count
+ * Number of values to search.
+ * \param keys
+ * Array of \c count elements, receiving key associated to each value.
+ * \param found
+ * Array of \c count booleans set to \c true if value has been found,
+ * can be \c nullptr.
+ * \return
+ * Returns number of values found.
+ */
+FLATBIMAP_TEMPLATE
+std::size_t FLATBIMAP_CLASS::getKeys(const TypeValue *values, std::size_t count, TypeKey *keys, bool *found) const
+{
+    std::size_t hashes[detail::BimapBatchWidth];
+    std::size_t nbFound = 0;
+
+    for(std::size_t first = 0; first < count; first += detail::BimapBatchWidth){
+        const std::size_t width = std::min(detail::BimapBatchWidth, count - first);
+        const TypeValue *group = values + first;
+
+        /* Stage 1: hash all elements and prefetch their first group */
+        for(std::size_t i = 0; i < width; ++i){
+            hashes[i] = hashValue(group[i]);
+            m_indexValue.prefetch(hashes[i]);
+        }
+
+        /* Stage 2: prefetch most likely pairs */
+        for(std::size_t i = 0; i < width; ++i){
+            const std::size_t candidate = m_indexValue.candidate(hashes[i]);
+            if(candidate != _ContainerIndexValue::NoPos){
+                detail::bimapPrefetch(&m_data[candidate]);
+            }
+        }
+
+        /* Stage 3: search */
+        for(std::size_t i = 0; i < width; ++i){
+            const std::size_t pos = findPosValue(group[i], hashes[i]);
+            const bool isFound = pos != _ContainerIndexValue::NoPos;
+
+            if(isFound){
+                keys[first + i] = m_data[m_indexValue.slotAt(pos).index].first;
+                ++nbFound;
+            }
+            if(found){
+                found[first + i] = isFound;
+            }
+        }
+    }
+
+    return nbFound;
+}
+
+/*!
+ * \brief Construct element in-place if neither its key nor
+ * its value already exist
+ * \details
+ * Element is constructed from \c args (like \c std::pair constructors)
+ * directly at the end of storage, unlike insert(), existing elements are
+ * never replaced. If insertion fails, constructed element is destroyed.
+ *
+ * \param args
+ * Arguments to forward to the constructor of the element.
+ * \return
+ * Returns a pair consisting of an iterator to the inserted element (or to
+ * the element that prevented the insertion, element with same key has precedence)
+ * and a boolean set to \c true if insertion took place.
+ */
+FLATBIMAP_TEMPLATE
+template<class... Args>
+std::pair<typename FLATBIMAP_CLASS::iterator, bool> FLATBIMAP_CLASS::emplace(Args&&... args)
+{
+    prepareInsert();
+    m_data.emplace_back(std::forward<Args>(args)...);
+
+    const value_type &pair = m_data.back();
+    const std::size_t hk = hashKey(pair.first);
+    const std::size_t hv = hashValue(pair.second);
+
+    std::size_t pos = findPosKey(pair.first, hk);
+    if(pos != _ContainerIndexKey::NoPos){
+        m_data.pop_back();
+        return std::make_pair(m_data.cbegin() + m_indexKey.slotAt(pos).index, false);
+    }
+
+    pos = findPosValue(pair.second, hv);
+    if(pos != _ContainerIndexValue::NoPos){
+        m_data.pop_back();
+        return std::make_pair(m_data.cbegin() + m_indexValue.slotAt(pos).index, false);
+    }
+
+    const _TypeIndex index = static_cast<_TypeIndex>(m_data.size() - 1);
+    m_indexKey.insert(hk, _SlotKey(index, pair.first));
+    m_indexValue.insert(hv, _SlotValue(index, pair.second));
+    BIMAP_STATS_RECORD(m_stats, Insert);
+
+    return std::make_pair(m_data.cend() - 1, true);
+}
+
+/*!
+ * \brief Insert element if neither its key nor its value
+ * already exist
+ * \details
+ * Unlike emplace(), no element is constructed when insertion
+ * fails, so arguments are never copied (or moved) in this case.
+ *
+ * \param key
+ * Key of element.
+ * \param value
+ * Value associated to the key.
+ * \return
+ * Returns a pair consisting of an iterator to the inserted element (or to
+ * the element that prevented the insertion, element with same key has precedence)
+ * and a boolean set to \c true if insertion took place.
+ */
+FLATBIMAP_TEMPLATE
+std::pair<typename FLATBIMAP_CLASS::iterator, bool> FLATBIMAP_CLASS::tryInsert(const TypeKey &key, const TypeValue &value)
+{
+    return tryInsertPair(key, value);
+}
+
+/*!
+ * \overload
+ * \details
+ * Key and value are moved only if insertion took place.
+ */
+FLATBIMAP_TEMPLATE
+std::pair<typename FLATBIMAP_CLASS::iterator, bool> FLATBIMAP_CLASS::tryInsert(TypeKey &&key, TypeValue &&value)
+{
+    return tryInsertPair(std::move(key), std::move(value));
+}
+
+/*!
+ * \brief Insert element, or assign value of existing key
+ * \details
+ * Like insert(), both sides are kept consistent: if \c value was
+ * associated to another key, this association is removed. \n
+ * But when \c key already exists, its pair is reused and only its
+ * value is assigned, a single search is performed on each side.
+ *
+ * \param key
+ * Key of element.
+ * \param value
+ * Value to associate to the key.
+ * \return
+ * Returns a pair consisting of an iterator to the element and a
+ * boolean set to \c true if key was inserted, \c false if assigned.
+ */
+FLATBIMAP_TEMPLATE
+std::pair<typename FLATBIMAP_CLASS::iterator, bool> FLATBIMAP_CLASS::insertOrAssign(const TypeKey &key, const TypeValue &value)
+{
+    bool inserted = false;
+    auto result = replacePair(key, value, true, true, inserted);
+    return std::make_pair(result.first, inserted);
+}
+
+/*!
+ * \overload
+ */
+FLATBIMAP_TEMPLATE
+std::pair<typename FLATBIMAP_CLASS::iterator, bool> FLATBIMAP_CLASS::insertOrAssign(TypeKey &&key, TypeValue &&value)
+{
+    bool inserted = false;
+    auto result = replacePair(std::move(key), std::move(value), true, true, inserted);
+    return std::make_pair(result.first, inserted);
+}
+
+/*!
+ * \brief Insert pair, resolving conflicts with existing
+ * elements according to \c policy
+ * \details
+ * A single search is performed on each side, pairs are
+ * reused when possible.
+ *
+ * \param key
+ * Key of element.
+ * \param value
+ * Value to associate to the key.
+ * \param policy
+ * Policy to apply when \c key or \c value already exist.
+ * \return
+ * Returns a pair consisting of an iterator to the element (or to the
+ * element which caused the rejection) and a boolean set to \c true
+ * if bimap now contains the pair.
+ *
+ * \sa insert(), insertOrAssign(), tryInsert()
+ */
+FLATBIMAP_TEMPLATE
+std::pair<typename FLATBIMAP_CLASS::iterator, bool> FLATBIMAP_CLASS::replace(const TypeKey &key, const TypeValue &value, ReplacePolicy policy)
+{
+    bool inserted = false;
+    return replacePair(key, value, policy == ReplacePolicy::OverwriteLeft, policy == ReplacePolicy::OverwriteRight, inserted);
+}
+
+/*!
+ * \overload
+ * \details
+ * Key and value are moved only if they are used.
+ */
+FLATBIMAP_TEMPLATE
+std::pair<typename FLATBIMAP_CLASS::iterator, bool> FLATBIMAP_CLASS::replace(TypeKey &&key, TypeValue &&value, ReplacePolicy policy)
+{
+    bool inserted = false;
+    return replacePair(std::move(key), std::move(value), policy == ReplacePolicy::OverwriteLeft, policy == ReplacePolicy::OverwriteRight, inserted);
+}
+
+/*!
+ * \brief Returns number of slots of each index table
+ *
+ * \return
+ * Number of slots, up to 7/8 of them can be used before tables grow.
+ */
+FLATBIMAP_TEMPLATE
+std::size_t FLATBIMAP_CLASS::capacity() const
+{
+    return m_indexKey.capacity();
+}
+
+/*!
+ * \brief Returns ratio of used slots in index tables
+ *
+ * \return
+ * Ratio of used slots, \c 0 if nothing is allocated.
+ */
+FLATBIMAP_TEMPLATE
+float FLATBIMAP_CLASS::loadFactor() const
+{
+    const std::size_t slots = capacity();
+    return slots > 0 ? static_cast<float>(size()) / static_cast<float>(slots) : 0.0f;
+}
+
+/*!
+ * \brief Reserves space for at least the specified number of elements
+ * \details
+ * Both pairs array and index tables are resized, so no reallocation will
+ * happen until \c count elements are stored.
+ *
+ * \param count
+ * Number of elements to reserve space for.
+ *
+ * \throw std::length_error
+ * Throw if \c count is greater than maxSize()
+ */
+FLATBIMAP_TEMPLATE
+void FLATBIMAP_CLASS::reserve(std::size_t count)
+{
+    if(count > maxSize()){
+        throw std::length_error("cmap::FlatBimap::reserve");
+    }
+
+    m_data.reserve(count);
+
+    const std::size_t slots = _ContainerIndexKey::capacityFor(count);
+    if(slots > capacity()){
+        rebuildIndexes(slots);
+    }
+}
+
+/*!
+ * \brief Rebuild index tables
+ * \details
+ * Index tables are rebuilt with at least \c count slots (rounded to
+ * next power of two, and never lower than what is required for size()),
+ * this also purge slots marked as deleted.
+ *
+ * \param count
+ * Minimal number of slots.
+ */
+FLATBIMAP_TEMPLATE
+void FLATBIMAP_CLASS::rehash(std::size_t count)
+{
+    std::size_t slots = _ContainerIndexKey::capacityFor(size());
+    while(slots < count){
+        slots <<= 1;
+    }
+    rebuildIndexes(slots);
+}
+
+/*!
+ * \brief Release unused memory
+ * \details
+ * Pairs array and index tables are shrunk to smallest size able
+ * to store size() elements.
+ */
+FLATBIMAP_TEMPLATE
+void FLATBIMAP_CLASS::shrinkToFit()
+{
+    m_data.shrink_to_fit();
+    if(empty()){
+        _ContainerIndexKey().swap(m_indexKey);
+        _ContainerIndexValue().swap(m_indexValue);
+    }else{
+        rehash(0);
+    }
+}
+
+/*!
+ * \brief Returns function used to hash keys
+ */
+FLATBIMAP_TEMPLATE
+HashKey FLATBIMAP_CLASS::hashFunctionKey() const
+{
+    return m_hashKey;
+}
+
+/*!
+ * \brief Returns function used to hash values
+ */
+FLATBIMAP_TEMPLATE
+HashValue FLATBIMAP_CLASS::hashFunctionValue() const
+{
+    return m_hashValue;
+}
+
+/*!
+ * \brief Returns memory owned by bimap
+ * \details
+ * Each slot of index tables is made of a metadata byte and an index
+ * (plus a copy of its element when stored inline, see
+ * cmap::FlatBimapStoragePolicy). Free slots (including those marked as
+ * deleted) and unused capacity of pairs array are reported in \c unused.
+ */
+FLATBIMAP_TEMPLATE
+BimapMemoryUsage FLATBIMAP_CLASS::memoryUsage() const
+{
+    constexpr std::size_t slotSizeKey = sizeof(std::int8_t) + sizeof(_SlotKey);
+    constexpr std::size_t slotSizeValue = sizeof(std::int8_t) + sizeof(_SlotValue);
+    const std::size_t nbArrays = (m_data.capacity() > 0) + 2 * (m_indexKey.capacity() > 0) + 2 * (m_indexValue.capacity() > 0);
+
+    BimapMemoryUsage usage;
+    usage.indexKey = m_indexKey.size() * slotSizeKey;
+    usage.indexValue = m_indexValue.size() * slotSizeValue;
+    usage.payload = m_data.size() * sizeof(value_type);
+    usage.overhead = nbArrays * BimapAllocationOverhead;
+    usage.unused = (m_data.capacity() - m_data.size()) * sizeof(value_type)
+                 + (m_indexKey.capacity() - m_indexKey.size()) * slotSizeKey
+                 + (m_indexValue.capacity() - m_indexValue.size()) * slotSizeValue;
+
+    return usage;
+}
+
+/*!
+ * \brief Returns histogram of probe lengths of keys
+ * \details
+ * Probe length of an element is the number of groups of slots
+ * visited to find it by key (\c 1 when it is referenced by the first
+ * probed group). A badly distributed hash function shows up as long
+ * tails. \n
+ * Complexity is the one of size() lookups.
+ *
+ * \return
+ * Histogram, element at index \c i is the number of elements found
+ * after <tt>i + 1</tt> probes. Empty if bimap is empty.
+ */
+FLATBIMAP_TEMPLATE
+std::vector<std::size_t> FLATBIMAP_CLASS::probeHistogramKey() const
+{
+    std::vector<std::size_t> histogram;
+    for(std::size_t i = 0; i < m_data.size(); ++i){
+        detail::bimapHistogramAdd(histogram, m_indexKey.probeLength(hashKey(m_data[i].first), static_cast<_TypeIndex>(i)));
+    }
+    return histogram;
+}
+
+/*!
+ * \brief Returns histogram of probe lengths of values
+ * \sa probeHistogramKey()
+ */
+FLATBIMAP_TEMPLATE
+std::vector<std::size_t> FLATBIMAP_CLASS::probeHistogramValue() const
+{
+    std::vector<std::size_t> histogram;
+    for(std::size_t i = 0; i < m_data.size(); ++i){
+        detail::bimapHistogramAdd(histogram, m_indexValue.probeLength(hashValue(m_data[i].second), static_cast<_TypeIndex>(i)));
+    }
+    return histogram;
+}
+
+#if defined(BIMAP_ENABLE_STATS)
+/*!
+ * \brief Returns statistics of lookups and updates of bimap
+ * \details
+ * Only available when \c BIMAP_ENABLE_STATS is defined.
+ *
+ * \sa bimapstats.h
+ */
+FLATBIMAP_TEMPLATE
+BimapStats& FLATBIMAP_CLASS::stats() const
+{
+    return m_stats;
+}
+#endif
+
+/*!
+ * \brief Append pair built from \c key and \c value, replacing
+ * elements which conflict with it
+ */
+FLATBIMAP_TEMPLATE
+template<class K, class V>
+void FLATBIMAP_CLASS::insertPair(K &&key, V &&value)
+{
+    const std::size_t hk = hashKey(key);
+    const std::size_t hv = hashValue(value);
+
+    /* Remove entries which conflict with new pair */
+    bool overwritten = false;
+    std::size_t posKey = findPosKey(key, hk);
+    if(posKey != _ContainerIndexKey::NoPos){
+        const _TypeIndex index = m_indexKey.slotAt(posKey).index;
+        eraseAt(index, posKey, m_indexValue.findIndex(hashValue(m_data[index].second), index));
+        overwritten = true;
+    }
+
+    std::size_t posValue = findPosValue(value, hv);
+    if(posValue != _ContainerIndexValue::NoPos){
+        const _TypeIndex index = m_indexValue.slotAt(posValue).index;
+        eraseAt(index, m_indexKey.findIndex(hashKey(m_data[index].first), index), posValue);
+        overwritten = true;
+    }
+
+    /* Append pair and reference it */
+    prepareInsert();
+
+    const _TypeIndex index = static_cast<_TypeIndex>(m_data.size());
+    m_data.emplace_back(std::forward<K>(key), std::forward<V>(value));
+    m_indexKey.insert(hk, _SlotKey(index, m_data.back().first));
+    m_indexValue.insert(hv, _SlotValue(index, m_data.back().second));
+
+    if(overwritten){
+        BIMAP_STATS_RECORD(m_stats, Overwrite);
+    }else{
+        BIMAP_STATS_RECORD(m_stats, Insert);
+    }
+}
+
+/*!
+ * \brief Append pair built from \c key and \c value if
+ * they do not conflict with existing elements
+ * \details
+ * Each side is hashed and searched once, pair is only
+ * constructed if both searches fail.
+ */
+FLATBIMAP_TEMPLATE
+template<class K, class V>
+std::pair<typename FLATBIMAP_CLASS::iterator, bool> FLATBIMAP_CLASS::tryInsertPair(K &&key, V &&value)
+{
+    const std::size_t hk = hashKey(key);
+    std::size_t pos = findPosKey(key, hk);
+    if(pos != _ContainerIndexKey::NoPos){
+        return std::make_pair(m_data.cbegin() + m_indexKey.slotAt(pos).index, false);
+    }
+
+    const std::size_t hv = hashValue(value);
+    pos = findPosValue(value, hv);
+    if(pos != _ContainerIndexValue::NoPos){
+        return std::make_pair(m_data.cbegin() + m_indexValue.slotAt(pos).index, false);
+    }
+
+    prepareInsert();
+
+    const _TypeIndex index = static_cast<_TypeIndex>(m_data.size());
+    m_data.emplace_back(std::forward<K>(key), std::forward<V>(value));
+    m_indexKey.insert(hk, _SlotKey(index, m_data.back().first));
+    m_indexValue.insert(hv, _SlotValue(index, m_data.back().second));
+    BIMAP_STATS_RECORD(m_stats, Insert);
+
+    return std::make_pair(m_data.cend() - 1, true);
+}
+
+/*!
+ * \brief Insert pair built from \c key and \c value, overwriting
+ * conflicting sides when allowed
+ * \details
+ * Each side is hashed and searched once. When one side already exists,
+ * its pair is reused: only the other side is assigned and referenced
+ * again in its index table.
+ *
+ * \param overwriteLeft
+ * Allow to replace the key associated to \c value.
+ * \param overwriteRight
+ * Allow to replace the value associated to \c key.
+ * \param inserted
+ * Set to \c true if a new key has been inserted.
+ */
+FLATBIMAP_TEMPLATE
+template<class K, class V>
+std::pair<typename FLATBIMAP_CLASS::iterator, bool> FLATBIMAP_CLASS::replacePair(K &&key, V &&value, bool overwriteLeft, bool overwriteRight, bool &inserted)
+{
+    inserted = false;
+
+    /* Done first: index tables are rebuilt if they are full, invalidating positions */
+    prepareInsert();
+
+    const std::size_t hk = hashKey(key);
+    const std::size_t hv = hashValue(value);
+    const std::size_t posKey = findPosKey(key, hk);
+    const std::size_t posValue = findPosValue(value, hv);
+
+    const bool hasKey = posKey != _ContainerIndexKey::NoPos;
+    const bool hasValue = posValue != _ContainerIndexValue::NoPos;
+    _TypeIndex indexKey = hasKey ? m_indexKey.slotAt(posKey).index : 0;
+    const _TypeIndex indexValue = hasValue ? m_indexValue.slotAt(posValue).index : 0;
+
+    /* Apply policy */
+    if(hasKey && hasValue && indexKey == indexValue){
+        return std::make_pair(m_data.cbegin() + indexKey, true);
+    }
+    if(hasKey && !overwriteRight){
+        return std::make_pair(m_data.cbegin() + indexKey, false);
+    }
+    if(hasValue && !overwriteLeft){
+        return std::make_pair(m_data.cbegin() + indexValue, false);
+    }
+
+    /* New key */
+    if(!hasKey){
+        inserted = true;
+
+        if(!hasValue){
+            const _TypeIndex index = static_cast<_TypeIndex>(m_data.size());
+            m_data.emplace_back(std::forward<K>(key), std::forward<V>(value));
+            m_indexKey.insert(hk, _SlotKey(index, m_data.back().first));
+            m_indexValue.insert(hv, _SlotValue(index, m_data.back().second));
+            BIMAP_STATS_RECORD(m_stats, Insert);
+
+            return std::make_pair(m_data.cend() - 1, true);
+        }
+
+        /* Reuse pair owning value, only its key is replaced */
+        const std::size_t posOld = m_indexKey.findIndex(hashKey(m_data[indexValue].first), indexValue);
+        try{
+            m_data[indexValue].first = std::forward<K>(key);
+        }catch(...){
+            eraseAt(indexValue, posOld, posValue);
+            throw;
+        }
+
+        m_indexKey.eraseAt(posOld);
+        m_indexKey.insert(hk, _SlotKey(indexValue, m_data[indexValue].first));
+        BIMAP_STATS_RECORD(m_stats, Overwrite);
+
+        return std::make_pair(m_data.cbegin() + indexValue, true);
+    }
+
+    /* Existing key, only its value is replaced */
+    const std::size_t posOld = m_indexValue.findIndex(hashValue(m_data[indexKey].second), indexKey);
+    try{
+        m_data[indexKey].second = std::forward<V>(value);
+    }catch(...){
+        eraseAt(indexKey, posKey, posOld);
+        throw;
+    }
+
+    m_indexValue.eraseAt(posOld);
+    m_indexValue.insert(hv, _SlotValue(indexKey, m_data[indexKey].second));
+
+    /* Remove pair which owned value (last pair may be moved in its place) */
+    if(hasValue){
+        const _TypeIndex last = static_cast<_TypeIndex>(m_data.size() - 1);
+        eraseAt(indexValue, m_indexKey.findIndex(hashKey(m_data[indexValue].first), indexValue), posValue);
+
+        if(indexKey == last){
+            indexKey = indexValue;
+        }
+    }
+    BIMAP_STATS_RECORD(m_stats, Overwrite);
+
+    return std::make_pair(m_data.cbegin() + indexKey, true);
+}
+
+FLATBIMAP_TEMPLATE
+template<class K>
+std::size_t FLATBIMAP_CLASS::hashKey(const K &key) const
+{
+    return detail::bimapHashMix(m_hashKey(key));
+}
+
+FLATBIMAP_TEMPLATE
+template<class V>
+std::size_t FLATBIMAP_CLASS::hashValue(const V &value) const
+{
+    return detail::bimapHashMix(m_hashValue(value));
+}
+
+FLATBIMAP_TEMPLATE
+template<class K>
+std::size_t FLATBIMAP_CLASS::findPosKey(const K &key, std::size_t hash) const
+{
+    return m_indexKey.find(hash, [this, &key](const _SlotKey &slot){
+        return m_equalKey(slot.item(m_data[slot.index].first), key);
+    });
+}
+
+FLATBIMAP_TEMPLATE
+template<class V>
+std::size_t FLATBIMAP_CLASS::findPosValue(const V &value, std::size_t hash) const
+{
+    return m_indexValue.find(hash, [this, &value](const _SlotValue &slot){
+        return m_equalValue(slot.item(m_data[slot.index].second), value);
+    });
+}
+
+/*!
+ * \brief Erase pair stored at \c index
+ * \details
+ * \c posKey and \c posValue are positions of slots referencing pair into
+ * each index table. Last pair is moved in place of erased one.
+ */
+FLATBIMAP_TEMPLATE
+void FLATBIMAP_CLASS::eraseAt(std::size_t index, std::size_t posKey, std::size_t posValue)
+{
+    m_indexKey.eraseAt(posKey);
+    m_indexValue.eraseAt(posValue);
+
+    /* Move last pair in place of erased one */
+    const _TypeIndex last = static_cast<_TypeIndex>(m_data.size() - 1);
+    if(index != last){
+        value_type &moved = m_data[last];
+        m_indexKey.setIndexAt(m_indexKey.findIndex(hashKey(moved.first), last), static_cast<_TypeIndex>(index));
+        m_indexValue.setIndexAt(m_indexValue.findIndex(hashValue(moved.second), last), static_cast<_TypeIndex>(index));
+
+        m_data[index] = std::move(moved);
+    }
+    m_data.pop_back();
+}
+
+/*!
+ * \brief Make sure one more element can be referenced by index tables
+ *
+ * \throw std::length_error
+ * Throw if container is full
+ */
+FLATBIMAP_TEMPLATE
+void FLATBIMAP_CLASS::prepareInsert()
+{
+    if(size() >= maxSize()){
+        throw std::length_error("cmap::FlatBimap::insert");
+    }
+
+    if(m_indexKey.growthLeft() > 0 && m_indexValue.growthLeft() > 0){
+        return;
+    }
+
+    /* Grow tables, or only purge deleted slots if they are sparse enough */
+    const std::size_t required = _ContainerIndexKey::capacityFor(size() + 1);
+    rebuildIndexes(required > capacity() / 2 ? std::max(required, 2 * capacity()) : capacity());
+}
+
+/*!
+ * \brief Rebuild both index tables with \c capacity slots
+ */
+FLATBIMAP_TEMPLATE
+void FLATBIMAP_CLASS::rebuildIndexes(std::size_t capacity)
+{
+    _ContainerIndexKey indexKey;
+    _ContainerIndexValue indexValue;
+    indexKey.reset(capacity);
+    indexValue.reset(capacity);
+
+    for(std::size_t i = 0; i < m_data.size(); ++i){
+        const _TypeIndex index = static_cast<_TypeIndex>(i);
+        indexKey.insert(hashKey(m_data[i].first), _SlotKey(index, m_data[i].first));
+        indexValue.insert(hashValue(m_data[i].second), _SlotValue(index, m_data[i].second));
+    }
+
+    m_indexKey.swap(indexKey);
+    m_indexValue.swap(indexValue);
+}
+
+/*!
+ * \brief Build both index tables of pairs array, using
+ * tasks of \c executor
+ * \details
+ * Hashes are computed concurrently by chunks of pairs, then each
+ * table is filled by its own task.
+ *
+ * \throw std::invalid_argument
+ * Throw if a key or a value is present more than once
+ */
+FLATBIMAP_TEMPLATE
+template<class Executor>
+void FLATBIMAP_CLASS::buildIndexes(Executor &executor)
+{
+    const std::size_t count = m_data.size();
+    const std::size_t tasks = detail::bimapParallelTasks(count, executor.concurrency());
+
+    std::vector<std::size_t> hashesKey(count);
+    std::vector<std::size_t> hashesValue(count);
+    executor.run(tasks, [&](std::size_t task){
+        const std::size_t last = count / tasks * (task + 1) + std::min(task + 1, count % tasks);
+        for(std::size_t i = count / tasks * task + std::min(task, count % tasks); i < last; ++i){
+            hashesKey[i] = hashKey(m_data[i].first);
+            hashesValue[i] = hashValue(m_data[i].second);
+        }
+    });
+
+    /* Each task only writes its own table and flag */
+    const std::size_t capacity = _ContainerIndexKey::capacityFor(count);
+    bool duplicated[2] = {false, false};
+    executor.run(2, [&](std::size_t side){
+        if(side == 0){
+            m_indexKey.reset(capacity);
+            for(std::size_t i = 0; i < count; ++i){
+                if(findPosKey(m_data[i].first, hashesKey[i]) != _ContainerIndexKey::NoPos){
+                    duplicated[0] = true;
+                    return;
+                }
+                m_indexKey.insert(hashesKey[i], _SlotKey(static_cast<_TypeIndex>(i), m_data[i].first));
+            }
+        }else{
+            m_indexValue.reset(capacity);
+            for(std::size_t i = 0; i < count; ++i){
+                if(findPosValue(m_data[i].second, hashesValue[i]) != _ContainerIndexValue::NoPos){
+                    duplicated[1] = true;
+                    return;
+                }
+                m_indexValue.insert(hashesValue[i], _SlotValue(static_cast<_TypeIndex>(i), m_data[i].second));
+            }
+        }
+    });
+
+    if(duplicated[0]){
+        throw std::invalid_argument("cmap::FlatBimap: duplicated key");
+    }
+    if(duplicated[1]){
+        throw std::invalid_argument("cmap::FlatBimap: duplicated value");
+    }
+}
+
+/*!
+ * \brief Returns an iterator to the beginning
+ *
+ * \return
+ * Iterator to the first element. \n
+ * If the map is empty, the returned iterator will be equal to \c end().
+ */
+FLATBIMAP_TEMPLATE
+typename FLATBIMAP_CLASS::iterator FLATBIMAP_CLASS::begin()
+{
+    return m_data.cbegin();
+}
+
+/*!
+ * \brief Returns a constant iterator to the beginning
+ *
+ * \return
+ * Iterator to the first element. \n
+ * If the map is empty, the returned iterator will be equal to \c cend().
+ */
+FLATBIMAP_TEMPLATE
+typename FLATBIMAP_CLASS::const_iterator FLATBIMAP_CLASS::cbegin() const
+{
+    return m_data.cbegin();
+}
+
+/*!
+ * \brief Returns a reverse iterator to the beginning
+ *
+ * \return
+ * Reverse iterator to the last element. \n
+ * If the map is empty, the returned iterator is equal to \c rend().
+ */
+FLATBIMAP_TEMPLATE
+typename FLATBIMAP_CLASS::reverse_iterator FLATBIMAP_CLASS::rbegin()
+{
+    return reverse_iterator(end());
+}
+
+/*!
+ * \brief Returns a constant reverse iterator to the beginning
+ *
+ * \return
+ * Reverse iterator to the last element. \n
+ * If the map is empty, the returned iterator is equal to \c crend().
+ */
+FLATBIMAP_TEMPLATE
+typename FLATBIMAP_CLASS::const_reverse_iterator FLATBIMAP_CLASS::crbegin() const
+{
+    return const_reverse_iterator(cend());
+}
+
+/*!
+ * \brief Returns an iterator to the end
+ *
+ * \return
+ * Iterator to the element following the last element.
+ */
+FLATBIMAP_TEMPLATE
+typename FLATBIMAP_CLASS::iterator FLATBIMAP_CLASS::end()
+{
+    return m_data.cend();
+}
+
+/*!
+ * \brief Returns a constant iterator to the end
+ *
+ * \return
+ * Iterator to the element following the last element.
+ */
+FLATBIMAP_TEMPLATE
+typename FLATBIMAP_CLASS::const_iterator FLATBIMAP_CLASS::cend() const
+{
+    return m_data.cend();
+}
+
+/*!
+ * \brief Returns a reverse iterator to the end
+ *
+ * \return
+ * Reverse iterator to the element preceding the first element.
+ */
+FLATBIMAP_TEMPLATE
+typename FLATBIMAP_CLASS::reverse_iterator FLATBIMAP_CLASS::rend()
+{
+    return reverse_iterator(begin());
+}
+
+/*!
+ * \brief Returns a constant reverse iterator to the end
+ *
+ * \return
+ * Reverse iterator to the element preceding the first element.
+ */
+FLATBIMAP_TEMPLATE
+typename FLATBIMAP_CLASS::const_reverse_iterator FLATBIMAP_CLASS::crend() const
+{
+    return const_reverse_iterator(cbegin());
+}
+
+#undef FLATBIMAP_TEMPLATE
+#undef FLATBIMAP_CLASS
+
+} // Namespace cmap
+
+#endif // LCH_FLATBIMAP_H
@@ -0,0 +1,1022 @@
+#ifndef LCH_MAPPEDBIMAP_H
+#define LCH_MAPPEDBIMAP_H
+
+/*****************************/
+/* Class documentations      */
+/*****************************/
+
+/*!
+   \class cmap::MappedBimap
+   \brief Class use to provide read-only bi-directional map stored in a memory-mapped file.
+
+   Files are produced by write() from any bimap (or range of pairs), and are
+   mapped read-only by open(): no element is parsed, copied or allocated, only
+   header and array of indexes (4 bytes per pair) are read to validate file,
+   and pages of keys and values are only loaded from the page cache when
+   they are accessed. Mappings are shared, so every process
+   of an host opening the same file shares the same physical memory.
+
+   Files store a 64 bytes header (magic, format version, endianness marker,
+   sizes of types, number of pairs, offsets of arrays and checksum), followed
+   by an array of keys sorted by keys, the array of associated values and an
+   array of 32-bits indexes sorted by values (same layout than
+   cmap::SortedVectorBimap). Both lookups are binary searches
+   (complexity: <b>O(log(n))</b>).
+
+   \code{.cpp}
+   cmap::MappedBimap<std::uint64_t, std::uint32_t>::write("ids.cmap", bimap);
+
+   cmap::MappedBimap<std::uint64_t, std::uint32_t> mapped("ids.cmap");
+   std::uint32_t id = mapped.getValue(42);
+   \endcode
+
+   \note
+   Keys and values must be trivially copyable types (integers, enumerations,
+   fixed-size arrays of characters, etc...) and files are only readable on
+   hosts with the same endianness and same types sizes, which is checked by
+   open(). \n
+   Comparison functions used to read a file must order elements like those
+   used to write it.
+
+   \note
+   open() validates header and indexes, so lookups never read out of mapping,
+   use verifyChecksum() to check content of keys and values (this reads the
+   whole file). Number of elements is limited to \c 2^32-1.
+
+   \sa cmap::SortedVectorBimap
+*/
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "bimapcommon.h"
+
+#if defined(_WIN32)
+#   ifndef NOMINMAX
+#       define NOMINMAX
+#       define BIMAP_UNDEF_NOMINMAX
+#   endif
+#   include <windows.h>
+#   ifdef BIMAP_UNDEF_NOMINMAX
+#       undef NOMINMAX
+#       undef BIMAP_UNDEF_NOMINMAX
+#   endif
+#else
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+namespace cmap{
+
+/*****************************/
+/* Internal implementation   */
+/*****************************/
+
+namespace detail{
+
+/*!
+ * \brief Header of mapped bimap files
+ * \details
+ * Header is written with native byte order, \c endianness allow
+ * to detect files written by an host of another byte order.
+ */
+struct MappedBimapHeader
+{
+    static constexpr std::uint32_t Version = 1;
+    static constexpr std::uint32_t Endianness = 0x01020304;
+
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t endianness;
+    std::uint32_t keySize;
+    std::uint32_t valueSize;
+    std::uint64_t count;
+    std::uint64_t offsetKeys;
+    std::uint64_t offsetValues;
+    std::uint64_t offsetPermutation;
+    std::uint64_t checksum;
+};
+
+constexpr char MappedBimapMagic[8] = {'C', 'M', 'A', 'P', 'B', 'I', 'M', 'P'};
+
+static_assert(sizeof(MappedBimapHeader) == 64, "Header of mapped bimap files must be packed");
+
+/*!
+ * \brief Checksum of file content (all bytes following header),
+ * computed incrementally
+ * \details
+ * Content is consumed by words of 64-bits, so verifying a file is
+ * mostly bounded by memory bandwidth. Bytes not filling a whole
+ * word are kept until next update(), so checksum doesn't depend
+ * on how content is split.
+ */
+class MappedBimapChecksum
+{
+public:
+    void update(const unsigned char *data, std::size_t size);
+    std::uint64_t value() const;
+
+private:
+    void consumeWord(const unsigned char *data)
+    {
+        std::uint64_t word;
+        std::memcpy(&word, data, sizeof(word));
+        m_hash = (m_hash ^ word) * 0x100000001B3ULL;
+        m_hash ^= m_hash >> 32;
+    }
+
+private:
+    std::uint64_t m_hash = 0xCBF29CE484222325ULL;
+    unsigned char m_pending[sizeof(std::uint64_t)];
+    std::size_t m_nbPending = 0;
+};
+
+inline void MappedBimapChecksum::update(const unsigned char *data, std::size_t size)
+{
+    if(m_nbPending != 0){
+        const std::size_t nbCopied = std::min(size, sizeof(m_pending) - m_nbPending);
+        std::memcpy(m_pending + m_nbPending, data, nbCopied);
+        m_nbPending += nbCopied;
+        data += nbCopied;
+        size -= nbCopied;
+
+        if(m_nbPending < sizeof(m_pending)){
+            return;
+        }
+        consumeWord(m_pending);
+        m_nbPending = 0;
+    }
+
+    std::size_t i = 0;
+    for(; i + sizeof(std::uint64_t) <= size; i += sizeof(std::uint64_t)){
+        consumeWord(data + i);
+    }
+
+    m_nbPending = size - i;
+    if(m_nbPending != 0){
+        std::memcpy(m_pending, data + i, m_nbPending);
+    }
+}
+
+inline std::uint64_t MappedBimapChecksum::value() const
+{
+    std::uint64_t hash = m_hash;
+    for(std::size_t i = 0; i < m_nbPending; ++i){
+        hash = (hash ^ m_pending[i]) * 0x100000001B3ULL;
+    }
+
+    return hash;
+}
+
+inline std::uint64_t mappedBimapChecksum(const unsigned char *data, std::size_t size)
+{
+    MappedBimapChecksum checksum;
+    checksum.update(data, size);
+
+    return checksum.value();
+}
+
+/*!
+ * \brief Buffered writer of mapped bimap files
+ * \details
+ * Content is streamed to file by chunks and checksummed on the fly,
+ * so writing a file never holds a whole image of it in memory.
+ * Header is written last, at beginning of file.
+ */
+class MappedBimapWriter
+{
+public:
+    static constexpr std::size_t ChunkSize = 64 * 1024;
+
+public:
+    explicit MappedBimapWriter(const std::string &path) :
+        m_file(path, std::ios::binary | std::ios::trunc)
+    {
+        m_chunk.reserve(ChunkSize);
+    }
+
+public:
+    std::size_t offset() const { return m_offset; }
+
+    void write(const void *data, std::size_t size)
+    {
+        const unsigned char *bytes = static_cast<const unsigned char*>(data);
+        while(size != 0){
+            const std::size_t nbCopied = std::min(size, ChunkSize - m_chunk.size());
+            m_chunk.insert(m_chunk.end(), bytes, bytes + nbCopied);
+            bytes += nbCopied;
+            size -= nbCopied;
+
+            if(m_chunk.size() == ChunkSize){
+                flushChunk();
+            }
+        }
+    }
+
+    void pad(std::size_t offset)
+    {
+        static const unsigned char zeros[16] = {};
+        while(m_offset + m_chunk.size() < offset){
+            write(zeros, std::min(sizeof(zeros), offset - m_offset - m_chunk.size()));
+        }
+    }
+
+    bool finish(const MappedBimapHeader &header)
+    {
+        flushChunk();
+        m_file.seekp(0);
+        m_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        return static_cast<bool>(m_file.flush());
+    }
+
+    std::uint64_t checksum()
+    {
+        flushChunk();
+        return m_checksum.value();
+    }
+
+private:
+    void flushChunk()
+    {
+        if(m_chunk.empty()){
+            return;
+        }
+
+        /* Header is left out of checksum */
+        const std::size_t skipped = m_offset < sizeof(MappedBimapHeader) ? std::min(m_chunk.size(), sizeof(MappedBimapHeader) - m_offset) : 0;
+        m_checksum.update(m_chunk.data() + skipped, m_chunk.size() - skipped);
+
+        m_file.write(reinterpret_cast<const char*>(m_chunk.data()), static_cast<std::streamsize>(m_chunk.size()));
+        m_offset += m_chunk.size();
+        m_chunk.clear();
+    }
+
+private:
+    std::ofstream m_file;
+    std::vector<unsigned char> m_chunk;
+    std::size_t m_offset = 0;
+    MappedBimapChecksum m_checksum;
+};
+
+/*!
+ * \brief Read-only shared mapping of a whole file
+ */
+class MappedBimapFile
+{
+public:
+    MappedBimapFile() = default;
+    ~MappedBimapFile() { close(); }
+
+    MappedBimapFile(const MappedBimapFile &other) = delete;
+    MappedBimapFile& operator=(const MappedBimapFile &other) = delete;
+
+public:
+    const unsigned char* data() const { return m_data; }
+    std::size_t size() const { return m_size; }
+
+    void open(const std::string &path);
+    void close();
+
+    void swap(MappedBimapFile &other)
+    {
+        std::swap(m_data, other.m_data);
+        std::swap(m_size, other.m_size);
+    }
+
+private:
+    const unsigned char *m_data = nullptr;
+    std::size_t m_size = 0;
+};
+
+#if defined(_WIN32)
+inline void MappedBimapFile::open(const std::string &path)
+{
+    close();
+
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if(file == INVALID_HANDLE_VALUE){
+        throw std::system_error(static_cast<int>(GetLastError()), std::system_category(), "cmap::MappedBimap: cannot open " + path);
+    }
+
+    LARGE_INTEGER size;
+    if(!GetFileSizeEx(file, &size)){
+        const DWORD error = GetLastError();
+        CloseHandle(file);
+        throw std::system_error(static_cast<int>(error), std::system_category(), "cmap::MappedBimap: cannot read size of " + path);
+    }
+
+    /* Empty files cannot be mapped, they are rejected when header is validated */
+    if(size.QuadPart != 0){
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        const DWORD error = GetLastError();
+        CloseHandle(file);
+        if(!mapping){
+            throw std::system_error(static_cast<int>(error), std::system_category(), "cmap::MappedBimap: cannot map " + path);
+        }
+
+        /* View keeps a reference to mapping, handle can be closed */
+        void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        const DWORD errorView = GetLastError();
+        CloseHandle(mapping);
+        if(!view){
+            throw std::system_error(static_cast<int>(errorView), std::system_category(), "cmap::MappedBimap: cannot map " + path);
+        }
+
+        m_data = static_cast<const unsigned char*>(view);
+        m_size = static_cast<std::size_t>(size.QuadPart);
+    }else{
+        CloseHandle(file);
+    }
+}
+
+inline void MappedBimapFile::close()
+{
+    if(m_data){
+        UnmapViewOfFile(m_data);
+    }
+    m_data = nullptr;
+    m_size = 0;
+}
+#else
+inline void MappedBimapFile::open(const std::string &path)
+{
+    close();
+
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if(fd < 0){
+        throw std::system_error(errno, std::generic_category(), "cmap::MappedBimap: cannot open " + path);
+    }
+
+    struct stat info;
+    if(::fstat(fd, &info) != 0){
+        const int error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), "cmap::MappedBimap: cannot read size of " + path);
+    }
+
+    /* Empty files cannot be mapped, they are rejected when header is validated */
+    const std::size_t size = static_cast<std::size_t>(info.st_size);
+    if(size != 0){
+        void *addr = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        const int error = errno;
+        ::close(fd);
+        if(addr == MAP_FAILED){
+            throw std::system_error(error, std::generic_category(), "cmap::MappedBimap: cannot map " + path);
+        }
+
+        m_data = static_cast<const unsigned char*>(addr);
+        m_size = size;
+    }else{
+        ::close(fd);
+    }
+}
+
+inline void MappedBimapFile::close()
+{
+    if(m_data){
+        ::munmap(const_cast<unsigned char*>(m_data), m_size);
+    }
+    m_data = nullptr;
+    m_size = 0;
+}
+#endif
+
+} // Namespace detail
+
+/*****************************/
+/* Class definitions         */
+/*****************************/
+
+template<class TypeKey, class TypeValue, class CompareKey = std::less<TypeKey>, class CompareValue = std::less<TypeValue>>
+class MappedBimap
+{
+    static_assert(std::is_trivially_copyable<TypeKey>::value, "cmap::MappedBimap keys must be trivially copyable");
+    static_assert(std::is_trivially_copyable<TypeValue>::value, "cmap::MappedBimap values must be trivially copyable");
+
+public:
+    using key_type = TypeKey;
+    using mapped_type = TypeValue;
+    using size_type = std::size_t;
+
+    using key_compare = CompareKey;
+    using value_compare = CompareValue;
+
+private:
+    using _TypeIndex = std::uint32_t;
+    using _Header = detail::MappedBimapHeader;
+
+    static constexpr std::size_t NoPos = std::numeric_limits<std::size_t>::max();
+
+public:
+    explicit MappedBimap(const CompareKey &compareKey = CompareKey(), const CompareValue &compareValue = CompareValue());
+    explicit MappedBimap(const std::string &path, const CompareKey &compareKey = CompareKey(), const CompareValue &compareValue = CompareValue());
+
+    MappedBimap(const MappedBimap &other) = delete;
+    MappedBimap(MappedBimap &&other);
+
+    MappedBimap& operator=(const MappedBimap &other) = delete;
+    MappedBimap& operator=(MappedBimap &&other);
+
+public:
+    template<class Container>
+    static void write(const std::string &path, const Container &bimap,
+                      const CompareKey &compareKey = CompareKey(), const CompareValue &compareValue = CompareValue());
+
+    template<class InputIt>
+    static void write(const std::string &path, InputIt first, InputIt last,
+                      const CompareKey &compareKey = CompareKey(), const CompareValue &compareValue = CompareValue());
+
+public:
+    void open(const std::string &path);
+    void close();
+    bool isOpen() const;
+    bool verifyChecksum() const;
+
+    bool empty() const;
+    std::size_t size() const;
+    void swap(MappedBimap &other);
+
+    const TypeValue& getValue(const TypeKey &key) const;
+    const TypeKey& getKey(const TypeValue &value) const;
+
+    bool tryGetValue(const TypeKey &key, TypeValue &value) const;
+    bool tryGetKey(const TypeValue &value, TypeKey &key) const;
+    bool containsKey(const TypeKey &key) const;
+    bool containsValue(const TypeValue &value) const;
+
+    template<class Func>
+    void forEach(Func func) const;
+
+    CompareKey keyComp() const;
+    CompareValue valueComp() const;
+
+private:
+    std::size_t findKey(const TypeKey &key) const;
+    std::size_t findValue(const TypeValue &value) const;
+
+    static std::size_t alignOffset(std::size_t offset, std::size_t alignment);
+
+private:
+    detail::MappedBimapFile m_file;
+
+    const TypeKey *m_keys;
+    const TypeValue *m_values;
+    const _TypeIndex *m_permutation;
+    std::size_t m_size;
+
+    CompareKey m_compareKey;
+    CompareValue m_compareValue;
+};
+
+/*
+ * Functions implementations
+ * Class use template and methods cannot be defined in .cpp file.
+ * See https://isocpp.org/wiki/faq/templates#separate-template-fn-defn-from-decl
+ */
+
+#define MAPPEDBIMAP_TEMPLATE template<class TypeKey, class TypeValue, class CompareKey, class CompareValue>
+#define MAPPEDBIMAP_CLASS MappedBimap<TypeKey, TypeValue, CompareKey, CompareValue>
+
+MAPPEDBIMAP_TEMPLATE constexpr std::size_t MAPPEDBIMAP_CLASS::NoPos;
+
+/*!
+ * \brief Construct a mapped bimap not associated to any file
+ * \details
+ * Use open() to map a file.
+ *
+ * \param compareKey
+ * Comparison function used to order keys.
+ * \param compareValue
+ * Comparison function used to order values.
+ */
+MAPPEDBIMAP_TEMPLATE
+MAPPEDBIMAP_CLASS::MappedBimap(const CompareKey &compareKey, const CompareValue &compareValue) :
+    m_keys(nullptr), m_values(nullptr), m_permutation(nullptr), m_size(0),
+    m_compareKey(compareKey), m_compareValue(compareValue)
+{
+    /* Nothing to do */
+}
+
+/*!
+ * \brief Construct a mapped bimap and map file \c path
+ * \sa open()
+ */
+MAPPEDBIMAP_TEMPLATE
+MAPPEDBIMAP_CLASS::MappedBimap(const std::string &path, const CompareKey &compareKey, const CompareValue &compareValue) :
+    MappedBimap(compareKey, compareValue)
+{
+    open(path);
+}
+
+/*!
+ * \brief Move constructor
+ * \details
+ * Mapping is transferred, \c other is left closed.
+ */
+MAPPEDBIMAP_TEMPLATE
+MAPPEDBIMAP_CLASS::MappedBimap(MappedBimap &&other) : MappedBimap(other.m_compareKey, other.m_compareValue)
+{
+    swap(other);
+}
+
+/*!
+ * \brief Move assignment operator
+ * \details
+ * Previous mapping of this bimap is released by \c other.
+ */
+MAPPEDBIMAP_TEMPLATE
+MAPPEDBIMAP_CLASS &MAPPEDBIMAP_CLASS::operator=(MappedBimap &&other)
+{
+    if(this != &other){
+        swap(other);
+        other.close();
+    }
+    return *this;
+}
+
+/*!
+ * \brief Write a file readable by open()
+ * \details
+ * Pairs of \c bimap (any container iterable with \c cbegin() and
+ * \c cend() over pairs, like cmap::Bimap) are sorted once per side,
+ * sorts are skipped if pairs are already ordered. \n
+ * Content is streamed to file, so only copies of keys and values and
+ * two arrays of indexes are held in memory. \n
+ * File is written next to \c path then renamed, so processes which
+ * already mapped a previous version of the file keep reading it.
+ * If file cannot be renamed, previous version of file is left intact.
+ *
+ * \param path
+ * Path of file to write.
+ * \param bimap
+ * Container of pairs to write.
+ * \param compareKey
+ * Comparison function used to order keys.
+ * \param compareValue
+ * Comparison function used to order values.
+ *
+ * \throw std::invalid_argument
+ * Throw if keys or values are duplicated, or if there are more
+ * than \c 2^32-1 pairs.
+ * \throw std::runtime_error
+ * Throw if file cannot be written.
+ */
+MAPPEDBIMAP_TEMPLATE
+template<class Container>
+void MAPPEDBIMAP_CLASS::write(const std::string &path, const Container &bimap, const CompareKey &compareKey, const CompareValue &compareValue)
+{
+    write(path, bimap.cbegin(), bimap.cend(), compareKey, compareValue);
+}
+
+/*!
+ * \overload
+ * \details
+ * Pairs are read from range <tt>[first, last)</tt>.
+ */
+MAPPEDBIMAP_TEMPLATE
+template<class InputIt>
+void MAPPEDBIMAP_CLASS::write(const std::string &path, InputIt first, InputIt last, const CompareKey &compareKey, const CompareValue &compareValue)
+{
+    std::vector<TypeKey> keys;
+    std::vector<TypeValue> values;
+    for(; first != last; ++first){
+        keys.push_back(first->first);
+        values.push_back(first->second);
+    }
+
+    const std::size_t count = keys.size();
+    if(count > std::numeric_limits<_TypeIndex>::max()){
+        throw std::invalid_argument("cmap::MappedBimap: too many pairs");
+    }
+
+    /* Order pairs by keys */
+    std::vector<_TypeIndex> order(count);
+    for(std::size_t i = 0; i < count; ++i){
+        order[i] = static_cast<_TypeIndex>(i);
+    }
+
+    const auto lessKey = [&keys, &compareKey](_TypeIndex lhs, _TypeIndex rhs){ return compareKey(keys[lhs], keys[rhs]); };
+    if(!std::is_sorted(order.begin(), order.end(), lessKey)){
+        std::sort(order.begin(), order.end(), lessKey);
+    }
+    if(std::adjacent_find(order.begin(), order.end(), [&lessKey](_TypeIndex lhs, _TypeIndex rhs){ return !lessKey(lhs, rhs); }) != order.end()){
+        throw std::invalid_argument("cmap::MappedBimap: duplicated key");
+    }
+
+    /* Order positions of pairs (in key order) by values */
+    std::vector<_TypeIndex> permutation(count);
+    for(std::size_t i = 0; i < count; ++i){
+        permutation[i] = static_cast<_TypeIndex>(i);
+    }
+
+    const auto lessValue = [&values, &order, &compareValue](_TypeIndex lhs, _TypeIndex rhs){ return compareValue(values[order[lhs]], values[order[rhs]]); };
+    if(!std::is_sorted(permutation.begin(), permutation.end(), lessValue)){
+        std::sort(permutation.begin(), permutation.end(), lessValue);
+    }
+    if(std::adjacent_find(permutation.begin(), permutation.end(), [&lessValue](_TypeIndex lhs, _TypeIndex rhs){ return !lessValue(lhs, rhs); }) != permutation.end()){
+        throw std::invalid_argument("cmap::MappedBimap: duplicated value");
+    }
+
+    /* Layout file */
+    _Header header;
+    std::memset(&header, 0, sizeof(_Header));
+    std::memcpy(header.magic, detail::MappedBimapMagic, sizeof(header.magic));
+    header.version = _Header::Version;
+    header.endianness = _Header::Endianness;
+    header.keySize = static_cast<std::uint32_t>(sizeof(TypeKey));
+    header.valueSize = static_cast<std::uint32_t>(sizeof(TypeValue));
+    header.count = count;
+    header.offsetKeys = alignOffset(sizeof(_Header), alignof(TypeKey));
+    header.offsetValues = alignOffset(header.offsetKeys + count * sizeof(TypeKey), alignof(TypeValue));
+    header.offsetPermutation = alignOffset(header.offsetValues + count * sizeof(TypeValue), alignof(_TypeIndex));
+
+    /* Stream content after a placeholder header, then write actual header */
+    const std::string pathTmp = path + ".tmp";
+    bool written = false;
+    {
+        detail::MappedBimapWriter file(pathTmp);
+        file.write(&header, sizeof(_Header));
+
+        file.pad(static_cast<std::size_t>(header.offsetKeys));
+        for(std::size_t i = 0; i < count; ++i){
+            file.write(&keys[order[i]], sizeof(TypeKey));
+        }
+        file.pad(static_cast<std::size_t>(header.offsetValues));
+        for(std::size_t i = 0; i < count; ++i){
+            file.write(&values[order[i]], sizeof(TypeValue));
+        }
+        file.pad(static_cast<std::size_t>(header.offsetPermutation));
+        file.write(permutation.data(), count * sizeof(_TypeIndex));
+
+        header.checksum = file.checksum();
+        written = file.finish(header);
+    }
+    if(!written){
+        std::remove(pathTmp.c_str());
+        throw std::runtime_error("cmap::MappedBimap: cannot write " + path);
+    }
+
+    /* Replace previous file, which is kept if replacement fails */
+#if defined(_WIN32)
+    const bool replaced = MoveFileExA(pathTmp.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    const bool replaced = std::rename(pathTmp.c_str(), path.c_str()) == 0;
+#endif
+    if(!replaced){
+        std::remove(pathTmp.c_str());
+        throw std::runtime_error("cmap::MappedBimap: cannot write " + path);
+    }
+}
+
+/*!
+ * \brief Map file \c path
+ * \details
+ * Previous mapping is released. Only header and array of indexes are
+ * read (indexes must all reference a pair), keys and values are loaded
+ * on demand when elements are accessed.
+ *
+ * \param path
+ * Path of file written by write().
+ *
+ * \throw std::system_error
+ * Throw if file cannot be opened or mapped.
+ * \throw std::runtime_error
+ * Throw if file is not a mapped bimap file, has been written by an host
+ * of another byte order or for other types, is truncated or has
+ * corrupted indexes.
+ */
+MAPPEDBIMAP_TEMPLATE
+void MAPPEDBIMAP_CLASS::open(const std::string &path)
+{
+    close();
+
+    detail::MappedBimapFile file;
+    file.open(path);
+
+    _Header header;
+    if(file.size() < sizeof(_Header)){
+        throw std::runtime_error("cmap::MappedBimap: truncated file " + path);
+    }
+    std::memcpy(&header, file.data(), sizeof(_Header));
+
+    if(std::memcmp(header.magic, detail::MappedBimapMagic, sizeof(header.magic)) != 0){
+        throw std::runtime_error("cmap::MappedBimap: invalid file " + path);
+    }
+    if(header.endianness != _Header::Endianness){
+        throw std::runtime_error("cmap::MappedBimap: file " + path + " has been written with another byte order");
+    }
+    if(header.version != _Header::Version){
+        throw std::runtime_error("cmap::MappedBimap: unsupported version of file " + path);
+    }
+    if(header.keySize != sizeof(TypeKey) || header.valueSize != sizeof(TypeValue)){
+        throw std::runtime_error("cmap::MappedBimap: file " + path + " has been written with other types");
+    }
+
+    /* Check that arrays are aligned and fit in file (without overflow) */
+    const std::uint64_t size = file.size();
+    const auto fits = [size](std::uint64_t offset, std::uint64_t count, std::size_t sizeItem, std::size_t alignment){
+        return offset % alignment == 0 && offset >= sizeof(_Header) && offset <= size && count <= (size - offset) / sizeItem;
+    };
+    if(!fits(header.offsetKeys, header.count, sizeof(TypeKey), alignof(TypeKey))
+       || !fits(header.offsetValues, header.count, sizeof(TypeValue), alignof(TypeValue))
+       || !fits(header.offsetPermutation, header.count, sizeof(_TypeIndex), alignof(_TypeIndex))){
+        throw std::runtime_error("cmap::MappedBimap: truncated file " + path);
+    }
+
+    /* Lookups by value index arrays with permutation */
+    const _TypeIndex *permutation = reinterpret_cast<const _TypeIndex*>(file.data() + header.offsetPermutation);
+    const std::uint64_t count = header.count;
+    if(std::any_of(permutation, permutation + count, [count](_TypeIndex index){ return index >= count; })){
+        throw std::runtime_error("cmap::MappedBimap: corrupted indexes in file " + path);
+    }
+
+    m_file.swap(file);
+    m_keys = reinterpret_cast<const TypeKey*>(m_file.data() + header.offsetKeys);
+    m_values = reinterpret_cast<const TypeValue*>(m_file.data() + header.offsetValues);
+    m_permutation = reinterpret_cast<const _TypeIndex*>(m_file.data() + header.offsetPermutation);
+    m_size = static_cast<std::size_t>(header.count);
+}
+
+/*!
+ * \brief Release mapping
+ * \details
+ * References to elements are invalidated.
+ */
+MAPPEDBIMAP_TEMPLATE
+void MAPPEDBIMAP_CLASS::close()
+{
+    m_file.close();
+    m_keys = nullptr;
+    m_values = nullptr;
+    m_permutation = nullptr;
+    m_size = 0;
+}
+
+/*!
+ * \brief Check if a file is mapped
+ */
+MAPPEDBIMAP_TEMPLATE
+bool MAPPEDBIMAP_CLASS::isOpen() const
+{
+    return m_file.data() != nullptr;
+}
+
+/*!
+ * \brief Check that content of mapped file match its checksum
+ * \details
+ * Whole file is read.
+ *
+ * \return
+ * Returns \c true if content is valid, \c false if it has been
+ * corrupted or if no file is mapped.
+ */
+MAPPEDBIMAP_TEMPLATE
+bool MAPPEDBIMAP_CLASS::verifyChecksum() const
+{
+    if(!isOpen()){
+        return false;
+    }
+
+    _Header header;
+    std::memcpy(&header, m_file.data(), sizeof(_Header));
+    return header.checksum == detail::mappedBimapChecksum(m_file.data() + sizeof(_Header), m_file.size() - sizeof(_Header));
+}
+
+/*!
+ * \brief Check if bimap is empty
+ * \details
+ * A bimap without mapped file is empty.
+ */
+MAPPEDBIMAP_TEMPLATE
+bool MAPPEDBIMAP_CLASS::empty() const
+{
+    return m_size == 0;
+}
+
+/*!
+ * \brief Returns the number of elements
+ */
+MAPPEDBIMAP_TEMPLATE
+std::size_t MAPPEDBIMAP_CLASS::size() const
+{
+    return m_size;
+}
+
+/*!
+ * \brief Exchange mappings and comparison functions with \c other
+ */
+MAPPEDBIMAP_TEMPLATE
+void MAPPEDBIMAP_CLASS::swap(MappedBimap &other)
+{
+    using std::swap;
+
+    m_file.swap(other.m_file);
+    swap(m_keys, other.m_keys);
+    swap(m_values, other.m_values);
+    swap(m_permutation, other.m_permutation);
+    swap(m_size, other.m_size);
+    swap(m_compareKey, other.m_compareKey);
+    swap(m_compareValue, other.m_compareValue);
+}
+
+/*!
+ * \brief Use to retrieve value by key
+ *
+ * \param key
+ * Key of element to get.
+ * \return
+ * Return value associated to key, stored in mapped file.
+ *
+ * \throw std::out_of_range
+ * Throw if key cannot be found
+ */
+MAPPEDBIMAP_TEMPLATE
+const TypeValue &MAPPEDBIMAP_CLASS::getValue(const TypeKey &key) const
+{
+    const std::size_t pos = findKey(key);
+    if(pos == NoPos){
+        throw std::out_of_range("cmap::MappedBimap::getValue");
+    }
+
+    return m_values[pos];
+}
+
+/*!
+ * \brief Use to retrieve key by value
+ *
+ * \param value
+ * Value to use to retrieve key element.
+ * \return
+ * Return key associated to value, stored in mapped file.
+ *
+ * \throw std::out_of_range
+ * Throw if value cannot be found
+ */
+MAPPEDBIMAP_TEMPLATE
+const TypeKey &MAPPEDBIMAP_CLASS::getKey(const TypeValue &value) const
+{
+    const std::size_t pos = findValue(value);
+    if(pos == NoPos){
+        throw std::out_of_range("cmap::MappedBimap::getKey");
+    }
+
+    return m_keys[pos];
+}
+
+/*!
+ * \brief Retrieve value associated to \c key without throwing
+ *
+ * \param key
+ * Key of element to get.
+ * \param value
+ * Set to associated value if key is found, left untouched otherwise.
+ * \return
+ * Returns \c true if key has been found.
+ */
+MAPPEDBIMAP_TEMPLATE
+bool MAPPEDBIMAP_CLASS::tryGetValue(const TypeKey &key, TypeValue &value) const
+{
+    const std::size_t pos = findKey(key);
+    if(pos == NoPos){
+        return false;
+    }
+
+    value = m_values[pos];
+    return true;
+}
+
+/*!
+ * \brief Retrieve key associated to \c value without throwing
+ *
+ * \param value
+ * Value of element to get.
+ * \param key
+ * Set to associated key if value is found, left untouched otherwise.
+ * \return
+ * Returns \c true if value has been found.
+ */
+MAPPEDBIMAP_TEMPLATE
+bool MAPPEDBIMAP_CLASS::tryGetKey(const TypeValue &value, TypeKey &key) const
+{
+    const std::size_t pos = findValue(value);
+    if(pos == NoPos){
+        return false;
+    }
+
+    key = m_keys[pos];
+    return true;
+}
+
+/*!
+ * \brief Check if a key is stored
+ */
+MAPPEDBIMAP_TEMPLATE
+bool MAPPEDBIMAP_CLASS::containsKey(const TypeKey &key) const
+{
+    return findKey(key) != NoPos;
+}
+
+/*!
+ * \brief Check if a value is stored
+ */
+MAPPEDBIMAP_TEMPLATE
+bool MAPPEDBIMAP_CLASS::containsValue(const TypeValue &value) const
+{
+    return findValue(value) != NoPos;
+}
+
+/*!
+ * \brief Visit all elements, ordered by keys
+ *
+ * \param func
+ * Function called with <tt>(const TypeKey&, const TypeValue&)</tt>
+ * for each element.
+ */
+MAPPEDBIMAP_TEMPLATE
+template<class Func>
+void MAPPEDBIMAP_CLASS::forEach(Func func) const
+{
+    for(std::size_t i = 0; i < m_size; ++i){
+        func(m_keys[i], m_values[i]);
+    }
+}
+
+/*!
+ * \brief Returns the function object comparing keys
+ */
+MAPPEDBIMAP_TEMPLATE
+CompareKey MAPPEDBIMAP_CLASS::keyComp() const
+{
+    return m_compareKey;
+}
+
+/*!
+ * \brief Returns the function object comparing values
+ */
+MAPPEDBIMAP_TEMPLATE
+CompareValue MAPPEDBIMAP_CLASS::valueComp() const
+{
+    return m_compareValue;
+}
+
+/*!
+ * \brief Returns position of \c key in arrays sorted by keys,
+ * \c NoPos if not found
+ */
+MAPPEDBIMAP_TEMPLATE
+std::size_t MAPPEDBIMAP_CLASS::findKey(const TypeKey &key) const
+{
+    const TypeKey *last = m_keys + m_size;
+    const TypeKey *it = std::lower_bound(m_keys, last, key, m_compareKey);
+    if(it == last || m_compareKey(key, *it)){
+        return NoPos;
+    }
+
+    return static_cast<std::size_t>(it - m_keys);
+}
+
+/*!
+ * \brief Returns position of \c value in arrays sorted by keys,
+ * \c NoPos if not found
+ */
+MAPPEDBIMAP_TEMPLATE
+std::size_t MAPPEDBIMAP_CLASS::findValue(const TypeValue &value) const
+{
+    const _TypeIndex *last = m_permutation + m_size;
+    const _TypeIndex *it = std::lower_bound(m_permutation, last, value, [this](_TypeIndex index, const TypeValue &v){
+        return m_compareValue(m_values[index], v);
+    });
+    if(it == last || m_compareValue(value, m_values[*it])){
+        return NoPos;
+    }
+
+    return *it;
+}
+
+MAPPEDBIMAP_TEMPLATE
+std::size_t MAPPEDBIMAP_CLASS::alignOffset(std::size_t offset, std::size_t alignment)
+{
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+#undef MAPPEDBIMAP_TEMPLATE
+#undef MAPPEDBIMAP_CLASS
+
+} // Namespace cmap
+
+#endif // LCH_MAPPEDBIMAP_H
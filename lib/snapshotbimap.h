@@ -0,0 +1,478 @@
+#ifndef LCH_SNAPSHOTBIMAP_H
+#define LCH_SNAPSHOTBIMAP_H
+
+/*****************************/
+/* Class documentations      */
+/*****************************/
+
+/*!
+   \class cmap::SnapshotBimap
+   \brief Class use to share a read-mostly cmap::Bimap between threads.
+
+   Data is stored in immutable versions of \c cmap::Bimap. Writers build a
+   new version (a copy of current one, modified by update()) and publish it
+   with an atomic pointer swap. Readers take a snapshot of current version,
+   which stays valid and unchanged as long as snapshot is alive, and use
+   the normal constant API of \c cmap::Bimap (getValue(), getKey(),
+   iteration, etc...).
+
+   Old versions are reclaimed with epochs: each thread reading the container
+   owns a \c Reader, which publish the epoch it entered. A retired version is
+   destroyed once every reader has entered a later epoch (or is idle).
+   Taking a snapshot only performs loads and one store to the reader own
+   slot: there is no lock nor atomic read-modify-write on the read path, so
+   reads scale with the number of cores.
+
+   <b>Example: </b>
+   \code{.cpp}
+    cmap::SnapshotBimap<int, std::string> table;
+    table.insert(1, "ONE");
+
+    // Reading thread
+    auto reader = table.reader();            // Once per thread
+    {
+        auto snapshot = reader.snapshot();   // Wait-free
+        std::cout << snapshot->getValue(1);
+    }
+   \endcode
+
+   \note
+   Writers are serialized and copy the whole bimap: nodes of intrusive
+   trees cannot be shared between versions. This class is meant for
+   tables which are updated rarely, use update() to apply several
+   modifications with a single copy.
+
+   \warning
+   Readers and snapshots must be destroyed before their container.
+   A \c Reader (and its snapshots) must only be used by one thread at a time.
+
+   \sa cmap::Bimap, cmap::ConcurrentBimap
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "bimap.h"
+#include "bimapcommon.h"
+
+namespace cmap{
+
+/*****************************/
+/* Internal implementation   */
+/*****************************/
+
+namespace detail{
+
+/*!
+ * \brief Epoch announced by a reader
+ * \details
+ * Slots are padded, so readers never write to
+ * the same cache line.
+ */
+struct SnapshotBimapSlot
+{
+    static constexpr std::uint64_t Idle = std::numeric_limits<std::uint64_t>::max();
+
+    std::atomic<std::uint64_t> epoch{Idle};
+    bool used = false;
+
+    char padding[BimapCacheLineSize];
+};
+
+} // Namespace detail
+
+/*****************************/
+/* Class definitions         */
+/*****************************/
+
+template<class TypeKey, class TypeValue, class CompareKey = detail::BimapLess<TypeKey>, class CompareValue = detail::BimapLess<TypeValue>>
+class SnapshotBimap
+{
+public:
+    using container_type = Bimap<TypeKey, TypeValue, CompareKey, CompareValue>;
+    using key_type = TypeKey;
+    using mapped_type = TypeValue;
+
+    class Reader;
+
+    /*!
+     * \brief Handle on an immutable version of the container
+     * \details
+     * Version is kept alive until handle is destroyed.
+     */
+    class Snapshot
+    {
+        friend class Reader;
+
+    public:
+        Snapshot(Snapshot &&other) noexcept : m_reader(other.m_reader), m_data(other.m_data) { other.m_reader = nullptr; }
+        ~Snapshot() { release(); }
+
+        Snapshot(const Snapshot &other) = delete;
+        Snapshot& operator=(const Snapshot &other) = delete;
+        Snapshot& operator=(Snapshot &&other) = delete;
+
+    public:
+        const container_type& operator*() const { return *m_data; }
+        const container_type* operator->() const { return m_data; }
+        const container_type* get() const { return m_data; }
+
+        typename container_type::const_iterator begin() const { return m_data->cbegin(); }
+        typename container_type::const_iterator end() const { return m_data->cend(); }
+
+    private:
+        Snapshot(Reader *reader, const container_type *data) : m_reader(reader), m_data(data) {}
+        void release();
+
+    private:
+        Reader *m_reader;
+        const container_type *m_data;
+    };
+
+    /*!
+     * \brief Registration of a reading thread
+     * \details
+     * Creating a reader takes a lock, so it should be done once per
+     * thread and reused for each snapshot.
+     */
+    class Reader
+    {
+        friend class SnapshotBimap;
+        friend class Snapshot;
+
+    public:
+        Reader(Reader &&other) noexcept : m_owner(other.m_owner), m_slot(other.m_slot), m_depth(other.m_depth) { other.m_slot = nullptr; }
+        ~Reader();
+
+        Reader(const Reader &other) = delete;
+        Reader& operator=(const Reader &other) = delete;
+        Reader& operator=(Reader &&other) = delete;
+
+    public:
+        Snapshot snapshot();
+
+    private:
+        Reader(SnapshotBimap *owner, detail::SnapshotBimapSlot *slot) : m_owner(owner), m_slot(slot), m_depth(0) {}
+
+    private:
+        SnapshotBimap *m_owner;
+        detail::SnapshotBimapSlot *m_slot;
+        std::size_t m_depth;
+    };
+
+private:
+    using _Slot = detail::SnapshotBimapSlot;
+    using _Retired = std::pair<std::uint64_t, const container_type*>;
+
+public:
+    SnapshotBimap();
+    explicit SnapshotBimap(container_type data);
+    ~SnapshotBimap();
+
+    SnapshotBimap(const SnapshotBimap &other) = delete;
+    SnapshotBimap& operator=(const SnapshotBimap &other) = delete;
+
+public:
+    Reader reader();
+
+    template<class Func>
+    void update(Func func);
+    void assign(container_type data);
+
+    void clear();
+    void insert(const TypeKey &key, const TypeValue &value);
+    void erase(const TypeKey &key);
+
+    std::size_t reclaim();
+    std::size_t retiredCount() const;
+
+private:
+    void publish(std::unique_ptr<container_type> data);
+    std::size_t reclaimVersions();
+
+private:
+    std::atomic<const container_type*> m_current;
+    std::atomic<std::uint64_t> m_epoch;
+
+    mutable std::mutex m_mutexWriters;
+    std::vector<_Retired> m_retired;
+
+    std::mutex m_mutexReaders;
+    std::vector<std::unique_ptr<_Slot>> m_slots;
+};
+
+/*
+ * Functions implementations
+ * Class use template and methods cannot be defined in .cpp file.
+ * See https://isocpp.org/wiki/faq/templates#separate-template-fn-defn-from-decl
+ */
+
+#define SNAPSHOTBIMAP_TEMPLATE template<class TypeKey, class TypeValue, class CompareKey, class CompareValue>
+#define SNAPSHOTBIMAP_CLASS SnapshotBimap<TypeKey, TypeValue, CompareKey, CompareValue>
+
+/*!
+ * \brief Construct snapshot bimap with an empty version
+ */
+SNAPSHOTBIMAP_TEMPLATE
+SNAPSHOTBIMAP_CLASS::SnapshotBimap() : SnapshotBimap(container_type())
+{
+    /* Nothing to do */
+}
+
+/*!
+ * \brief Construct snapshot bimap
+ *
+ * \param data
+ * Bimap used as first version.
+ */
+SNAPSHOTBIMAP_TEMPLATE
+SNAPSHOTBIMAP_CLASS::SnapshotBimap(container_type data) :
+    m_current(new container_type(std::move(data))), m_epoch(0)
+{
+    /* Nothing to do */
+}
+
+/*!
+ * \brief Destroy snapshot bimap and all its versions
+ * \warning
+ * All readers must have been destroyed before.
+ */
+SNAPSHOTBIMAP_TEMPLATE
+SNAPSHOTBIMAP_CLASS::~SnapshotBimap()
+{
+    for(const _Retired &retired : m_retired){
+        delete retired.second;
+    }
+    delete m_current.load();
+}
+
+/*!
+ * \brief Register a new reader
+ * \details
+ * Slots of destroyed readers are reused.
+ *
+ * \return
+ * Returns reader to use to take snapshots.
+ */
+SNAPSHOTBIMAP_TEMPLATE
+typename SNAPSHOTBIMAP_CLASS::Reader SNAPSHOTBIMAP_CLASS::reader()
+{
+    std::lock_guard<std::mutex> lock(m_mutexReaders);
+
+    for(const auto &slot : m_slots){
+        if(!slot->used){
+            slot->used = true;
+            return Reader(this, slot.get());
+        }
+    }
+
+    m_slots.emplace_back(new _Slot());
+    m_slots.back()->used = true;
+    return Reader(this, m_slots.back().get());
+}
+
+/*!
+ * \brief Publish a new version built from current one
+ * \details
+ * Current version is copied, modified by \c func and published at once:
+ * readers see either all modifications or none of them. \n
+ * Writers are serialized, so \c func can safely read current version
+ * through its argument.
+ *
+ * \param func
+ * Function called with a reference to the new version
+ * (<tt>container_type&</tt>).
+ */
+SNAPSHOTBIMAP_TEMPLATE
+template<class Func>
+void SNAPSHOTBIMAP_CLASS::update(Func func)
+{
+    std::lock_guard<std::mutex> lock(m_mutexWriters);
+
+    std::unique_ptr<container_type> next(new container_type(*m_current.load()));
+    func(*next);
+    publish(std::move(next));
+}
+
+/*!
+ * \brief Publish \c data as new version
+ * \details
+ * Current version is not copied, use this method when
+ * table is rebuilt from scratch.
+ */
+SNAPSHOTBIMAP_TEMPLATE
+void SNAPSHOTBIMAP_CLASS::assign(container_type data)
+{
+    std::unique_ptr<container_type> next(new container_type(std::move(data)));
+
+    std::lock_guard<std::mutex> lock(m_mutexWriters);
+    publish(std::move(next));
+}
+
+/*!
+ * \brief Publish an empty version
+ */
+SNAPSHOTBIMAP_TEMPLATE
+void SNAPSHOTBIMAP_CLASS::clear()
+{
+    assign(container_type());
+}
+
+/*!
+ * \brief Publish a new version containing pair
+ * \sa update()
+ */
+SNAPSHOTBIMAP_TEMPLATE
+void SNAPSHOTBIMAP_CLASS::insert(const TypeKey &key, const TypeValue &value)
+{
+    update([&key, &value](container_type &data){
+        data.insert(key, value);
+    });
+}
+
+/*!
+ * \brief Publish a new version without element of key
+ * \sa update()
+ */
+SNAPSHOTBIMAP_TEMPLATE
+void SNAPSHOTBIMAP_CLASS::erase(const TypeKey &key)
+{
+    update([&key](container_type &data){
+        data.erase(key);
+    });
+}
+
+/*!
+ * \brief Destroy retired versions which are no longer used by any reader
+ * \details
+ * This is done after each publication, this method is only needed
+ * to release memory of last retired versions once readers are done.
+ *
+ * \return
+ * Returns number of versions which are still retired.
+ */
+SNAPSHOTBIMAP_TEMPLATE
+std::size_t SNAPSHOTBIMAP_CLASS::reclaim()
+{
+    std::lock_guard<std::mutex> lock(m_mutexWriters);
+    return reclaimVersions();
+}
+
+/*!
+ * \brief Returns number of retired versions waiting for reclamation
+ */
+SNAPSHOTBIMAP_TEMPLATE
+std::size_t SNAPSHOTBIMAP_CLASS::retiredCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutexWriters);
+    return m_retired.size();
+}
+
+/*!
+ * \brief Swap current version and retire old one
+ * \details
+ * Retired version is tagged with epoch of publication, readers entering
+ * after epoch increment are guaranteed to load the new version. \n
+ * Writers mutex must be locked.
+ */
+SNAPSHOTBIMAP_TEMPLATE
+void SNAPSHOTBIMAP_CLASS::publish(std::unique_ptr<container_type> data)
+{
+    m_retired.reserve(m_retired.size() + 1);
+
+    const container_type *old = m_current.exchange(data.release());
+    const std::uint64_t epoch = m_epoch.fetch_add(1);
+    m_retired.emplace_back(epoch, old);
+
+    reclaimVersions();
+}
+
+/*!
+ * \brief Destroy versions retired before epoch of all active readers
+ * \details
+ * Writers mutex must be locked.
+ */
+SNAPSHOTBIMAP_TEMPLATE
+std::size_t SNAPSHOTBIMAP_CLASS::reclaimVersions()
+{
+    std::uint64_t minEpoch = _Slot::Idle;
+    {
+        std::lock_guard<std::mutex> lock(m_mutexReaders);
+        for(const auto &slot : m_slots){
+            minEpoch = std::min(minEpoch, slot->epoch.load());
+        }
+    }
+
+    auto itKeep = m_retired.begin();
+    for(auto it = m_retired.begin(); it != m_retired.end(); ++it){
+        if(it->first < minEpoch){
+            delete it->second;
+        }else{
+            *itKeep++ = *it;
+        }
+    }
+    m_retired.erase(itKeep, m_retired.end());
+
+    return m_retired.size();
+}
+
+/*!
+ * \brief Unregister reader
+ * \warning
+ * All snapshots taken from this reader must have been destroyed.
+ */
+SNAPSHOTBIMAP_TEMPLATE
+SNAPSHOTBIMAP_CLASS::Reader::~Reader()
+{
+    if(!m_slot){
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_owner->m_mutexReaders);
+    m_slot->epoch.store(_Slot::Idle);
+    m_slot->used = false;
+}
+
+/*!
+ * \brief Take a snapshot of current version
+ * \details
+ * This method is wait-free: reader announces epoch in its own slot
+ * and loads current version. Snapshots can be nested, only the
+ * outermost announces an epoch.
+ *
+ * \return
+ * Returns handle on current version.
+ */
+SNAPSHOTBIMAP_TEMPLATE
+typename SNAPSHOTBIMAP_CLASS::Snapshot SNAPSHOTBIMAP_CLASS::Reader::snapshot()
+{
+    /* Announcement must be visible before loading version (sequentially consistent) */
+    if(m_depth++ == 0){
+        m_slot->epoch.store(m_owner->m_epoch.load());
+    }
+
+    return Snapshot(this, m_owner->m_current.load());
+}
+
+SNAPSHOTBIMAP_TEMPLATE
+void SNAPSHOTBIMAP_CLASS::Snapshot::release()
+{
+    if(m_reader && --m_reader->m_depth == 0){
+        m_reader->m_slot->epoch.store(_Slot::Idle, std::memory_order_release);
+    }
+    m_reader = nullptr;
+}
+
+#undef SNAPSHOTBIMAP_TEMPLATE
+#undef SNAPSHOTBIMAP_CLASS
+
+} // Namespace cmap
+
+#endif // LCH_SNAPSHOTBIMAP_H
@@ -0,0 +1,1480 @@
+#ifndef LCH_SORTEDVECTORBIMAP_H
+#define LCH_SORTEDVECTORBIMAP_H
+
+/*****************************/
+/* Class documentations      */
+/*****************************/
+
+/*!
+   \class cmap::SortedVectorBimap
+   \brief Class use to provide read-optimized bi-directional map support.
+
+   This class provide the same interface than cmap::Bimap but pairs are stored
+   in a single contiguous array sorted by keys, and values are indexed by an
+   array of 32-bits indexes sorted by values. Both lookups are binary searches
+   over contiguous memory (complexity: <b>O(log(n))</b>).
+
+   \note
+   This container is designed for maps which are built once and then only
+   read: use the range constructor to sort all pairs once in
+   <b>O(n log(n))</b>. \n
+   insert() and erase() are still available but have a complexity of <b>O(n)</b>.
+
+   \note
+   Number of elements is limited to \c 2^32-1.
+
+   \sa cmap::Bimap
+*/
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "bimapcommon.h"
+#include "bimapstats.h"
+
+namespace cmap{
+
+/*****************************/
+/* Class definitions         */
+/*****************************/
+
+template<class TypeKey, class TypeValue, class CompareKey = detail::BimapLess<TypeKey>, class CompareValue = detail::BimapLess<TypeValue>>
+class SortedVectorBimap
+{
+public:
+    using key_type = TypeKey;
+    using mapped_type = TypeValue;
+    using value_type = std::pair<TypeKey, TypeValue>;
+    using size_type = std::size_t;
+
+    using key_compare = CompareKey;
+    using value_compare = CompareValue;
+
+private:
+    using _TypeNode = std::pair<TypeKey, TypeValue>; // Used to implement std::initializer_list<T> support
+
+    using _TypeIndex = std::uint32_t;
+    using _ContainerData = std::vector<value_type>;
+    using _ContainerPermutation = std::vector<_TypeIndex>;
+
+public:
+    using iterator = typename _ContainerData::const_iterator;
+    using const_iterator = iterator;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+public:
+    SortedVectorBimap();
+    explicit SortedVectorBimap(const CompareKey &compareKey, const CompareValue &compareValue = CompareValue());
+    SortedVectorBimap(const std::initializer_list<_TypeNode> &args);
+
+    template<class InputIt>
+    SortedVectorBimap(InputIt first, InputIt last,
+                      const CompareKey &compareKey = CompareKey(), const CompareValue &compareValue = CompareValue());
+
+public:
+    bool empty() const;
+    std::size_t size() const;
+    std::size_t maxSize() const;
+
+    void clear();
+    void insert(const TypeKey &key, const TypeValue &value);
+    void insert(TypeKey &&key, TypeValue &&value);
+    void erase(const TypeKey &key);
+    void swap(SortedVectorBimap &other);
+
+    template<class InputIt>
+    void assign(InputIt first, InputIt last);
+    template<class InputIt, class Executor>
+    void assign(InputIt first, InputIt last, Executor &executor);
+
+    const TypeValue& getValue(const TypeKey &key) const;
+    const TypeKey& getKey(const TypeValue &value) const;
+
+    template<class K, class C = CompareKey, detail::BimapEnableTransparent<C> = 0>
+    const TypeValue& getValue(const K &key) const;
+    template<class V, class C = CompareValue, detail::BimapEnableTransparent<C> = 0>
+    const TypeKey& getKey(const V &value) const;
+
+    const_iterator findByKey(const TypeKey &key) const;
+    const_iterator findByValue(const TypeValue &value) const;
+    bool containsKey(const TypeKey &key) const;
+    bool containsValue(const TypeValue &value) const;
+
+    template<class K, class C = CompareKey, detail::BimapEnableTransparent<C> = 0>
+    const_iterator findByKey(const K &key) const;
+    template<class V, class C = CompareValue, detail::BimapEnableTransparent<C> = 0>
+    const_iterator findByValue(const V &value) const;
+    template<class K, class C = CompareKey, detail::BimapEnableTransparent<C> = 0>
+    bool containsKey(const K &key) const;
+    template<class V, class C = CompareValue, detail::BimapEnableTransparent<C> = 0>
+    bool containsValue(const V &value) const;
+
+    std::size_t getValues(const TypeKey *keys, std::size_t count, TypeValue *values, bool *found = nullptr) const;
+    std::size_t getKeys(const TypeValue *values, std::size_t count, TypeKey *keys, bool *found = nullptr) const;
+
+    template<class... Args>
+    std::pair<iterator, bool> emplace(Args&&... args);
+    std::pair<iterator, bool> tryInsert(const TypeKey &key, const TypeValue &value);
+    std::pair<iterator, bool> tryInsert(TypeKey &&key, TypeValue &&value);
+
+    std::pair<iterator, bool> insertOrAssign(const TypeKey &key, const TypeValue &value);
+    std::pair<iterator, bool> insertOrAssign(TypeKey &&key, TypeValue &&value);
+    std::pair<iterator, bool> replace(const TypeKey &key, const TypeValue &value, ReplacePolicy policy);
+    std::pair<iterator, bool> replace(TypeKey &&key, TypeValue &&value, ReplacePolicy policy);
+
+public:
+    std::size_t capacity() const;
+    void reserve(std::size_t count);
+    void shrinkToFit();
+
+    CompareKey keyComp() const;
+    CompareValue valueComp() const;
+
+    BimapMemoryUsage memoryUsage() const;
+
+#if defined(BIMAP_ENABLE_STATS)
+    BimapStats& stats() const;
+#endif
+
+private:
+    void insert(_TypeNode &&node);
+    void insert(const _TypeNode &node);
+
+    template<class K, class V>
+    void insertPair(K &&key, V &&value);
+    template<class K, class V>
+    std::pair<iterator, bool> tryInsertPair(K &&key, V &&value);
+    template<class K, class V>
+    std::pair<iterator, bool> linkPair(K &&key, V &&value);
+    template<class K, class V>
+    std::pair<iterator, bool> replacePair(K &&key, V &&value, bool overwriteLeft, bool overwriteRight, bool &inserted);
+
+    template<class K>
+    typename _ContainerData::const_iterator findKey(const K &key) const;
+    template<class V>
+    typename _ContainerPermutation::const_iterator findValue(const V &value) const;
+
+    template<class K>
+    typename _ContainerData::const_iterator lowerBoundKey(const K &key) const;
+    template<class V>
+    typename _ContainerPermutation::const_iterator lowerBoundValue(const V &value) const;
+
+    void eraseAt(std::size_t index);
+    void build();
+    template<class Executor>
+    void build(Executor &executor);
+
+public:
+    iterator begin();
+    const_iterator cbegin() const;
+    reverse_iterator rbegin();
+    const_reverse_iterator crbegin() const;
+    iterator end();
+    const_iterator cend() const;
+    reverse_iterator rend();
+    const_reverse_iterator crend() const;
+
+private:
+    _ContainerData m_data;
+    _ContainerPermutation m_permutation;
+
+    CompareKey m_compareKey;
+    CompareValue m_compareValue;
+
+#if defined(BIMAP_ENABLE_STATS)
+    mutable BimapStats m_stats;
+#endif
+};
+
+/*
+ * Functions implementations
+ * Class use template and methods cannot be defined in .cpp file.
+ * See https://isocpp.org/wiki/faq/templates#separate-template-fn-defn-from-decl
+ */
+
+#define SORTEDVECTORBIMAP_TEMPLATE template<class TypeKey, class TypeValue, class CompareKey, class CompareValue>
+#define SORTEDVECTORBIMAP_CLASS SortedVectorBimap<TypeKey, TypeValue, CompareKey, CompareValue>
+
+/*!
+ * \brief Construct empty sorted vector bimap
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+SORTEDVECTORBIMAP_CLASS::SortedVectorBimap() : SortedVectorBimap(CompareKey())
+{
+    /* Nothing to do */
+}
+
+/*!
+ * \brief Construct empty sorted vector bimap
+ *
+ * \param compareKey
+ * Comparison function used to order keys.
+ * \param compareValue
+ * Comparison function used to order values.
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+SORTEDVECTORBIMAP_CLASS::SortedVectorBimap(const CompareKey &compareKey, const CompareValue &compareValue) :
+    m_compareKey(compareKey), m_compareValue(compareValue)
+{
+    /* Nothing to do */
+}
+
+/*!
+ * \brief Construct sorted vector bimap with \c std::initializer_list
+ * \details
+ * Pairs are sorted only once, see range constructor.
+ *
+ * \param args
+ * List to use to construct sorted vector bimap.
+ *
+ * \throw std::invalid_argument
+ * Throw if a key or a value is present more than once
+ *
+ * <b>Example: </b>
+ * \code{.c}
+    const cmap::SortedVectorBimap<int, std::string> m_mapNumberToString =
+    {
+        {1, "ONE"},
+        {2, "TWO"},
+        {3, "THREE"}
+    };
+ * \endcode
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+SORTEDVECTORBIMAP_CLASS::SortedVectorBimap(const std::initializer_list<_TypeNode> &args) :
+    SortedVectorBimap(args.begin(), args.end())
+{
+    /* Nothing to do */
+}
+
+/*!
+ * \brief Construct sorted vector bimap from a range of pairs
+ * \details
+ * Range doesn't have to be sorted: pairs are copied then sorted once
+ * by keys, and indexes are sorted once by values
+ * (complexity: <b>O(n log(n))</b>).
+ *
+ * \param first, last
+ * Range of pairs to use to construct sorted vector bimap.
+ * \param compareKey
+ * Comparison function used to order keys.
+ * \param compareValue
+ * Comparison function used to order values.
+ *
+ * \throw std::invalid_argument
+ * Throw if a key or a value is present more than once
+ * \throw std::length_error
+ * Throw if range is larger than maxSize()
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+template<class InputIt>
+SORTEDVECTORBIMAP_CLASS::SortedVectorBimap(InputIt first, InputIt last, const CompareKey &compareKey, const CompareValue &compareValue) :
+    SortedVectorBimap(compareKey, compareValue)
+{
+    assign(first, last);
+}
+
+/*!
+ * \brief Checks whether the container is empty
+ *
+ * \return
+ * Returns \c true if the container is empty, \c false otherwise
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+bool SORTEDVECTORBIMAP_CLASS::empty() const
+{
+    return m_data.empty();
+}
+
+/*!
+ * \brief Returns the number of elements
+ *
+ * \return
+ * The number of elements in the container
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+std::size_t SORTEDVECTORBIMAP_CLASS::size() const
+{
+    return m_data.size();
+}
+
+/*!
+ * \brief Returns the maximum possible number of elements
+ *
+ * \return
+ * Maximum number of elements
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+std::size_t SORTEDVECTORBIMAP_CLASS::maxSize() const
+{
+    return std::min<std::size_t>(m_data.max_size(), std::numeric_limits<_TypeIndex>::max());
+}
+
+/*!
+ * \brief Clears the contents
+ * \details
+ * Erases all elements from the container. After this call, size() returns zero. \n
+ * Allocated memory is kept, so capacity() is unchanged.
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+void SORTEDVECTORBIMAP_CLASS::clear()
+{
+    m_data.clear();
+    m_permutation.clear();
+}
+
+/*!
+ * \brief Insert item to sorted vector bimap
+ * \details
+ * Complexity is <b>O(n)</b>, prefer the range constructor
+ * or assign() to insert many pairs.
+ *
+ * \param key
+ * Key of element, if key already exist, it will be replaced.
+ * \param value
+ * Value associated to the key, if value is already associated
+ * to another key, this association will be removed.
+ *
+ * \throw std::length_error
+ * Throw if container is full
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+void SORTEDVECTORBIMAP_CLASS::insert(const TypeKey &key, const TypeValue &value)
+{
+    insertPair(key, value);
+}
+
+/*!
+ * \overload
+ * \details
+ * Key and value are moved into the new element.
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+void SORTEDVECTORBIMAP_CLASS::insert(TypeKey &&key, TypeValue &&value)
+{
+    insertPair(std::move(key), std::move(value));
+}
+
+/*!
+ * \overload
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+void SORTEDVECTORBIMAP_CLASS::insert(_TypeNode &&node)
+{
+    insert(std::move(node.first), std::move(node.second));
+}
+
+/*!
+ * \overload
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+void SORTEDVECTORBIMAP_CLASS::insert(const _TypeNode &node)
+{
+    insert(node.first, node.second);
+}
+
+/*!
+ * \brief Use to erase an element
+ * \details
+ * Complexity is <b>O(n)</b>.
+ *
+ * \param key
+ * Key of element to erase, if key doesn't exist, this
+ * method do nothing.
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+void SORTEDVECTORBIMAP_CLASS::erase(const TypeKey &key)
+{
+    auto it = findKey(key);
+    if(it == m_data.cend()){
+        return;
+    }
+
+    eraseAt(it - m_data.cbegin());
+    BIMAP_STATS_RECORD(m_stats, Erase);
+}
+
+/*!
+ * \brief Exchanges the contents of the container with those of \c other
+ * \details
+ * Does not invoke any move, copy, or swap operations on individual elements.
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+void SORTEDVECTORBIMAP_CLASS::swap(SortedVectorBimap &other)
+{
+    using std::swap;
+
+    m_data.swap(other.m_data);
+    m_permutation.swap(other.m_permutation);
+    swap(m_compareKey, other.m_compareKey);
+    swap(m_compareValue, other.m_compareValue);
+}
+
+/*!
+ * \brief Replace contents with a range of pairs
+ * \details
+ * Range doesn't have to be sorted: pairs are copied then sorted once
+ * by keys, and indexes are sorted once by values
+ * (complexity: <b>O(n log(n))</b>).
+ *
+ * \param first, last
+ * Range of pairs to copy.
+ *
+ * \throw std::invalid_argument
+ * Throw if a key or a value is present more than once, container
+ * is left empty.
+ * \throw std::length_error
+ * Throw if range is larger than maxSize()
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+template<class InputIt>
+void SORTEDVECTORBIMAP_CLASS::assign(InputIt first, InputIt last)
+{
+    clear();
+    m_data.assign(first, last);
+
+    try{
+        build();
+    }catch(...){
+        clear();
+        throw;
+    }
+    BIMAP_STATS_RECORD_COUNT(m_stats, Insert, m_data.size());
+}
+
+/*!
+ * \brief Replace content of sorted vector with a range of pairs, using
+ * tasks of \c executor
+ * \overload
+ * \details
+ * Pairs are copied by calling thread, then sorted by keys and indexes
+ * sorted by values with all tasks of \c executor (see bimapparallel.h
+ * for executors).
+ *
+ * \param first, last
+ * Range of pairs to copy.
+ * \param executor
+ * Executor running tasks, \c cmap::BimapThreadExecutor for example.
+ *
+ * \throw std::invalid_argument
+ * Throw if a key or a value is present more than once, container
+ * is left empty.
+ * \throw std::length_error
+ * Throw if range is larger than maxSize()
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+template<class InputIt, class Executor>
+void SORTEDVECTORBIMAP_CLASS::assign(InputIt first, InputIt last, Executor &executor)
+{
+    clear();
+    m_data.assign(first, last);
+
+    try{
+        build(executor);
+    }catch(...){
+        clear();
+        throw;
+    }
+    BIMAP_STATS_RECORD_COUNT(m_stats, Insert, m_data.size());
+}
+
+/*!
+ * \brief Use to retrieve value by key
+ *
+ * \param key
+ * Key of element to get.
+ * \return
+ * Return value associated to key.
+ *
+ * \throw std::out_of_range
+ * Throw if key cannot be found
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+const TypeValue &SORTEDVECTORBIMAP_CLASS::getValue(const TypeKey &key) const
+{
+    BIMAP_STATS_LOOKUP_BEGIN(m_stats);
+    auto it = findKey(key);
+    BIMAP_STATS_LOOKUP_END(m_stats, it != m_data.cend());
+    if(it == m_data.cend()){
+        throw std::out_of_range("cmap::SortedVectorBimap::getValue");
+    }
+
+    return it->second;
+}
+
+/*!
+ * \brief Use to retrieve key by value
+ *
+ * \param value
+ * Value to use to retrieve key element.
+ * \return
+ * Return key associated to value.
+ *
+ * \throw std::out_of_range
+ * Throw if value cannot be found
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+const TypeKey &SORTEDVECTORBIMAP_CLASS::getKey(const TypeValue &value) const
+{
+    BIMAP_STATS_LOOKUP_BEGIN(m_stats);
+    auto it = findValue(value);
+    BIMAP_STATS_LOOKUP_END(m_stats, it != m_permutation.cend());
+    if(it == m_permutation.cend()){
+        throw std::out_of_range("cmap::SortedVectorBimap::getKey");
+    }
+
+    return m_data[*it].first;
+}
+
+/*!
+ * \brief Use to retrieve value by an object comparable to keys
+ * \details
+ * This overload is only available when \c CompareKey is transparent
+ * (which is the case by default with C++14), so no temporary key is
+ * constructed to perform the lookup.
+ *
+ * \param key
+ * Object comparable to keys.
+ * \return
+ * Return value associated to key.
+ *
+ * \throw std::out_of_range
+ * Throw if key cannot be found
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+template<class K, class C, detail::BimapEnableTransparent<C>>
+const TypeValue &SORTEDVECTORBIMAP_CLASS::getValue(const K &key) const
+{
+    BIMAP_STATS_LOOKUP_BEGIN(m_stats);
+    auto it = findKey(key);
+    BIMAP_STATS_LOOKUP_END(m_stats, it != m_data.cend());
+    if(it == m_data.cend()){
+        throw std::out_of_range("cmap::SortedVectorBimap::getValue");
+    }
+
+    return it->second;
+}
+
+/*!
+ * \brief Use to retrieve key by an object comparable to values
+ * \details
+ * This overload is only available when \c CompareValue is transparent
+ * (which is the case by default with C++14), so no temporary value is
+ * constructed to perform the lookup.
+ *
+ * \param value
+ * Object comparable to values.
+ * \return
+ * Return key associated to value.
+ *
+ * \throw std::out_of_range
+ * Throw if value cannot be found
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+template<class V, class C, detail::BimapEnableTransparent<C>>
+const TypeKey &SORTEDVECTORBIMAP_CLASS::getKey(const V &value) const
+{
+    BIMAP_STATS_LOOKUP_BEGIN(m_stats);
+    auto it = findValue(value);
+    BIMAP_STATS_LOOKUP_END(m_stats, it != m_permutation.cend());
+    if(it == m_permutation.cend()){
+        throw std::out_of_range("cmap::SortedVectorBimap::getKey");
+    }
+
+    return m_data[*it].first;
+}
+
+/*!
+ * \brief Use to search an element by key
+ * \details
+ * Unlike getValue(), this method never throw: a missing key
+ * cost the same than a found one.
+ *
+ * \param key
+ * Key of element to search.
+ * \return
+ * Return iterator to element, equal to \c cend() if key cannot be found.
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+typename SORTEDVECTORBIMAP_CLASS::const_iterator SORTEDVECTORBIMAP_CLASS::findByKey(const TypeKey &key) const
+{
+    return findKey(key);
+}
+
+/*!
+ * \brief Use to search an element by value
+ * \details
+ * Unlike getKey(), this method never throw: a missing value
+ * cost the same than a found one.
+ *
+ * \param value
+ * Value of element to search.
+ * \return
+ * Return iterator to element, equal to \c cend() if value cannot be found.
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+typename SORTEDVECTORBIMAP_CLASS::const_iterator SORTEDVECTORBIMAP_CLASS::findByValue(const TypeValue &value) const
+{
+    auto it = findValue(value);
+    if(it == m_permutation.cend()){
+        return cend();
+    }
+
+    return m_data.cbegin() + *it;
+}
+
+/*!
+ * \brief Checks if bimap contains an element with key \c key
+ *
+ * \param key
+ * Key of element to search.
+ * \return
+ * Returns \c true if key exists, \c false otherwise.
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+bool SORTEDVECTORBIMAP_CLASS::containsKey(const TypeKey &key) const
+{
+    return findByKey(key) != cend();
+}
+
+/*!
+ * \brief Checks if bimap contains an element with value \c value
+ *
+ * \param value
+ * Value of element to search.
+ * \return
+ * Returns \c true if value exists, \c false otherwise.
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+bool SORTEDVECTORBIMAP_CLASS::containsValue(const TypeValue &value) const
+{
+    return findByValue(value) != cend();
+}
+
+/*!
+ * \brief Use to search an element by an object comparable to keys
+ * \details
+ * This overload is only available when \c CompareKey is transparent.
+ *
+ * \param key
+ * Object comparable to keys.
+ * \return
+ * Return iterator to element, equal to \c cend() if key cannot be found.
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+template<class K, class C, detail::BimapEnableTransparent<C>>
+typename SORTEDVECTORBIMAP_CLASS::const_iterator SORTEDVECTORBIMAP_CLASS::findByKey(const K &key) const
+{
+    return findKey(key);
+}
+
+/*!
+ * \brief Use to search an element by an object comparable to values
+ * \details
+ * This overload is only available when \c CompareValue is transparent.
+ *
+ * \param value
+ * Object comparable to values.
+ * \return
+ * Return iterator to element, equal to \c cend() if value cannot be found.
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+template<class V, class C, detail::BimapEnableTransparent<C>>
+typename SORTEDVECTORBIMAP_CLASS::const_iterator SORTEDVECTORBIMAP_CLASS::findByValue(const V &value) const
+{
+    auto it = findValue(value);
+    if(it == m_permutation.cend()){
+        return cend();
+    }
+
+    return m_data.cbegin() + *it;
+}
+
+/*!
+ * \brief Checks if bimap contains an element with key
+ * equivalent to \c key
+ * \details
+ * This overload is only available when \c CompareKey is transparent.
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+template<class K, class C, detail::BimapEnableTransparent<C>>
+bool SORTEDVECTORBIMAP_CLASS::containsKey(const K &key) const
+{
+    return findByKey(key) != cend();
+}
+
+/*!
+ * \brief Checks if bimap contains an element with value
+ * equivalent to \c value
+ * \details
+ * This overload is only available when \c CompareValue is transparent.
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+template<class V, class C, detail::BimapEnableTransparent<C>>
+bool SORTEDVECTORBIMAP_CLASS::containsValue(const V &value) const
+{
+    return findByValue(value) != cend();
+}
+
+/*!
+ * \brief Retrieve values of several keys at once
+ * \details
+ * Searches are interleaved: all binary searches of a group of keys
+ * share the same sequence of ranges, so they are advanced together and each
+ * one prefetches its next probe while others are processed. Prefer this
+ * method to a loop of getValue() for large batches. \n
+ * Misses are reported in \c found instead of throwing, elements of
+ * \c values matching a missing key are left untouched.
+ *
+ * \param keys
+ * Array of \c count keys to search.
+ * \param count
+ * Number of keys to search.
+ * \param values
+ * Array of \c count elements, receiving value associated to each key.
+ * \param found
+ * Array of \c count booleans set to \c true if key has been found,
+ * can be \c nullptr.
+ * \return
+ * Returns number of keys found.
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+std::size_t SORTEDVECTORBIMAP_CLASS::getValues(const TypeKey *keys, std::size_t count, TypeValue *values, bool *found) const
+{
+    std::size_t bases[detail::BimapBatchWidth];
+    const std::size_t size = m_data.size();
+    std::size_t nbFound = 0;
+
+    for(std::size_t first = 0; first < count; first += detail::BimapBatchWidth){
+        const std::size_t width = std::min(detail::BimapBatchWidth, count - first);
+        const TypeKey *group = keys + first;
+
+        /* Branchless lower bound, all searches use the same lengths */
+        std::fill(bases, bases + width, 0);
+        for(std::size_t len = size; len > 1; len -= len / 2){
+            const std::size_t half = len / 2;
+            const std::size_t next = (len - half) / 2;
+
+            for(std::size_t i = 0; i < width; ++i){
+                bases[i] = m_compareKey(m_data[bases[i] + half].first, group[i]) ? bases[i] + half : bases[i];
+                detail::bimapPrefetch(&m_data[bases[i] + next]);
+            }
+        }
+
+        for(std::size_t i = 0; i < width; ++i){
+            std::size_t index = bases[i];
+            if(index < size && m_compareKey(m_data[index].first, group[i])){
+                ++index;
+            }
+
+            const bool isFound = index < size && !m_compareKey(group[i], m_data[index].first);
+            if(isFound){
+                values[first + i] = m_data[index].second;
+                ++nbFound;
+            }
+            if(found){
+                found[first + i] = isFound;
+            }
+        }
+    }
+
+    return nbFound;
+}
+
+/*!
+ * \brief Retrieve keys of several values at once
+ * \details
+ * Reverse direction of getValues().
+ *
+ * \param values
+ * Array of \c count values to search.
+ * \param count
+ * Number of values to search.
+ * \param keys
+ * Array of \c count elements, receiving key associated to each value.
+ * \param found
+ * Array of \c count booleans set to \c true if value has been found,
+ * can be \c nullptr.
+ * \return
+ * Returns number of values found.
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+std::size_t SORTEDVECTORBIMAP_CLASS::getKeys(const TypeValue *values, std::size_t count, TypeKey *keys, bool *found) const
+{
+    std::size_t bases[detail::BimapBatchWidth];
+    const std::size_t size = m_permutation.size();
+    std::size_t nbFound = 0;
+
+    for(std::size_t first = 0; first < count; first += detail::BimapBatchWidth){
+        const std::size_t width = std::min(detail::BimapBatchWidth, count - first);
+        const TypeValue *group = values + first;
+
+        /* Branchless lower bound over permutation, all searches use the same lengths */
+        std::fill(bases, bases + width, 0);
+        for(std::size_t len = size; len > 1; len -= len / 2){
+            const std::size_t half = len / 2;
+            const std::size_t next = (len - half) / 2;
+
+            for(std::size_t i = 0; i < width; ++i){
+                bases[i] = m_compareValue(m_data[m_permutation[bases[i] + half]].second, group[i]) ? bases[i] + half : bases[i];
+                detail::bimapPrefetch(&m_data[m_permutation[bases[i] + next]]);
+            }
+        }
+
+        for(std::size_t i = 0; i < width; ++i){
+            std::size_t index = bases[i];
+            if(index < size && m_compareValue(m_data[m_permutation[index]].second, group[i])){
+                ++index;
+            }
+
+            const bool isFound = index < size && !m_compareValue(group[i], m_data[m_permutation[index]].second);
+            if(isFound){
+                keys[first + i] = m_data[m_permutation[index]].first;
+                ++nbFound;
+            }
+            if(found){
+                found[first + i] = isFound;
+            }
+        }
+    }
+
+    return nbFound;
+}
+
+/*!
+ * \brief Construct element if neither its key nor
+ * its value already exist
+ * \details
+ * Element is constructed from \c args (like \c std::pair constructors)
+ * then moved at its sorted position, unlike insert(), existing elements
+ * are never replaced. \n
+ * Complexity is <b>O(n)</b>, like insert().
+ *
+ * \param args
+ * Arguments to forward to the constructor of the element.
+ * \return
+ * Returns a pair consisting of an iterator to the inserted element (or to
+ * the element that prevented the insertion, element with same key has precedence)
+ * and a boolean set to \c true if insertion took place.
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+template<class... Args>
+std::pair<typename SORTEDVECTORBIMAP_CLASS::iterator, bool> SORTEDVECTORBIMAP_CLASS::emplace(Args&&... args)
+{
+    value_type pair(std::forward<Args>(args)...);
+    return tryInsertPair(std::move(pair.first), std::move(pair.second));
+}
+
+/*!
+ * \brief Insert element if neither its key nor its value
+ * already exist
+ * \details
+ * Unlike emplace(), no element is constructed when insertion
+ * fails, so arguments are never copied (or moved) in this case. \n
+ * Complexity is <b>O(n)</b>, like insert().
+ *
+ * \param key
+ * Key of element.
+ * \param value
+ * Value associated to the key.
+ * \return
+ * Returns a pair consisting of an iterator to the inserted element (or to
+ * the element that prevented the insertion, element with same key has precedence)
+ * and a boolean set to \c true if insertion took place.
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+std::pair<typename SORTEDVECTORBIMAP_CLASS::iterator, bool> SORTEDVECTORBIMAP_CLASS::tryInsert(const TypeKey &key, const TypeValue &value)
+{
+    return tryInsertPair(key, value);
+}
+
+/*!
+ * \overload
+ * \details
+ * Key and value are moved only if insertion took place.
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+std::pair<typename SORTEDVECTORBIMAP_CLASS::iterator, bool> SORTEDVECTORBIMAP_CLASS::tryInsert(TypeKey &&key, TypeValue &&value)
+{
+    return tryInsertPair(std::move(key), std::move(value));
+}
+
+/*!
+ * \brief Insert element, or assign value of existing key
+ * \details
+ * Like insert(), both sides are kept consistent: if \c value was
+ * associated to another key, this association is removed. \n
+ * Complexity is <b>O(n)</b>, like insert().
+ *
+ * \param key
+ * Key of element.
+ * \param value
+ * Value to associate to the key.
+ * \return
+ * Returns a pair consisting of an iterator to the element and a
+ * boolean set to \c true if key was inserted, \c false if assigned.
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+std::pair<typename SORTEDVECTORBIMAP_CLASS::iterator, bool> SORTEDVECTORBIMAP_CLASS::insertOrAssign(const TypeKey &key, const TypeValue &value)
+{
+    bool inserted = false;
+    auto result = replacePair(key, value, true, true, inserted);
+    return std::make_pair(result.first, inserted);
+}
+
+/*!
+ * \overload
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+std::pair<typename SORTEDVECTORBIMAP_CLASS::iterator, bool> SORTEDVECTORBIMAP_CLASS::insertOrAssign(TypeKey &&key, TypeValue &&value)
+{
+    bool inserted = false;
+    auto result = replacePair(std::move(key), std::move(value), true, true, inserted);
+    return std::make_pair(result.first, inserted);
+}
+
+/*!
+ * \brief Insert pair, resolving conflicts with existing
+ * elements according to \c policy
+ * \details
+ * Complexity is <b>O(n)</b>, like insert().
+ *
+ * \param key
+ * Key of element.
+ * \param value
+ * Value to associate to the key.
+ * \param policy
+ * Policy to apply when \c key or \c value already exist.
+ * \return
+ * Returns a pair consisting of an iterator to the element (or to the
+ * element which caused the rejection) and a boolean set to \c true
+ * if bimap now contains the pair.
+ *
+ * \sa insert(), insertOrAssign(), tryInsert()
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+std::pair<typename SORTEDVECTORBIMAP_CLASS::iterator, bool> SORTEDVECTORBIMAP_CLASS::replace(const TypeKey &key, const TypeValue &value, ReplacePolicy policy)
+{
+    bool inserted = false;
+    return replacePair(key, value, policy == ReplacePolicy::OverwriteLeft, policy == ReplacePolicy::OverwriteRight, inserted);
+}
+
+/*!
+ * \overload
+ * \details
+ * Key and value are moved only if they are used.
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+std::pair<typename SORTEDVECTORBIMAP_CLASS::iterator, bool> SORTEDVECTORBIMAP_CLASS::replace(TypeKey &&key, TypeValue &&value, ReplacePolicy policy)
+{
+    bool inserted = false;
+    return replacePair(std::move(key), std::move(value), policy == ReplacePolicy::OverwriteLeft, policy == ReplacePolicy::OverwriteRight, inserted);
+}
+
+/*!
+ * \brief Returns number of elements that can be held without reallocation
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+std::size_t SORTEDVECTORBIMAP_CLASS::capacity() const
+{
+    return m_data.capacity();
+}
+
+/*!
+ * \brief Reserves space for at least the specified number of elements
+ *
+ * \param count
+ * Number of elements to reserve space for.
+ *
+ * \throw std::length_error
+ * Throw if \c count is greater than maxSize()
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+void SORTEDVECTORBIMAP_CLASS::reserve(std::size_t count)
+{
+    if(count > maxSize()){
+        throw std::length_error("cmap::SortedVectorBimap::reserve");
+    }
+
+    m_data.reserve(count);
+    m_permutation.reserve(count);
+}
+
+/*!
+ * \brief Release unused memory
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+void SORTEDVECTORBIMAP_CLASS::shrinkToFit()
+{
+    m_data.shrink_to_fit();
+    m_permutation.shrink_to_fit();
+}
+
+/*!
+ * \brief Returns function used to compare keys
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+CompareKey SORTEDVECTORBIMAP_CLASS::keyComp() const
+{
+    return m_compareKey;
+}
+
+/*!
+ * \brief Returns function used to compare values
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+CompareValue SORTEDVECTORBIMAP_CLASS::valueComp() const
+{
+    return m_compareValue;
+}
+
+/*!
+ * \brief Returns memory owned by bimap
+ * \details
+ * Pairs array, sorted by keys, is both the payload and the index
+ * of keys (so \c indexKey is always \c 0), index of values is the
+ * permutation array. Unused capacity of both arrays is reported in
+ * \c unused.
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+BimapMemoryUsage SORTEDVECTORBIMAP_CLASS::memoryUsage() const
+{
+    const std::size_t nbArrays = (m_data.capacity() > 0) + (m_permutation.capacity() > 0);
+
+    BimapMemoryUsage usage;
+    usage.indexKey = 0;
+    usage.indexValue = m_permutation.size() * sizeof(_TypeIndex);
+    usage.payload = m_data.size() * sizeof(value_type);
+    usage.overhead = nbArrays * BimapAllocationOverhead;
+    usage.unused = (m_data.capacity() - m_data.size()) * sizeof(value_type)
+                 + (m_permutation.capacity() - m_permutation.size()) * sizeof(_TypeIndex);
+
+    return usage;
+}
+
+#if defined(BIMAP_ENABLE_STATS)
+/*!
+ * \brief Returns statistics of lookups and updates of bimap
+ * \details
+ * Only available when \c BIMAP_ENABLE_STATS is defined.
+ *
+ * \sa bimapstats.h
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+BimapStats& SORTEDVECTORBIMAP_CLASS::stats() const
+{
+    return m_stats;
+}
+#endif
+
+/*!
+ * \brief Insert pair built from \c key and \c value, replacing
+ * elements which conflict with it
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+template<class K, class V>
+void SORTEDVECTORBIMAP_CLASS::insertPair(K &&key, V &&value)
+{
+    /* Remove entries which conflict with new pair */
+    bool overwritten = false;
+    auto itKey = findKey(key);
+    if(itKey != m_data.cend()){
+        eraseAt(itKey - m_data.cbegin());
+        overwritten = true;
+    }
+
+    auto itValue = findValue(value);
+    if(itValue != m_permutation.cend()){
+        eraseAt(*itValue);
+        overwritten = true;
+    }
+
+    linkPair(std::forward<K>(key), std::forward<V>(value));
+    if(overwritten){
+        BIMAP_STATS_RECORD(m_stats, Overwrite);
+    }else{
+        BIMAP_STATS_RECORD(m_stats, Insert);
+    }
+}
+
+/*!
+ * \brief Insert pair built from \c key and \c value if
+ * they do not conflict with existing elements
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+template<class K, class V>
+std::pair<typename SORTEDVECTORBIMAP_CLASS::iterator, bool> SORTEDVECTORBIMAP_CLASS::tryInsertPair(K &&key, V &&value)
+{
+    auto res = linkPair(std::forward<K>(key), std::forward<V>(value));
+    if(res.second){
+        BIMAP_STATS_RECORD(m_stats, Insert);
+    }
+    return res;
+}
+
+/*!
+ * \brief Insert pair in storage if it doesn't conflict with
+ * existing elements
+ * \details
+ * Lower bounds of each side are searched once, and used both to
+ * detect conflicts and as insertion positions. \n
+ * Unlike tryInsertPair(), insertion isn't counted in statistics,
+ * callers count it as an insertion or an overwrite.
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+template<class K, class V>
+std::pair<typename SORTEDVECTORBIMAP_CLASS::iterator, bool> SORTEDVECTORBIMAP_CLASS::linkPair(K &&key, V &&value)
+{
+    auto itKey = lowerBoundKey(key);
+    if(itKey != m_data.cend() && !m_compareKey(key, itKey->first)){
+        return std::make_pair(itKey, false);
+    }
+
+    auto itValue = lowerBoundValue(value);
+    if(itValue != m_permutation.cend() && !m_compareValue(value, m_data[*itValue].second)){
+        return std::make_pair(m_data.cbegin() + *itValue, false);
+    }
+
+    if(size() >= maxSize()){
+        throw std::length_error("cmap::SortedVectorBimap::insert");
+    }
+
+    /* Insert pair, shift indexes referencing moved pairs */
+    const _TypeIndex index = static_cast<_TypeIndex>(itKey - m_data.cbegin());
+    const std::size_t posValue = itValue - m_permutation.cbegin();
+
+    /* Reserve both arrays first, so only emplace() can throw and nothing is modified if it does */
+    if(m_data.size() == m_data.capacity()){
+        m_data.reserve(std::max<std::size_t>(2 * m_data.size(), 8));
+    }
+    if(m_permutation.size() == m_permutation.capacity()){
+        m_permutation.reserve(std::max<std::size_t>(2 * m_permutation.size(), 8));
+    }
+
+    m_data.emplace(m_data.begin() + index, std::forward<K>(key), std::forward<V>(value));
+    for(_TypeIndex &i : m_permutation){
+        i += (i >= index);
+    }
+    m_permutation.insert(m_permutation.begin() + posValue, index);
+
+    return std::make_pair(m_data.cbegin() + index, true);
+}
+
+/*!
+ * \brief Insert pair built from \c key and \c value, overwriting
+ * conflicting sides when allowed
+ * \details
+ * Storage must be shifted anyway, so conflicting pairs are
+ * simply erased before inserting the new one.
+ *
+ * \param overwriteLeft
+ * Allow to replace the key associated to \c value.
+ * \param overwriteRight
+ * Allow to replace the value associated to \c key.
+ * \param inserted
+ * Set to \c true if a new key has been inserted.
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+template<class K, class V>
+std::pair<typename SORTEDVECTORBIMAP_CLASS::iterator, bool> SORTEDVECTORBIMAP_CLASS::replacePair(K &&key, V &&value, bool overwriteLeft, bool overwriteRight, bool &inserted)
+{
+    auto itKey = findKey(key);
+    auto itValue = findValue(value);
+
+    const bool hasKey = itKey != m_data.cend();
+    const bool hasValue = itValue != m_permutation.cend();
+    const std::size_t indexKey = itKey - m_data.cbegin();
+    std::size_t indexValue = hasValue ? *itValue : 0;
+
+    /* Apply policy */
+    inserted = !hasKey;
+    if(hasKey && hasValue && indexKey == indexValue){
+        return std::make_pair(itKey, true);
+    }
+    if(hasKey && !overwriteRight){
+        inserted = false;
+        return std::make_pair(itKey, false);
+    }
+    if(hasValue && !overwriteLeft){
+        inserted = false;
+        return std::make_pair(m_data.cbegin() + indexValue, false);
+    }
+
+    /* Remove entries which conflict with new pair */
+    if(hasKey){
+        eraseAt(indexKey);
+        indexValue -= (hasValue && indexValue > indexKey);
+    }
+    if(hasValue){
+        eraseAt(indexValue);
+    }
+
+    auto res = linkPair(std::forward<K>(key), std::forward<V>(value));
+    if(hasKey || hasValue){
+        BIMAP_STATS_RECORD(m_stats, Overwrite);
+    }else{
+        BIMAP_STATS_RECORD(m_stats, Insert);
+    }
+    return res;
+}
+
+/*!
+ * \brief Search pair with key equivalent to \c key
+ * \return
+ * Returns iterator to pair, \c m_data.cend() if not found.
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+template<class K>
+typename SORTEDVECTORBIMAP_CLASS::_ContainerData::const_iterator SORTEDVECTORBIMAP_CLASS::findKey(const K &key) const
+{
+    auto it = lowerBoundKey(key);
+    if(it != m_data.cend() && m_compareKey(key, it->first)){
+        return m_data.cend();
+    }
+    return it;
+}
+
+/*!
+ * \brief Search index of pair with value equivalent to \c value
+ * \return
+ * Returns iterator to index, \c m_permutation.cend() if not found.
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+template<class V>
+typename SORTEDVECTORBIMAP_CLASS::_ContainerPermutation::const_iterator SORTEDVECTORBIMAP_CLASS::findValue(const V &value) const
+{
+    auto it = lowerBoundValue(value);
+    if(it != m_permutation.cend() && m_compareValue(value, m_data[*it].second)){
+        return m_permutation.cend();
+    }
+    return it;
+}
+
+SORTEDVECTORBIMAP_TEMPLATE
+template<class K>
+typename SORTEDVECTORBIMAP_CLASS::_ContainerData::const_iterator SORTEDVECTORBIMAP_CLASS::lowerBoundKey(const K &key) const
+{
+    return std::lower_bound(m_data.cbegin(), m_data.cend(), key, [this](const value_type &pair, const K &k){
+        return m_compareKey(pair.first, k);
+    });
+}
+
+SORTEDVECTORBIMAP_TEMPLATE
+template<class V>
+typename SORTEDVECTORBIMAP_CLASS::_ContainerPermutation::const_iterator SORTEDVECTORBIMAP_CLASS::lowerBoundValue(const V &value) const
+{
+    return std::lower_bound(m_permutation.cbegin(), m_permutation.cend(), value, [this](_TypeIndex index, const V &v){
+        return m_compareValue(m_data[index].second, v);
+    });
+}
+
+/*!
+ * \brief Erase pair stored at \c index
+ * \details
+ * Indexes referencing following pairs are shifted.
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+void SORTEDVECTORBIMAP_CLASS::eraseAt(std::size_t index)
+{
+    const _TypeIndex removed = static_cast<_TypeIndex>(index);
+
+    auto it = std::remove(m_permutation.begin(), m_permutation.end(), removed);
+    m_permutation.erase(it, m_permutation.end());
+    for(_TypeIndex &i : m_permutation){
+        i -= (i > removed);
+    }
+
+    m_data.erase(m_data.begin() + index);
+}
+
+/*!
+ * \brief Sort pairs and build values index
+ * \details
+ * Sorts are performed by calling thread.
+ *
+ * \throw std::invalid_argument
+ * Throw if a key or a value is present more than once
+ * \throw std::length_error
+ * Throw if container is larger than maxSize()
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+void SORTEDVECTORBIMAP_CLASS::build()
+{
+    detail::BimapInlineExecutor executor;
+    build(executor);
+}
+
+/*!
+ * \brief Sort pairs and build values index, using tasks of \c executor
+ * \details
+ * Each sort is split between tasks of \c executor, and skipped if
+ * already sorted.
+ *
+ * \throw std::invalid_argument
+ * Throw if a key or a value is present more than once
+ * \throw std::length_error
+ * Throw if container is larger than maxSize()
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+template<class Executor>
+void SORTEDVECTORBIMAP_CLASS::build(Executor &executor)
+{
+    if(m_data.size() > maxSize()){
+        throw std::length_error("cmap::SortedVectorBimap::assign");
+    }
+
+    /* Sort pairs by keys */
+    detail::bimapParallelSort(executor, m_data.begin(), m_data.end(), [this](const value_type &lhs, const value_type &rhs){
+        return m_compareKey(lhs.first, rhs.first);
+    });
+    auto itKey = std::adjacent_find(m_data.cbegin(), m_data.cend(), [this](const value_type &lhs, const value_type &rhs){
+        return !m_compareKey(lhs.first, rhs.first);
+    });
+    if(itKey != m_data.cend()){
+        throw std::invalid_argument("cmap::SortedVectorBimap: duplicated key");
+    }
+
+    /* Sort indexes by values */
+    m_permutation.resize(m_data.size());
+    for(std::size_t i = 0; i < m_permutation.size(); ++i){
+        m_permutation[i] = static_cast<_TypeIndex>(i);
+    }
+
+    detail::bimapParallelSort(executor, m_permutation.begin(), m_permutation.end(), [this](_TypeIndex lhs, _TypeIndex rhs){
+        return m_compareValue(m_data[lhs].second, m_data[rhs].second);
+    });
+    auto itValue = std::adjacent_find(m_permutation.cbegin(), m_permutation.cend(), [this](_TypeIndex lhs, _TypeIndex rhs){
+        return !m_compareValue(m_data[lhs].second, m_data[rhs].second);
+    });
+    if(itValue != m_permutation.cend()){
+        throw std::invalid_argument("cmap::SortedVectorBimap: duplicated value");
+    }
+}
+
+/*!
+ * \brief Returns an iterator to the beginning
+ *
+ * \return
+ * Iterator to the first element. \n
+ * If the map is empty, the returned iterator will be equal to \c end().
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+typename SORTEDVECTORBIMAP_CLASS::iterator SORTEDVECTORBIMAP_CLASS::begin()
+{
+    return m_data.cbegin();
+}
+
+/*!
+ * \brief Returns a constant iterator to the beginning
+ *
+ * \return
+ * Iterator to the first element. \n
+ * If the map is empty, the returned iterator will be equal to \c cend().
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+typename SORTEDVECTORBIMAP_CLASS::const_iterator SORTEDVECTORBIMAP_CLASS::cbegin() const
+{
+    return m_data.cbegin();
+}
+
+/*!
+ * \brief Returns a reverse iterator to the beginning
+ * \details
+ * Returns a reverse iterator to the first element of the reversed map.
+ * It corresponds to the last element of the non-reversed map. \n
+ *
+ * \return
+ * Reverse iterator to the first element. \n
+ * If the map is empty, the returned iterator is equal to \c rend().
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+typename SORTEDVECTORBIMAP_CLASS::reverse_iterator SORTEDVECTORBIMAP_CLASS::rbegin()
+{
+    return reverse_iterator(end());
+}
+
+/*!
+ * \brief Returns a constant reverse iterator to the beginning
+ * \details
+ * Returns a reverse iterator to the first element of the reversed map.
+ * It corresponds to the last element of the non-reversed map. \n
+ *
+ * \return
+ * Reverse iterator to the first element. \n
+ * If the map is empty, the returned iterator is equal to \c crend().
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+typename SORTEDVECTORBIMAP_CLASS::const_reverse_iterator SORTEDVECTORBIMAP_CLASS::crbegin() const
+{
+    return const_reverse_iterator(cend());
+}
+
+/*!
+ * \brief Returns an iterator to the end
+ *
+ * \return
+ * Iterator to the element following the last element.
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+typename SORTEDVECTORBIMAP_CLASS::iterator SORTEDVECTORBIMAP_CLASS::end()
+{
+    return m_data.cend();
+}
+
+/*!
+ * \brief Returns a constant iterator to the end
+ *
+ * \return
+ * Iterator to the element following the last element.
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+typename SORTEDVECTORBIMAP_CLASS::const_iterator SORTEDVECTORBIMAP_CLASS::cend() const
+{
+    return m_data.cend();
+}
+
+/*!
+ * \brief Returns a reverse iterator to the end
+ * \details
+ * Returns a reverse iterator to the element following the last element of the reversed map.
+ * It corresponds to the element preceding the first element of the non-reversed map.
+ *
+ * \return
+ * Reverse iterator to the element following the last element.
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+typename SORTEDVECTORBIMAP_CLASS::reverse_iterator SORTEDVECTORBIMAP_CLASS::rend()
+{
+    return reverse_iterator(begin());
+}
+
+/*!
+ * \brief Returns a constant reverse iterator to the end
+ * \details
+ * Returns a reverse iterator to the element following the last element of the reversed map.
+ * It corresponds to the element preceding the first element of the non-reversed map.
+ *
+ * \return
+ * Reverse iterator to the element following the last element.
+ */
+SORTEDVECTORBIMAP_TEMPLATE
+typename SORTEDVECTORBIMAP_CLASS::const_reverse_iterator SORTEDVECTORBIMAP_CLASS::crend() const
+{
+    return const_reverse_iterator(cbegin());
+}
+
+#undef SORTEDVECTORBIMAP_TEMPLATE
+#undef SORTEDVECTORBIMAP_CLASS
+
+} // Namespace cmap
+
+#endif // LCH_SORTEDVECTORBIMAP_H
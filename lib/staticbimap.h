@@ -0,0 +1,602 @@
+#ifndef LCH_STATICBIMAP_H
+#define LCH_STATICBIMAP_H
+
+/*****************************/
+/* Class documentations      */
+/*****************************/
+
+/*!
+   \class cmap::StaticBimap
+   \brief Class use to provide fixed-size bi-directional map built at compile-time.
+
+   This class store \c N pairs in an array sorted by keys, and values are
+   indexed by an array of indexes sorted by values. Both arrays are sorted
+   by the constructor, which is \c constexpr: a table declared \c constexpr
+   is fully built by the compiler, so it doesn't allocate anything and has
+   no static initialization cost. \n
+   Lookups are branchless binary searches (complexity: <b>O(log(n))</b>),
+   performing exactly <tt>log2(N)</tt> comparisons.
+
+   \code{.cpp}
+   constexpr auto colors = cmap::makeStaticBimap<Color, std::string_view>({
+       {Color::Red, "red"},
+       {Color::Green, "green"},
+       {Color::Blue, "blue"}
+   });
+
+   static_assert(colors.getKey("green") == Color::Green);
+   \endcode
+
+   \note
+   Requires C++17. Keys and values must be literal types which are
+   default constructible and copy assignable (like integers, enumerations
+   or \c std::string_view) to be built at compile-time. \n
+   Sorting has a complexity of <b>O(n^2)</b>, this container is designed
+   for small tables.
+
+   \sa cmap::SortedVectorBimap
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "bimapcommon.h"
+
+#if BIMAP_HAS_CPP17
+
+namespace cmap{
+
+/*****************************/
+/* Class definitions         */
+/*****************************/
+
+template<class TypeKey, class TypeValue, std::size_t N, class CompareKey = detail::BimapLess<TypeKey>, class CompareValue = detail::BimapLess<TypeValue>>
+class StaticBimap
+{
+    static_assert(N > 0, "cmap::StaticBimap must contain at least one pair");
+    static_assert(N <= std::numeric_limits<std::uint32_t>::max(), "cmap::StaticBimap is limited to 2^32-1 pairs");
+
+public:
+    using key_type = TypeKey;
+    using mapped_type = TypeValue;
+    using value_type = std::pair<TypeKey, TypeValue>;
+    using size_type = std::size_t;
+
+    using key_compare = CompareKey;
+    using value_compare = CompareValue;
+
+private:
+    using _TypeIndex = std::uint32_t;
+
+public:
+    using iterator = const value_type*;
+    using const_iterator = iterator;
+
+public:
+    constexpr explicit StaticBimap(const value_type (&pairs)[N],
+                                   const CompareKey &compareKey = CompareKey(), const CompareValue &compareValue = CompareValue());
+
+public:
+    constexpr bool empty() const;
+    constexpr std::size_t size() const;
+
+    constexpr const TypeValue& getValue(const TypeKey &key) const;
+    constexpr const TypeKey& getKey(const TypeValue &value) const;
+
+    template<class K, class C = CompareKey, detail::BimapEnableTransparent<C> = 0>
+    constexpr const TypeValue& getValue(const K &key) const;
+    template<class V, class C = CompareValue, detail::BimapEnableTransparent<C> = 0>
+    constexpr const TypeKey& getKey(const V &value) const;
+
+    constexpr const_iterator findByKey(const TypeKey &key) const;
+    constexpr const_iterator findByValue(const TypeValue &value) const;
+    constexpr bool containsKey(const TypeKey &key) const;
+    constexpr bool containsValue(const TypeValue &value) const;
+
+    template<class K, class C = CompareKey, detail::BimapEnableTransparent<C> = 0>
+    constexpr const_iterator findByKey(const K &key) const;
+    template<class V, class C = CompareValue, detail::BimapEnableTransparent<C> = 0>
+    constexpr const_iterator findByValue(const V &value) const;
+    template<class K, class C = CompareKey, detail::BimapEnableTransparent<C> = 0>
+    constexpr bool containsKey(const K &key) const;
+    template<class V, class C = CompareValue, detail::BimapEnableTransparent<C> = 0>
+    constexpr bool containsValue(const V &value) const;
+
+public:
+    constexpr CompareKey keyComp() const;
+    constexpr CompareValue valueComp() const;
+
+private:
+    template<class K>
+    constexpr const_iterator findKey(const K &key) const;
+    template<class V>
+    constexpr const_iterator findValue(const V &value) const;
+
+    template<class K>
+    constexpr const value_type* lowerBoundKey(const K &key) const;
+    template<class V>
+    constexpr const _TypeIndex* lowerBoundValue(const V &value) const;
+
+    constexpr void sortKeys();
+    constexpr void sortValues();
+
+public:
+    constexpr const_iterator begin() const;
+    constexpr const_iterator cbegin() const;
+    constexpr const_iterator end() const;
+    constexpr const_iterator cend() const;
+
+private:
+    value_type m_data[N] = {};
+    _TypeIndex m_permutation[N] = {};
+
+    CompareKey m_compareKey;
+    CompareValue m_compareValue;
+};
+
+/*
+ * Functions implementations
+ * Class use template and methods cannot be defined in .cpp file.
+ * See https://isocpp.org/wiki/faq/templates#separate-template-fn-defn-from-decl
+ */
+
+#define STATICBIMAP_TEMPLATE template<class TypeKey, class TypeValue, std::size_t N, class CompareKey, class CompareValue>
+#define STATICBIMAP_CLASS StaticBimap<TypeKey, TypeValue, N, CompareKey, CompareValue>
+
+/*!
+ * \brief Construct static bimap from an array of pairs
+ * \details
+ * Pairs are copied then sorted once by keys and once by values. \n
+ * When evaluated at compile-time, duplicated elements make the
+ * program ill-formed.
+ *
+ * \param pairs
+ * Pairs to store, in any order.
+ * \param compareKey
+ * Comparison function object used to order keys.
+ * \param compareValue
+ * Comparison function object used to order values.
+ *
+ * \throw std::invalid_argument
+ * Throw if \c pairs contains duplicated keys or values.
+ *
+ * \sa makeStaticBimap()
+ */
+STATICBIMAP_TEMPLATE
+constexpr STATICBIMAP_CLASS::StaticBimap(const value_type (&pairs)[N], const CompareKey &compareKey, const CompareValue &compareValue)
+    : m_compareKey(compareKey), m_compareValue(compareValue)
+{
+    for(std::size_t i = 0; i < N; ++i){
+        m_data[i].first = pairs[i].first;
+        m_data[i].second = pairs[i].second;
+    }
+
+    sortKeys();
+    sortValues();
+}
+
+/*!
+ * \brief Check if bimap is empty
+ * \details
+ * A static bimap always contains \c N pairs, so it is never empty.
+ *
+ * \return
+ * Always returns \c false.
+ */
+STATICBIMAP_TEMPLATE
+constexpr bool STATICBIMAP_CLASS::empty() const
+{
+    return false;
+}
+
+/*!
+ * \brief Returns the number of elements
+ *
+ * \return
+ * Returns \c N.
+ */
+STATICBIMAP_TEMPLATE
+constexpr std::size_t STATICBIMAP_CLASS::size() const
+{
+    return N;
+}
+
+/*!
+ * \brief Use to retrieve value by key
+ *
+ * \param key
+ * Key of element to get.
+ * \return
+ * Return value associated to key.
+ *
+ * \throw std::out_of_range
+ * Throw if key cannot be found (ill-formed at compile-time)
+ */
+STATICBIMAP_TEMPLATE
+constexpr const TypeValue &STATICBIMAP_CLASS::getValue(const TypeKey &key) const
+{
+    const_iterator it = findKey(key);
+    if(it == cend()){
+        throw std::out_of_range("cmap::StaticBimap::getValue");
+    }
+
+    return it->second;
+}
+
+/*!
+ * \brief Use to retrieve key by value
+ *
+ * \param value
+ * Value to use to retrieve key element.
+ * \return
+ * Return key associated to value.
+ *
+ * \throw std::out_of_range
+ * Throw if value cannot be found (ill-formed at compile-time)
+ */
+STATICBIMAP_TEMPLATE
+constexpr const TypeKey &STATICBIMAP_CLASS::getKey(const TypeValue &value) const
+{
+    const_iterator it = findValue(value);
+    if(it == cend()){
+        throw std::out_of_range("cmap::StaticBimap::getKey");
+    }
+
+    return it->first;
+}
+
+/*!
+ * \brief Use to retrieve value by an object comparable to keys
+ * \details
+ * This overload is only available when \c CompareKey is transparent
+ * (which is the case by default), so no temporary key is
+ * constructed to perform the lookup.
+ *
+ * \param key
+ * Object comparable to keys.
+ * \return
+ * Return value associated to key.
+ *
+ * \throw std::out_of_range
+ * Throw if key cannot be found (ill-formed at compile-time)
+ */
+STATICBIMAP_TEMPLATE
+template<class K, class C, detail::BimapEnableTransparent<C>>
+constexpr const TypeValue &STATICBIMAP_CLASS::getValue(const K &key) const
+{
+    const_iterator it = findKey(key);
+    if(it == cend()){
+        throw std::out_of_range("cmap::StaticBimap::getValue");
+    }
+
+    return it->second;
+}
+
+/*!
+ * \brief Use to retrieve key by an object comparable to values
+ * \details
+ * This overload is only available when \c CompareValue is transparent
+ * (which is the case by default), so no temporary value is
+ * constructed to perform the lookup.
+ *
+ * \param value
+ * Object comparable to values.
+ * \return
+ * Return key associated to value.
+ *
+ * \throw std::out_of_range
+ * Throw if value cannot be found (ill-formed at compile-time)
+ */
+STATICBIMAP_TEMPLATE
+template<class V, class C, detail::BimapEnableTransparent<C>>
+constexpr const TypeKey &STATICBIMAP_CLASS::getKey(const V &value) const
+{
+    const_iterator it = findValue(value);
+    if(it == cend()){
+        throw std::out_of_range("cmap::StaticBimap::getKey");
+    }
+
+    return it->first;
+}
+
+/*!
+ * \brief Search pair associated to a key
+ *
+ * \param key
+ * Key of element to search.
+ * \return
+ * Iterator to the pair, \c cend() if key cannot be found.
+ */
+STATICBIMAP_TEMPLATE
+constexpr typename STATICBIMAP_CLASS::const_iterator STATICBIMAP_CLASS::findByKey(const TypeKey &key) const
+{
+    return findKey(key);
+}
+
+/*!
+ * \brief Search pair associated to a value
+ *
+ * \param value
+ * Value of element to search.
+ * \return
+ * Iterator to the pair, \c cend() if value cannot be found.
+ */
+STATICBIMAP_TEMPLATE
+constexpr typename STATICBIMAP_CLASS::const_iterator STATICBIMAP_CLASS::findByValue(const TypeValue &value) const
+{
+    return findValue(value);
+}
+
+/*!
+ * \brief Check if a key is stored
+ */
+STATICBIMAP_TEMPLATE
+constexpr bool STATICBIMAP_CLASS::containsKey(const TypeKey &key) const
+{
+    return findKey(key) != cend();
+}
+
+/*!
+ * \brief Check if a value is stored
+ */
+STATICBIMAP_TEMPLATE
+constexpr bool STATICBIMAP_CLASS::containsValue(const TypeValue &value) const
+{
+    return findValue(value) != cend();
+}
+
+/*!
+ * \brief Search pair associated to an object comparable to keys
+ * \details
+ * This overload is only available when \c CompareKey is transparent.
+ */
+STATICBIMAP_TEMPLATE
+template<class K, class C, detail::BimapEnableTransparent<C>>
+constexpr typename STATICBIMAP_CLASS::const_iterator STATICBIMAP_CLASS::findByKey(const K &key) const
+{
+    return findKey(key);
+}
+
+/*!
+ * \brief Search pair associated to an object comparable to values
+ * \details
+ * This overload is only available when \c CompareValue is transparent.
+ */
+STATICBIMAP_TEMPLATE
+template<class V, class C, detail::BimapEnableTransparent<C>>
+constexpr typename STATICBIMAP_CLASS::const_iterator STATICBIMAP_CLASS::findByValue(const V &value) const
+{
+    return findValue(value);
+}
+
+/*!
+ * \brief Check if an object comparable to keys is stored
+ * \details
+ * This overload is only available when \c CompareKey is transparent.
+ */
+STATICBIMAP_TEMPLATE
+template<class K, class C, detail::BimapEnableTransparent<C>>
+constexpr bool STATICBIMAP_CLASS::containsKey(const K &key) const
+{
+    return findKey(key) != cend();
+}
+
+/*!
+ * \brief Check if an object comparable to values is stored
+ * \details
+ * This overload is only available when \c CompareValue is transparent.
+ */
+STATICBIMAP_TEMPLATE
+template<class V, class C, detail::BimapEnableTransparent<C>>
+constexpr bool STATICBIMAP_CLASS::containsValue(const V &value) const
+{
+    return findValue(value) != cend();
+}
+
+/*!
+ * \brief Returns the function object comparing keys
+ */
+STATICBIMAP_TEMPLATE
+constexpr CompareKey STATICBIMAP_CLASS::keyComp() const
+{
+    return m_compareKey;
+}
+
+/*!
+ * \brief Returns the function object comparing values
+ */
+STATICBIMAP_TEMPLATE
+constexpr CompareValue STATICBIMAP_CLASS::valueComp() const
+{
+    return m_compareValue;
+}
+
+STATICBIMAP_TEMPLATE
+template<class K>
+constexpr typename STATICBIMAP_CLASS::const_iterator STATICBIMAP_CLASS::findKey(const K &key) const
+{
+    const value_type *it = lowerBoundKey(key);
+    return (it != cend() && !m_compareKey(key, it->first)) ? it : cend();
+}
+
+STATICBIMAP_TEMPLATE
+template<class V>
+constexpr typename STATICBIMAP_CLASS::const_iterator STATICBIMAP_CLASS::findValue(const V &value) const
+{
+    const _TypeIndex *it = lowerBoundValue(value);
+    if(it == m_permutation + N){
+        return cend();
+    }
+
+    const value_type *pair = m_data + *it;
+    return m_compareValue(value, pair->second) ? cend() : pair;
+}
+
+/*!
+ * \brief Branchless lower bound of \c key
+ * \details
+ * Range is halved by a conditional move at each step, instead of a
+ * branch the predictor cannot guess. Since \c N is known at
+ * compile-time, loop is fully unrolled by compilers.
+ */
+STATICBIMAP_TEMPLATE
+template<class K>
+constexpr const typename STATICBIMAP_CLASS::value_type* STATICBIMAP_CLASS::lowerBoundKey(const K &key) const
+{
+    const value_type *base = m_data;
+    std::size_t len = N;
+    while(len > 1){
+        const std::size_t half = len / 2;
+        base = m_compareKey(base[half - 1].first, key) ? base + half : base;
+        len -= half;
+    }
+
+    return base + (m_compareKey(base->first, key) ? 1 : 0);
+}
+
+/*!
+ * \brief Branchless lower bound of \c value
+ * \sa lowerBoundKey()
+ */
+STATICBIMAP_TEMPLATE
+template<class V>
+constexpr const typename STATICBIMAP_CLASS::_TypeIndex* STATICBIMAP_CLASS::lowerBoundValue(const V &value) const
+{
+    const _TypeIndex *base = m_permutation;
+    std::size_t len = N;
+    while(len > 1){
+        const std::size_t half = len / 2;
+        base = m_compareValue(m_data[base[half - 1]].second, value) ? base + half : base;
+        len -= half;
+    }
+
+    return base + (m_compareValue(m_data[*base].second, value) ? 1 : 0);
+}
+
+/*!
+ * \brief Sort pairs by keys and reject duplicated keys
+ * \details
+ * Uses an insertion sort: \c std::sort() and \c std::pair assignment
+ * are not \c constexpr in C++17, so members are copied one by one.
+ */
+STATICBIMAP_TEMPLATE
+constexpr void STATICBIMAP_CLASS::sortKeys()
+{
+    for(std::size_t i = 1; i < N; ++i){
+        for(std::size_t j = i; j > 0 && m_compareKey(m_data[j].first, m_data[j - 1].first); --j){
+            TypeKey key = m_data[j].first;
+            m_data[j].first = m_data[j - 1].first;
+            m_data[j - 1].first = key;
+
+            TypeValue value = m_data[j].second;
+            m_data[j].second = m_data[j - 1].second;
+            m_data[j - 1].second = value;
+        }
+    }
+
+    for(std::size_t i = 1; i < N; ++i){
+        if(!m_compareKey(m_data[i - 1].first, m_data[i].first)){
+            throw std::invalid_argument("cmap::StaticBimap: duplicated key");
+        }
+    }
+}
+
+/*!
+ * \brief Sort indexes of pairs by values and reject duplicated values
+ * \sa sortKeys()
+ */
+STATICBIMAP_TEMPLATE
+constexpr void STATICBIMAP_CLASS::sortValues()
+{
+    for(std::size_t i = 0; i < N; ++i){
+        m_permutation[i] = static_cast<_TypeIndex>(i);
+    }
+
+    for(std::size_t i = 1; i < N; ++i){
+        for(std::size_t j = i; j > 0 && m_compareValue(m_data[m_permutation[j]].second, m_data[m_permutation[j - 1]].second); --j){
+            const _TypeIndex index = m_permutation[j];
+            m_permutation[j] = m_permutation[j - 1];
+            m_permutation[j - 1] = index;
+        }
+    }
+
+    for(std::size_t i = 1; i < N; ++i){
+        if(!m_compareValue(m_data[m_permutation[i - 1]].second, m_data[m_permutation[i]].second)){
+            throw std::invalid_argument("cmap::StaticBimap: duplicated value");
+        }
+    }
+}
+
+/*!
+ * \brief Returns an iterator to the first pair
+ * \details
+ * Pairs are sorted by keys. Unlike other containers, this
+ * method is \c const since a static bimap is never modified.
+ */
+STATICBIMAP_TEMPLATE
+constexpr typename STATICBIMAP_CLASS::const_iterator STATICBIMAP_CLASS::begin() const
+{
+    return m_data;
+}
+
+/*!
+ * \brief Returns an iterator to the first pair
+ */
+STATICBIMAP_TEMPLATE
+constexpr typename STATICBIMAP_CLASS::const_iterator STATICBIMAP_CLASS::cbegin() const
+{
+    return m_data;
+}
+
+/*!
+ * \brief Returns an iterator to the element following the last pair
+ */
+STATICBIMAP_TEMPLATE
+constexpr typename STATICBIMAP_CLASS::const_iterator STATICBIMAP_CLASS::end() const
+{
+    return m_data + N;
+}
+
+/*!
+ * \brief Returns an iterator to the element following the last pair
+ */
+STATICBIMAP_TEMPLATE
+constexpr typename STATICBIMAP_CLASS::const_iterator STATICBIMAP_CLASS::cend() const
+{
+    return m_data + N;
+}
+
+#undef STATICBIMAP_TEMPLATE
+#undef STATICBIMAP_CLASS
+
+/*****************************/
+/* Functions definitions     */
+/*****************************/
+
+/*!
+ * \brief Build a static bimap, deducing its size
+ * \details
+ * Types must be explicitly provided, size is deduced from the
+ * number of pairs:
+ * \code{.cpp}
+ * constexpr auto errors = cmap::makeStaticBimap<int, std::string_view>({{0, "ok"}, {1, "failed"}});
+ * \endcode
+ *
+ * \throw std::invalid_argument
+ * Throw if \c pairs contains duplicated keys or values.
+ */
+template<class TypeKey, class TypeValue, std::size_t N>
+constexpr StaticBimap<TypeKey, TypeValue, N> makeStaticBimap(const std::pair<TypeKey, TypeValue> (&pairs)[N])
+{
+    return StaticBimap<TypeKey, TypeValue, N>(pairs);
+}
+
+} // Namespace cmap
+
+#endif // BIMAP_HAS_CPP17
+
+#endif // LCH_STATICBIMAP_H
@@ -0,0 +1,731 @@
+#ifndef LCH_STRINGPOOLBIMAP_H
+#define LCH_STRINGPOOLBIMAP_H
+
+/*****************************/
+/* Class documentations      */
+/*****************************/
+
+/*!
+   \class cmap::StringPoolBimap
+   \brief Class use to provide a bi-directional map between dense
+   identifiers and interned strings.
+
+   This class is a specialized bimap for symbol tables: strings are
+   \em interned with intern(), which returns identifier of an equal string
+   if it is already known, or assigns next identifier (identifiers are
+   dense: <tt>0</tt> to <tt>size() - 1</tt>, in order of interning).
+
+   Characters of each string are stored only once, in an append-only arena
+   made of blocks of \c BlockSize bytes. Each identifier only holds a
+   32-bits offset and a 32-bits length into that arena, so there is no
+   \c std::string header on either side. Strings are indexed by an
+   open-addressing table of 32-bits identifiers (the one used by
+   cmap::FlatBimap), hashed as \c std::string_view.
+
+   \code{.cpp}
+   cmap::StringPoolBimap<> symbols;
+
+   const std::uint32_t id = symbols.intern("main");    // 0
+   symbols.intern("printf");                           // 1
+   symbols.intern("main");                             // 0 again
+
+   std::string_view name = symbols.getValue(id);       // "main"
+   \endcode
+
+   \note
+   Requires C++17. Strings are never moved, so views returned by
+   getValue() stay valid until clear() or destruction of the pool (a moved
+   or swapped pool keeps them). Strings cannot be erased: interning is
+   append-only. \n
+   Number of strings is limited to \c 2^32-1 and sum of their lengths
+   to about 4 GiB.
+
+   \sa cmap::FlatBimap, cmap::StringHash
+*/
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "bimapcommon.h"
+#include "bimapstats.h"
+#include "flatbimap.h"
+
+#if BIMAP_HAS_CPP17
+#include <string_view>
+
+namespace cmap{
+
+/*****************************/
+/* Class definitions         */
+/*****************************/
+
+template<class TypeId = std::uint32_t, class Hash = StringHash>
+class StringPoolBimap
+{
+    static_assert(std::is_integral<TypeId>::value && std::is_unsigned<TypeId>::value, "cmap::StringPoolBimap identifiers must be unsigned integers");
+
+public:
+    using key_type = TypeId;
+    using mapped_type = std::string_view;
+    using size_type = std::size_t;
+
+    using hasher_value = Hash;
+
+    static constexpr std::size_t BlockSize = 64 * 1024; /**< Size of arena blocks, longer strings get their own allocation */
+
+private:
+    struct _Span
+    {
+        std::uint32_t offset;
+        std::uint32_t length;
+    };
+
+    using _ContainerSpans = std::vector<_Span>;
+    using _ContainerBlocks = std::vector<std::unique_ptr<char[]>>;
+    using _ContainerIndex = detail::FlatBimapIndex<std::uint32_t>;
+
+    static constexpr std::uint64_t ArenaMaxSize = std::uint64_t(std::numeric_limits<std::uint32_t>::max()) + 1;
+
+public:
+    StringPoolBimap();
+    explicit StringPoolBimap(std::size_t count, const Hash &hash = Hash());
+    StringPoolBimap(const std::initializer_list<std::string_view> &strings);
+
+    StringPoolBimap(const StringPoolBimap &other);
+    StringPoolBimap(StringPoolBimap &&other) noexcept;
+
+    StringPoolBimap& operator=(const StringPoolBimap &other);
+    StringPoolBimap& operator=(StringPoolBimap &&other) noexcept;
+
+public:
+    bool empty() const;
+    std::size_t size() const;
+    std::size_t maxSize() const;
+
+    void clear();
+    void swap(StringPoolBimap &other);
+
+    TypeId intern(std::string_view str);
+    std::pair<TypeId, bool> insert(std::string_view str);
+
+    std::string_view getValue(TypeId id) const;
+    TypeId getKey(std::string_view str) const;
+
+    bool tryGetKey(std::string_view str, TypeId &id) const;
+    bool containsKey(TypeId id) const;
+    bool containsValue(std::string_view str) const;
+
+    template<class Func>
+    void forEach(Func func) const;
+
+public:
+    std::size_t capacity() const;
+    std::size_t arenaSize() const;
+    void reserve(std::size_t count);
+
+    Hash hashFunction() const;
+
+    BimapMemoryUsage memoryUsage() const;
+
+#if defined(BIMAP_ENABLE_STATS)
+    BimapStats& stats() const;
+#endif
+
+private:
+    std::string_view viewAt(std::uint32_t id) const;
+    std::size_t hashValue(std::string_view str) const;
+    std::size_t findPos(std::string_view str, std::size_t hash) const;
+
+    _Span append(std::string_view str);
+    void prepareInsert();
+    void rebuildIndex(std::size_t capacity);
+
+private:
+    _ContainerSpans m_spans;
+    _ContainerBlocks m_blocks;
+    _ContainerIndex m_index;
+
+    std::uint64_t m_arenaUsed;
+    std::size_t m_arenaAllocated;
+    std::size_t m_payload;
+
+    Hash m_hash;
+
+#if defined(BIMAP_ENABLE_STATS)
+    mutable BimapStats m_stats;
+#endif
+};
+
+/*
+ * Functions implementations
+ * Class use template and methods cannot be defined in .cpp file.
+ * See https://isocpp.org/wiki/faq/templates#separate-template-fn-defn-from-decl
+ */
+
+#define STRINGPOOLBIMAP_TEMPLATE template<class TypeId, class Hash>
+#define STRINGPOOLBIMAP_CLASS StringPoolBimap<TypeId, Hash>
+
+/*!
+ * \brief Construct empty string pool
+ * \details
+ * No memory is allocated until first string is interned.
+ */
+STRINGPOOLBIMAP_TEMPLATE
+STRINGPOOLBIMAP_CLASS::StringPoolBimap() :
+    m_arenaUsed(0), m_arenaAllocated(0), m_payload(0)
+{
+    /* Nothing to do */
+}
+
+/*!
+ * \brief Construct empty string pool able to hold \c count
+ * strings without rehashing
+ *
+ * \param count
+ * Number of strings to reserve room for.
+ * \param hash
+ * Hash function used for strings.
+ */
+STRINGPOOLBIMAP_TEMPLATE
+STRINGPOOLBIMAP_CLASS::StringPoolBimap(std::size_t count, const Hash &hash) :
+    m_arenaUsed(0), m_arenaAllocated(0), m_payload(0), m_hash(hash)
+{
+    reserve(count);
+}
+
+/*!
+ * \brief Construct string pool interning \c strings in order
+ * \details
+ * Duplicated strings receive identifier of their first occurrence.
+ */
+STRINGPOOLBIMAP_TEMPLATE
+STRINGPOOLBIMAP_CLASS::StringPoolBimap(const std::initializer_list<std::string_view> &strings) :
+    StringPoolBimap(strings.size())
+{
+    for(std::string_view str : strings){
+        intern(str);
+    }
+}
+
+/*!
+ * \brief Copy string pool
+ * \details
+ * Strings are interned again in order of their identifiers (so
+ * identifiers are kept), copy arena is compacted.
+ */
+STRINGPOOLBIMAP_TEMPLATE
+STRINGPOOLBIMAP_CLASS::StringPoolBimap(const StringPoolBimap &other) :
+    StringPoolBimap(other.size(), other.m_hash)
+{
+    for(std::size_t id = 0; id < other.size(); ++id){
+        intern(other.viewAt(static_cast<std::uint32_t>(id)));
+    }
+}
+
+/*!
+ * \brief Move string pool
+ * \details
+ * Views of \c other strings stay valid, \c other is left empty.
+ */
+STRINGPOOLBIMAP_TEMPLATE
+STRINGPOOLBIMAP_CLASS::StringPoolBimap(StringPoolBimap &&other) noexcept :
+    StringPoolBimap()
+{
+    swap(other);
+}
+
+STRINGPOOLBIMAP_TEMPLATE
+STRINGPOOLBIMAP_CLASS& STRINGPOOLBIMAP_CLASS::operator=(const StringPoolBimap &other)
+{
+    if(this != &other){
+        StringPoolBimap copy(other);
+        swap(copy);
+    }
+    return *this;
+}
+
+STRINGPOOLBIMAP_TEMPLATE
+STRINGPOOLBIMAP_CLASS& STRINGPOOLBIMAP_CLASS::operator=(StringPoolBimap &&other) noexcept
+{
+    StringPoolBimap moved(std::move(other));
+    swap(moved);
+    return *this;
+}
+
+/*!
+ * \brief Check if string pool is empty
+ */
+STRINGPOOLBIMAP_TEMPLATE
+bool STRINGPOOLBIMAP_CLASS::empty() const
+{
+    return m_spans.empty();
+}
+
+/*!
+ * \brief Returns number of interned strings
+ */
+STRINGPOOLBIMAP_TEMPLATE
+std::size_t STRINGPOOLBIMAP_CLASS::size() const
+{
+    return m_spans.size();
+}
+
+/*!
+ * \brief Returns maximum number of strings, limited by
+ * identifiers type and by 32-bits indexes
+ */
+STRINGPOOLBIMAP_TEMPLATE
+std::size_t STRINGPOOLBIMAP_CLASS::maxSize() const
+{
+    const std::uint64_t maxId = std::min<std::uint64_t>(std::numeric_limits<TypeId>::max(), std::numeric_limits<std::uint32_t>::max() - 1);
+    return static_cast<std::size_t>(maxId + 1);
+}
+
+/*!
+ * \brief Remove all strings and release arena
+ * \details
+ * Invalidate all views returned by getValue(). Capacity of
+ * index is kept.
+ */
+STRINGPOOLBIMAP_TEMPLATE
+void STRINGPOOLBIMAP_CLASS::clear()
+{
+    m_spans.clear();
+    m_blocks.clear();
+    m_index.clear();
+
+    m_arenaUsed = 0;
+    m_arenaAllocated = 0;
+    m_payload = 0;
+}
+
+/*!
+ * \brief Exchanges the contents of the string pool with those of \c other
+ * \details
+ * Views of strings of both pools stay valid.
+ */
+STRINGPOOLBIMAP_TEMPLATE
+void STRINGPOOLBIMAP_CLASS::swap(StringPoolBimap &other)
+{
+    using std::swap;
+
+    m_spans.swap(other.m_spans);
+    m_blocks.swap(other.m_blocks);
+    m_index.swap(other.m_index);
+
+    swap(m_arenaUsed, other.m_arenaUsed);
+    swap(m_arenaAllocated, other.m_arenaAllocated);
+    swap(m_payload, other.m_payload);
+    swap(m_hash, other.m_hash);
+}
+
+/*!
+ * \brief Intern a string
+ * \details
+ * Average complexity is <b>O(1)</b>, plus copy of string
+ * characters when it is new.
+ *
+ * \param str
+ * String to intern.
+ * \return
+ * Returns identifier of string: identifier of an equal string
+ * if already interned, next identifier otherwise.
+ *
+ * \throw std::length_error
+ * Throw if pool is full (see maxSize()), or if arena cannot
+ * hold string anymore.
+ *
+ * \sa insert()
+ */
+STRINGPOOLBIMAP_TEMPLATE
+TypeId STRINGPOOLBIMAP_CLASS::intern(std::string_view str)
+{
+    return insert(str).first;
+}
+
+/*!
+ * \brief Intern a string, reporting if it was new
+ * \return
+ * Returns a pair consisting of identifier of string and a boolean
+ * set to \c true if string was not already interned.
+ *
+ * \throw std::length_error
+ * Throw if pool is full (see maxSize()), or if arena cannot
+ * hold string anymore.
+ *
+ * \sa intern()
+ */
+STRINGPOOLBIMAP_TEMPLATE
+std::pair<TypeId, bool> STRINGPOOLBIMAP_CLASS::insert(std::string_view str)
+{
+    const std::size_t hash = hashValue(str);
+    const std::size_t pos = findPos(str, hash);
+    if(pos != _ContainerIndex::NoPos){
+        return std::make_pair(static_cast<TypeId>(m_index.slotAt(pos)), false);
+    }
+
+    prepareInsert();
+
+    const std::uint32_t id = static_cast<std::uint32_t>(m_spans.size());
+    m_spans.emplace_back();
+    try{
+        m_spans.back() = append(str);
+    }catch(...){
+        m_spans.pop_back();
+        throw;
+    }
+    m_index.insert(hash, id);
+    BIMAP_STATS_RECORD(m_stats, Insert);
+
+    return std::make_pair(static_cast<TypeId>(id), true);
+}
+
+/*!
+ * \brief Use to retrieve string by identifier
+ * \details
+ * Complexity is <b>O(1)</b>, no hash is computed.
+ *
+ * \param id
+ * Identifier of string.
+ * \return
+ * Return view of interned string, valid until clear().
+ *
+ * \throw std::out_of_range
+ * Throw if identifier has not been assigned
+ */
+STRINGPOOLBIMAP_TEMPLATE
+std::string_view STRINGPOOLBIMAP_CLASS::getValue(TypeId id) const
+{
+    BIMAP_STATS_LOOKUP_BEGIN(m_stats);
+    const bool found = containsKey(id);
+    BIMAP_STATS_LOOKUP_END(m_stats, found);
+    if(!found){
+        throw std::out_of_range("cmap::StringPoolBimap::getValue");
+    }
+
+    return viewAt(static_cast<std::uint32_t>(id));
+}
+
+/*!
+ * \brief Use to retrieve identifier of a string
+ *
+ * \param str
+ * String to search.
+ * \return
+ * Return identifier of string.
+ *
+ * \throw std::out_of_range
+ * Throw if string has not been interned
+ */
+STRINGPOOLBIMAP_TEMPLATE
+TypeId STRINGPOOLBIMAP_CLASS::getKey(std::string_view str) const
+{
+    BIMAP_STATS_LOOKUP_BEGIN(m_stats);
+    const std::size_t pos = findPos(str, hashValue(str));
+    BIMAP_STATS_LOOKUP_END(m_stats, pos != _ContainerIndex::NoPos);
+    if(pos == _ContainerIndex::NoPos){
+        throw std::out_of_range("cmap::StringPoolBimap::getKey");
+    }
+
+    return static_cast<TypeId>(m_index.slotAt(pos));
+}
+
+/*!
+ * \brief Use to retrieve identifier of a string, without throwing
+ *
+ * \param str
+ * String to search.
+ * \param id
+ * Set to identifier of string if found, left untouched otherwise.
+ * \return
+ * Returns \c true if string has been interned.
+ */
+STRINGPOOLBIMAP_TEMPLATE
+bool STRINGPOOLBIMAP_CLASS::tryGetKey(std::string_view str, TypeId &id) const
+{
+    const std::size_t pos = findPos(str, hashValue(str));
+    if(pos == _ContainerIndex::NoPos){
+        return false;
+    }
+
+    id = static_cast<TypeId>(m_index.slotAt(pos));
+    return true;
+}
+
+/*!
+ * \brief Check if identifier has been assigned
+ */
+STRINGPOOLBIMAP_TEMPLATE
+bool STRINGPOOLBIMAP_CLASS::containsKey(TypeId id) const
+{
+    return static_cast<std::size_t>(id) < m_spans.size();
+}
+
+/*!
+ * \brief Check if string has been interned
+ */
+STRINGPOOLBIMAP_TEMPLATE
+bool STRINGPOOLBIMAP_CLASS::containsValue(std::string_view str) const
+{
+    return findPos(str, hashValue(str)) != _ContainerIndex::NoPos;
+}
+
+/*!
+ * \brief Visit all strings, ordered by identifiers
+ *
+ * \param func
+ * Function called with <tt>(TypeId, std::string_view)</tt>
+ * for each string.
+ */
+STRINGPOOLBIMAP_TEMPLATE
+template<class Func>
+void STRINGPOOLBIMAP_CLASS::forEach(Func func) const
+{
+    for(std::size_t id = 0; id < m_spans.size(); ++id){
+        func(static_cast<TypeId>(id), viewAt(static_cast<std::uint32_t>(id)));
+    }
+}
+
+/*!
+ * \brief Returns number of slots of strings index
+ */
+STRINGPOOLBIMAP_TEMPLATE
+std::size_t STRINGPOOLBIMAP_CLASS::capacity() const
+{
+    return m_index.capacity();
+}
+
+/*!
+ * \brief Returns number of characters stored in arena
+ * \details
+ * Each interned string is counted once, whatever the number
+ * of times it has been interned.
+ */
+STRINGPOOLBIMAP_TEMPLATE
+std::size_t STRINGPOOLBIMAP_CLASS::arenaSize() const
+{
+    return m_payload;
+}
+
+/*!
+ * \brief Reserve room for \c count strings
+ * \details
+ * Index is sized so that \c count strings can be interned without
+ * rehashing. Arena grows by blocks and is never reserved.
+ */
+STRINGPOOLBIMAP_TEMPLATE
+void STRINGPOOLBIMAP_CLASS::reserve(std::size_t count)
+{
+    m_spans.reserve(count);
+
+    const std::size_t required = _ContainerIndex::capacityFor(count);
+    if(required > capacity()){
+        rebuildIndex(required);
+    }
+}
+
+/*!
+ * \brief Returns the function used to hash strings
+ */
+STRINGPOOLBIMAP_TEMPLATE
+Hash STRINGPOOLBIMAP_CLASS::hashFunction() const
+{
+    return m_hash;
+}
+
+/*!
+ * \brief Returns memory owned by string pool
+ * \details
+ * \c indexKey is the array of offsets and lengths of strings
+ * (8 bytes per identifier), \c indexValue the hash table of
+ * identifiers and \c payload the characters of strings. Unused
+ * room of arena blocks is reported in \c unused.
+ */
+STRINGPOOLBIMAP_TEMPLATE
+BimapMemoryUsage STRINGPOOLBIMAP_CLASS::memoryUsage() const
+{
+    constexpr std::size_t slotSize = sizeof(std::int8_t) + sizeof(std::uint32_t);
+
+    const std::size_t nbBlocks = std::count_if(m_blocks.cbegin(), m_blocks.cend(), [](const std::unique_ptr<char[]> &block){
+        return block != nullptr;
+    });
+    const std::size_t nbArrays = (m_spans.capacity() > 0) + (m_blocks.capacity() > 0) + 2 * (m_index.capacity() > 0);
+
+    BimapMemoryUsage usage;
+    usage.indexKey = m_spans.size() * sizeof(_Span);
+    usage.indexValue = m_index.size() * slotSize;
+    usage.payload = m_payload;
+    usage.overhead = (nbArrays + nbBlocks) * BimapAllocationOverhead + m_blocks.capacity() * sizeof(std::unique_ptr<char[]>);
+    usage.unused = (m_spans.capacity() - m_spans.size()) * sizeof(_Span)
+                 + (m_index.capacity() - m_index.size()) * slotSize
+                 + (m_arenaAllocated - m_payload);
+
+    return usage;
+}
+
+#if defined(BIMAP_ENABLE_STATS)
+/*!
+ * \brief Returns statistics of lookups and updates of string pool
+ * \details
+ * Only available when \c BIMAP_ENABLE_STATS is defined.
+ *
+ * \sa bimapstats.h
+ */
+STRINGPOOLBIMAP_TEMPLATE
+BimapStats& STRINGPOOLBIMAP_CLASS::stats() const
+{
+    return m_stats;
+}
+#endif
+
+/*!
+ * \brief Returns view of string \c id
+ * \details
+ * Arena offsets are split in a block number and an offset inside
+ * of that block.
+ */
+STRINGPOOLBIMAP_TEMPLATE
+std::string_view STRINGPOOLBIMAP_CLASS::viewAt(std::uint32_t id) const
+{
+    const _Span &span = m_spans[id];
+    if(span.length == 0){
+        return std::string_view();
+    }
+
+    const char *block = m_blocks[span.offset / BlockSize].get();
+    return std::string_view(block + span.offset % BlockSize, span.length);
+}
+
+STRINGPOOLBIMAP_TEMPLATE
+std::size_t STRINGPOOLBIMAP_CLASS::hashValue(std::string_view str) const
+{
+    return detail::bimapHashMix(m_hash(str));
+}
+
+/*!
+ * \brief Search slot referencing string equal to \c str
+ * \return
+ * Returns position of slot, \c _ContainerIndex::NoPos if not found.
+ */
+STRINGPOOLBIMAP_TEMPLATE
+std::size_t STRINGPOOLBIMAP_CLASS::findPos(std::string_view str, std::size_t hash) const
+{
+    return m_index.find(hash, [this, &str](std::uint32_t id){
+        return m_spans[id].length == str.size() && viewAt(id) == str;
+    });
+}
+
+/*!
+ * \brief Copy characters of \c str into arena
+ * \details
+ * Strings are appended to last block while they fit in it. A string
+ * which doesn't fit starts a new block, and strings longer than
+ * \c BlockSize get an allocation of their own, addressed as if it was
+ * made of consecutive blocks (so offsets always map to a block with a
+ * single division).
+ *
+ * \return
+ * Returns offset and length of copied string.
+ *
+ * \throw std::length_error
+ * Throw if length of string doesn't fit 32 bits, or if arena
+ * cannot address string.
+ */
+STRINGPOOLBIMAP_TEMPLATE
+typename STRINGPOOLBIMAP_CLASS::_Span STRINGPOOLBIMAP_CLASS::append(std::string_view str)
+{
+    if(str.size() > std::numeric_limits<std::uint32_t>::max()){
+        throw std::length_error("cmap::StringPoolBimap::intern");
+    }
+
+    _Span span{0, static_cast<std::uint32_t>(str.size())};
+    if(str.empty()){
+        return span;
+    }
+
+    const std::uint64_t length = str.size();
+    const std::uint64_t used = m_arenaUsed % BlockSize;
+    if(used != 0 && used + length <= BlockSize){
+        span.offset = static_cast<std::uint32_t>(m_arenaUsed);
+        std::memcpy(m_blocks.back().get() + used, str.data(), str.size());
+
+        m_arenaUsed += length;
+        m_payload += str.size();
+        return span;
+    }
+
+    /* Start new block(s) */
+    const std::uint64_t start = m_blocks.size() * std::uint64_t(BlockSize);
+    const std::uint64_t nbBlocks = (length + BlockSize - 1) / BlockSize;
+    if(start + nbBlocks * BlockSize > ArenaMaxSize){
+        throw std::length_error("cmap::StringPoolBimap::intern");
+    }
+
+    const std::size_t allocated = nbBlocks > 1 ? str.size() : BlockSize;
+    m_blocks.reserve(m_blocks.size() + nbBlocks);
+    m_blocks.emplace_back(new char[allocated]);
+    m_blocks.resize(m_blocks.size() + nbBlocks - 1);
+
+    span.offset = static_cast<std::uint32_t>(start);
+    std::memcpy(m_blocks[start / BlockSize].get(), str.data(), str.size());
+
+    m_arenaUsed = nbBlocks > 1 ? start + nbBlocks * BlockSize : start + length;
+    m_arenaAllocated += allocated;
+    m_payload += str.size();
+    return span;
+}
+
+/*!
+ * \brief Make sure index can reference one more string
+ *
+ * \throw std::length_error
+ * Throw if pool is full.
+ */
+STRINGPOOLBIMAP_TEMPLATE
+void STRINGPOOLBIMAP_CLASS::prepareInsert()
+{
+    if(size() >= maxSize()){
+        throw std::length_error("cmap::StringPoolBimap::intern");
+    }
+
+    if(m_index.growthLeft() > 0){
+        return;
+    }
+    rebuildIndex(std::max(_ContainerIndex::capacityFor(size() + 1), 2 * capacity()));
+}
+
+/*!
+ * \brief Rebuild index of strings with \c capacity slots
+ * \details
+ * Hashes are not stored, strings are hashed again.
+ */
+STRINGPOOLBIMAP_TEMPLATE
+void STRINGPOOLBIMAP_CLASS::rebuildIndex(std::size_t capacity)
+{
+    _ContainerIndex index;
+    index.reset(capacity);
+
+    for(std::size_t id = 0; id < m_spans.size(); ++id){
+        index.insert(hashValue(viewAt(static_cast<std::uint32_t>(id))), static_cast<std::uint32_t>(id));
+    }
+
+    m_index.swap(index);
+}
+
+#undef STRINGPOOLBIMAP_TEMPLATE
+#undef STRINGPOOLBIMAP_CLASS
+
+} // Namespace cmap
+
+#endif // BIMAP_HAS_CPP17
+
+#endif // LCH_STRINGPOOLBIMAP_H
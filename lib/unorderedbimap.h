@@ -0,0 +1,2109 @@
+#ifndef LCH_UNORDEREDBIMAP_H
+#define LCH_UNORDEREDBIMAP_H
+
+/*****************************/
+/* Class documentations      */
+/*****************************/
+
+/*!
+   \class cmap::UnorderedBimap
+   \brief Class use to provide unordered bi-directional map support.
+
+   This class provide the same interface than cmap::Bimap but use hash tables
+   for both directions, so searching by keys or by values have an average
+   complexity of <b>O(1)</b>. \n
+   Elements are iterated in insertion order.
+
+   \note
+   Like cmap::Bimap, each pair is stored only once, inside a single node
+   which is chained into two intrusive hash tables (one per direction).
+   Hashes of both sides are cached in nodes, so rehashing never call
+   user hash functions.
+
+   \note
+   By default, growing buckets rehash all elements at once. With
+   setRehashStep(), growth is incremental instead: old and new buckets
+   are kept side by side and each insertion or erasure migrates a few
+   old buckets, lookups searching both until migration ends. New buckets
+   are still allocated (and zeroed) at once.
+
+   \note
+   Nodes are allocated with \c Allocator (rebound to the node type), so
+   \c cmap::PoolAllocator (see bimapallocator.h) or, with C++17,
+   \c std::pmr::polymorphic_allocator (see alias \c cmap::pmr::UnorderedBimap)
+   can be used to avoid one heap allocation per element. Buckets arrays
+   always use \c std::allocator.
+
+   \sa cmap::Bimap
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "bimapcommon.h"
+#include "bimapstats.h"
+
+#if BIMAP_HAS_PMR
+#   include <memory_resource>
+#endif
+
+namespace cmap{
+
+/*****************************/
+/* Internal implementation   */
+/*****************************/
+
+namespace detail{
+
+/*!
+ * \brief Links of a node inside the iteration list of an unordered bimap
+ */
+struct UnorderedBimapLink
+{
+    UnorderedBimapLink *prev;
+    UnorderedBimapLink *next;
+};
+
+/*!
+ * \brief Node shared by both hash tables of an unordered bimap
+ */
+template<class TypeData>
+struct UnorderedBimapNode : UnorderedBimapLink
+{
+    using value_type = TypeData;
+
+    template<class... Args>
+    explicit UnorderedBimapNode(Args&&... args) : UnorderedBimapLink(), data(std::forward<Args>(args)...) {}
+
+    UnorderedBimapNode *nextKey = nullptr;
+    UnorderedBimapNode *nextValue = nullptr;
+    std::size_t hashKey = 0;
+    std::size_t hashValue = 0;
+
+    TypeData data;
+};
+
+/*!
+ * \brief Bidirectional iterator over elements of an unordered bimap
+ * \details
+ * Iterated elements are constant since keys and values are both
+ * used to index nodes.
+ */
+template<class TypeNode>
+class UnorderedBimapIterator
+{
+public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = typename TypeNode::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type*;
+    using reference = const value_type&;
+
+public:
+    UnorderedBimapIterator() : m_link(nullptr) {}
+    explicit UnorderedBimapIterator(UnorderedBimapLink *link) : m_link(link) {}
+
+public:
+    reference operator*() const { return node()->data; }
+    pointer operator->() const { return &node()->data; }
+
+    UnorderedBimapIterator& operator++() { m_link = m_link->next; return *this; }
+    UnorderedBimapIterator operator++(int) { UnorderedBimapIterator tmp = *this; ++*this; return tmp; }
+    UnorderedBimapIterator& operator--() { m_link = m_link->prev; return *this; }
+    UnorderedBimapIterator operator--(int) { UnorderedBimapIterator tmp = *this; --*this; return tmp; }
+
+    friend bool operator==(const UnorderedBimapIterator &lhs, const UnorderedBimapIterator &rhs) { return lhs.m_link == rhs.m_link; }
+    friend bool operator!=(const UnorderedBimapIterator &lhs, const UnorderedBimapIterator &rhs) { return lhs.m_link != rhs.m_link; }
+
+public:
+    TypeNode* node() const { return static_cast<TypeNode*>(m_link); }
+
+private:
+    UnorderedBimapLink *m_link;
+};
+
+} // Namespace detail
+
+/*****************************/
+/* Class definitions         */
+/*****************************/
+
+template<class TypeKey, class TypeValue,
+         class HashKey = std::hash<TypeKey>, class EqualKey = std::equal_to<TypeKey>,
+         class HashValue = std::hash<TypeValue>, class EqualValue = std::equal_to<TypeValue>,
+         class Allocator = std::allocator<std::pair<const TypeKey, TypeValue>>>
+class UnorderedBimap
+{
+public:
+    using key_type = TypeKey;
+    using mapped_type = TypeValue;
+    using value_type = std::pair<const TypeKey, TypeValue>;
+    using size_type = std::size_t;
+
+    using hasher_key = HashKey;
+    using key_equal = EqualKey;
+    using hasher_value = HashValue;
+    using value_equal = EqualValue;
+    using allocator_type = Allocator;
+
+private:
+    using _TypeNode = std::pair<TypeKey, TypeValue>; // Used to implement std::initializer_list<T> support
+
+    using _Node = detail::UnorderedBimapNode<value_type>;
+    using _AllocNode = typename std::allocator_traits<Allocator>::template rebind_alloc<_Node>;
+    using _AllocTraits = std::allocator_traits<_AllocNode>;
+    using _ContainerBuckets = std::vector<_Node*>;
+
+public:
+    using iterator = detail::UnorderedBimapIterator<_Node>;
+    using const_iterator = iterator;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+public:
+    UnorderedBimap();
+    explicit UnorderedBimap(std::size_t bucketCount,
+                            const HashKey &hashKey = HashKey(), const EqualKey &equalKey = EqualKey(),
+                            const HashValue &hashValue = HashValue(), const EqualValue &equalValue = EqualValue(),
+                            const Allocator &alloc = Allocator());
+    explicit UnorderedBimap(const Allocator &alloc);
+    UnorderedBimap(const std::initializer_list<_TypeNode> &args, const Allocator &alloc = Allocator());
+
+    UnorderedBimap(const UnorderedBimap &other);
+    UnorderedBimap(const UnorderedBimap &other, const Allocator &alloc);
+    UnorderedBimap(UnorderedBimap &&other);
+    ~UnorderedBimap();
+
+    UnorderedBimap& operator=(const UnorderedBimap &other);
+    UnorderedBimap& operator=(UnorderedBimap &&other);
+
+public:
+    bool empty() const;
+    std::size_t size() const;
+    std::size_t maxSize() const;
+
+    void clear();
+    void insert(const TypeKey &key, const TypeValue &value);
+    void insert(TypeKey &&key, TypeValue &&value);
+    void erase(const TypeKey &key);
+    void swap(UnorderedBimap &other);
+
+    const TypeValue& getValue(const TypeKey &key) const;
+    const TypeKey& getKey(const TypeValue &value) const;
+
+    template<class K, class H = HashKey, class E = EqualKey, detail::BimapEnableTransparent<H, E> = 0>
+    const TypeValue& getValue(const K &key) const;
+    template<class V, class H = HashValue, class E = EqualValue, detail::BimapEnableTransparent<H, E> = 0>
+    const TypeKey& getKey(const V &value) const;
+
+    const_iterator findByKey(const TypeKey &key) const;
+    const_iterator findByValue(const TypeValue &value) const;
+    bool containsKey(const TypeKey &key) const;
+    bool containsValue(const TypeValue &value) const;
+
+    template<class K, class H = HashKey, class E = EqualKey, detail::BimapEnableTransparent<H, E> = 0>
+    const_iterator findByKey(const K &key) const;
+    template<class V, class H = HashValue, class E = EqualValue, detail::BimapEnableTransparent<H, E> = 0>
+    const_iterator findByValue(const V &value) const;
+    template<class K, class H = HashKey, class E = EqualKey, detail::BimapEnableTransparent<H, E> = 0>
+    bool containsKey(const K &key) const;
+    template<class V, class H = HashValue, class E = EqualValue, detail::BimapEnableTransparent<H, E> = 0>
+    bool containsValue(const V &value) const;
+
+    std::size_t getValues(const TypeKey *keys, std::size_t count, TypeValue *values, bool *found = nullptr) const;
+    std::size_t getKeys(const TypeValue *values, std::size_t count, TypeKey *keys, bool *found = nullptr) const;
+
+    template<class... Args>
+    std::pair<iterator, bool> emplace(Args&&... args);
+    std::pair<iterator, bool> tryInsert(const TypeKey &key, const TypeValue &value);
+    std::pair<iterator, bool> tryInsert(TypeKey &&key, TypeValue &&value);
+
+    std::pair<iterator, bool> insertOrAssign(const TypeKey &key, const TypeValue &value);
+    std::pair<iterator, bool> insertOrAssign(TypeKey &&key, TypeValue &&value);
+    std::pair<iterator, bool> replace(const TypeKey &key, const TypeValue &value, ReplacePolicy policy);
+    std::pair<iterator, bool> replace(TypeKey &&key, TypeValue &&value, ReplacePolicy policy);
+
+public:
+    std::size_t bucketCount() const;
+    float loadFactor() const;
+    float maxLoadFactor() const;
+    void setMaxLoadFactor(float ml);
+
+    void reserve(std::size_t count);
+    void rehash(std::size_t count);
+
+    std::size_t rehashStep() const;
+    void setRehashStep(std::size_t buckets);
+    bool isRehashing() const;
+
+    HashKey hashFunctionKey() const;
+    HashValue hashFunctionValue() const;
+    Allocator getAllocator() const;
+
+    BimapMemoryUsage memoryUsage() const;
+    std::vector<std::size_t> probeHistogramKey() const;
+    std::vector<std::size_t> probeHistogramValue() const;
+
+#if defined(BIMAP_ENABLE_STATS)
+    BimapStats& stats() const;
+#endif
+
+private:
+    void insert(_TypeNode &&node);
+    void insert(const _TypeNode &node);
+
+    template<class K, class V>
+    std::pair<iterator, bool> tryInsertPair(K &&key, V &&value);
+    template<class K, class V>
+    std::pair<iterator, bool> replacePair(K &&key, V &&value, bool overwriteLeft, bool overwriteRight, bool &inserted);
+
+    template<class... Args>
+    _Node* createNode(Args&&... args);
+    void destroyNode(_Node *node);
+
+    std::size_t bucketIndex(std::size_t hash) const;
+
+    template<class K>
+    _Node* findNodeKey(const K &key, std::size_t hash) const;
+    template<class V>
+    _Node* findNodeValue(const V &value, std::size_t hash) const;
+    template<class K>
+    _Node* findOldNodeKey(const K &key, std::size_t hash) const;
+    template<class V>
+    _Node* findOldNodeValue(const V &value, std::size_t hash) const;
+    _Node** slotKey(const _Node *node);
+    _Node** slotValue(const _Node *node);
+
+    void prepareInsert();
+    void insertNode(_Node *node);
+    void linkNode(_Node *node);
+    void unlinkNode(_Node *node);
+    void linkValue(_Node *node);
+    void unlinkValue(_Node *node);
+    void rehashBuckets(std::size_t count);
+    void startRehash(std::size_t count);
+    std::size_t migrationStep() const;
+    void migrateBuckets(std::size_t count);
+    void releaseOldBuckets();
+
+public:
+    iterator begin();
+    const_iterator cbegin() const;
+    reverse_iterator rbegin();
+    const_reverse_iterator crbegin() const;
+    iterator end();
+    const_iterator cend() const;
+    reverse_iterator rend();
+    const_reverse_iterator crend() const;
+
+private:
+    _ContainerBuckets m_bucketsKey;
+    _ContainerBuckets m_bucketsValue;
+    _ContainerBuckets m_oldBucketsKey;      // Buckets being migrated, empty if no rehash is in progress
+    _ContainerBuckets m_oldBucketsValue;
+    detail::UnorderedBimapLink m_list;
+    std::size_t m_size;
+    float m_maxLoadFactor;
+    std::size_t m_rehashIndex;              // Next old bucket to migrate
+    std::size_t m_rehashStep;
+
+    HashKey m_hashKey;
+    EqualKey m_equalKey;
+    HashValue m_hashValue;
+    EqualValue m_equalValue;
+
+    _AllocNode m_alloc;
+
+#if defined(BIMAP_ENABLE_STATS)
+    mutable BimapStats m_stats;
+#endif
+};
+
+#if BIMAP_HAS_PMR
+namespace pmr{
+
+/*!
+ * \brief Alias of \c cmap::UnorderedBimap allocating its nodes from a
+ * \c std::pmr::memory_resource
+ */
+template<class TypeKey, class TypeValue,
+         class HashKey = std::hash<TypeKey>, class EqualKey = std::equal_to<TypeKey>,
+         class HashValue = std::hash<TypeValue>, class EqualValue = std::equal_to<TypeValue>>
+using UnorderedBimap = cmap::UnorderedBimap<TypeKey, TypeValue, HashKey, EqualKey, HashValue, EqualValue,
+                                            std::pmr::polymorphic_allocator<std::pair<const TypeKey, TypeValue>>>;
+
+} // Namespace pmr
+#endif
+
+/*
+ * Functions implementations
+ * Class use template and methods cannot be defined in .cpp file.
+ * See https://isocpp.org/wiki/faq/templates#separate-template-fn-defn-from-decl
+ */
+
+#define UNORDEREDBIMAP_TEMPLATE template<class TypeKey, class TypeValue, class HashKey, class EqualKey, class HashValue, class EqualValue, class Allocator>
+#define UNORDEREDBIMAP_CLASS UnorderedBimap<TypeKey, TypeValue, HashKey, EqualKey, HashValue, EqualValue, Allocator>
+
+/*!
+ * \brief Construct empty unordered bimap
+ * \details
+ * No bucket is allocated until first insertion.
+ */
+UNORDEREDBIMAP_TEMPLATE
+UNORDEREDBIMAP_CLASS::UnorderedBimap() : UnorderedBimap(0)
+{
+    /* Nothing to do */
+}
+
+/*!
+ * \brief Construct empty unordered bimap
+ *
+ * \param bucketCount
+ * Minimal number of buckets to use on initialization.
+ * \param hashKey, equalKey
+ * Hash and comparison functions used for keys.
+ * \param hashValue, equalValue
+ * Hash and comparison functions used for values.
+ * \param alloc
+ * Allocator used to allocate nodes.
+ */
+UNORDEREDBIMAP_TEMPLATE
+UNORDEREDBIMAP_CLASS::UnorderedBimap(std::size_t bucketCount,
+                                     const HashKey &hashKey, const EqualKey &equalKey,
+                                     const HashValue &hashValue, const EqualValue &equalValue,
+                                     const Allocator &alloc) :
+    m_size(0), m_maxLoadFactor(1.0f), m_rehashIndex(0), m_rehashStep(0),
+    m_hashKey(hashKey), m_equalKey(equalKey), m_hashValue(hashValue), m_equalValue(equalValue),
+    m_alloc(alloc)
+{
+    m_list.prev = &m_list;
+    m_list.next = &m_list;
+
+    if(bucketCount > 0){
+        rehash(bucketCount);
+    }
+}
+
+/*!
+ * \brief Construct empty unordered bimap using allocator \c alloc
+ */
+UNORDEREDBIMAP_TEMPLATE
+UNORDEREDBIMAP_CLASS::UnorderedBimap(const Allocator &alloc) :
+    UnorderedBimap(0, HashKey(), EqualKey(), HashValue(), EqualValue(), alloc)
+{
+    /* Nothing to do */
+}
+
+/*!
+ * \brief Construct unordered bimap with \c std::initializer_list
+ * \param args
+ * List to use to construct unordered bimap.
+ *
+ * <b>Example: </b>
+ * \code{.c}
+    const cmap::UnorderedBimap<int, std::string> m_mapNumberToString =
+    {
+        {1, "ONE"},
+        {2, "TWO"},
+        {3, "THREE"}
+    };
+ * \endcode
+ */
+UNORDEREDBIMAP_TEMPLATE
+UNORDEREDBIMAP_CLASS::UnorderedBimap(const std::initializer_list<_TypeNode> &args, const Allocator &alloc) :
+    UnorderedBimap(args.size(), HashKey(), EqualKey(), HashValue(), EqualValue(), alloc)
+{
+    for(auto it=args.begin(); it != args.end(); ++it){
+        insert(*it);
+    }
+}
+
+/*!
+ * \brief Copy constructor
+ * \details
+ * Cached hashes of \c other are reused, so hash functions are not called.
+ */
+UNORDEREDBIMAP_TEMPLATE
+UNORDEREDBIMAP_CLASS::UnorderedBimap(const UnorderedBimap &other) :
+    UnorderedBimap(other, Allocator(_AllocTraits::select_on_container_copy_construction(other.m_alloc)))
+{
+    /* Nothing to do */
+}
+
+/*!
+ * \brief Copy constructor using allocator \c alloc
+ */
+UNORDEREDBIMAP_TEMPLATE
+UNORDEREDBIMAP_CLASS::UnorderedBimap(const UnorderedBimap &other, const Allocator &alloc) :
+    UnorderedBimap(0, other.m_hashKey, other.m_equalKey, other.m_hashValue, other.m_equalValue, alloc)
+{
+    m_maxLoadFactor = other.m_maxLoadFactor;
+    m_rehashStep = other.m_rehashStep;
+    rehashBuckets(other.bucketCount());
+
+    try{
+        for(auto it = other.cbegin(); it != other.cend(); ++it){
+            _Node *node = createNode(*it);
+            node->hashKey = it.node()->hashKey;
+            node->hashValue = it.node()->hashValue;
+            linkNode(node);
+        }
+    }catch(...){
+        clear();
+        throw;
+    }
+}
+
+/*!
+ * \brief Move constructor
+ * \details
+ * Nodes and buckets are stolen from \c other, which is left empty.
+ */
+UNORDEREDBIMAP_TEMPLATE
+UNORDEREDBIMAP_CLASS::UnorderedBimap(UnorderedBimap &&other) :
+    UnorderedBimap(0, other.m_hashKey, other.m_equalKey, other.m_hashValue, other.m_equalValue, other.getAllocator())
+{
+    swap(other);
+}
+
+/*!
+ * \brief Destroy unordered bimap and all its elements
+ */
+UNORDEREDBIMAP_TEMPLATE
+UNORDEREDBIMAP_CLASS::~UnorderedBimap()
+{
+    clear();
+}
+
+/*!
+ * \brief Copy assignment operator
+ * \details
+ * Allocator of \c other is only used if it propagates on
+ * copy assignment.
+ */
+UNORDEREDBIMAP_TEMPLATE
+UNORDEREDBIMAP_CLASS &UNORDEREDBIMAP_CLASS::operator=(const UnorderedBimap &other)
+{
+    if(this != &other){
+        const bool propagate = _AllocTraits::propagate_on_container_copy_assignment::value;
+        UnorderedBimap tmp(other, propagate ? other.getAllocator() : getAllocator());
+
+        /* Nodes of tmp must be released by the allocator which created them */
+        clear();
+        detail::bimapAssignAllocator(m_alloc, tmp.m_alloc, typename _AllocTraits::propagate_on_container_copy_assignment());
+        swap(tmp);
+    }
+    return *this;
+}
+
+/*!
+ * \brief Move assignment operator
+ * \details
+ * Nodes are stolen from \c other, except if allocators doesn't
+ * propagate on move assignment and are not equal: elements are
+ * then copied with current allocator.
+ */
+UNORDEREDBIMAP_TEMPLATE
+UNORDEREDBIMAP_CLASS &UNORDEREDBIMAP_CLASS::operator=(UnorderedBimap &&other)
+{
+    if(this != &other){
+        clear();
+
+        if(_AllocTraits::propagate_on_container_move_assignment::value || m_alloc == other.m_alloc){
+            detail::bimapAssignAllocator(m_alloc, other.m_alloc, typename _AllocTraits::propagate_on_container_move_assignment());
+            swap(other);
+        }else{
+            UnorderedBimap tmp(other, getAllocator());
+            swap(tmp);
+            other.clear();
+        }
+    }
+    return *this;
+}
+
+/*!
+ * \brief Checks whether the container is empty
+ *
+ * \return
+ * Returns \c true if the container is empty, \c false otherwise
+ */
+UNORDEREDBIMAP_TEMPLATE
+bool UNORDEREDBIMAP_CLASS::empty() const
+{
+    return m_size == 0;
+}
+
+/*!
+ * \brief Returns the number of elements
+ *
+ * \return
+ * The number of elements in the container
+ */
+UNORDEREDBIMAP_TEMPLATE
+std::size_t UNORDEREDBIMAP_CLASS::size() const
+{
+    return m_size;
+}
+
+/*!
+ * \brief Returns the maximum possible number of elements
+ *
+ * \return
+ * Maximum number of elements
+ */
+UNORDEREDBIMAP_TEMPLATE
+std::size_t UNORDEREDBIMAP_CLASS::maxSize() const
+{
+    return std::numeric_limits<std::size_t>::max() / sizeof(_Node);
+}
+
+/*!
+ * \brief Clears the contents
+ * \details
+ * Erases all elements from the container. After this call, size() returns zero. \n
+ * Buckets are kept allocated, so bucketCount() is unchanged.
+ */
+UNORDEREDBIMAP_TEMPLATE
+void UNORDEREDBIMAP_CLASS::clear()
+{
+    detail::UnorderedBimapLink *link = m_list.next;
+    while(link != &m_list){
+        detail::UnorderedBimapLink *next = link->next;
+        destroyNode(static_cast<_Node*>(link));
+        link = next;
+    }
+
+    m_list.prev = &m_list;
+    m_list.next = &m_list;
+    std::fill(m_bucketsKey.begin(), m_bucketsKey.end(), nullptr);
+    std::fill(m_bucketsValue.begin(), m_bucketsValue.end(), nullptr);
+    releaseOldBuckets();
+    m_size = 0;
+}
+
+/*!
+ * \brief Insert item to unordered bimap
+ *
+ * \param key
+ * Key of element, if key already exist, it will be replaced.
+ * \param value
+ * Value associated to the key, if value is already associated
+ * to another key, this association will be removed.
+ */
+UNORDEREDBIMAP_TEMPLATE
+void UNORDEREDBIMAP_CLASS::insert(const TypeKey &key, const TypeValue &value)
+{
+    prepareInsert();
+    insertNode(createNode(key, value));
+}
+
+/*!
+ * \overload
+ * \details
+ * Key and value are moved into the new element.
+ */
+UNORDEREDBIMAP_TEMPLATE
+void UNORDEREDBIMAP_CLASS::insert(TypeKey &&key, TypeValue &&value)
+{
+    prepareInsert();
+    insertNode(createNode(std::move(key), std::move(value)));
+}
+
+/*!
+ * \overload
+ */
+UNORDEREDBIMAP_TEMPLATE
+void UNORDEREDBIMAP_CLASS::insert(_TypeNode &&node)
+{
+    insert(std::move(node.first), std::move(node.second));
+}
+
+/*!
+ * \overload
+ */
+UNORDEREDBIMAP_TEMPLATE
+void UNORDEREDBIMAP_CLASS::insert(const _TypeNode &node)
+{
+    insert(node.first, node.second);
+}
+
+/*!
+ * \brief Use to erase an element
+ *
+ * \param key
+ * Key of element to erase, if key doesn't exist, this
+ * method do nothing.
+ */
+UNORDEREDBIMAP_TEMPLATE
+void UNORDEREDBIMAP_CLASS::erase(const TypeKey &key)
+{
+    if(isRehashing()){
+        migrateBuckets(migrationStep());
+    }
+
+    _Node *node = findNodeKey(key, detail::bimapHashMix(m_hashKey(key)));
+    if(!node){
+        return;
+    }
+
+    unlinkNode(node);
+    destroyNode(node);
+    BIMAP_STATS_RECORD(m_stats, Erase);
+}
+
+/*!
+ * \brief Exchanges the contents of the container with those of \c other
+ * \details
+ * Does not invoke any move, copy, or swap operations on individual elements. \n
+ * Allocators are only exchanged if they propagate on swap, otherwise
+ * they must be equal (like for standard containers).
+ */
+UNORDEREDBIMAP_TEMPLATE
+void UNORDEREDBIMAP_CLASS::swap(UnorderedBimap &other)
+{
+    using std::swap;
+
+    swap(m_bucketsKey, other.m_bucketsKey);
+    swap(m_bucketsValue, other.m_bucketsValue);
+    swap(m_oldBucketsKey, other.m_oldBucketsKey);
+    swap(m_oldBucketsValue, other.m_oldBucketsValue);
+    swap(m_list, other.m_list);
+    swap(m_size, other.m_size);
+    swap(m_maxLoadFactor, other.m_maxLoadFactor);
+    swap(m_rehashIndex, other.m_rehashIndex);
+    swap(m_rehashStep, other.m_rehashStep);
+    swap(m_hashKey, other.m_hashKey);
+    swap(m_equalKey, other.m_equalKey);
+    swap(m_hashValue, other.m_hashValue);
+    swap(m_equalValue, other.m_equalValue);
+    detail::bimapSwapAllocator(m_alloc, other.m_alloc, typename _AllocTraits::propagate_on_container_swap());
+
+    /* Restore links pointing to list sentinels */
+    detail::UnorderedBimapLink *lists[] = {&m_list, &other.m_list};
+    for(detail::UnorderedBimapLink *list : lists){
+        if(list->next == (list == &m_list ? &other.m_list : &m_list)){
+            list->prev = list;
+            list->next = list;
+        }else{
+            list->next->prev = list;
+            list->prev->next = list;
+        }
+    }
+}
+
+/*!
+ * \brief Use to retrieve value by key
+ *
+ * \param key
+ * Key of element to get.
+ * \return
+ * Return value associated to key.
+ *
+ * \throw std::out_of_range
+ * Throw if key cannot be found
+ */
+UNORDEREDBIMAP_TEMPLATE
+const TypeValue &UNORDEREDBIMAP_CLASS::getValue(const TypeKey &key) const
+{
+    BIMAP_STATS_LOOKUP_BEGIN(m_stats);
+    const _Node *node = findNodeKey(key, detail::bimapHashMix(m_hashKey(key)));
+    BIMAP_STATS_LOOKUP_END(m_stats, node != nullptr);
+    if(!node){
+        throw std::out_of_range("cmap::UnorderedBimap::getValue");
+    }
+
+    return node->data.second;
+}
+
+/*!
+ * \brief Use to retrieve key by value
+ *
+ * \param value
+ * Value to use to retrieve key element.
+ * \return
+ * Return key associated to value.
+ *
+ * \throw std::out_of_range
+ * Throw if value cannot be found
+ */
+UNORDEREDBIMAP_TEMPLATE
+const TypeKey &UNORDEREDBIMAP_CLASS::getKey(const TypeValue &value) const
+{
+    BIMAP_STATS_LOOKUP_BEGIN(m_stats);
+    const _Node *node = findNodeValue(value, detail::bimapHashMix(m_hashValue(value)));
+    BIMAP_STATS_LOOKUP_END(m_stats, node != nullptr);
+    if(!node){
+        throw std::out_of_range("cmap::UnorderedBimap::getKey");
+    }
+
+    return node->data.first;
+}
+
+/*!
+ * \brief Use to retrieve value by an object comparable to keys
+ * \details
+ * This overload is only available when both \c HashKey and \c EqualKey
+ * are transparent (see cmap::StringHash), so no temporary key is
+ * constructed to perform the lookup.
+ *
+ * \param key
+ * Object comparable to keys, its hash must be equal to the hash of
+ * the equivalent key.
+ * \return
+ * Return value associated to key.
+ *
+ * \throw std::out_of_range
+ * Throw if key cannot be found
+ */
+UNORDEREDBIMAP_TEMPLATE
+template<class K, class H, class E, detail::BimapEnableTransparent<H, E>>
+const TypeValue &UNORDEREDBIMAP_CLASS::getValue(const K &key) const
+{
+    BIMAP_STATS_LOOKUP_BEGIN(m_stats);
+    const _Node *node = findNodeKey(key, detail::bimapHashMix(m_hashKey(key)));
+    BIMAP_STATS_LOOKUP_END(m_stats, node != nullptr);
+    if(!node){
+        throw std::out_of_range("cmap::UnorderedBimap::getValue");
+    }
+
+    return node->data.second;
+}
+
+/*!
+ * \brief Use to retrieve key by an object comparable to values
+ * \details
+ * This overload is only available when both \c HashValue and \c EqualValue
+ * are transparent (see cmap::StringHash), so no temporary value is
+ * constructed to perform the lookup.
+ *
+ * \param value
+ * Object comparable to values, its hash must be equal to the hash of
+ * the equivalent value.
+ * \return
+ * Return key associated to value.
+ *
+ * \throw std::out_of_range
+ * Throw if value cannot be found
+ */
+UNORDEREDBIMAP_TEMPLATE
+template<class V, class H, class E, detail::BimapEnableTransparent<H, E>>
+const TypeKey &UNORDEREDBIMAP_CLASS::getKey(const V &value) const
+{
+    BIMAP_STATS_LOOKUP_BEGIN(m_stats);
+    const _Node *node = findNodeValue(value, detail::bimapHashMix(m_hashValue(value)));
+    BIMAP_STATS_LOOKUP_END(m_stats, node != nullptr);
+    if(!node){
+        throw std::out_of_range("cmap::UnorderedBimap::getKey");
+    }
+
+    return node->data.first;
+}
+
+/*!
+ * \brief Use to search an element by key
+ * \details
+ * Unlike getValue(), this method never throw: a missing key
+ * cost the same than a found one.
+ *
+ * \param key
+ * Key of element to search.
+ * \return
+ * Return iterator to element, equal to \c cend() if key cannot be found.
+ */
+UNORDEREDBIMAP_TEMPLATE
+typename UNORDEREDBIMAP_CLASS::const_iterator UNORDEREDBIMAP_CLASS::findByKey(const TypeKey &key) const
+{
+    _Node *node = findNodeKey(key, detail::bimapHashMix(m_hashKey(key)));
+    return node ? const_iterator(node) : cend();
+}
+
+/*!
+ * \brief Use to search an element by value
+ * \details
+ * Unlike getKey(), this method never throw: a missing value
+ * cost the same than a found one.
+ *
+ * \param value
+ * Value of element to search.
+ * \return
+ * Return iterator to element, equal to \c cend() if value cannot be found.
+ */
+UNORDEREDBIMAP_TEMPLATE
+typename UNORDEREDBIMAP_CLASS::const_iterator UNORDEREDBIMAP_CLASS::findByValue(const TypeValue &value) const
+{
+    _Node *node = findNodeValue(value, detail::bimapHashMix(m_hashValue(value)));
+    return node ? const_iterator(node) : cend();
+}
+
+/*!
+ * \brief Checks if bimap contains an element with key \c key
+ *
+ * \param key
+ * Key of element to search.
+ * \return
+ * Returns \c true if key exists, \c false otherwise.
+ */
+UNORDEREDBIMAP_TEMPLATE
+bool UNORDEREDBIMAP_CLASS::containsKey(const TypeKey &key) const
+{
+    return findByKey(key) != cend();
+}
+
+/*!
+ * \brief Checks if bimap contains an element with value \c value
+ *
+ * \param value
+ * Value of element to search.
+ * \return
+ * Returns \c true if value exists, \c false otherwise.
+ */
+UNORDEREDBIMAP_TEMPLATE
+bool UNORDEREDBIMAP_CLASS::containsValue(const TypeValue &value) const
+{
+    return findByValue(value) != cend();
+}
+
+/*!
+ * \brief Use to search an element by an object comparable to keys
+ * \details
+ * This overload is only available when both \c HashKey and \c EqualKey are transparent.
+ *
+ * \param key
+ * Object comparable to keys.
+ * \return
+ * Return iterator to element, equal to \c cend() if key cannot be found.
+ */
+UNORDEREDBIMAP_TEMPLATE
+template<class K, class H, class E, detail::BimapEnableTransparent<H, E>>
+typename UNORDEREDBIMAP_CLASS::const_iterator UNORDEREDBIMAP_CLASS::findByKey(const K &key) const
+{
+    _Node *node = findNodeKey(key, detail::bimapHashMix(m_hashKey(key)));
+    return node ? const_iterator(node) : cend();
+}
+
+/*!
+ * \brief Use to search an element by an object comparable to values
+ * \details
+ * This overload is only available when both \c HashValue and \c EqualValue are transparent.
+ *
+ * \param value
+ * Object comparable to values.
+ * \return
+ * Return iterator to element, equal to \c cend() if value cannot be found.
+ */
+UNORDEREDBIMAP_TEMPLATE
+template<class V, class H, class E, detail::BimapEnableTransparent<H, E>>
+typename UNORDEREDBIMAP_CLASS::const_iterator UNORDEREDBIMAP_CLASS::findByValue(const V &value) const
+{
+    _Node *node = findNodeValue(value, detail::bimapHashMix(m_hashValue(value)));
+    return node ? const_iterator(node) : cend();
+}
+
+/*!
+ * \brief Checks if bimap contains an element with key
+ * equivalent to \c key
+ * \details
+ * This overload is only available when both \c HashKey and \c EqualKey are transparent.
+ */
+UNORDEREDBIMAP_TEMPLATE
+template<class K, class H, class E, detail::BimapEnableTransparent<H, E>>
+bool UNORDEREDBIMAP_CLASS::containsKey(const K &key) const
+{
+    return findByKey(key) != cend();
+}
+
+/*!
+ * \brief Checks if bimap contains an element with value
+ * equivalent to \c value
+ * \details
+ * This overload is only available when both \c HashValue and \c EqualValue are transparent.
+ */
+UNORDEREDBIMAP_TEMPLATE
+template<class V, class H, class E, detail::BimapEnableTransparent<H, E>>
+bool UNORDEREDBIMAP_CLASS::containsValue(const V &value) const
+{
+    return findByValue(value) != cend();
+}
+
+/*!
+ * \brief Retrieve values of several keys at once
+ * \details
+ * Searches are interleaved: keys are processed by groups, each stage
+ * (hashing, loading bucket, loading node) prefetches memory needed by the
+ * next one for all keys of the group, so cache misses overlap. Prefer
+ * this method to a loop of getValue() for large batches. \n
+ * Misses are reported in \c found instead of throwing, elements of
+ * \c values matching a missing key are left untouched.
+ *
+ * \param keys
+ * Array of \c count keys to search.
+ * \param count
+ * Number of keys to search.
+ * \param values
+ * Array of \c count elements, receiving value associated to each key.
+ * \param found
+ * Array of \c count booleans set to \c true if key has been found,
+ * can be \c nullptr.
+ * \return
+ * Returns number of keys found.
+ */
+UNORDEREDBIMAP_TEMPLATE
+std::size_t UNORDEREDBIMAP_CLASS::getValues(const TypeKey *keys, std::size_t count, TypeValue *values, bool *found) const
+{
+    std::size_t hashes[detail::BimapBatchWidth];
+    _Node *nodes[detail::BimapBatchWidth];
+    std::size_t nbFound = 0;
+
+    for(std::size_t first = 0; first < count; first += detail::BimapBatchWidth){
+        const std::size_t width = std::min(detail::BimapBatchWidth, count - first);
+        const TypeKey *group = keys + first;
+
+        /* Stage 1: hash all elements and prefetch their buckets */
+        if(m_size != 0){
+            for(std::size_t i = 0; i < width; ++i){
+                hashes[i] = detail::bimapHashMix(m_hashKey(group[i]));
+                detail::bimapPrefetch(&m_bucketsKey[bucketIndex(hashes[i])]);
+            }
+        }
+
+        /* Stage 2: load heads of chains and prefetch them */
+        for(std::size_t i = 0; i < width; ++i){
+            nodes[i] = m_size != 0 ? m_bucketsKey[bucketIndex(hashes[i])] : nullptr;
+            if(nodes[i]){
+                detail::bimapPrefetch(nodes[i]);
+                detail::bimapPrefetch(&nodes[i]->data);
+            }
+        }
+
+        /* Stage 3: walk chains */
+        for(std::size_t i = 0; i < width; ++i){
+            _Node *node = nodes[i];
+            while(node && !(node->hashKey == hashes[i] && m_equalKey(node->data.first, group[i]))){
+                node = node->nextKey;
+            }
+            if(!node && isRehashing()){
+                node = findOldNodeKey(group[i], hashes[i]);
+            }
+
+            if(node){
+                values[first + i] = node->data.second;
+                ++nbFound;
+            }
+            if(found){
+                found[first + i] = node != nullptr;
+            }
+        }
+    }
+
+    return nbFound;
+}
+
+/*!
+ * \brief Retrieve keys of several values at once
+ * \details
+ * Reverse direction of getValues().
+ *
+ * \param values
+ * Array of \c count values to search.
+ * \param count
+ * Number of values to search.
+ * \param keys
+ * Array of \c count elements, receiving key associated to each value.
+ * \param found
+ * Array of \c count booleans set to \c true if value has been found,
+ * can be \c nullptr.
+ * \return
+ * Returns number of values found.
+ */
+UNORDEREDBIMAP_TEMPLATE
+std::size_t UNORDEREDBIMAP_CLASS::getKeys(const TypeValue *values, std::size_t count, TypeKey *keys, bool *found) const
+{
+    std::size_t hashes[detail::BimapBatchWidth];
+    _Node *nodes[detail::BimapBatchWidth];
+    std::size_t nbFound = 0;
+
+    for(std::size_t first = 0; first < count; first += detail::BimapBatchWidth){
+        const std::size_t width = std::min(detail::BimapBatchWidth, count - first);
+        const TypeValue *group = values + first;
+
+        /* Stage 1: hash all elements and prefetch their buckets */
+        if(m_size != 0){
+            for(std::size_t i = 0; i < width; ++i){
+                hashes[i] = detail::bimapHashMix(m_hashValue(group[i]));
+                detail::bimapPrefetch(&m_bucketsValue[bucketIndex(hashes[i])]);
+            }
+        }
+
+        /* Stage 2: load heads of chains and prefetch them */
+        for(std::size_t i = 0; i < width; ++i){
+            nodes[i] = m_size != 0 ? m_bucketsValue[bucketIndex(hashes[i])] : nullptr;
+            if(nodes[i]){
+                detail::bimapPrefetch(nodes[i]);
+                detail::bimapPrefetch(&nodes[i]->data);
+            }
+        }
+
+        /* Stage 3: walk chains */
+        for(std::size_t i = 0; i < width; ++i){
+            _Node *node = nodes[i];
+            while(node && !(node->hashValue == hashes[i] && m_equalValue(node->data.second, group[i]))){
+                node = node->nextValue;
+            }
+            if(!node && isRehashing()){
+                node = findOldNodeValue(group[i], hashes[i]);
+            }
+
+            if(node){
+                keys[first + i] = node->data.first;
+                ++nbFound;
+            }
+            if(found){
+                found[first + i] = node != nullptr;
+            }
+        }
+    }
+
+    return nbFound;
+}
+
+/*!
+ * \brief Construct element in-place if neither its key nor
+ * its value already exist
+ * \details
+ * Element is constructed from \c args (like \c std::pair constructors)
+ * then linked, unlike insert(), existing elements are never replaced.
+ * If insertion fails, constructed element is destroyed.
+ *
+ * \param args
+ * Arguments to forward to the constructor of the element.
+ * \return
+ * Returns a pair consisting of an iterator to the inserted element (or to
+ * the element that prevented the insertion, element with same key has precedence)
+ * and a boolean set to \c true if insertion took place.
+ */
+UNORDEREDBIMAP_TEMPLATE
+template<class... Args>
+std::pair<typename UNORDEREDBIMAP_CLASS::iterator, bool> UNORDEREDBIMAP_CLASS::emplace(Args&&... args)
+{
+    prepareInsert();
+
+    _Node *node = createNode(std::forward<Args>(args)...);
+    node->hashKey = detail::bimapHashMix(m_hashKey(node->data.first));
+    node->hashValue = detail::bimapHashMix(m_hashValue(node->data.second));
+
+    _Node *found = findNodeKey(node->data.first, node->hashKey);
+    if(!found){
+        found = findNodeValue(node->data.second, node->hashValue);
+    }
+
+    if(found){
+        destroyNode(node);
+        return std::make_pair(iterator(found), false);
+    }
+
+    linkNode(node);
+    BIMAP_STATS_RECORD(m_stats, Insert);
+    return std::make_pair(iterator(node), true);
+}
+
+/*!
+ * \brief Insert element if neither its key nor its value
+ * already exist
+ * \details
+ * Unlike emplace(), no element is constructed when insertion
+ * fails, so arguments are never copied (or moved) in this case.
+ *
+ * \param key
+ * Key of element.
+ * \param value
+ * Value associated to the key.
+ * \return
+ * Returns a pair consisting of an iterator to the inserted element (or to
+ * the element that prevented the insertion, element with same key has precedence)
+ * and a boolean set to \c true if insertion took place.
+ */
+UNORDEREDBIMAP_TEMPLATE
+std::pair<typename UNORDEREDBIMAP_CLASS::iterator, bool> UNORDEREDBIMAP_CLASS::tryInsert(const TypeKey &key, const TypeValue &value)
+{
+    return tryInsertPair(key, value);
+}
+
+/*!
+ * \overload
+ * \details
+ * Key and value are moved only if insertion took place.
+ */
+UNORDEREDBIMAP_TEMPLATE
+std::pair<typename UNORDEREDBIMAP_CLASS::iterator, bool> UNORDEREDBIMAP_CLASS::tryInsert(TypeKey &&key, TypeValue &&value)
+{
+    return tryInsertPair(std::move(key), std::move(value));
+}
+
+/*!
+ * \brief Insert element, or assign value of existing key
+ * \details
+ * Like insert(), both sides are kept consistent: if \c value was
+ * associated to another key, this association is removed. \n
+ * But when \c key already exists, its element is reused and only its
+ * value is assigned (element keeps its place in iteration order), a single
+ * search is performed on each side.
+ *
+ * \param key
+ * Key of element.
+ * \param value
+ * Value to associate to the key.
+ * \return
+ * Returns a pair consisting of an iterator to the element and a
+ * boolean set to \c true if key was inserted, \c false if assigned.
+ */
+UNORDEREDBIMAP_TEMPLATE
+std::pair<typename UNORDEREDBIMAP_CLASS::iterator, bool> UNORDEREDBIMAP_CLASS::insertOrAssign(const TypeKey &key, const TypeValue &value)
+{
+    bool inserted = false;
+    auto result = replacePair(key, value, true, true, inserted);
+    return std::make_pair(result.first, inserted);
+}
+
+/*!
+ * \overload
+ */
+UNORDEREDBIMAP_TEMPLATE
+std::pair<typename UNORDEREDBIMAP_CLASS::iterator, bool> UNORDEREDBIMAP_CLASS::insertOrAssign(TypeKey &&key, TypeValue &&value)
+{
+    bool inserted = false;
+    auto result = replacePair(std::move(key), std::move(value), true, true, inserted);
+    return std::make_pair(result.first, inserted);
+}
+
+/*!
+ * \brief Insert pair, resolving conflicts with existing
+ * elements according to \c policy
+ * \details
+ * A single search is performed on each side, elements are
+ * reused when possible.
+ *
+ * \param key
+ * Key of element.
+ * \param value
+ * Value to associate to the key.
+ * \param policy
+ * Policy to apply when \c key or \c value already exist.
+ * \return
+ * Returns a pair consisting of an iterator to the element (or to the
+ * element which caused the rejection) and a boolean set to \c true
+ * if bimap now contains the pair.
+ *
+ * \sa insert(), insertOrAssign(), tryInsert()
+ */
+UNORDEREDBIMAP_TEMPLATE
+std::pair<typename UNORDEREDBIMAP_CLASS::iterator, bool> UNORDEREDBIMAP_CLASS::replace(const TypeKey &key, const TypeValue &value, ReplacePolicy policy)
+{
+    bool inserted = false;
+    return replacePair(key, value, policy == ReplacePolicy::OverwriteLeft, policy == ReplacePolicy::OverwriteRight, inserted);
+}
+
+/*!
+ * \overload
+ * \details
+ * Key and value are moved only if they are used.
+ */
+UNORDEREDBIMAP_TEMPLATE
+std::pair<typename UNORDEREDBIMAP_CLASS::iterator, bool> UNORDEREDBIMAP_CLASS::replace(TypeKey &&key, TypeValue &&value, ReplacePolicy policy)
+{
+    bool inserted = false;
+    return replacePair(std::move(key), std::move(value), policy == ReplacePolicy::OverwriteLeft, policy == ReplacePolicy::OverwriteRight, inserted);
+}
+
+/*!
+ * \brief Returns the number of buckets
+ * \details
+ * Both directions always use the same number of buckets. During an
+ * incremental rehash, number of new buckets is returned.
+ *
+ * \return
+ * The number of buckets in the container.
+ */
+UNORDEREDBIMAP_TEMPLATE
+std::size_t UNORDEREDBIMAP_CLASS::bucketCount() const
+{
+    return m_bucketsKey.size();
+}
+
+/*!
+ * \brief Returns average number of elements per bucket
+ *
+ * \return
+ * Average number of elements per bucket, \c 0 if
+ * no bucket is allocated.
+ */
+UNORDEREDBIMAP_TEMPLATE
+float UNORDEREDBIMAP_CLASS::loadFactor() const
+{
+    const std::size_t count = bucketCount();
+    return count > 0 ? static_cast<float>(m_size) / static_cast<float>(count) : 0.0f;
+}
+
+/*!
+ * \brief Returns maximum load factor
+ * \details
+ * Container automatically increases the number of buckets if the
+ * load factor exceeds this threshold. \n
+ * Default value is \c 1.0
+ *
+ * \return
+ * Current maximum load factor.
+ */
+UNORDEREDBIMAP_TEMPLATE
+float UNORDEREDBIMAP_CLASS::maxLoadFactor() const
+{
+    return m_maxLoadFactor;
+}
+
+/*!
+ * \brief Set maximum load factor
+ *
+ * \param ml
+ * New maximum load factor, must be positive.
+ *
+ * \sa maxLoadFactor()
+ */
+UNORDEREDBIMAP_TEMPLATE
+void UNORDEREDBIMAP_CLASS::setMaxLoadFactor(float ml)
+{
+    m_maxLoadFactor = ml;
+    if(loadFactor() > m_maxLoadFactor){
+        reserve(m_size);
+    }
+}
+
+/*!
+ * \brief Reserves space for at least the specified number of elements
+ * \details
+ * Use this method before bulk insertions to avoid intermediate rehashes.
+ *
+ * \param count
+ * New capacity of the container.
+ */
+UNORDEREDBIMAP_TEMPLATE
+void UNORDEREDBIMAP_CLASS::reserve(std::size_t count)
+{
+    rehash(static_cast<std::size_t>(std::ceil(static_cast<float>(count) / m_maxLoadFactor)));
+}
+
+/*!
+ * \brief Set the number of buckets
+ * \details
+ * Number of buckets is rounded to next power of two, and cannot be
+ * lower than what is required by current size and maximum load factor. \n
+ * All elements are rehashed at once (completing any incremental
+ * rehash in progress). Invalidate no iterators: only buckets are reallocated.
+ *
+ * \param count
+ * Minimal number of buckets.
+ */
+UNORDEREDBIMAP_TEMPLATE
+void UNORDEREDBIMAP_CLASS::rehash(std::size_t count)
+{
+    const std::size_t required = static_cast<std::size_t>(std::ceil(static_cast<float>(m_size) / m_maxLoadFactor));
+    count = std::max<std::size_t>({count, required, 8});
+
+    std::size_t buckets = 1;
+    while(buckets < count){
+        buckets <<= 1;
+    }
+
+    if(buckets != bucketCount() || isRehashing()){
+        rehashBuckets(buckets);
+    }
+}
+
+/*!
+ * \brief Returns number of old buckets migrated by each insertion
+ * or erasure during an incremental rehash
+ * \details
+ * \c 0 (default) means that buckets are rehashed at once.
+ *
+ * \sa setRehashStep()
+ */
+UNORDEREDBIMAP_TEMPLATE
+std::size_t UNORDEREDBIMAP_CLASS::rehashStep() const
+{
+    return m_rehashStep;
+}
+
+/*!
+ * \brief Enable incremental rehash of buckets
+ * \details
+ * When buckets need to grow, new buckets are allocated but elements
+ * stay in old ones: each following insertion or erasure migrates
+ * \c buckets old buckets (in both directions) to new ones, so no
+ * single operation rehash the whole container. Lookups search both
+ * buckets until migration ends, and never migrate anything (so
+ * concurrent lookups stay allowed). \n
+ * Step is raised when needed so migration is over before next growth,
+ * even when few insertions are allowed until then (for instance with a
+ * maximum load factor lower than \c 1). \n
+ * Growth still allocates new buckets at once and fills them with null
+ * pointers, which costs time proportional to number of buckets.
+ *
+ * \param buckets
+ * Number of old buckets migrated by each operation, use \c 0 to rehash
+ * at once (pending migration is then completed).
+ */
+UNORDEREDBIMAP_TEMPLATE
+void UNORDEREDBIMAP_CLASS::setRehashStep(std::size_t buckets)
+{
+    m_rehashStep = buckets;
+    if(m_rehashStep == 0 && isRehashing()){
+        migrateBuckets(m_oldBucketsKey.size());
+    }
+}
+
+/*!
+ * \brief Returns \c true if an incremental rehash is in progress
+ *
+ * \sa setRehashStep()
+ */
+UNORDEREDBIMAP_TEMPLATE
+bool UNORDEREDBIMAP_CLASS::isRehashing() const
+{
+    return !m_oldBucketsKey.empty();
+}
+
+/*!
+ * \brief Returns function used to hash keys
+ */
+UNORDEREDBIMAP_TEMPLATE
+HashKey UNORDEREDBIMAP_CLASS::hashFunctionKey() const
+{
+    return m_hashKey;
+}
+
+/*!
+ * \brief Returns function used to hash values
+ */
+UNORDEREDBIMAP_TEMPLATE
+HashValue UNORDEREDBIMAP_CLASS::hashFunctionValue() const
+{
+    return m_hashValue;
+}
+
+/*!
+ * \brief Returns allocator associated with the container
+ */
+UNORDEREDBIMAP_TEMPLATE
+Allocator UNORDEREDBIMAP_CLASS::getAllocator() const
+{
+    return Allocator(m_alloc);
+}
+
+/*!
+ * \brief Returns memory owned by bimap
+ * \details
+ * Indexes are made of bucket arrays plus, in each node, the chaining
+ * link and the cached hash of each direction. Links of iteration list
+ * are reported in \c overhead.
+ */
+UNORDEREDBIMAP_TEMPLATE
+BimapMemoryUsage UNORDEREDBIMAP_CLASS::memoryUsage() const
+{
+    constexpr std::size_t perNodeIndex = sizeof(_Node*) + sizeof(std::size_t);
+    const std::size_t nbBuckets = m_bucketsKey.size() + m_oldBucketsKey.size();
+    const std::size_t nbArrays = (m_bucketsKey.capacity() > 0) + (m_bucketsValue.capacity() > 0) + 2 * isRehashing();
+
+    BimapMemoryUsage usage;
+    usage.indexKey = nbBuckets * sizeof(_Node*) + m_size * perNodeIndex;
+    usage.indexValue = (m_bucketsValue.size() + m_oldBucketsValue.size()) * sizeof(_Node*) + m_size * perNodeIndex;
+    usage.payload = m_size * sizeof(value_type);
+    usage.overhead = m_size * (sizeof(_Node) - 2 * perNodeIndex - sizeof(value_type) + BimapAllocationOverhead) + nbArrays * BimapAllocationOverhead;
+    usage.unused = (m_bucketsKey.capacity() - m_bucketsKey.size() + m_bucketsValue.capacity() - m_bucketsValue.size()) * sizeof(_Node*);
+
+    return usage;
+}
+
+/*!
+ * \brief Returns histogram of probe lengths of keys
+ * \details
+ * Probe length of an element is the number of nodes of its bucket
+ * visited to find it by key (first node of a bucket has length \c 1).
+ * A badly distributed hash function shows up as long tails.
+ *
+ * \return
+ * Histogram, element at index \c i is the number of elements found
+ * after <tt>i + 1</tt> probes. Empty if bimap is empty.
+ */
+UNORDEREDBIMAP_TEMPLATE
+std::vector<std::size_t> UNORDEREDBIMAP_CLASS::probeHistogramKey() const
+{
+    std::vector<std::size_t> histogram;
+    for(const _ContainerBuckets *buckets : {&m_bucketsKey, &m_oldBucketsKey}){
+        for(_Node *head : *buckets){
+            std::size_t length = 0;
+            for(_Node *node = head; node; node = node->nextKey){
+                detail::bimapHistogramAdd(histogram, ++length);
+            }
+        }
+    }
+    return histogram;
+}
+
+/*!
+ * \brief Returns histogram of probe lengths of values
+ * \sa probeHistogramKey()
+ */
+UNORDEREDBIMAP_TEMPLATE
+std::vector<std::size_t> UNORDEREDBIMAP_CLASS::probeHistogramValue() const
+{
+    std::vector<std::size_t> histogram;
+    for(const _ContainerBuckets *buckets : {&m_bucketsValue, &m_oldBucketsValue}){
+        for(_Node *head : *buckets){
+            std::size_t length = 0;
+            for(_Node *node = head; node; node = node->nextValue){
+                detail::bimapHistogramAdd(histogram, ++length);
+            }
+        }
+    }
+    return histogram;
+}
+
+#if defined(BIMAP_ENABLE_STATS)
+/*!
+ * \brief Returns statistics of lookups and updates of bimap
+ * \details
+ * Only available when \c BIMAP_ENABLE_STATS is defined.
+ *
+ * \sa bimapstats.h
+ */
+UNORDEREDBIMAP_TEMPLATE
+BimapStats& UNORDEREDBIMAP_CLASS::stats() const
+{
+    return m_stats;
+}
+#endif
+
+/*!
+ * \brief Link a new element built from \c key and \c value if
+ * they do not conflict with existing elements
+ * \details
+ * Each side is hashed and searched once, node is only
+ * allocated if both searches fail.
+ */
+UNORDEREDBIMAP_TEMPLATE
+template<class K, class V>
+std::pair<typename UNORDEREDBIMAP_CLASS::iterator, bool> UNORDEREDBIMAP_CLASS::tryInsertPair(K &&key, V &&value)
+{
+    const std::size_t hk = detail::bimapHashMix(m_hashKey(key));
+    _Node *found = findNodeKey(key, hk);
+    if(found){
+        return std::make_pair(iterator(found), false);
+    }
+
+    const std::size_t hv = detail::bimapHashMix(m_hashValue(value));
+    found = findNodeValue(value, hv);
+    if(found){
+        return std::make_pair(iterator(found), false);
+    }
+
+    prepareInsert();
+
+    _Node *node = createNode(std::forward<K>(key), std::forward<V>(value));
+    node->hashKey = hk;
+    node->hashValue = hv;
+    linkNode(node);
+    BIMAP_STATS_RECORD(m_stats, Insert);
+
+    return std::make_pair(iterator(node), true);
+}
+
+/*!
+ * \brief Insert pair built from \c key and \c value, overwriting
+ * conflicting sides when allowed
+ * \details
+ * Each side is hashed and searched once. A new key always require a
+ * new node (keys are constants), while an existing key keep its node
+ * which is only moved to the bucket of its new value.
+ *
+ * \param overwriteLeft
+ * Allow to replace the key associated to \c value.
+ * \param overwriteRight
+ * Allow to replace the value associated to \c key.
+ * \param inserted
+ * Set to \c true if a new key has been inserted.
+ */
+UNORDEREDBIMAP_TEMPLATE
+template<class K, class V>
+std::pair<typename UNORDEREDBIMAP_CLASS::iterator, bool> UNORDEREDBIMAP_CLASS::replacePair(K &&key, V &&value, bool overwriteLeft, bool overwriteRight, bool &inserted)
+{
+    inserted = false;
+
+    const std::size_t hk = detail::bimapHashMix(m_hashKey(key));
+    const std::size_t hv = detail::bimapHashMix(m_hashValue(value));
+    _Node *nodeKey = findNodeKey(key, hk);
+    _Node *nodeValue = findNodeValue(value, hv);
+
+    /* Apply policy */
+    if(nodeKey && nodeKey == nodeValue){
+        return std::make_pair(iterator(nodeKey), true);
+    }
+    if(nodeKey && !overwriteRight){
+        return std::make_pair(iterator(nodeKey), false);
+    }
+    if(nodeValue && !overwriteLeft){
+        return std::make_pair(iterator(nodeValue), false);
+    }
+
+    /* New key: link a new node */
+    if(!nodeKey){
+        prepareInsert();
+
+        _Node *node = createNode(std::forward<K>(key), std::forward<V>(value));
+        node->hashKey = hk;
+        node->hashValue = hv;
+
+        if(nodeValue){
+            unlinkNode(nodeValue);
+            destroyNode(nodeValue);
+            BIMAP_STATS_RECORD(m_stats, Overwrite);
+        }else{
+            BIMAP_STATS_RECORD(m_stats, Insert);
+        }
+        linkNode(node);
+
+        inserted = true;
+        return std::make_pair(iterator(node), true);
+    }
+
+    /* Existing key: chains are only relinked, so if assignment fails, element can still be removed */
+    try{
+        nodeKey->data.second = std::forward<V>(value);
+    }catch(...){
+        unlinkNode(nodeKey);
+        destroyNode(nodeKey);
+        throw;
+    }
+
+    if(nodeValue){
+        unlinkNode(nodeValue);
+        destroyNode(nodeValue);
+    }
+
+    unlinkValue(nodeKey);
+    nodeKey->hashValue = hv;
+    linkValue(nodeKey);
+    BIMAP_STATS_RECORD(m_stats, Overwrite);
+
+    return std::make_pair(iterator(nodeKey), true);
+}
+
+/*!
+ * \brief Allocate and construct a node
+ * \details
+ * Node is not linked to any table, and its hashes are not computed.
+ */
+UNORDEREDBIMAP_TEMPLATE
+template<class... Args>
+typename UNORDEREDBIMAP_CLASS::_Node* UNORDEREDBIMAP_CLASS::createNode(Args&&... args)
+{
+    _Node *node = _AllocTraits::allocate(m_alloc, 1);
+    try{
+        _AllocTraits::construct(m_alloc, node, std::forward<Args>(args)...);
+    }catch(...){
+        _AllocTraits::deallocate(m_alloc, node, 1);
+        throw;
+    }
+    return node;
+}
+
+/*!
+ * \brief Destroy and deallocate a node
+ * \details
+ * Node must be unlinked from both tables.
+ */
+UNORDEREDBIMAP_TEMPLATE
+void UNORDEREDBIMAP_CLASS::destroyNode(_Node *node)
+{
+    _AllocTraits::destroy(m_alloc, node);
+    _AllocTraits::deallocate(m_alloc, node, 1);
+}
+
+UNORDEREDBIMAP_TEMPLATE
+std::size_t UNORDEREDBIMAP_CLASS::bucketIndex(std::size_t hash) const
+{
+    return hash & (bucketCount() - 1);
+}
+
+UNORDEREDBIMAP_TEMPLATE
+template<class K>
+typename UNORDEREDBIMAP_CLASS::_Node* UNORDEREDBIMAP_CLASS::findNodeKey(const K &key, std::size_t hash) const
+{
+    if(m_size == 0){
+        return nullptr;
+    }
+
+    for(_Node *node = m_bucketsKey[bucketIndex(hash)]; node; node = node->nextKey){
+        if(node->hashKey == hash && m_equalKey(node->data.first, key)){
+            return node;
+        }
+    }
+    return isRehashing() ? findOldNodeKey(key, hash) : nullptr;
+}
+
+UNORDEREDBIMAP_TEMPLATE
+template<class V>
+typename UNORDEREDBIMAP_CLASS::_Node* UNORDEREDBIMAP_CLASS::findNodeValue(const V &value, std::size_t hash) const
+{
+    if(m_size == 0){
+        return nullptr;
+    }
+
+    for(_Node *node = m_bucketsValue[bucketIndex(hash)]; node; node = node->nextValue){
+        if(node->hashValue == hash && m_equalValue(node->data.second, value)){
+            return node;
+        }
+    }
+    return isRehashing() ? findOldNodeValue(value, hash) : nullptr;
+}
+
+/*!
+ * \brief Search key in old buckets, during an incremental rehash
+ * \details
+ * Old buckets already migrated are empty.
+ */
+UNORDEREDBIMAP_TEMPLATE
+template<class K>
+typename UNORDEREDBIMAP_CLASS::_Node* UNORDEREDBIMAP_CLASS::findOldNodeKey(const K &key, std::size_t hash) const
+{
+    for(_Node *node = m_oldBucketsKey[hash & (m_oldBucketsKey.size() - 1)]; node; node = node->nextKey){
+        if(node->hashKey == hash && m_equalKey(node->data.first, key)){
+            return node;
+        }
+    }
+    return nullptr;
+}
+
+/*!
+ * \brief Search value in old buckets, during an incremental rehash
+ * \sa findOldNodeKey()
+ */
+UNORDEREDBIMAP_TEMPLATE
+template<class V>
+typename UNORDEREDBIMAP_CLASS::_Node* UNORDEREDBIMAP_CLASS::findOldNodeValue(const V &value, std::size_t hash) const
+{
+    for(_Node *node = m_oldBucketsValue[hash & (m_oldBucketsValue.size() - 1)]; node; node = node->nextValue){
+        if(node->hashValue == hash && m_equalValue(node->data.second, value)){
+            return node;
+        }
+    }
+    return nullptr;
+}
+
+/*!
+ * \brief Returns link pointing to \c node in chain of its key
+ * \details
+ * Node may still be in an old bucket during an incremental rehash.
+ */
+UNORDEREDBIMAP_TEMPLATE
+typename UNORDEREDBIMAP_CLASS::_Node** UNORDEREDBIMAP_CLASS::slotKey(const _Node *node)
+{
+    if(isRehashing()){
+        for(_Node **slot = &m_oldBucketsKey[node->hashKey & (m_oldBucketsKey.size() - 1)]; *slot; slot = &(*slot)->nextKey){
+            if(*slot == node){
+                return slot;
+            }
+        }
+    }
+
+    _Node **slot = &m_bucketsKey[bucketIndex(node->hashKey)];
+    while(*slot != node){
+        slot = &(*slot)->nextKey;
+    }
+    return slot;
+}
+
+/*!
+ * \brief Returns link pointing to \c node in chain of its value
+ * \sa slotKey()
+ */
+UNORDEREDBIMAP_TEMPLATE
+typename UNORDEREDBIMAP_CLASS::_Node** UNORDEREDBIMAP_CLASS::slotValue(const _Node *node)
+{
+    if(isRehashing()){
+        for(_Node **slot = &m_oldBucketsValue[node->hashValue & (m_oldBucketsValue.size() - 1)]; *slot; slot = &(*slot)->nextValue){
+            if(*slot == node){
+                return slot;
+            }
+        }
+    }
+
+    _Node **slot = &m_bucketsValue[bucketIndex(node->hashValue)];
+    while(*slot != node){
+        slot = &(*slot)->nextValue;
+    }
+    return slot;
+}
+
+/*!
+ * \brief Grow buckets if one more element would exceed
+ * maximum load factor
+ * \details
+ * Called before allocating a node, so new node is chained only
+ * once and is never leaked if buckets allocation fails. \n
+ * Also perform one step of incremental rehash.
+ */
+UNORDEREDBIMAP_TEMPLATE
+void UNORDEREDBIMAP_CLASS::prepareInsert()
+{
+    if(isRehashing()){
+        migrateBuckets(migrationStep());
+    }
+
+    if(m_size + 1 > bucketCount() * m_maxLoadFactor){
+        if(m_rehashStep > 0 && m_size > 0){
+            std::size_t buckets = 2 * bucketCount();
+            while(m_size + 1 > buckets * m_maxLoadFactor){
+                buckets <<= 1;
+            }
+            startRehash(buckets);
+        }else{
+            reserve(m_size + 1);
+        }
+    }
+}
+
+/*!
+ * \brief Link node, replacing elements which conflict with it
+ */
+UNORDEREDBIMAP_TEMPLATE
+void UNORDEREDBIMAP_CLASS::insertNode(_Node *node)
+{
+    node->hashKey = detail::bimapHashMix(m_hashKey(node->data.first));
+    node->hashValue = detail::bimapHashMix(m_hashValue(node->data.second));
+
+    /* Remove entries which conflict with new pair */
+    bool overwritten = false;
+    _Node *found = findNodeKey(node->data.first, node->hashKey);
+    if(found){
+        unlinkNode(found);
+        destroyNode(found);
+        overwritten = true;
+    }
+
+    found = findNodeValue(node->data.second, node->hashValue);
+    if(found){
+        unlinkNode(found);
+        destroyNode(found);
+        overwritten = true;
+    }
+
+    linkNode(node);
+    if(overwritten){
+        BIMAP_STATS_RECORD(m_stats, Overwrite);
+    }else{
+        BIMAP_STATS_RECORD(m_stats, Insert);
+    }
+}
+
+/*!
+ * \brief Chain node into both tables and append it to iteration list
+ * \details
+ * Key and value of \c node must not already exist in bimap, and
+ * buckets must be allocated.
+ */
+UNORDEREDBIMAP_TEMPLATE
+void UNORDEREDBIMAP_CLASS::linkNode(_Node *node)
+{
+    _Node *&headKey = m_bucketsKey[bucketIndex(node->hashKey)];
+    node->nextKey = headKey;
+    headKey = node;
+
+    linkValue(node);
+
+    node->prev = m_list.prev;
+    node->next = &m_list;
+    m_list.prev->next = node;
+    m_list.prev = node;
+
+    ++m_size;
+}
+
+/*!
+ * \brief Unchain node from both tables and from iteration list
+ * \details
+ * Node is not destroyed.
+ */
+UNORDEREDBIMAP_TEMPLATE
+void UNORDEREDBIMAP_CLASS::unlinkNode(_Node *node)
+{
+    _Node **slot = slotKey(node);
+    *slot = node->nextKey;
+
+    unlinkValue(node);
+
+    node->prev->next = node->next;
+    node->next->prev = node->prev;
+
+    /* Batched lookups rely on empty bimaps never rehashing */
+    if(--m_size == 0 && isRehashing()){
+        releaseOldBuckets();
+    }
+}
+
+/*!
+ * \brief Chain node in bucket of its value
+ * \details
+ * New nodes are always chained in new buckets.
+ */
+UNORDEREDBIMAP_TEMPLATE
+void UNORDEREDBIMAP_CLASS::linkValue(_Node *node)
+{
+    _Node *&head = m_bucketsValue[bucketIndex(node->hashValue)];
+    node->nextValue = head;
+    head = node;
+}
+
+/*!
+ * \brief Remove node from bucket of its value
+ * \details
+ * Bucket is selected with cached hash, so values are never compared.
+ */
+UNORDEREDBIMAP_TEMPLATE
+void UNORDEREDBIMAP_CLASS::unlinkValue(_Node *node)
+{
+    _Node **slot = slotValue(node);
+    *slot = node->nextValue;
+}
+
+/*!
+ * \brief Redistribute nodes into \c count buckets
+ * \details
+ * \c count must be a power of two.
+ */
+UNORDEREDBIMAP_TEMPLATE
+void UNORDEREDBIMAP_CLASS::rehashBuckets(std::size_t count)
+{
+    _ContainerBuckets bucketsKey(count, nullptr);
+    _ContainerBuckets bucketsValue(count, nullptr);
+
+    const std::size_t mask = count - 1;
+    for(detail::UnorderedBimapLink *link = m_list.next; link != &m_list; link = link->next){
+        _Node *node = static_cast<_Node*>(link);
+
+        _Node *&headKey = bucketsKey[node->hashKey & mask];
+        node->nextKey = headKey;
+        headKey = node;
+
+        _Node *&headValue = bucketsValue[node->hashValue & mask];
+        node->nextValue = headValue;
+        headValue = node;
+    }
+
+    m_bucketsKey.swap(bucketsKey);
+    m_bucketsValue.swap(bucketsValue);
+    releaseOldBuckets();
+}
+
+/*!
+ * \brief Start an incremental rehash to \c count buckets
+ * \details
+ * Current buckets become old ones, elements are migrated
+ * by migrateBuckets(). \c count must be a power of two.
+ */
+UNORDEREDBIMAP_TEMPLATE
+void UNORDEREDBIMAP_CLASS::startRehash(std::size_t count)
+{
+    if(isRehashing()){
+        migrateBuckets(m_oldBucketsKey.size());
+    }
+
+    _ContainerBuckets bucketsKey(count, nullptr);
+    _ContainerBuckets bucketsValue(count, nullptr);
+
+    m_oldBucketsKey.swap(m_bucketsKey);
+    m_oldBucketsValue.swap(m_bucketsValue);
+    m_bucketsKey.swap(bucketsKey);
+    m_bucketsValue.swap(bucketsValue);
+    m_rehashIndex = 0;
+}
+
+/*!
+ * \brief Returns number of old buckets to migrate by one update
+ * \details
+ * Rehash step is raised when remaining old buckets couldn't be migrated
+ * by insertions still allowed before next growth (with a maximum load
+ * factor lower than \c 1, fewer insertions than buckets fill the table),
+ * so migration ends before next growth is needed.
+ */
+UNORDEREDBIMAP_TEMPLATE
+std::size_t UNORDEREDBIMAP_CLASS::migrationStep() const
+{
+    const std::size_t remaining = m_oldBucketsKey.size() - m_rehashIndex;
+    const std::size_t capacity = static_cast<std::size_t>(bucketCount() * m_maxLoadFactor);
+    const std::size_t insertions = capacity > m_size ? capacity - m_size : 1;
+
+    return std::max(m_rehashStep, (remaining + insertions - 1) / insertions);
+}
+
+/*!
+ * \brief Move nodes of next \c count old buckets (of both
+ * directions) to new buckets
+ * \details
+ * Old buckets are released once all of them are migrated.
+ */
+UNORDEREDBIMAP_TEMPLATE
+void UNORDEREDBIMAP_CLASS::migrateBuckets(std::size_t count)
+{
+    const std::size_t last = std::min(m_oldBucketsKey.size(), m_rehashIndex + count);
+    for(; m_rehashIndex < last; ++m_rehashIndex){
+        _Node *node = m_oldBucketsKey[m_rehashIndex];
+        while(node){
+            _Node *next = node->nextKey;
+            _Node *&head = m_bucketsKey[bucketIndex(node->hashKey)];
+            node->nextKey = head;
+            head = node;
+            node = next;
+        }
+        m_oldBucketsKey[m_rehashIndex] = nullptr;
+
+        node = m_oldBucketsValue[m_rehashIndex];
+        while(node){
+            _Node *next = node->nextValue;
+            _Node *&head = m_bucketsValue[bucketIndex(node->hashValue)];
+            node->nextValue = head;
+            head = node;
+            node = next;
+        }
+        m_oldBucketsValue[m_rehashIndex] = nullptr;
+    }
+
+    if(m_rehashIndex == m_oldBucketsKey.size()){
+        releaseOldBuckets();
+    }
+}
+
+/*!
+ * \brief End incremental rehash, old buckets must not chain any node
+ */
+UNORDEREDBIMAP_TEMPLATE
+void UNORDEREDBIMAP_CLASS::releaseOldBuckets()
+{
+    _ContainerBuckets().swap(m_oldBucketsKey);
+    _ContainerBuckets().swap(m_oldBucketsValue);
+    m_rehashIndex = 0;
+}
+
+/*!
+ * \brief Returns an iterator to the beginning
+ *
+ * \return
+ * Iterator to the first inserted element. \n
+ * If the map is empty, the returned iterator will be equal to \c end().
+ */
+UNORDEREDBIMAP_TEMPLATE
+typename UNORDEREDBIMAP_CLASS::iterator UNORDEREDBIMAP_CLASS::begin()
+{
+    return iterator(m_list.next);
+}
+
+/*!
+ * \brief Returns a constant iterator to the beginning
+ *
+ * \return
+ * Iterator to the first inserted element. \n
+ * If the map is empty, the returned iterator will be equal to \c cend().
+ */
+UNORDEREDBIMAP_TEMPLATE
+typename UNORDEREDBIMAP_CLASS::const_iterator UNORDEREDBIMAP_CLASS::cbegin() const
+{
+    return const_iterator(m_list.next);
+}
+
+/*!
+ * \brief Returns a reverse iterator to the beginning
+ *
+ * \return
+ * Reverse iterator to the last inserted element. \n
+ * If the map is empty, the returned iterator is equal to \c rend().
+ */
+UNORDEREDBIMAP_TEMPLATE
+typename UNORDEREDBIMAP_CLASS::reverse_iterator UNORDEREDBIMAP_CLASS::rbegin()
+{
+    return reverse_iterator(end());
+}
+
+/*!
+ * \brief Returns a constant reverse iterator to the beginning
+ *
+ * \return
+ * Reverse iterator to the last inserted element. \n
+ * If the map is empty, the returned iterator is equal to \c crend().
+ */
+UNORDEREDBIMAP_TEMPLATE
+typename UNORDEREDBIMAP_CLASS::const_reverse_iterator UNORDEREDBIMAP_CLASS::crbegin() const
+{
+    return const_reverse_iterator(cend());
+}
+
+/*!
+ * \brief Returns an iterator to the end
+ *
+ * \return
+ * Iterator to the element following the last element.
+ */
+UNORDEREDBIMAP_TEMPLATE
+typename UNORDEREDBIMAP_CLASS::iterator UNORDEREDBIMAP_CLASS::end()
+{
+    return iterator(&m_list);
+}
+
+/*!
+ * \brief Returns a constant iterator to the end
+ *
+ * \return
+ * Iterator to the element following the last element.
+ */
+UNORDEREDBIMAP_TEMPLATE
+typename UNORDEREDBIMAP_CLASS::const_iterator UNORDEREDBIMAP_CLASS::cend() const
+{
+    return const_iterator(const_cast<detail::UnorderedBimapLink*>(&m_list));
+}
+
+/*!
+ * \brief Returns a reverse iterator to the end
+ *
+ * \return
+ * Reverse iterator to the element preceding the first inserted element.
+ */
+UNORDEREDBIMAP_TEMPLATE
+typename UNORDEREDBIMAP_CLASS::reverse_iterator UNORDEREDBIMAP_CLASS::rend()
+{
+    return reverse_iterator(begin());
+}
+
+/*!
+ * \brief Returns a constant reverse iterator to the end
+ *
+ * \return
+ * Reverse iterator to the element preceding the first inserted element.
+ */
+UNORDEREDBIMAP_TEMPLATE
+typename UNORDEREDBIMAP_CLASS::const_reverse_iterator UNORDEREDBIMAP_CLASS::crend() const
+{
+    return const_reverse_iterator(cbegin());
+}
+
+#undef UNORDEREDBIMAP_TEMPLATE
+#undef UNORDEREDBIMAP_CLASS
+
+} // Namespace cmap
+
+#endif // LCH_UNORDEREDBIMAP_H
@@ -1,6 +1,22 @@
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <new>
+#include <random>
+#include <sstream>
 #include <string>
+#include <tuple>
+#include <vector>
 
+#include "bimapcommon.h"
+#if BIMAP_HAS_PMR
+#include <memory_resource>
+#endif
+
+#include "bimapallocator.h"
 #include "bimap.h"
 
 /*****************************/
@@ -11,6 +27,25 @@
 /* Classes aliases           */
 /*****************************/
 
+/*!
+ * \brief Key only constructible explicitly, used to
+ * check heterogeneous lookups
+ */
+struct Id
+{
+    explicit Id(int v) : value(v) {}
+    int value;
+};
+
+struct IdLess
+{
+    using is_transparent = void;
+
+    bool operator()(const Id &lhs, const Id &rhs) const { return lhs.value < rhs.value; }
+    bool operator()(const Id &lhs, int rhs) const { return lhs.value < rhs; }
+    bool operator()(int lhs, const Id &rhs) const { return lhs < rhs.value; }
+};
+
 /*****************************/
 /* Define test classes       */
 /*****************************/
@@ -60,6 +95,33 @@ TEST_F(BimapTests, insertNewItems)
     EXPECT_EQ(4, m_mapNumberToString.getKey("FOUR"));
 }
 
+TEST_F(BimapTests, insertStringLiteralsIsNotRangeInsert)
+{
+    cmap::Bimap<std::string, std::string> mapStrings;
+    mapStrings.insert("ab", "cd");
+    mapStrings.insert("ONE", "TWO");
+
+    EXPECT_EQ(2, mapStrings.size());
+    EXPECT_EQ("cd", mapStrings.getValue("ab"));
+    EXPECT_EQ("ONE", mapStrings.getKey("TWO"));
+}
+
+TEST_F(BimapTests, insertIntegerLiteralsIsNotRangeInsert)
+{
+    cmap::Bimap<std::uint64_t, std::uint64_t> mapIntegers;
+    mapIntegers.insert(1, 2);
+    mapIntegers.insert(3, 4);
+
+    EXPECT_EQ(2, mapIntegers.size());
+    EXPECT_EQ(2u, mapIntegers.getValue(1));
+    EXPECT_EQ(3u, mapIntegers.getKey(4));
+
+    /* Range overload is still used by iterators of pairs */
+    const std::vector<std::pair<int, std::string>> pairs = {{4, "FOUR"}, {5, "FIVE"}};
+    EXPECT_EQ(2, m_mapNumberToString.insert(pairs.cbegin(), pairs.cend()));
+    EXPECT_EQ(5, m_mapNumberToString.getKey("FIVE"));
+}
+
 TEST_F(BimapTests, searchByValidKeys)
 {
     EXPECT_EQ("ONE", m_mapNumberToString.getValue(1));
@@ -67,6 +129,862 @@ TEST_F(BimapTests, searchByValidKeys)
     EXPECT_EQ("THREE", m_mapNumberToString.getValue(3));
 }
 
+TEST_F(BimapTests, searchByValidValues)
+{
+    EXPECT_EQ(1, m_mapNumberToString.getKey("ONE"));
+    EXPECT_EQ(2, m_mapNumberToString.getKey("TWO"));
+    EXPECT_EQ(3, m_mapNumberToString.getKey("THREE"));
+}
+
+TEST_F(BimapTests, searchByInvalidItemsThrow)
+{
+    EXPECT_THROW(m_mapNumberToString.getValue(42), std::out_of_range);
+    EXPECT_THROW(m_mapNumberToString.getKey("FORTY-TWO"), std::out_of_range);
+}
+
+TEST_F(BimapTests, eraseRemoveBothSides)
+{
+    m_mapNumberToString.erase(2);
+    m_mapNumberToString.erase(42);
+
+    EXPECT_EQ(2, m_mapNumberToString.size());
+    EXPECT_THROW(m_mapNumberToString.getValue(2), std::out_of_range);
+    EXPECT_THROW(m_mapNumberToString.getKey("TWO"), std::out_of_range);
+}
+
+TEST_F(BimapTests, eraseByValueAndRanges)
+{
+    m_mapNumberToString.insert(4, "FOUR");
+    m_mapNumberToString.eraseByValue("TWO");
+    m_mapNumberToString.eraseByValue("FORTY-TWO");
+    EXPECT_EQ(3, m_mapNumberToString.size());
+    EXPECT_FALSE(m_mapNumberToString.containsKey(2));
+
+    /* Keys 3 and 4 */
+    auto it = m_mapNumberToString.erase(m_mapNumberToString.findByKey(3), m_mapNumberToString.cend());
+    EXPECT_EQ(m_mapNumberToString.cend(), it);
+    EXPECT_EQ(1, m_mapNumberToString.size());
+    EXPECT_FALSE(m_mapNumberToString.containsValue("FOUR"));
+
+    m_mapNumberToString.insert(5, "A");
+    m_mapNumberToString.insert(6, "Z");
+
+    /* Values "A" and "ONE" */
+    auto view = m_mapNumberToString.byValue();
+    auto itValue = m_mapNumberToString.erase(view.begin(), view.lowerBound("Z"));
+    EXPECT_EQ(6, itValue->first);
+    EXPECT_EQ(1, m_mapNumberToString.size());
+    EXPECT_FALSE(m_mapNumberToString.containsKey(1));
+
+    EXPECT_EQ(view.end(), m_mapNumberToString.erase(view.begin(), view.end()));
+    EXPECT_TRUE(m_mapNumberToString.empty());
+}
+
+TEST_F(BimapTests, insertExistingItemsKeepSidesConsistent)
+{
+    m_mapNumberToString.insert(1, "UN");    // Existing key
+    m_mapNumberToString.insert(4, "TWO");   // Existing value
+
+    EXPECT_EQ(3, m_mapNumberToString.size());
+    EXPECT_EQ("UN", m_mapNumberToString.getValue(1));
+    EXPECT_EQ(1, m_mapNumberToString.getKey("UN"));
+    EXPECT_EQ(4, m_mapNumberToString.getKey("TWO"));
+    EXPECT_THROW(m_mapNumberToString.getKey("ONE"), std::out_of_range);
+    EXPECT_THROW(m_mapNumberToString.getValue(2), std::out_of_range);
+}
+
+TEST_F(BimapTests, iterateInKeyOrder)
+{
+    std::vector<int> keys;
+    for(auto it = m_mapNumberToString.cbegin(); it != m_mapNumberToString.cend(); ++it){
+        keys.push_back(it->first);
+    }
+    EXPECT_EQ(std::vector<int>({1, 2, 3}), keys);
+
+    keys.clear();
+    for(auto it = m_mapNumberToString.crbegin(); it != m_mapNumberToString.crend(); ++it){
+        keys.push_back(it->first);
+    }
+    EXPECT_EQ(std::vector<int>({3, 2, 1}), keys);
+}
+
+TEST_F(BimapTests, copyAndMoveAreIndependent)
+{
+    cmap::Bimap<int, std::string> copy(m_mapNumberToString);
+    copy.erase(1);
+
+    EXPECT_EQ(3, m_mapNumberToString.size());
+    EXPECT_EQ(2, copy.size());
+    EXPECT_EQ(2, copy.getKey("TWO"));
+
+    cmap::Bimap<int, std::string> moved(std::move(copy));
+    EXPECT_TRUE(copy.empty());
+    EXPECT_EQ(2, moved.size());
+    EXPECT_EQ("THREE", moved.getValue(3));
+}
+
+TEST_F(BimapTests, findDoesNotThrow)
+{
+    auto itKey = m_mapNumberToString.findByKey(2);
+    ASSERT_NE(m_mapNumberToString.cend(), itKey);
+    EXPECT_EQ("TWO", itKey->second);
+
+    auto itValue = m_mapNumberToString.findByValue("THREE");
+    ASSERT_NE(m_mapNumberToString.cend(), itValue);
+    EXPECT_EQ(3, itValue->first);
+
+    EXPECT_EQ(m_mapNumberToString.cend(), m_mapNumberToString.findByKey(42));
+    EXPECT_EQ(m_mapNumberToString.cend(), m_mapNumberToString.findByValue("FORTY-TWO"));
+
+    EXPECT_TRUE(m_mapNumberToString.containsKey(1));
+    EXPECT_FALSE(m_mapNumberToString.containsKey(42));
+    EXPECT_TRUE(m_mapNumberToString.containsValue("ONE"));
+    EXPECT_FALSE(m_mapNumberToString.containsValue("FORTY-TWO"));
+}
+
+TEST_F(BimapTests, tryInsertNeverReplace)
+{
+    std::string value = "UNO";
+    auto result = m_mapNumberToString.tryInsert(1, std::move(value));
+    EXPECT_FALSE(result.second);
+    EXPECT_EQ("ONE", result.first->second);
+    EXPECT_EQ("UNO", value);
+
+    result = m_mapNumberToString.tryInsert(4, "TWO");
+    EXPECT_FALSE(result.second);
+    EXPECT_EQ(2, result.first->first);
+
+    result = m_mapNumberToString.tryInsert(4, "FOUR");
+    EXPECT_TRUE(result.second);
+    EXPECT_EQ(4, result.first->first);
+    EXPECT_EQ(4, m_mapNumberToString.size());
+    EXPECT_EQ(4, m_mapNumberToString.getKey("FOUR"));
+}
+
+TEST_F(BimapTests, emplaceConstructInPlace)
+{
+    auto result = m_mapNumberToString.emplace(std::piecewise_construct, std::forward_as_tuple(4), std::forward_as_tuple(3, 'X'));
+    EXPECT_TRUE(result.second);
+    EXPECT_EQ("XXX", result.first->second);
+    EXPECT_EQ(4, m_mapNumberToString.getKey("XXX"));
+
+    result = m_mapNumberToString.emplace(5, "ONE");
+    EXPECT_FALSE(result.second);
+    EXPECT_EQ(1, result.first->first);
+    EXPECT_FALSE(m_mapNumberToString.containsKey(5));
+    EXPECT_EQ(4, m_mapNumberToString.size());
+}
+
+TEST_F(BimapTests, insertOrAssignKeepSidesConsistent)
+{
+    auto result = m_mapNumberToString.insertOrAssign(1, "UNO");
+    EXPECT_FALSE(result.second);
+    EXPECT_EQ("UNO", result.first->second);
+    EXPECT_EQ(1, m_mapNumberToString.getKey("UNO"));
+    EXPECT_FALSE(m_mapNumberToString.containsValue("ONE"));
+
+    result = m_mapNumberToString.insertOrAssign(1, "TWO");
+    EXPECT_FALSE(result.second);
+    EXPECT_EQ(1, m_mapNumberToString.getKey("TWO"));
+    EXPECT_FALSE(m_mapNumberToString.containsKey(2));
+    EXPECT_FALSE(m_mapNumberToString.containsValue("UNO"));
+    EXPECT_EQ(2, m_mapNumberToString.size());
+
+    result = m_mapNumberToString.insertOrAssign(4, "THREE");
+    EXPECT_TRUE(result.second);
+    EXPECT_EQ(4, result.first->first);
+    EXPECT_EQ(4, m_mapNumberToString.getKey("THREE"));
+    EXPECT_FALSE(m_mapNumberToString.containsKey(3));
+    EXPECT_EQ(2, m_mapNumberToString.size());
+}
+
+TEST_F(BimapTests, replaceFollowPolicy)
+{
+    auto result = m_mapNumberToString.replace(1, "TWO", cmap::ReplacePolicy::Reject);
+    EXPECT_FALSE(result.second);
+    EXPECT_EQ(1, result.first->first);
+
+    result = m_mapNumberToString.replace(1, "UNO", cmap::ReplacePolicy::OverwriteLeft);
+    EXPECT_FALSE(result.second);
+    EXPECT_EQ("ONE", m_mapNumberToString.getValue(1));
+
+    result = m_mapNumberToString.replace(4, "ONE", cmap::ReplacePolicy::OverwriteRight);
+    EXPECT_FALSE(result.second);
+    EXPECT_EQ(1, result.first->first);
+
+    result = m_mapNumberToString.replace(1, "UNO", cmap::ReplacePolicy::OverwriteRight);
+    EXPECT_TRUE(result.second);
+    EXPECT_EQ("UNO", m_mapNumberToString.getValue(1));
+
+    result = m_mapNumberToString.replace(4, "TWO", cmap::ReplacePolicy::OverwriteLeft);
+    EXPECT_TRUE(result.second);
+    EXPECT_EQ(4, m_mapNumberToString.getKey("TWO"));
+    EXPECT_FALSE(m_mapNumberToString.containsKey(2));
+
+    result = m_mapNumberToString.replace(4, "TWO", cmap::ReplacePolicy::Reject);
+    EXPECT_TRUE(result.second);
+    EXPECT_EQ(3, m_mapNumberToString.size());
+}
+
+TEST(BimapStressTests, matchReferenceMaps)
+{
+    cmap::Bimap<int, int> bimap;
+    std::map<int, int> refKeys;
+    std::map<int, int> refValues;
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> dist(0, 512);
+    for(int i = 0; i < 20000; ++i){
+        const int key = dist(rng);
+        const int value = dist(rng);
+
+        if(rng() % 3 == 0){
+            auto it = refKeys.find(key);
+            if(it != refKeys.end()){
+                refValues.erase(it->second);
+                refKeys.erase(it);
+            }
+            bimap.erase(key);
+        }else{
+            auto itKey = refKeys.find(key);
+            if(itKey != refKeys.end()){
+                refValues.erase(itKey->second);
+                refKeys.erase(itKey);
+            }
+            auto itValue = refValues.find(value);
+            if(itValue != refValues.end()){
+                refKeys.erase(itValue->second);
+                refValues.erase(itValue);
+            }
+            refKeys[key] = value;
+            refValues[value] = key;
+            if(rng() % 2 == 0){
+                bimap.insert(key, value);
+            }else{
+                bimap.insertOrAssign(key, value);
+            }
+        }
+    }
+
+    ASSERT_EQ(refKeys.size(), bimap.size());
+    EXPECT_TRUE(std::equal(refKeys.cbegin(), refKeys.cend(), bimap.cbegin()));
+    for(const auto &pair : refValues){
+        EXPECT_EQ(pair.second, bimap.getKey(pair.first));
+    }
+}
+
+TEST(BimapBulkTests, rangeConstructorRejectDuplicates)
+{
+    std::vector<std::pair<int, std::string>> pairs = {{3, "THREE"}, {1, "ONE"}, {2, "TWO"}};
+
+    cmap::Bimap<int, std::string> bimap(pairs.cbegin(), pairs.cend());
+    EXPECT_EQ(3, bimap.size());
+    EXPECT_EQ("ONE", bimap.getValue(1));
+    EXPECT_EQ(3, bimap.getKey("THREE"));
+    EXPECT_EQ(1, bimap.cbegin()->first);
+
+    pairs.emplace_back(1, "UN");
+    using Map = cmap::Bimap<int, std::string>;
+    EXPECT_THROW(Map(pairs.cbegin(), pairs.cend()), std::invalid_argument);
+
+    pairs.back() = std::make_pair(4, "TWO");
+    EXPECT_THROW(Map(pairs.cbegin(), pairs.cend()), std::invalid_argument);
+}
+
+TEST(BimapBulkTests, rangeInsertMatchTryInsert)
+{
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> dist(0, 300);
+
+    for(std::size_t size : {0, 1, 2, 7, 100, 1000}){
+        /* Sorted and unique pairs use the linear build, others don't */
+        std::vector<std::pair<int, int>> sorted;
+        std::vector<std::pair<int, int>> random;
+        for(std::size_t i = 0; i < size; ++i){
+            sorted.emplace_back(static_cast<int>(i), static_cast<int>(size - i));
+            random.emplace_back(dist(rng), dist(rng));
+        }
+
+        for(const auto &pairs : {sorted, random}){
+            for(bool startEmpty : {true, false}){
+                cmap::Bimap<int, int> bulk;
+                cmap::Bimap<int, int> reference;
+                if(!startEmpty){
+                    bulk.insert(5, 5);
+                    reference.insert(5, 5);
+                }
+
+                std::size_t expected = 0;
+                for(const auto &pair : pairs){
+                    expected += reference.tryInsert(pair.first, pair.second).second ? 1 : 0;
+                }
+                ASSERT_EQ(expected, bulk.insert(pairs.cbegin(), pairs.cend()));
+                ASSERT_EQ(reference.size(), bulk.size());
+
+                /* Both trees must stay usable after a bulk build */
+                for(int i = 0; i < 300; i += 3){
+                    bulk.erase(i);
+                    reference.erase(i);
+                    bulk.insert(i + 1000, i);
+                    reference.insert(i + 1000, i);
+                }
+                ASSERT_TRUE(std::equal(reference.cbegin(), reference.cend(), bulk.cbegin()));
+                for(auto it = reference.cbegin(); it != reference.cend(); ++it){
+                    EXPECT_EQ(it->first, bulk.getKey(it->second));
+                }
+            }
+        }
+    }
+}
+
+TEST(BimapSerializationTests, roundTripThroughStreamAndBuffer)
+{
+    cmap::Bimap<int, std::string> bimap;
+    for(int i = 0; i < 5000; ++i){
+        bimap.insert(i * 3, "value-" + std::to_string(i));
+    }
+
+    std::stringstream stream;
+    bimap.serialize(stream);
+    stream << "trailing";
+
+    cmap::Bimap<int, std::string> fromStream = {{42, "replaced"}};
+    fromStream.deserialize(stream);
+    ASSERT_EQ(bimap.size(), fromStream.size());
+    EXPECT_TRUE(std::equal(bimap.cbegin(), bimap.cend(), fromStream.cbegin()));
+    EXPECT_EQ(2997, fromStream.getKey("value-999"));
+
+    /* Only serialized bytes are consumed */
+    std::string trailing;
+    stream >> trailing;
+    EXPECT_EQ("trailing", trailing);
+
+    std::vector<unsigned char> buffer;
+    bimap.serialize(buffer);
+
+    cmap::Bimap<int, std::string> fromBuffer;
+    EXPECT_EQ(buffer.size(), fromBuffer.deserialize(buffer.data(), buffer.size()));
+    EXPECT_TRUE(std::equal(bimap.cbegin(), bimap.cend(), fromBuffer.cbegin()));
+}
+
+TEST(BimapSerializationTests, invalidDataLeaveBimapUnchanged)
+{
+    const cmap::Bimap<int, int> source = {{1, 10}, {2, 20}, {3, 30}};
+    std::vector<unsigned char> buffer;
+    source.serialize(buffer);
+
+    cmap::Bimap<int, int> bimap = {{7, 70}};
+    EXPECT_THROW(bimap.deserialize(buffer.data(), buffer.size() - 1), std::runtime_error);
+    EXPECT_THROW(bimap.deserialize(buffer.data() + 1, buffer.size() - 1), std::runtime_error);
+
+    /* Duplicated value */
+    const int duplicated = 20;
+    std::memcpy(&buffer[buffer.size() - sizeof(int)], &duplicated, sizeof(int));
+    EXPECT_THROW(bimap.deserialize(buffer.data(), buffer.size()), std::invalid_argument);
+
+    ASSERT_EQ(1, bimap.size());
+    EXPECT_EQ(70, bimap.getValue(7));
+
+    std::stringstream empty;
+    EXPECT_THROW(bimap.deserialize(empty), std::runtime_error);
+    EXPECT_EQ(1, bimap.size());
+}
+
+TEST(BimapRangeTests, iterateInValueOrder)
+{
+    const cmap::Bimap<int, int> bimap = {{1, 30}, {2, 10}, {3, 20}, {4, 40}};
+    const auto view = bimap.byValue();
+    ASSERT_EQ(4, view.size());
+
+    std::vector<int> keys;
+    for(const auto &pair : view){
+        keys.push_back(pair.first);
+    }
+    EXPECT_EQ(std::vector<int>({2, 3, 1, 4}), keys);
+
+    keys.clear();
+    for(auto it = view.rbegin(); it != view.rend(); ++it){
+        keys.push_back(it->first);
+    }
+    EXPECT_EQ(std::vector<int>({4, 1, 3, 2}), keys);
+
+    EXPECT_EQ(3, view.find(20)->first);
+    EXPECT_EQ(view.end(), view.find(25));
+    EXPECT_TRUE((cmap::Bimap<int, int>().byValue().empty()));
+}
+
+TEST(BimapRangeTests, boundsMatchReferenceMaps)
+{
+    cmap::Bimap<int, int> bimap;
+    std::map<int, int> byKey;
+    std::map<int, int> byValue;
+    for(int i = 0; i < 200; ++i){
+        bimap.insert(3 * i, 1000 - 5 * i);
+        byKey.emplace(3 * i, 1000 - 5 * i);
+        byValue.emplace(1000 - 5 * i, 3 * i);
+    }
+
+    const auto keyOf = [&bimap](cmap::Bimap<int, int>::const_iterator it){ return it == bimap.cend() ? -1 : it->first; };
+    const auto valueOf = [&bimap](cmap::Bimap<int, int>::value_iterator it){ return it == bimap.byValue().end() ? -1 : it->second; };
+    for(int probe = -2; probe < 1003; ++probe){
+        const auto lowerKey = byKey.lower_bound(probe);
+        const auto upperKey = byKey.upper_bound(probe);
+        EXPECT_EQ(lowerKey == byKey.cend() ? -1 : lowerKey->first, keyOf(bimap.lowerBoundKey(probe)));
+        EXPECT_EQ(upperKey == byKey.cend() ? -1 : upperKey->first, keyOf(bimap.upperBoundKey(probe)));
+
+        const auto lowerValue = byValue.lower_bound(probe);
+        const auto upperValue = byValue.upper_bound(probe);
+        EXPECT_EQ(lowerValue == byValue.cend() ? -1 : lowerValue->first, valueOf(bimap.lowerBoundValue(probe)));
+        EXPECT_EQ(upperValue == byValue.cend() ? -1 : upperValue->first, valueOf(bimap.upperBoundValue(probe)));
+
+        const auto rangeKey = bimap.equalRangeKey(probe);
+        const auto rangeValue = bimap.equalRangeValue(probe);
+        EXPECT_EQ(byKey.count(probe), static_cast<std::size_t>(std::distance(rangeKey.first, rangeKey.second)));
+        EXPECT_EQ(byValue.count(probe), static_cast<std::size_t>(std::distance(rangeValue.first, rangeValue.second)));
+    }
+}
+
+#if BIMAP_HAS_CPP14
+TEST(BimapRangeTests, scanValuesSharingPrefix)
+{
+    cmap::Bimap<int, std::string, std::less<int>, std::less<>> bimap;
+    bimap.insert(1, "apple");
+    bimap.insert(2, "apricot");
+    bimap.insert(3, "banana");
+    bimap.insert(4, "application");
+    bimap.insert(5, "aq");
+
+    /* Values starting with "ap" are in [ "ap", "aq" ) */
+    std::vector<int> keys;
+    const auto last = bimap.lowerBoundValue("aq");
+    for(auto it = bimap.lowerBoundValue("ap"); it != last; ++it){
+        keys.push_back(it->first);
+    }
+    EXPECT_EQ(std::vector<int>({1, 4, 2}), keys);
+}
+#endif
+
+TEST(BimapBatchTests, batchedLookupsMatchSingleLookups)
+{
+    const std::size_t sizes[] = {0, 1, 2, 3, 15, 16, 17, 100, 1000};
+    for(std::size_t size : sizes){
+        cmap::Bimap<int, int> bimap;
+        for(std::size_t i = 0; i < size; ++i){
+            bimap.insert(static_cast<int>(3 * i), static_cast<int>(5 * i + 1));
+        }
+
+        /* Probe hits and misses, including around bounds */
+        std::vector<int> probes;
+        for(int i = -2; i < static_cast<int>(5 * size + 4); ++i){
+            probes.push_back(i);
+        }
+
+        std::vector<int> results(probes.size(), -1);
+        std::unique_ptr<bool[]> found(new bool[probes.size()]);
+
+        EXPECT_EQ(std::count_if(probes.cbegin(), probes.cend(), [&bimap](int key){ return bimap.containsKey(key); }),
+                  bimap.getValues(probes.data(), probes.size(), results.data(), found.get()));
+        for(std::size_t i = 0; i < probes.size(); ++i){
+            auto it = bimap.findByKey(probes[i]);
+            ASSERT_EQ(it != bimap.cend(), found[i]);
+            EXPECT_EQ(it != bimap.cend() ? it->second : -1, results[i]);
+        }
+
+        std::fill(results.begin(), results.end(), -1);
+        EXPECT_EQ(std::count_if(probes.cbegin(), probes.cend(), [&bimap](int value){ return bimap.containsValue(value); }),
+                  bimap.getKeys(probes.data(), probes.size(), results.data(), nullptr));
+        for(std::size_t i = 0; i < probes.size(); ++i){
+            auto it = bimap.findByValue(probes[i]);
+            EXPECT_EQ(it != bimap.cend() ? it->first : -1, results[i]);
+        }
+    }
+}
+
+TEST(BimapTransparentTests, searchWithoutTemporaryKey)
+{
+    cmap::Bimap<Id, std::string, IdLess> bimap;
+    bimap.insert(Id(1), "ONE");
+    bimap.insert(Id(2), "TWO");
+
+    EXPECT_EQ("TWO", bimap.getValue(2));
+    EXPECT_THROW(bimap.getValue(3), std::out_of_range);
+    EXPECT_TRUE(bimap.containsKey(1));
+    EXPECT_FALSE(bimap.containsKey(3));
+    EXPECT_EQ(bimap.cend(), bimap.findByKey(3));
+#if BIMAP_HAS_CPP14
+    EXPECT_EQ(1, bimap.getKey("ONE").value);
+#endif
+}
+
+TEST(BimapEraseTests, eraseIfRebuildBothTrees)
+{
+    cmap::Bimap<int, int> bimap;
+    for(int i = 0; i < 3000; ++i){
+        bimap.insert(i, (i * 7919) % 3000);
+    }
+
+    const std::size_t nbErased = bimap.eraseIf([](const std::pair<const int, int> &pair){
+        return pair.first % 3 == 0 || pair.second < 100;
+    });
+    EXPECT_EQ(0, bimap.eraseIf([](const std::pair<const int, int> &pair){ return pair.first % 3 == 0; }));
+
+    std::size_t expected = 0;
+    for(int i = 0; i < 3000; ++i){
+        const int value = (i * 7919) % 3000;
+        const bool erased = (i % 3 == 0 || value < 100);
+        expected += erased ? 1 : 0;
+        EXPECT_EQ(!erased, bimap.containsKey(i));
+        EXPECT_EQ(!erased, bimap.containsValue(value));
+    }
+    EXPECT_EQ(expected, nbErased);
+    EXPECT_EQ(3000 - expected, bimap.size());
+
+    /* Both trees are rebuilt in order, and stay usable */
+    auto view = bimap.byValue();
+    EXPECT_TRUE(std::is_sorted(view.begin(), view.end(), [](const std::pair<const int, int> &lhs, const std::pair<const int, int> &rhs){
+        return lhs.second < rhs.second;
+    }));
+    EXPECT_LE(bimap.keyTreeHeight(), 12);
+    EXPECT_LE(bimap.valueTreeHeight(), 12);
+    bimap.insert(0, 0);
+    EXPECT_EQ(0, bimap.getKey(0));
+
+    /* Nothing is erased if predicate throws */
+    EXPECT_THROW(bimap.eraseIf([](const std::pair<const int, int> &pair) -> bool {
+        if(pair.first > 1000){
+            throw std::runtime_error("predicate");
+        }
+        return true;
+    }), std::runtime_error);
+    EXPECT_EQ(3001 - expected, bimap.size());
+}
+
+TEST(BimapNodeTests, extractAndInsertRelinkNodes)
+{
+    cmap::Bimap<int, std::string> source = {{1, "ONE"}, {2, "TWO"}, {3, "THREE"}};
+    cmap::Bimap<int, std::string> target = {{4, "FOUR"}, {5, "TWO"}};
+    const auto *element = &*source.findByKey(2);
+
+    EXPECT_TRUE(source.extract(42).empty());
+
+    auto node = source.extract(2);
+    ASSERT_FALSE(node.empty());
+    EXPECT_EQ(2, node.key());
+    EXPECT_EQ("TWO", node.value());
+    EXPECT_EQ(2, source.size());
+    EXPECT_FALSE(source.containsValue("TWO"));
+
+    /* Conflicting value: handle keeps its element */
+    auto result = target.insert(std::move(node));
+    EXPECT_FALSE(result.second);
+    EXPECT_EQ(5, result.first->first);
+    ASSERT_TRUE(static_cast<bool>(node));
+
+    node.value() = "DEUX";
+    result = target.insert(std::move(node));
+    EXPECT_TRUE(result.second);
+    EXPECT_TRUE(node.empty());
+    EXPECT_EQ(element, &*result.first);
+    EXPECT_EQ(2, target.getKey("DEUX"));
+    EXPECT_EQ(3, target.size());
+
+    EXPECT_FALSE(target.insert(std::move(node)).second);
+
+    /* Element of a non-inserted handle is released with it */
+    auto moved = std::move(source.extract(source.cbegin()));
+    EXPECT_EQ(1, moved.key());
+    EXPECT_EQ(1, source.size());
+}
+
+TEST(BimapNodeTests, mergeKeepConflictingElements)
+{
+    cmap::NodePool pool(64);
+    using PoolBimap = cmap::Bimap<int, int, std::less<int>, std::less<int>, cmap::PoolAllocator<std::pair<const int, int>>>;
+
+    PoolBimap target(pool);
+    PoolBimap source(pool);
+    for(int i = 0; i < 500; ++i){
+        target.insert(2 * i, 2 * i);
+        source.insert(2 * i + 1, 2 * i + 1);
+    }
+    source.insert(0, -1);
+    source.insert(-2, 10);
+
+    const std::size_t chunks = pool.chunkCount();
+    target.merge(source);
+    EXPECT_EQ(chunks, pool.chunkCount());
+
+    EXPECT_EQ(1000, target.size());
+    for(int i = 0; i < 1000; ++i){
+        EXPECT_EQ(i, target.getValue(i));
+        EXPECT_EQ(i, target.getKey(i));
+    }
+
+    ASSERT_EQ(2, source.size());
+    EXPECT_EQ(-1, source.getValue(0));
+    EXPECT_EQ(-2, source.getKey(10));
+
+    /* Handles keep allocators which are not default constructible */
+    auto node = source.extract(0);
+    EXPECT_EQ(&pool, node.getAllocator().pool());
+    target.erase(0);
+    EXPECT_TRUE(target.insert(std::move(node)).second);
+    EXPECT_EQ(-1, target.getValue(0));
+
+    target.merge(std::move(source));
+    EXPECT_EQ(1, source.size());
+}
+
+TEST(BimapPatchTests, reportConflictsInBothDirections)
+{
+    using Bimap = cmap::Bimap<int, std::string>;
+    Bimap bimap = {{1, "ONE"}, {2, "TWO"}, {3, "THREE"}};
+
+    /* Values freed by erased or reassigned keys can be reused */
+    Bimap::Patch patch;
+    patch.erase(1);
+    patch.assign(2, "ONE");
+    patch.insert(4, "TWO");
+    patch.assign(3, "THREE");
+    EXPECT_TRUE(bimap.conflicts(patch).empty());
+
+    patch.insert(3, "FOUR");
+    patch.erase(5);
+    patch.insert(6, "THREE");
+    patch.insert(7, "ONE");
+    patch.insert(8, "EIGHT");
+
+    Bimap::Patch rejected;
+    rejected.insert(9, "TWO");
+    rejected.assign(1, "NINE");
+
+    const auto conflicts = bimap.conflicts(patch);
+    ASSERT_EQ(4, conflicts.size());
+    EXPECT_EQ(cmap::PatchConflict::DuplicatedKey, conflicts[0].reason);
+    EXPECT_EQ(4, conflicts[0].change);
+    EXPECT_EQ(cmap::PatchConflict::KeyMissing, conflicts[1].reason);
+    EXPECT_EQ(5, conflicts[1].change);
+    EXPECT_EQ(cmap::PatchConflict::DuplicatedValue, conflicts[2].reason);
+    EXPECT_EQ(6, conflicts[2].change);
+    EXPECT_EQ(cmap::PatchConflict::DuplicatedValue, conflicts[3].reason);
+    EXPECT_EQ(7, conflicts[3].change);
+
+    ASSERT_EQ(1, bimap.conflicts(rejected).size());
+    EXPECT_EQ(cmap::PatchConflict::ValueExists, bimap.conflicts(rejected)[0].reason);
+
+    rejected.clear();
+    rejected.insert(1, "UNO");
+    EXPECT_EQ(cmap::PatchConflict::KeyExists, bimap.conflicts(rejected)[0].reason);
+
+    /* Nothing is applied when a change conflicts */
+    EXPECT_THROW(bimap.apply(patch), std::invalid_argument);
+    EXPECT_EQ(3, bimap.size());
+    EXPECT_EQ("ONE", bimap.getValue(1));
+}
+
+TEST(BimapPatchTests, applyMatchReferenceMaps)
+{
+    cmap::Bimap<int, int> bimap;
+    std::map<int, int> refKeys;
+    std::map<int, int> refValues;
+
+    std::mt19937 rng(12);
+    std::uniform_int_distribution<int> dist(0, 2000);
+    for(int round = 0; round < 50; ++round){
+        cmap::Bimap<int, int>::Patch patch;
+        std::map<int, int> nextKeys = refKeys;
+        std::map<int, int> nextValues = refValues;
+
+        for(int i = 0; i < 100; ++i){
+            const int key = dist(rng);
+            const int value = dist(rng);
+            /* Each key is changed once, values may be freed by previous changes */
+            if(nextKeys.count(key) != refKeys.count(key) || (refKeys.count(key) && nextKeys[key] != refKeys[key]) || nextValues.count(value)){
+                continue;
+            }
+
+            auto itKey = nextKeys.find(key);
+            if(itKey == nextKeys.end()){
+                patch.insert(key, value);
+            }else{
+                nextValues.erase(itKey->second);
+                nextKeys.erase(itKey);
+                if(rng() % 2 == 0){
+                    patch.erase(key);
+                    continue;
+                }
+                patch.assign(key, value);
+            }
+            nextKeys[key] = value;
+            nextValues[value] = key;
+        }
+
+        ASSERT_TRUE(bimap.conflicts(patch).empty());
+        bimap.apply(patch);
+        refKeys.swap(nextKeys);
+        refValues.swap(nextValues);
+    }
+
+    ASSERT_EQ(refKeys.size(), bimap.size());
+    EXPECT_TRUE(std::equal(refKeys.cbegin(), refKeys.cend(), bimap.cbegin()));
+    for(const auto &pair : refValues){
+        EXPECT_EQ(pair.second, bimap.getKey(pair.first));
+    }
+    EXPECT_LE(bimap.keyTreeHeight(), 2 * 11);
+    EXPECT_LE(bimap.valueTreeHeight(), 2 * 11);
+}
+
+TEST(BimapPatchTests, replayJournalOnReplica)
+{
+    using Bimap = cmap::Bimap<int, std::string>;
+    Bimap primary;
+    Bimap::Journal journal;
+
+    Bimap::Patch patch;
+    patch.insert(1, "ONE");
+    patch.insert(2, "TWO");
+    primary.apply(patch, &journal);
+    const Bimap replica0 = primary;
+
+    patch.clear();
+    patch.erase(1);
+    patch.assign(2, "ONE");
+    patch.insert(3, "THREE");
+    primary.apply(patch, &journal);
+    EXPECT_EQ(2, journal.version());
+
+    /* Replica at version 1 only receives last patch */
+    std::stringstream stream;
+    journal.serialize(stream, 1);
+    Bimap::Journal received;
+    received.deserialize(stream);
+    EXPECT_EQ(1, received.firstVersion());
+    EXPECT_EQ(2, received.version());
+
+    Bimap replica = replica0;
+    EXPECT_EQ(2, replica.replay(received, 1));
+    ASSERT_EQ(primary.size(), replica.size());
+    EXPECT_TRUE(std::equal(primary.cbegin(), primary.cend(), replica.cbegin()));
+    EXPECT_THROW(replica.replay(received, 0), std::out_of_range);
+
+    /* Trimmed patches can't be sent anymore */
+    journal.trim(1);
+    EXPECT_EQ(1, journal.firstVersion());
+    EXPECT_THROW(journal.serialize(stream, 0), std::out_of_range);
+    EXPECT_THROW(journal.patch(0), std::out_of_range);
+
+    /* Journals and bimaps can't be mistaken for each other */
+    std::vector<unsigned char> buffer;
+    journal.serialize(buffer, 2);
+    EXPECT_THROW(replica.deserialize(buffer.data(), buffer.size()), std::runtime_error);
+    EXPECT_EQ(buffer.size(), received.deserialize(buffer.data(), buffer.size()));
+    EXPECT_EQ(2, received.firstVersion());
+    EXPECT_EQ(2, received.version());
+}
+
+TEST(BimapDiagnosticsTests, reportMemoryAndTreeHeights)
+{
+    cmap::Bimap<int, int> bimap;
+    EXPECT_EQ(0, bimap.memoryUsage().total());
+    EXPECT_EQ(0, bimap.keyTreeHeight());
+
+    for(int i = 0; i < 1023; ++i){
+        bimap.insert(i, -i);
+    }
+
+    const cmap::BimapMemoryUsage usage = bimap.memoryUsage();
+    EXPECT_EQ(1023 * sizeof(std::pair<const int, int>), usage.payload);
+    EXPECT_EQ(usage.indexKey, usage.indexValue);
+    EXPECT_EQ(0, usage.unused);
+    EXPECT_GE(usage.total(), 1023 * (sizeof(std::pair<const int, int>) + cmap::BimapAllocationOverhead));
+
+    /* Red-black trees height is at most 2 * log2(n + 1) */
+    EXPECT_GE(bimap.keyTreeHeight(), 10);
+    EXPECT_LE(bimap.keyTreeHeight(), 20);
+    EXPECT_GE(bimap.valueTreeHeight(), 10);
+    EXPECT_LE(bimap.valueTreeHeight(), 20);
+
+    /* Bulk construction builds complete trees */
+    const std::vector<std::pair<int, int>> pairs(bimap.cbegin(), bimap.cend());
+    const cmap::Bimap<int, int> built(pairs.cbegin(), pairs.cend());
+    EXPECT_EQ(10, built.keyTreeHeight());
+    EXPECT_EQ(10, built.valueTreeHeight());
+}
+
+TEST(BimapAllocatorTests, nodesAreAllocatedFromPool)
+{
+    cmap::NodePool pool(64);
+    cmap::Bimap<int, int, std::less<int>, std::less<int>, cmap::PoolAllocator<std::pair<const int, int>>> bimap(pool);
+    for(int i = 0; i < 1000; ++i){
+        bimap.insert(i, -i);
+    }
+    EXPECT_EQ(16, pool.chunkCount());
+
+    /* Released nodes are reused */
+    bimap.clear();
+    for(int i = 0; i < 1000; ++i){
+        bimap.insert(i, i);
+    }
+    EXPECT_EQ(16, pool.chunkCount());
+
+    auto copy = bimap;
+    EXPECT_EQ(&pool, copy.getAllocator().pool());
+    EXPECT_EQ(32, pool.chunkCount());
+    EXPECT_EQ(999, copy.getKey(999));
+}
+
+TEST(BimapAllocatorTests, poolFallbackChecksSizeAndAlignment)
+{
+    cmap::NodePool pool(64);
+
+    /* Size of arrays must not overflow */
+    cmap::PoolAllocator<std::uint64_t> allocator(pool);
+    EXPECT_THROW(allocator.allocate(allocator.max_size() + 1), std::bad_array_new_length);
+
+    std::uint64_t *array = allocator.allocate(16);
+    array[15] = 42;
+    allocator.deallocate(array, 16);
+
+#if BIMAP_HAS_ALIGNED_NEW
+    /* Over-aligned objects are never served by blocks */
+    struct alignas(128) Wide
+    {
+        char data[128];
+    };
+    cmap::PoolAllocator<Wide> allocatorWide(pool);
+    Wide *one = allocatorWide.allocate(1);
+    Wide *several = allocatorWide.allocate(3);
+    EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(one) % alignof(Wide));
+    EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(several) % alignof(Wide));
+    EXPECT_EQ(0, pool.chunkCount());
+    allocatorWide.deallocate(several, 3);
+    allocatorWide.deallocate(one, 1);
+#endif
+}
+
+#if BIMAP_HAS_PMR
+TEST(BimapAllocatorTests, nodesAreAllocatedFromMemoryResource)
+{
+    std::pmr::monotonic_buffer_resource arena;
+    std::pmr::monotonic_buffer_resource other;
+
+    cmap::pmr::Bimap<int, std::string> bimap(&arena);
+    bimap.insert(1, "ONE");
+    bimap.insert(2, "TWO");
+    EXPECT_EQ(&arena, bimap.getAllocator().resource());
+
+    /* Polymorphic allocators doesn't propagate on assignment */
+    cmap::pmr::Bimap<int, std::string> copy(&other);
+    copy = bimap;
+    EXPECT_EQ(&other, copy.getAllocator().resource());
+    EXPECT_EQ(2, copy.getKey("TWO"));
+
+    copy = std::move(bimap);
+    EXPECT_EQ(&other, copy.getAllocator().resource());
+    EXPECT_EQ("ONE", copy.getValue(1));
+}
+#endif
+
 /*****************************/
 /* End                       */
 /*****************************/
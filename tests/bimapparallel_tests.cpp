@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "bimap.h"
+#include "bimapparallel.h"
+#include "flatbimap.h"
+#include "sortedvectorbimap.h"
+#include "unorderedbimap.h"
+
+/*****************************/
+/* Test helpers              */
+/*****************************/
+
+/* Shuffled pairs, keys and values are unique */
+static std::vector<std::pair<int, std::string>> makePairs(int count)
+{
+    std::vector<std::pair<int, std::string>> pairs;
+    pairs.reserve(count);
+    for(int i = 0; i < count; ++i){
+        pairs.emplace_back(3 * i, "value_" + std::to_string(i));
+    }
+
+    std::mt19937 rng(42);
+    std::shuffle(pairs.begin(), pairs.end(), rng);
+    return pairs;
+}
+
+template<class Container>
+void checkAssign(const std::vector<std::pair<int, std::string>> &pairs, cmap::BimapThreadExecutor &executor)
+{
+    Container bimap;
+    bimap.insert(-1, "previous");
+    bimap.assign(pairs.cbegin(), pairs.cend(), executor);
+
+    ASSERT_EQ(pairs.size(), bimap.size());
+    EXPECT_FALSE(bimap.containsKey(-1));
+    for(const auto &pair : pairs){
+        EXPECT_EQ(pair.second, bimap.getValue(pair.first));
+        EXPECT_EQ(pair.first, bimap.getKey(pair.second));
+    }
+
+    /* Duplicated values are rejected */
+    std::vector<std::pair<int, std::string>> duplicated(pairs);
+    duplicated.emplace_back(-3, pairs[pairs.size() / 2].second);
+    EXPECT_THROW(bimap.assign(duplicated.cbegin(), duplicated.cend(), executor), std::invalid_argument);
+
+    duplicated.back() = std::make_pair(pairs.front().first, std::string("duplicated key"));
+    EXPECT_THROW(bimap.assign(duplicated.cbegin(), duplicated.cend(), executor), std::invalid_argument);
+}
+
+template<class Container>
+void checkLookups(const std::vector<std::pair<int, std::string>> &pairs, cmap::BimapThreadExecutor &executor)
+{
+    Container bimap;
+    for(const auto &pair : pairs){
+        bimap.insert(pair.first, pair.second);
+    }
+
+    /* One key out of 3 is missing */
+    std::vector<int> keys;
+    for(std::size_t i = 0; i < pairs.size(); ++i){
+        keys.push_back(static_cast<int>(i));
+    }
+
+    std::vector<std::string> values(keys.size());
+    std::unique_ptr<bool[]> found(new bool[keys.size()]);
+    const std::size_t nbFound = cmap::parallelGetValues(executor, bimap, keys.data(), keys.size(), values.data(), found.get());
+    EXPECT_EQ((keys.size() + 2) / 3, nbFound);
+    for(std::size_t i = 0; i < keys.size(); ++i){
+        ASSERT_EQ(keys[i] % 3 == 0, found[i]);
+        if(found[i]){
+            EXPECT_EQ("value_" + std::to_string(keys[i] / 3), values[i]);
+        }
+    }
+
+    std::vector<int> keysFound(values.size(), -1);
+    EXPECT_EQ(nbFound, cmap::parallelGetKeys(executor, bimap, values.data(), values.size(), keysFound.data()));
+    for(std::size_t i = 0; i < keys.size(); i += 3){
+        EXPECT_EQ(keys[i], keysFound[i]);
+    }
+}
+
+/*****************************/
+/* Defines test routines
+ * (using TEST())            */
+/*****************************/
+
+TEST(BimapParallelTests, executorRunEachTask)
+{
+    cmap::BimapThreadExecutor executor(4);
+    EXPECT_EQ(4, executor.concurrency());
+    EXPECT_LE(1u, cmap::BimapThreadExecutor().concurrency());
+
+    std::vector<std::atomic<int>> calls(1000);
+    executor.run(calls.size(), [&calls](std::size_t i){
+        ++calls[i];
+    });
+    for(const std::atomic<int> &call : calls){
+        EXPECT_EQ(1, call.load());
+    }
+
+    /* First exception is rethrown once all threads stopped */
+    std::atomic<int> done(0);
+    EXPECT_THROW(executor.run(1000, [&done](std::size_t i){
+        if(i == 10){
+            throw std::runtime_error("task failed");
+        }
+        ++done;
+    }), std::runtime_error);
+    EXPECT_LT(done.load(), 1000);
+
+    executor.run(0, [](std::size_t){ FAIL(); });
+}
+
+TEST(BimapParallelTests, assignBuildsBothSides)
+{
+    const std::vector<std::pair<int, std::string>> pairs = makePairs(50000);
+    cmap::BimapThreadExecutor executor(4);
+
+    checkAssign<cmap::Bimap<int, std::string>>(pairs, executor);
+    checkAssign<cmap::FlatBimap<int, std::string>>(pairs, executor);
+    checkAssign<cmap::SortedVectorBimap<int, std::string>>(pairs, executor);
+}
+
+TEST(BimapParallelTests, assignKeepOrderOfSides)
+{
+    std::vector<std::pair<int, std::string>> pairs = makePairs(30000);
+    cmap::BimapThreadExecutor executor(3);
+
+    cmap::Bimap<int, std::string> bimap;
+    bimap.assign(pairs.cbegin(), pairs.cend(), executor);
+    const cmap::Bimap<int, std::string> reference(pairs.cbegin(), pairs.cend());
+    EXPECT_TRUE(std::equal(bimap.cbegin(), bimap.cend(), reference.cbegin()));
+
+    const auto view = bimap.byValue();
+    const auto viewRef = reference.byValue();
+    EXPECT_TRUE(std::equal(view.begin(), view.end(), viewRef.begin()));
+
+    /* Failed assignment leaves previous elements */
+    pairs.push_back(pairs.front());
+    EXPECT_THROW(bimap.assign(pairs.cbegin(), pairs.cend(), executor), std::invalid_argument);
+    EXPECT_EQ(reference.size(), bimap.size());
+}
+
+TEST(BimapParallelTests, parallelLookupsMatchSequential)
+{
+    const std::vector<std::pair<int, std::string>> pairs = makePairs(20000);
+    cmap::BimapThreadExecutor executor(4);
+
+    checkLookups<cmap::Bimap<int, std::string>>(pairs, executor);
+    checkLookups<cmap::UnorderedBimap<int, std::string>>(pairs, executor);
+    checkLookups<cmap::FlatBimap<int, std::string>>(pairs, executor);
+    checkLookups<cmap::SortedVectorBimap<int, std::string>>(pairs, executor);
+}
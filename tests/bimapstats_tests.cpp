@@ -0,0 +1,156 @@
+/* Statistics change layout of containers, comparators and hashers
+ * of this file are local to it so instantiations enabling them
+ * are never shared with other test files */
+#ifndef BIMAP_ENABLE_STATS
+#define BIMAP_ENABLE_STATS
+#endif
+
+#include <gtest/gtest.h>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "bimap.h"
+#include "flatbimap.h"
+#include "sortedvectorbimap.h"
+#include "unorderedbimap.h"
+
+/*****************************/
+/* Namespace instructions    */
+/*****************************/
+
+namespace{
+
+struct StatsLess : std::less<int> {};
+struct StatsHash : std::hash<int> {};
+struct StatsEqual : std::equal_to<int> {};
+
+}
+
+/*****************************/
+/* Classes aliases           */
+/*****************************/
+
+using StatsBimap = cmap::Bimap<int, int, StatsLess, StatsLess>;
+using StatsUnorderedBimap = cmap::UnorderedBimap<int, int, StatsHash, StatsEqual, StatsHash, StatsEqual>;
+using StatsFlatBimap = cmap::FlatBimap<int, int, StatsHash, StatsEqual, StatsHash, StatsEqual>;
+using StatsSortedVectorBimap = cmap::SortedVectorBimap<int, int, StatsLess, StatsLess>;
+
+/*****************************/
+/* Test helpers              */
+/*****************************/
+
+template<class Container>
+void checkCounters()
+{
+    Container bimap;
+    bimap.insert(1, 10);
+    bimap.insert(2, 20);
+    bimap.insert(3, 30);
+    bimap.insert(3, 31);        // Overwrite value of key 3
+    bimap.insert(4, 10);        // Overwrite key of value 10
+    EXPECT_FALSE(bimap.tryInsert(2, 99).second);
+
+    EXPECT_EQ(31, bimap.getValue(3));
+    EXPECT_EQ(2, bimap.getKey(20));
+    EXPECT_THROW(bimap.getValue(1), std::out_of_range);
+    bimap.erase(2);
+    bimap.erase(2);             // Missing key is not counted
+
+    cmap::BimapStatsSnapshot snapshot = bimap.stats().snapshot();
+    EXPECT_EQ(3, snapshot.inserts);
+    EXPECT_EQ(2, snapshot.overwrites);
+    EXPECT_EQ(1, snapshot.erases);
+    EXPECT_EQ(2, snapshot.hits);
+    EXPECT_EQ(1, snapshot.misses);
+    EXPECT_EQ(3, snapshot.lookups());
+    EXPECT_EQ(0, snapshot.samples());
+
+    /* Containers copies start with their own counters */
+    const Container copy(bimap);
+    EXPECT_EQ(0, copy.stats().snapshot().lookups());
+
+    bimap.stats().reset();
+    snapshot = bimap.stats().snapshot();
+    EXPECT_EQ(0, snapshot.inserts + snapshot.overwrites + snapshot.erases + snapshot.lookups());
+}
+
+/*****************************/
+/* Defines test routines
+ * (using TEST())            */
+/*****************************/
+
+TEST(BimapStatsTests, countLookupsAndUpdates)
+{
+    checkCounters<StatsBimap>();
+    checkCounters<StatsUnorderedBimap>();
+    checkCounters<StatsFlatBimap>();
+    checkCounters<StatsSortedVectorBimap>();
+}
+
+TEST(BimapStatsTests, sampleLatencies)
+{
+    StatsFlatBimap bimap;
+    for(int i = 0; i < 100; ++i){
+        bimap.insert(i, -i);
+    }
+
+    bimap.stats().setLatencySampling(1);
+    for(int i = 0; i < 100; ++i){
+        EXPECT_EQ(-i, bimap.getValue(i));
+    }
+
+    cmap::BimapStatsSnapshot snapshot = bimap.stats().snapshot();
+    EXPECT_EQ(100, snapshot.samples());
+    EXPECT_GT(snapshot.latencyPercentile(0.99), 0u);
+    EXPECT_LE(snapshot.latencyPercentile(0.5), snapshot.latencyPercentile(0.99));
+
+    /* One lookup out of 4 is timed */
+    bimap.stats().reset();
+    bimap.stats().setLatencySampling(4);
+    for(int i = 0; i < 400; ++i){
+        bimap.containsKey(i);
+        bimap.getKey(-(i % 100));
+    }
+
+    snapshot = bimap.stats().snapshot();
+    EXPECT_EQ(400, snapshot.hits);
+    EXPECT_NEAR(100.0, static_cast<double>(snapshot.samples()), 1.0);
+
+    /* Sampling period is kept by copies */
+    const StatsFlatBimap copy(bimap);
+    EXPECT_EQ(4u, copy.stats().latencySampling());
+}
+
+TEST(BimapStatsTests, mergeConcurrentReaders)
+{
+    StatsBimap bimap;
+    for(int i = 0; i < 1000; ++i){
+        bimap.insert(i, 2 * i);
+    }
+
+    const StatsBimap &reader = bimap;
+    std::vector<std::thread> threads;
+    for(int t = 0; t < 4; ++t){
+        threads.emplace_back([&reader, t](){
+            for(int i = 0; i < 1000; ++i){
+                reader.getKey(2 * i);
+                if(i % 10 == t){
+                    EXPECT_THROW(reader.getValue(-1), std::out_of_range);
+                }
+            }
+        });
+    }
+    for(std::thread &thread : threads){
+        thread.join();
+    }
+
+    cmap::BimapStatsSnapshot snapshot = bimap.stats().snapshot();
+    EXPECT_EQ(4000, snapshot.hits);
+    EXPECT_EQ(400, snapshot.misses);
+    EXPECT_DOUBLE_EQ(400.0 / 4400.0, snapshot.missRate());
+
+    snapshot.merge(snapshot);
+    EXPECT_EQ(8800, snapshot.lookups());
+    EXPECT_EQ(2000, snapshot.inserts);
+}
@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "concurrentbimap.h"
+
+/*****************************/
+/* Namespace instructions    */
+/*****************************/
+
+/*****************************/
+/* Define test classes       */
+/*****************************/
+
+class ConcurrentBimapTests : public testing::Test
+{
+
+protected:
+    cmap::ConcurrentBimap<int, std::string> m_mapNumberToString =
+    {
+        {1, "ONE"},
+        {2, "TWO"},
+        {3, "THREE"}
+    };
+};
+
+/*****************************/
+/* Defines test fixtures routines
+ * (using TEST_F())            */
+/*****************************/
+
+TEST_F(ConcurrentBimapTests, sizeIsCorrect)
+{
+    EXPECT_FALSE(m_mapNumberToString.empty());
+    EXPECT_EQ(3, m_mapNumberToString.size());
+    EXPECT_EQ(64, m_mapNumberToString.shardCount());
+
+    m_mapNumberToString.clear();
+    EXPECT_TRUE(m_mapNumberToString.empty());
+}
+
+TEST_F(ConcurrentBimapTests, searchByItems)
+{
+    EXPECT_EQ("TWO", m_mapNumberToString.getValue(2));
+    EXPECT_EQ(3, m_mapNumberToString.getKey("THREE"));
+    EXPECT_THROW(m_mapNumberToString.getValue(42), std::out_of_range);
+    EXPECT_THROW(m_mapNumberToString.getKey("FORTY-TWO"), std::out_of_range);
+
+    std::string value;
+    EXPECT_TRUE(m_mapNumberToString.tryGetValue(1, value));
+    EXPECT_EQ("ONE", value);
+    EXPECT_FALSE(m_mapNumberToString.tryGetValue(42, value));
+    EXPECT_EQ("ONE", value);
+
+    int key = 0;
+    EXPECT_TRUE(m_mapNumberToString.tryGetKey("TWO", key));
+    EXPECT_EQ(2, key);
+    EXPECT_FALSE(m_mapNumberToString.containsKey(42));
+    EXPECT_TRUE(m_mapNumberToString.containsValue("THREE"));
+}
+
+TEST_F(ConcurrentBimapTests, insertExistingItemsKeepSidesConsistent)
+{
+    m_mapNumberToString.insert(1, "TWO");
+    EXPECT_EQ(2, m_mapNumberToString.size());
+    EXPECT_EQ("TWO", m_mapNumberToString.getValue(1));
+    EXPECT_EQ(1, m_mapNumberToString.getKey("TWO"));
+    EXPECT_FALSE(m_mapNumberToString.containsKey(2));
+    EXPECT_FALSE(m_mapNumberToString.containsValue("ONE"));
+
+    EXPECT_FALSE(m_mapNumberToString.tryInsert(3, "FOUR"));
+    EXPECT_FALSE(m_mapNumberToString.tryInsert(4, "THREE"));
+    EXPECT_TRUE(m_mapNumberToString.tryInsert(4, "FOUR"));
+    EXPECT_EQ(4, m_mapNumberToString.getKey("FOUR"));
+
+    EXPECT_TRUE(m_mapNumberToString.erase(1));
+    EXPECT_FALSE(m_mapNumberToString.erase(1));
+    EXPECT_FALSE(m_mapNumberToString.containsValue("TWO"));
+    EXPECT_EQ(2, m_mapNumberToString.size());
+}
+
+TEST_F(ConcurrentBimapTests, forEachVisitAllItems)
+{
+    std::unordered_map<int, std::string> visited;
+    m_mapNumberToString.forEach([&visited](int key, const std::string &value){
+        visited.emplace(key, value);
+    });
+
+    const std::unordered_map<int, std::string> expected = {{1, "ONE"}, {2, "TWO"}, {3, "THREE"}};
+    EXPECT_EQ(expected, visited);
+}
+
+/*****************************/
+/* Defines test routines
+ * (using TEST())            */
+/*****************************/
+
+TEST(ConcurrentBimapStressTests, writersKeepSidesConsistent)
+{
+    const int nbThreads = 8;
+    const int nbOperations = 20000;
+    const int range = 512; // Small range, so writers conflict often
+
+    cmap::ConcurrentBimap<int, int> bimap(8);
+    std::vector<std::thread> threads;
+    for(int t = 0; t < nbThreads; ++t){
+        threads.emplace_back([&bimap, t](){
+            std::mt19937 rng(t);
+            for(int i = 0; i < nbOperations; ++i){
+                const int key = static_cast<int>(rng() % range);
+                const int value = static_cast<int>(rng() % range);
+
+                switch(rng() % 4){
+                    case 0: bimap.insert(key, value); break;
+                    case 1: bimap.tryInsert(key, value); break;
+                    case 2: bimap.erase(key); break;
+
+                    /* Readers only run concurrently with writers */
+                    default:{
+                        int found = 0;
+                        if(bimap.tryGetValue(key, found)){
+                            bimap.containsValue(found);
+                        }
+                    }break;
+                }
+            }
+        });
+    }
+
+    for(auto &thread : threads){
+        thread.join();
+    }
+
+    /* Each pair must be visible from both sides */
+    std::vector<std::pair<int, int>> pairs;
+    bimap.forEach([&pairs](int key, int value){
+        pairs.emplace_back(key, value);
+    });
+    EXPECT_EQ(bimap.size(), pairs.size());
+
+    for(const auto &pair : pairs){
+        EXPECT_EQ(pair.first, bimap.getKey(pair.second));
+    }
+
+    std::size_t nbValues = 0;
+    for(int value = 0; value < range; ++value){
+        nbValues += bimap.containsValue(value) ? 1 : 0;
+    }
+    EXPECT_EQ(pairs.size(), nbValues);
+}
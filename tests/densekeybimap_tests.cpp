@@ -0,0 +1,249 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <map>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "densekeybimap.h"
+
+/*****************************/
+/* Namespace instructions    */
+/*****************************/
+
+/*****************************/
+/* Classes aliases           */
+/*****************************/
+
+enum class DenseColor : std::uint8_t
+{
+    Red,
+    Green,
+    Blue,
+    Black
+};
+
+/*****************************/
+/* Define test classes       */
+/*****************************/
+
+class DenseKeyBimapTests : public testing::Test
+{
+
+protected:
+    cmap::DenseKeyBimap<int, std::string> m_mapNumberToString =
+    {
+        {1, "ONE"},
+        {2, "TWO"},
+        {3, "THREE"}
+    };
+};
+
+/*****************************/
+/* Defines test fixtures routines
+ * (using TEST_F())            */
+/*****************************/
+
+TEST_F(DenseKeyBimapTests, searchByValidItems)
+{
+    EXPECT_EQ(3, m_mapNumberToString.size());
+    EXPECT_EQ(4, m_mapNumberToString.keyRange());
+    EXPECT_EQ("TWO", m_mapNumberToString.getValue(2));
+    EXPECT_EQ(3, m_mapNumberToString.getKey("THREE"));
+
+    EXPECT_THROW(m_mapNumberToString.getValue(0), std::out_of_range);
+    EXPECT_THROW(m_mapNumberToString.getValue(4), std::out_of_range);
+    EXPECT_THROW(m_mapNumberToString.getValue(-1), std::out_of_range);
+    EXPECT_THROW(m_mapNumberToString.getKey("FOUR"), std::out_of_range);
+
+    EXPECT_EQ(m_mapNumberToString.cend(), m_mapNumberToString.findByKey(-5));
+    EXPECT_EQ(2, m_mapNumberToString.findByValue("TWO")->first);
+    EXPECT_EQ("ONE", m_mapNumberToString.findByKey(1)->second);
+    EXPECT_TRUE(m_mapNumberToString.containsKey(3));
+    EXPECT_FALSE(m_mapNumberToString.containsValue("ZERO"));
+}
+
+TEST_F(DenseKeyBimapTests, insertExistingItemsKeepSidesConsistent)
+{
+    m_mapNumberToString.insert(1, "UNO");
+    EXPECT_EQ("UNO", m_mapNumberToString.getValue(1));
+    EXPECT_FALSE(m_mapNumberToString.containsValue("ONE"));
+
+    m_mapNumberToString.insert(10, "TWO");
+    EXPECT_EQ(10, m_mapNumberToString.getKey("TWO"));
+    EXPECT_FALSE(m_mapNumberToString.containsKey(2));
+    EXPECT_EQ(3, m_mapNumberToString.size());
+    EXPECT_EQ(11, m_mapNumberToString.keyRange());
+
+    /* Erased slots are reset */
+    m_mapNumberToString.erase(10);
+    m_mapNumberToString.erase(10);
+    EXPECT_FALSE(m_mapNumberToString.containsValue("TWO"));
+    EXPECT_EQ(2, m_mapNumberToString.size());
+
+    EXPECT_THROW(m_mapNumberToString.insert(-1, "MINUS ONE"), std::out_of_range);
+    EXPECT_THROW(m_mapNumberToString.tryInsert(-1, "MINUS ONE"), std::out_of_range);
+    EXPECT_EQ(2, m_mapNumberToString.size());
+}
+
+TEST_F(DenseKeyBimapTests, iterateSkipUnusedKeys)
+{
+    m_mapNumberToString.insert(100, "HUNDRED");
+    m_mapNumberToString.insert(64, "SIXTY-FOUR");
+    m_mapNumberToString.erase(2);
+
+    std::vector<int> keys;
+    for(const auto &pair : m_mapNumberToString){
+        keys.push_back(pair.first);
+        EXPECT_EQ(pair.first, m_mapNumberToString.getKey(pair.second));
+    }
+    EXPECT_EQ((std::vector<int>{1, 3, 64, 100}), keys);
+
+    m_mapNumberToString.clear();
+    EXPECT_EQ(m_mapNumberToString.cbegin(), m_mapNumberToString.cend());
+}
+
+TEST_F(DenseKeyBimapTests, tryInsertNeverReplace)
+{
+    auto result = m_mapNumberToString.tryInsert(1, "UNO");
+    EXPECT_FALSE(result.second);
+    EXPECT_EQ("ONE", result.first->second);
+
+    result = m_mapNumberToString.tryInsert(4, "ONE");
+    EXPECT_FALSE(result.second);
+    EXPECT_EQ(1, result.first->first);
+
+    result = m_mapNumberToString.emplace(4, "FOUR");
+    EXPECT_TRUE(result.second);
+    EXPECT_EQ("FOUR", result.first->second);
+    EXPECT_EQ(4, m_mapNumberToString.size());
+}
+
+TEST_F(DenseKeyBimapTests, insertOrAssignAndReplaceFollowPolicy)
+{
+    auto result = m_mapNumberToString.insertOrAssign(1, "TWO");
+    EXPECT_FALSE(result.second);
+    EXPECT_EQ(1, m_mapNumberToString.getKey("TWO"));
+    EXPECT_FALSE(m_mapNumberToString.containsKey(2));
+    EXPECT_EQ(2, m_mapNumberToString.size());
+
+    result = m_mapNumberToString.replace(1, "THREE", cmap::ReplacePolicy::OverwriteRight);
+    EXPECT_FALSE(result.second);
+    EXPECT_EQ(3, result.first->first);
+
+    result = m_mapNumberToString.replace(5, "THREE", cmap::ReplacePolicy::OverwriteLeft);
+    EXPECT_TRUE(result.second);
+    EXPECT_EQ(5, m_mapNumberToString.getKey("THREE"));
+    EXPECT_FALSE(m_mapNumberToString.containsKey(3));
+
+    result = m_mapNumberToString.replace(5, "FIVE", cmap::ReplacePolicy::Reject);
+    EXPECT_FALSE(result.second);
+    EXPECT_EQ("THREE", m_mapNumberToString.getValue(5));
+}
+
+/*****************************/
+/* Defines test routines
+ * (using TEST())            */
+/*****************************/
+
+TEST(DenseKeyBimapEnumTests, searchByEnumKeys)
+{
+    cmap::DenseKeyBimap<DenseColor, std::string> colors =
+    {
+        {DenseColor::Blue, "blue"},
+        {DenseColor::Red, "red"},
+        {DenseColor::Black, "black"}
+    };
+
+    EXPECT_EQ("red", colors.getValue(DenseColor::Red));
+    EXPECT_EQ(DenseColor::Black, colors.getKey("black"));
+    EXPECT_FALSE(colors.containsKey(DenseColor::Green));
+
+    std::vector<DenseColor> keys;
+    for(const auto &pair : colors){
+        keys.push_back(pair.first);
+    }
+    EXPECT_EQ((std::vector<DenseColor>{DenseColor::Red, DenseColor::Blue, DenseColor::Black}), keys);
+}
+
+TEST(DenseKeyBimapStressTests, matchReferenceMaps)
+{
+    cmap::DenseKeyBimap<unsigned, int> bimap;
+    std::map<unsigned, int> refKeys;
+    std::unordered_map<int, unsigned> refValues;
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<unsigned> distKey(0, 700);
+    std::uniform_int_distribution<int> distValue(-300, 300);
+    for(int i = 0; i < 20000; ++i){
+        const unsigned key = distKey(rng);
+        const int value = distValue(rng);
+
+        auto itKey = refKeys.find(key);
+        if(itKey != refKeys.end()){
+            refValues.erase(itKey->second);
+            refKeys.erase(itKey);
+        }
+
+        if(rng() % 3 == 0){
+            bimap.erase(key);
+            continue;
+        }
+
+        auto itValue = refValues.find(value);
+        if(itValue != refValues.end()){
+            refKeys.erase(itValue->second);
+            refValues.erase(itValue);
+        }
+        refKeys[key] = value;
+        refValues[value] = key;
+        if(rng() % 2 == 0){
+            bimap.insert(key, value);
+        }else{
+            bimap.insertOrAssign(key, value);
+        }
+    }
+
+    ASSERT_EQ(refKeys.size(), bimap.size());
+    for(const auto &pair : refKeys){
+        EXPECT_EQ(pair.second, bimap.getValue(pair.first));
+        EXPECT_EQ(pair.first, bimap.getKey(pair.second));
+    }
+
+    /* Iteration is ordered by keys */
+    auto itRef = refKeys.cbegin();
+    for(auto it = bimap.cbegin(); it != bimap.cend(); ++it, ++itRef){
+        ASSERT_NE(refKeys.cend(), itRef);
+        EXPECT_EQ(itRef->first, it->first);
+        EXPECT_EQ(itRef->second, it->second);
+    }
+    EXPECT_EQ(refKeys.cend(), itRef);
+}
+
+TEST(DenseKeyBimapDiagnosticsTests, reportMemoryAndShrink)
+{
+    cmap::DenseKeyBimap<std::uint32_t, std::uint64_t> bimap;
+    bimap.reserveKeys(1000);
+    for(std::uint32_t i = 0; i < 1000; ++i){
+        bimap.insert(i, i * 3);
+    }
+
+    EXPECT_EQ(1000, bimap.keyRange());
+    cmap::BimapMemoryUsage usage = bimap.memoryUsage();
+    EXPECT_EQ(1000 * sizeof(std::uint64_t), usage.payload);
+    EXPECT_EQ(((1000 + 31) / 32) * sizeof(std::uint32_t), usage.indexKey);
+    EXPECT_EQ(1000 * (1 + sizeof(std::uint32_t)), usage.indexValue);
+
+    /* Only low keys are kept: array is truncated after them */
+    for(std::uint32_t i = 10; i < 1000; ++i){
+        bimap.erase(i);
+    }
+    bimap.shrinkToFit();
+    EXPECT_EQ(10, bimap.keyRange());
+    EXPECT_EQ(16, bimap.capacity());
+    EXPECT_EQ(9u, bimap.getKey(27));
+
+    usage = bimap.memoryUsage();
+    EXPECT_LT(usage.total(), 1000 * sizeof(std::uint64_t));
+}
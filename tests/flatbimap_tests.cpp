@@ -0,0 +1,481 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "flatbimap.h"
+
+/*****************************/
+/* Namespace instructions    */
+/*****************************/
+
+/*****************************/
+/* Classes aliases           */
+/*****************************/
+
+/*!
+ * \brief Key only constructible explicitly, used to
+ * check heterogeneous lookups
+ */
+struct Id
+{
+    explicit Id(int v) : value(v) {}
+    int value;
+};
+
+struct IdHash
+{
+    using is_transparent = void;
+
+    std::size_t operator()(const Id &id) const { return std::hash<int>()(id.value); }
+    std::size_t operator()(int id) const { return std::hash<int>()(id); }
+};
+
+struct IdEqual
+{
+    using is_transparent = void;
+
+    bool operator()(const Id &lhs, const Id &rhs) const { return lhs.value == rhs.value; }
+    bool operator()(const Id &lhs, int rhs) const { return lhs.value == rhs; }
+};
+
+/*!
+ * \brief Hash sending every element into the same
+ * probe sequence, with the same control byte
+ */
+struct CollidingHash
+{
+    std::size_t operator()(int) const { return 0; }
+};
+
+/*****************************/
+/* Define test classes       */
+/*****************************/
+
+class FlatBimapTests : public testing::Test
+{
+
+protected:
+    cmap::FlatBimap<int, std::string> m_mapNumberToString =
+    {
+        {1, "ONE"},
+        {2, "TWO"},
+        {3, "THREE"}
+    };
+};
+
+/*****************************/
+/* Defines test fixtures routines
+ * (using TEST_F())            */
+/*****************************/
+
+TEST_F(FlatBimapTests, sizeIsCorrect)
+{
+    EXPECT_FALSE(m_mapNumberToString.empty());
+    EXPECT_EQ(3, m_mapNumberToString.size());
+}
+
+TEST_F(FlatBimapTests, searchByValidItems)
+{
+    EXPECT_EQ("TWO", m_mapNumberToString.getValue(2));
+    EXPECT_EQ(3, m_mapNumberToString.getKey("THREE"));
+    EXPECT_THROW(m_mapNumberToString.getValue(42), std::out_of_range);
+    EXPECT_THROW(m_mapNumberToString.getKey("FORTY-TWO"), std::out_of_range);
+}
+
+TEST_F(FlatBimapTests, insertExistingItemsKeepSidesConsistent)
+{
+    m_mapNumberToString.insert(1, "UN");
+    m_mapNumberToString.insert(4, "TWO");
+
+    EXPECT_EQ(3, m_mapNumberToString.size());
+    EXPECT_EQ(1, m_mapNumberToString.getKey("UN"));
+    EXPECT_EQ(4, m_mapNumberToString.getKey("TWO"));
+    EXPECT_THROW(m_mapNumberToString.getValue(2), std::out_of_range);
+}
+
+TEST_F(FlatBimapTests, eraseMoveLastItem)
+{
+    m_mapNumberToString.erase(1);
+
+    EXPECT_EQ(2, m_mapNumberToString.size());
+    EXPECT_EQ(3, m_mapNumberToString.cbegin()->first);
+    EXPECT_EQ("THREE", m_mapNumberToString.getValue(3));
+    EXPECT_EQ(3, m_mapNumberToString.getKey("THREE"));
+    EXPECT_THROW(m_mapNumberToString.getValue(1), std::out_of_range);
+}
+
+TEST_F(FlatBimapTests, reserveAvoidRehash)
+{
+    cmap::FlatBimap<int, int> bimap;
+    bimap.reserve(1000);
+
+    const std::size_t capacity = bimap.capacity();
+    for(int i = 0; i < 1000; ++i){
+        bimap.insert(i, -i);
+    }
+    EXPECT_EQ(capacity, bimap.capacity());
+    EXPECT_LE(bimap.loadFactor(), 0.875f);
+
+    bimap.rehash(4 * capacity);
+    EXPECT_EQ(4 * capacity, bimap.capacity());
+    EXPECT_EQ(-500, bimap.getValue(500));
+    EXPECT_EQ(500, bimap.getKey(-500));
+
+    bimap.shrinkToFit();
+    EXPECT_EQ(capacity, bimap.capacity());
+}
+
+TEST_F(FlatBimapTests, findDoesNotThrow)
+{
+    auto itKey = m_mapNumberToString.findByKey(2);
+    ASSERT_NE(m_mapNumberToString.cend(), itKey);
+    EXPECT_EQ("TWO", itKey->second);
+
+    auto itValue = m_mapNumberToString.findByValue("THREE");
+    ASSERT_NE(m_mapNumberToString.cend(), itValue);
+    EXPECT_EQ(3, itValue->first);
+
+    EXPECT_EQ(m_mapNumberToString.cend(), m_mapNumberToString.findByKey(42));
+    EXPECT_EQ(m_mapNumberToString.cend(), m_mapNumberToString.findByValue("FORTY-TWO"));
+
+    EXPECT_TRUE(m_mapNumberToString.containsKey(1));
+    EXPECT_FALSE(m_mapNumberToString.containsKey(42));
+    EXPECT_TRUE(m_mapNumberToString.containsValue("ONE"));
+    EXPECT_FALSE(m_mapNumberToString.containsValue("FORTY-TWO"));
+}
+
+TEST_F(FlatBimapTests, tryInsertNeverReplace)
+{
+    std::string value = "UNO";
+    auto result = m_mapNumberToString.tryInsert(1, std::move(value));
+    EXPECT_FALSE(result.second);
+    EXPECT_EQ("ONE", result.first->second);
+    EXPECT_EQ("UNO", value);
+
+    result = m_mapNumberToString.tryInsert(4, "TWO");
+    EXPECT_FALSE(result.second);
+    EXPECT_EQ(2, result.first->first);
+
+    result = m_mapNumberToString.tryInsert(4, "FOUR");
+    EXPECT_TRUE(result.second);
+    EXPECT_EQ(4, result.first->first);
+    EXPECT_EQ(4, m_mapNumberToString.size());
+    EXPECT_EQ(4, m_mapNumberToString.getKey("FOUR"));
+}
+
+TEST_F(FlatBimapTests, emplaceConstructInPlace)
+{
+    auto result = m_mapNumberToString.emplace(std::piecewise_construct, std::forward_as_tuple(4), std::forward_as_tuple(3, 'X'));
+    EXPECT_TRUE(result.second);
+    EXPECT_EQ("XXX", result.first->second);
+    EXPECT_EQ(4, m_mapNumberToString.getKey("XXX"));
+
+    result = m_mapNumberToString.emplace(5, "ONE");
+    EXPECT_FALSE(result.second);
+    EXPECT_EQ(1, result.first->first);
+    EXPECT_FALSE(m_mapNumberToString.containsKey(5));
+    EXPECT_EQ(4, m_mapNumberToString.size());
+}
+
+TEST_F(FlatBimapTests, insertOrAssignKeepSidesConsistent)
+{
+    auto result = m_mapNumberToString.insertOrAssign(1, "UNO");
+    EXPECT_FALSE(result.second);
+    EXPECT_EQ("UNO", result.first->second);
+    EXPECT_EQ(1, m_mapNumberToString.getKey("UNO"));
+    EXPECT_FALSE(m_mapNumberToString.containsValue("ONE"));
+
+    result = m_mapNumberToString.insertOrAssign(1, "TWO");
+    EXPECT_FALSE(result.second);
+    EXPECT_EQ(1, m_mapNumberToString.getKey("TWO"));
+    EXPECT_FALSE(m_mapNumberToString.containsKey(2));
+    EXPECT_FALSE(m_mapNumberToString.containsValue("UNO"));
+    EXPECT_EQ(2, m_mapNumberToString.size());
+
+    result = m_mapNumberToString.insertOrAssign(4, "THREE");
+    EXPECT_TRUE(result.second);
+    EXPECT_EQ(4, result.first->first);
+    EXPECT_EQ(4, m_mapNumberToString.getKey("THREE"));
+    EXPECT_FALSE(m_mapNumberToString.containsKey(3));
+    EXPECT_EQ(2, m_mapNumberToString.size());
+}
+
+TEST_F(FlatBimapTests, replaceFollowPolicy)
+{
+    auto result = m_mapNumberToString.replace(1, "TWO", cmap::ReplacePolicy::Reject);
+    EXPECT_FALSE(result.second);
+    EXPECT_EQ(1, result.first->first);
+
+    result = m_mapNumberToString.replace(1, "UNO", cmap::ReplacePolicy::OverwriteLeft);
+    EXPECT_FALSE(result.second);
+    EXPECT_EQ("ONE", m_mapNumberToString.getValue(1));
+
+    result = m_mapNumberToString.replace(4, "ONE", cmap::ReplacePolicy::OverwriteRight);
+    EXPECT_FALSE(result.second);
+    EXPECT_EQ(1, result.first->first);
+
+    result = m_mapNumberToString.replace(1, "UNO", cmap::ReplacePolicy::OverwriteRight);
+    EXPECT_TRUE(result.second);
+    EXPECT_EQ("UNO", m_mapNumberToString.getValue(1));
+
+    result = m_mapNumberToString.replace(4, "TWO", cmap::ReplacePolicy::OverwriteLeft);
+    EXPECT_TRUE(result.second);
+    EXPECT_EQ(4, m_mapNumberToString.getKey("TWO"));
+    EXPECT_FALSE(m_mapNumberToString.containsKey(2));
+
+    result = m_mapNumberToString.replace(4, "TWO", cmap::ReplacePolicy::Reject);
+    EXPECT_TRUE(result.second);
+    EXPECT_EQ(3, m_mapNumberToString.size());
+}
+
+TEST(FlatBimapStressTests, matchReferenceMaps)
+{
+    cmap::FlatBimap<int, int> bimap;
+    std::unordered_map<int, int> refKeys;
+    std::unordered_map<int, int> refValues;
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> dist(0, 512);
+    for(int i = 0; i < 20000; ++i){
+        const int key = dist(rng);
+        const int value = dist(rng);
+
+        auto itKey = refKeys.find(key);
+        if(itKey != refKeys.end()){
+            refValues.erase(itKey->second);
+            refKeys.erase(itKey);
+        }
+
+        if(rng() % 3 == 0){
+            bimap.erase(key);
+            continue;
+        }
+
+        auto itValue = refValues.find(value);
+        if(itValue != refValues.end()){
+            refKeys.erase(itValue->second);
+            refValues.erase(itValue);
+        }
+        refKeys[key] = value;
+        refValues[value] = key;
+        if(rng() % 2 == 0){
+            bimap.insert(key, value);
+        }else{
+            bimap.insertOrAssign(key, value);
+        }
+    }
+
+    ASSERT_EQ(refKeys.size(), bimap.size());
+    for(const auto &pair : refKeys){
+        EXPECT_EQ(pair.second, bimap.getValue(pair.first));
+        EXPECT_EQ(pair.first, bimap.getKey(pair.second));
+    }
+}
+
+TEST(FlatBimapLayoutTests, policiesKeepSidesConsistent)
+{
+    using Default = cmap::FlatBimap<std::uint32_t, std::string>;
+    static_assert(Default::storage_policy::InlineKey && !Default::storage_policy::InlineValue, "Only small trivially copyable types are inline");
+    static_assert(!cmap::FlatBimap<std::uint64_t, std::int8_t>::storage_policy::InlineKey, "Keys larger than indexes are not inline");
+
+    /* Same operations on every layout give the same content */
+    using Inline64 = cmap::BasicFlatBimap<std::uint64_t, std::uint64_t, cmap::FlatBimapStoragePolicy<true, true>,
+                                          cmap::FlatBimapIndexPolicy<std::uint64_t>, cmap::FlatBimapAllocPolicy<128>>;
+    using Indirect16 = cmap::BasicFlatBimap<std::uint64_t, std::uint64_t, cmap::FlatBimapStoragePolicy<false, true>,
+                                            cmap::FlatBimapIndexPolicy<std::uint16_t>, cmap::FlatBimapAllocPolicy<16>>;
+    Inline64 inline64;
+    Indirect16 indirect16;
+    cmap::FlatBimap<std::uint64_t, std::uint64_t> reference;
+
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<std::uint64_t> dist(0, 3000);
+    for(int i = 0; i < 20000; ++i){
+        const std::uint64_t key = dist(rng);
+        const std::uint64_t value = dist(rng);
+        if(rng() % 3 == 0){
+            inline64.erase(key);
+            indirect16.erase(key);
+            reference.erase(key);
+        }else{
+            inline64.insertOrAssign(key, value);
+            indirect16.insertOrAssign(key, value);
+            reference.insertOrAssign(key, value);
+        }
+    }
+
+    ASSERT_EQ(reference.size(), inline64.size());
+    ASSERT_EQ(reference.size(), indirect16.size());
+    for(const auto &pair : reference){
+        EXPECT_EQ(pair.second, inline64.getValue(pair.first));
+        EXPECT_EQ(pair.first, inline64.getKey(pair.second));
+        EXPECT_EQ(pair.second, indirect16.getValue(pair.first));
+        EXPECT_EQ(pair.first, indirect16.getKey(pair.second));
+    }
+
+    /* Slots size follow policies */
+    EXPECT_EQ(inline64.size() * (1 + 2 * sizeof(std::uint64_t)), inline64.memoryUsage().indexKey);
+    EXPECT_EQ(indirect16.size() * (1 + sizeof(std::uint16_t)), indirect16.memoryUsage().indexKey);
+    EXPECT_EQ(indirect16.size() * (1 + 2 * sizeof(std::uint64_t)), indirect16.memoryUsage().indexValue); // Index is padded
+
+    /* Index type limits number of elements */
+    EXPECT_EQ(65535, indirect16.maxSize());
+    EXPECT_THROW(indirect16.reserve(70000), std::length_error);
+}
+
+TEST(FlatBimapGroupTests, matchControlBytes)
+{
+    std::int8_t ctrl[16];
+    for(int i = 0; i < 16; ++i){
+        ctrl[i] = static_cast<std::int8_t>(i % 3 == 0 ? -128 : (i % 3 == 1 ? -2 : i));
+    }
+    ctrl[15] = 7;
+
+    std::uint32_t expectedFree = 0;
+    for(int i = 0; i < 16; ++i){
+        expectedFree |= static_cast<std::uint32_t>(ctrl[i] < 0) << i;
+    }
+
+    using Group = cmap::detail::FlatBimapGroup;
+    EXPECT_EQ(expectedFree, Group::matchFree(ctrl));
+    EXPECT_EQ(0x1249u, Group::match(ctrl, -128));
+    EXPECT_EQ(0x2492u, Group::match(ctrl, -2));
+    EXPECT_EQ(0x8000u, Group::match(ctrl, 7));
+    EXPECT_EQ(0x4000u, Group::match(ctrl, 14));
+    EXPECT_EQ(0u, Group::match(ctrl, 0x7F));
+    EXPECT_EQ(0u, cmap::detail::bimapLowestBit(1u));
+    EXPECT_EQ(15u, cmap::detail::bimapLowestBit(0x8000u));
+}
+
+TEST(FlatBimapStressTests, collidingHashesKeepSidesConsistent)
+{
+    cmap::FlatBimap<int, int, CollidingHash, std::equal_to<int>, CollidingHash> bimap;
+    for(int i = 0; i < 100; ++i){
+        bimap.insert(i, -i);
+    }
+    for(int i = 0; i < 100; i += 3){
+        bimap.erase(i);
+    }
+    for(int i = 100; i < 120; ++i){
+        bimap.insert(i, -i);
+    }
+
+    EXPECT_EQ(86, bimap.size());
+    for(int i = 0; i < 120; ++i){
+        const bool erased = i < 100 && i % 3 == 0;
+        EXPECT_EQ(!erased, bimap.containsKey(i));
+        EXPECT_EQ(!erased, bimap.containsValue(-i));
+        if(!erased){
+            EXPECT_EQ(-i, bimap.getValue(i));
+            EXPECT_EQ(i, bimap.getKey(-i));
+        }
+    }
+}
+
+TEST(FlatBimapDiagnosticsTests, reportMemoryAndProbeLengths)
+{
+    cmap::FlatBimap<int, int> bimap;
+    EXPECT_EQ(0, bimap.memoryUsage().total());
+    EXPECT_TRUE(bimap.probeHistogramKey().empty());
+
+    for(int i = 0; i < 1000; ++i){
+        bimap.insert(i, -i);
+    }
+
+    /* Integers are stored inline by default */
+    const cmap::BimapMemoryUsage usage = bimap.memoryUsage();
+    EXPECT_EQ(1000 * sizeof(std::pair<int, int>), usage.payload);
+    EXPECT_EQ(1000 * (1 + sizeof(std::uint32_t) + sizeof(int)), usage.indexKey);
+    EXPECT_EQ(usage.indexKey, usage.indexValue);
+    EXPECT_GE(usage.unused, 2 * (bimap.capacity() - 1000) * (1 + sizeof(std::uint32_t) + sizeof(int)));
+
+    /* Mixed hashes of consecutive integers are well distributed */
+    const std::vector<std::size_t> histogram = bimap.probeHistogramKey();
+    ASSERT_FALSE(histogram.empty());
+    EXPECT_EQ(1000, std::accumulate(histogram.cbegin(), histogram.cend(), std::size_t(0)));
+    EXPECT_GT(histogram[0], 900);
+
+    bimap.reserve(100000);
+    EXPECT_GT(bimap.memoryUsage().unused, usage.unused);
+
+    /* All elements share the same probe sequence */
+    cmap::FlatBimap<int, int, CollidingHash, std::equal_to<int>, CollidingHash> colliding;
+    for(int i = 0; i < 100; ++i){
+        colliding.insert(i, -i);
+    }
+    const std::vector<std::size_t> lengths = colliding.probeHistogramValue();
+    ASSERT_EQ(7, lengths.size());
+    EXPECT_EQ(16, lengths[0]);
+    EXPECT_EQ(4, lengths[6]);
+}
+
+TEST(FlatBimapBatchTests, batchedLookupsMatchSingleLookups)
+{
+    const std::size_t sizes[] = {0, 1, 2, 3, 15, 16, 17, 100, 1000};
+    for(std::size_t size : sizes){
+        cmap::FlatBimap<int, int> bimap;
+        for(std::size_t i = 0; i < size; ++i){
+            bimap.insert(static_cast<int>(3 * i), static_cast<int>(5 * i + 1));
+        }
+
+        /* Probe hits and misses, including around bounds */
+        std::vector<int> probes;
+        for(int i = -2; i < static_cast<int>(5 * size + 4); ++i){
+            probes.push_back(i);
+        }
+
+        std::vector<int> results(probes.size(), -1);
+        std::unique_ptr<bool[]> found(new bool[probes.size()]);
+
+        EXPECT_EQ(std::count_if(probes.cbegin(), probes.cend(), [&bimap](int key){ return bimap.containsKey(key); }),
+                  bimap.getValues(probes.data(), probes.size(), results.data(), found.get()));
+        for(std::size_t i = 0; i < probes.size(); ++i){
+            auto it = bimap.findByKey(probes[i]);
+            ASSERT_EQ(it != bimap.cend(), found[i]);
+            EXPECT_EQ(it != bimap.cend() ? it->second : -1, results[i]);
+        }
+
+        std::fill(results.begin(), results.end(), -1);
+        EXPECT_EQ(std::count_if(probes.cbegin(), probes.cend(), [&bimap](int value){ return bimap.containsValue(value); }),
+                  bimap.getKeys(probes.data(), probes.size(), results.data(), nullptr));
+        for(std::size_t i = 0; i < probes.size(); ++i){
+            auto it = bimap.findByValue(probes[i]);
+            EXPECT_EQ(it != bimap.cend() ? it->first : -1, results[i]);
+        }
+    }
+}
+
+TEST(FlatBimapTransparentTests, searchWithoutTemporaryKey)
+{
+    cmap::FlatBimap<Id, std::string, IdHash, IdEqual> bimap;
+    bimap.insert(Id(1), "ONE");
+    bimap.insert(Id(2), "TWO");
+
+    EXPECT_EQ("TWO", bimap.getValue(2));
+    EXPECT_THROW(bimap.getValue(3), std::out_of_range);
+    EXPECT_TRUE(bimap.containsKey(1));
+    EXPECT_FALSE(bimap.containsKey(3));
+    EXPECT_EQ(bimap.cend(), bimap.findByKey(3));
+}
+
+#if BIMAP_HAS_CPP17
+TEST(FlatBimapTransparentTests, searchByStringView)
+{
+    cmap::FlatBimap<int, std::string, std::hash<int>, std::equal_to<int>, cmap::StringHash, std::equal_to<>> bimap;
+    bimap.insert(1, "ONE");
+    bimap.insert(2, "TWO");
+
+    EXPECT_EQ(2, bimap.getKey(std::string_view("TWO")));
+    EXPECT_EQ(1, bimap.getKey("ONE"));
+    EXPECT_THROW(bimap.getKey(std::string_view("THREE")), std::out_of_range);
+}
+#endif
+
+/*****************************/
+/* End                       */
+/*****************************/
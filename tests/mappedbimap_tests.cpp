@@ -0,0 +1,236 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "bimap.h"
+#include "mappedbimap.h"
+
+/*****************************/
+/* Namespace instructions    */
+/*****************************/
+
+/*****************************/
+/* Define test classes       */
+/*****************************/
+
+class MappedBimapTests : public testing::Test
+{
+
+protected:
+    void SetUp() override
+    {
+        m_path = testing::TempDir() + "bimap_tests_" + testing::UnitTest::GetInstance()->current_test_info()->name() + ".cmap";
+
+        cmap::Bimap<std::uint64_t, std::int32_t> bimap;
+        for(std::int32_t i = 0; i < 1000; ++i){
+            bimap.insert(static_cast<std::uint64_t>(i) * 7919, 1000 - 3 * i);
+        }
+        cmap::MappedBimap<std::uint64_t, std::int32_t>::write(m_path, bimap);
+    }
+
+    void TearDown() override
+    {
+        std::remove(m_path.c_str());
+    }
+
+    /* Overwrite byte at offset of file */
+    void corrupt(std::size_t offset, char byte)
+    {
+        std::fstream file(m_path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(static_cast<std::streamoff>(offset));
+        file.put(byte);
+    }
+
+protected:
+    std::string m_path;
+};
+
+/*****************************/
+/* Defines test fixtures routines
+ * (using TEST_F())            */
+/*****************************/
+
+TEST_F(MappedBimapTests, searchByItems)
+{
+    cmap::MappedBimap<std::uint64_t, std::int32_t> mapped(m_path);
+    ASSERT_TRUE(mapped.isOpen());
+    EXPECT_EQ(1000, mapped.size());
+    EXPECT_TRUE(mapped.verifyChecksum());
+
+    for(std::int32_t i = 0; i < 1000; ++i){
+        const std::uint64_t key = static_cast<std::uint64_t>(i) * 7919;
+        EXPECT_EQ(1000 - 3 * i, mapped.getValue(key));
+        EXPECT_EQ(key, mapped.getKey(1000 - 3 * i));
+    }
+
+    EXPECT_THROW(mapped.getValue(1), std::out_of_range);
+    EXPECT_THROW(mapped.getKey(1001), std::out_of_range);
+    EXPECT_FALSE(mapped.containsKey(7920));
+    EXPECT_TRUE(mapped.containsValue(1000));
+
+    std::int32_t value = 42;
+    EXPECT_FALSE(mapped.tryGetValue(3, value));
+    EXPECT_EQ(42, value);
+    EXPECT_TRUE(mapped.tryGetValue(7919, value));
+    EXPECT_EQ(997, value);
+}
+
+TEST_F(MappedBimapTests, forEachVisitSortedKeys)
+{
+    const cmap::MappedBimap<std::uint64_t, std::int32_t> mapped(m_path);
+
+    std::vector<std::pair<std::uint64_t, std::int32_t>> pairs;
+    mapped.forEach([&pairs](std::uint64_t key, std::int32_t value){
+        pairs.emplace_back(key, value);
+    });
+
+    ASSERT_EQ(1000, pairs.size());
+    for(std::size_t i = 0; i < pairs.size(); ++i){
+        EXPECT_EQ(i * 7919, pairs[i].first);
+    }
+}
+
+TEST_F(MappedBimapTests, moveTransferMapping)
+{
+    cmap::MappedBimap<std::uint64_t, std::int32_t> mapped(m_path);
+    cmap::MappedBimap<std::uint64_t, std::int32_t> moved(std::move(mapped));
+
+    EXPECT_FALSE(mapped.isOpen());
+    EXPECT_TRUE(mapped.empty());
+    EXPECT_EQ(1000, moved.getValue(0));
+
+    mapped = std::move(moved);
+    EXPECT_FALSE(moved.isOpen());
+    EXPECT_EQ(0u, mapped.getKey(1000));
+
+    mapped.close();
+    EXPECT_FALSE(mapped.containsKey(0));
+}
+
+TEST_F(MappedBimapTests, invalidFilesAreRejected)
+{
+    using Mapped = cmap::MappedBimap<std::uint64_t, std::int32_t>;
+
+    /* Types must match those used to write */
+    EXPECT_THROW((cmap::MappedBimap<std::uint32_t, std::int32_t>(m_path)), std::runtime_error);
+    EXPECT_THROW(Mapped(m_path + ".missing"), std::system_error);
+
+    /* Content corruption is only detected by checksum */
+    corrupt(100, 0x55);
+    Mapped mapped(m_path);
+    EXPECT_FALSE(mapped.verifyChecksum());
+
+    corrupt(0, 'X');
+    EXPECT_THROW(mapped.open(m_path), std::runtime_error);
+    EXPECT_FALSE(mapped.isOpen());
+
+    std::ofstream(m_path, std::ios::binary | std::ios::trunc) << "CMAPBIMP";
+    EXPECT_THROW(mapped.open(m_path), std::runtime_error);
+}
+
+TEST_F(MappedBimapTests, corruptedIndexesAndByteOrderAreReported)
+{
+    using Mapped = cmap::MappedBimap<std::uint64_t, std::int32_t>;
+
+    cmap::detail::MappedBimapHeader header;
+    std::ifstream(m_path, std::ios::binary).read(reinterpret_cast<char*>(&header), sizeof(header));
+
+    /* Index referencing a pair out of arrays */
+    for(std::size_t i = 0; i < sizeof(std::uint32_t); ++i){
+        corrupt(static_cast<std::size_t>(header.offsetPermutation) + i, 0x7F);
+    }
+    try{
+        Mapped mapped(m_path);
+        FAIL() << "Corrupted indexes must be rejected";
+    }catch(const std::runtime_error &e){
+        EXPECT_NE(std::string::npos, std::string(e.what()).find("corrupted indexes"));
+    }
+
+    /* Fields of a file written by an host of other byte order are swapped, version included */
+    char swapped[2 * sizeof(std::uint32_t)];
+    std::memcpy(swapped, &header.version, sizeof(std::uint32_t));
+    std::memcpy(swapped + sizeof(std::uint32_t), &header.endianness, sizeof(std::uint32_t));
+    std::reverse(swapped, swapped + sizeof(std::uint32_t));
+    std::reverse(swapped + sizeof(std::uint32_t), swapped + sizeof(swapped));
+    for(std::size_t i = 0; i < sizeof(swapped); ++i){
+        corrupt(offsetof(cmap::detail::MappedBimapHeader, version) + i, swapped[i]);
+    }
+    try{
+        Mapped mapped(m_path);
+        FAIL() << "Files of other byte order must be rejected";
+    }catch(const std::runtime_error &e){
+        EXPECT_NE(std::string::npos, std::string(e.what()).find("byte order"));
+    }
+}
+
+/*****************************/
+/* Defines test routines
+ * (using TEST())            */
+/*****************************/
+
+TEST(MappedBimapWriteTests, emptyAndDuplicatedRanges)
+{
+    const std::string path = testing::TempDir() + "bimap_tests_write.cmap";
+    using Mapped = cmap::MappedBimap<int, int>;
+
+    const std::vector<std::pair<int, int>> empty;
+    Mapped::write(path, empty.cbegin(), empty.cend());
+    Mapped mapped(path);
+    EXPECT_TRUE(mapped.isOpen());
+    EXPECT_TRUE(mapped.empty());
+    EXPECT_TRUE(mapped.verifyChecksum());
+    EXPECT_FALSE(mapped.containsKey(0));
+
+    /* Previous mapping stay readable when file is replaced */
+    const std::vector<std::pair<int, int>> pairs = {{3, 30}, {1, 10}, {2, 20}};
+    Mapped::write(path, pairs.cbegin(), pairs.cend());
+    EXPECT_TRUE(mapped.empty());
+    mapped.open(path);
+    EXPECT_EQ(20, mapped.getValue(2));
+    EXPECT_EQ(3, mapped.getKey(30));
+
+    const std::vector<std::pair<int, int>> duplicated = {{1, 10}, {2, 10}};
+    EXPECT_THROW(Mapped::write(path, duplicated.cbegin(), duplicated.cend()), std::invalid_argument);
+
+    mapped.close();
+    std::remove(path.c_str());
+}
+
+TEST(MappedBimapWriteTests, streamLargeFilesByChunks)
+{
+    const std::string path = testing::TempDir() + "bimap_tests_stream.cmap";
+    using Mapped = cmap::MappedBimap<std::uint64_t, std::uint16_t>;
+
+    /* Several chunks, with padding between arrays and content not ending on a word */
+    std::vector<std::pair<std::uint64_t, std::uint16_t>> pairs;
+    for(std::uint16_t i = 0; i < 20001; ++i){
+        pairs.emplace_back(static_cast<std::uint64_t>(20001 - i) * 31, static_cast<std::uint16_t>(i * 3));
+    }
+    Mapped::write(path, pairs.cbegin(), pairs.cend());
+
+    Mapped mapped(path);
+    EXPECT_TRUE(mapped.verifyChecksum());
+    ASSERT_EQ(pairs.size(), mapped.size());
+    for(const auto &pair : pairs){
+        EXPECT_EQ(pair.second, mapped.getValue(pair.first));
+        EXPECT_EQ(pair.first, mapped.getKey(pair.second));
+    }
+
+    /* Incremental checksum doesn't depend on how content is split */
+    const unsigned char data[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19};
+    cmap::detail::MappedBimapChecksum checksum;
+    checksum.update(data, 3);
+    checksum.update(data + 3, 7);
+    checksum.update(data + 10, 9);
+    EXPECT_EQ(cmap::detail::mappedBimapChecksum(data, sizeof(data)), checksum.value());
+
+    mapped.close();
+    std::remove(path.c_str());
+}
@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "snapshotbimap.h"
+
+/*****************************/
+/* Namespace instructions    */
+/*****************************/
+
+/*****************************/
+/* Define test classes       */
+/*****************************/
+
+class SnapshotBimapTests : public testing::Test
+{
+
+protected:
+    cmap::SnapshotBimap<int, std::string> m_mapNumberToString{
+        cmap::Bimap<int, std::string>{
+            {1, "ONE"},
+            {2, "TWO"},
+            {3, "THREE"}
+        }
+    };
+};
+
+/*****************************/
+/* Defines test fixtures routines
+ * (using TEST_F())            */
+/*****************************/
+
+TEST_F(SnapshotBimapTests, snapshotUseBimapApi)
+{
+    auto reader = m_mapNumberToString.reader();
+    auto snapshot = reader.snapshot();
+
+    EXPECT_EQ(3, snapshot->size());
+    EXPECT_EQ("TWO", snapshot->getValue(2));
+    EXPECT_EQ(3, snapshot->getKey("THREE"));
+    EXPECT_THROW(snapshot->getValue(42), std::out_of_range);
+
+    int expectedKey = 1;
+    for(const auto &pair : snapshot){
+        EXPECT_EQ(expectedKey++, pair.first);
+    }
+}
+
+TEST_F(SnapshotBimapTests, snapshotIsImmutable)
+{
+    auto reader = m_mapNumberToString.reader();
+    {
+        auto before = reader.snapshot();
+
+        m_mapNumberToString.insert(1, "TWO");
+        m_mapNumberToString.erase(3);
+
+        /* Old version is kept alive by snapshot */
+        EXPECT_EQ(2, m_mapNumberToString.retiredCount());
+        EXPECT_EQ("ONE", before->getValue(1));
+        EXPECT_EQ(3, before->size());
+
+        auto after = reader.snapshot();
+        EXPECT_EQ("TWO", after->getValue(1));
+        EXPECT_FALSE(after->containsKey(2));
+        EXPECT_FALSE(after->containsKey(3));
+    }
+
+    EXPECT_EQ(0, m_mapNumberToString.reclaim());
+}
+
+TEST_F(SnapshotBimapTests, updatePublishAllModificationsAtOnce)
+{
+    auto reader = m_mapNumberToString.reader();
+
+    m_mapNumberToString.update([](cmap::Bimap<int, std::string> &data){
+        data.erase(1);
+        data.insert(4, "FOUR");
+    });
+    EXPECT_EQ(0, m_mapNumberToString.retiredCount());
+
+    auto snapshot = reader.snapshot();
+    EXPECT_FALSE(snapshot->containsKey(1));
+    EXPECT_EQ(4, snapshot->getKey("FOUR"));
+
+    m_mapNumberToString.clear();
+    EXPECT_EQ(3, snapshot->size());
+    EXPECT_TRUE(reader.snapshot()->empty());
+}
+
+/*****************************/
+/* Defines test routines
+ * (using TEST())            */
+/*****************************/
+
+TEST(SnapshotBimapStressTests, readersNeverSeeReclaimedVersion)
+{
+    const int nbReaders = 4;
+    const int nbVersions = 500;
+
+    /* Each version i contains pairs (k, k + i) */
+    cmap::SnapshotBimap<int, int> bimap;
+    std::atomic<bool> done(false);
+    std::atomic<int> errors(0);
+
+    std::vector<std::thread> readers;
+    for(int t = 0; t < nbReaders; ++t){
+        readers.emplace_back([&bimap, &done, &errors](){
+            auto reader = bimap.reader();
+            while(!done.load()){
+                auto snapshot = reader.snapshot();
+                if(snapshot->empty()){
+                    continue;
+                }
+
+                const int shift = snapshot->cbegin()->second - snapshot->cbegin()->first;
+                for(const auto &pair : snapshot){
+                    if(pair.second - pair.first != shift || snapshot->getKey(pair.second) != pair.first){
+                        ++errors;
+                    }
+                }
+            }
+        });
+    }
+
+    for(int i = 0; i < nbVersions; ++i){
+        cmap::Bimap<int, int> data;
+        for(int k = 0; k < 64; ++k){
+            data.insert(k, k + i);
+        }
+        bimap.assign(std::move(data));
+    }
+    done = true;
+
+    for(auto &thread : readers){
+        thread.join();
+    }
+
+    EXPECT_EQ(0, errors.load());
+    EXPECT_EQ(0, bimap.reclaim());
+}
@@ -0,0 +1,318 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "sortedvectorbimap.h"
+
+/*****************************/
+/* Namespace instructions    */
+/*****************************/
+
+/*****************************/
+/* Classes aliases           */
+/*****************************/
+
+/*!
+ * \brief Key only constructible explicitly, used to
+ * check heterogeneous lookups
+ */
+struct Id
+{
+    explicit Id(int v) : value(v) {}
+    int value;
+};
+
+struct IdLess
+{
+    using is_transparent = void;
+
+    bool operator()(const Id &lhs, const Id &rhs) const { return lhs.value < rhs.value; }
+    bool operator()(const Id &lhs, int rhs) const { return lhs.value < rhs; }
+    bool operator()(int lhs, const Id &rhs) const { return lhs < rhs.value; }
+};
+
+/*****************************/
+/* Define test classes       */
+/*****************************/
+
+class SortedVectorBimapTests : public testing::Test
+{
+
+protected:
+    cmap::SortedVectorBimap<int, std::string> m_mapNumberToString =
+    {
+        {3, "THREE"},
+        {1, "ONE"},
+        {2, "TWO"}
+    };
+};
+
+/*****************************/
+/* Defines test fixtures routines
+ * (using TEST_F())            */
+/*****************************/
+
+TEST_F(SortedVectorBimapTests, sizeIsCorrect)
+{
+    EXPECT_FALSE(m_mapNumberToString.empty());
+    EXPECT_EQ(3, m_mapNumberToString.size());
+}
+
+TEST_F(SortedVectorBimapTests, searchByValidItems)
+{
+    EXPECT_EQ("TWO", m_mapNumberToString.getValue(2));
+    EXPECT_EQ(3, m_mapNumberToString.getKey("THREE"));
+    EXPECT_THROW(m_mapNumberToString.getValue(42), std::out_of_range);
+    EXPECT_THROW(m_mapNumberToString.getKey("FORTY-TWO"), std::out_of_range);
+}
+
+TEST_F(SortedVectorBimapTests, iterateInKeyOrder)
+{
+    std::vector<int> keys;
+    for(auto it = m_mapNumberToString.cbegin(); it != m_mapNumberToString.cend(); ++it){
+        keys.push_back(it->first);
+    }
+    EXPECT_EQ(std::vector<int>({1, 2, 3}), keys);
+}
+
+TEST_F(SortedVectorBimapTests, insertExistingItemsKeepSidesConsistent)
+{
+    m_mapNumberToString.insert(1, "UN");
+    m_mapNumberToString.insert(4, "TWO");
+    m_mapNumberToString.insert(0, "ZERO");
+
+    EXPECT_EQ(4, m_mapNumberToString.size());
+    EXPECT_EQ(1, m_mapNumberToString.getKey("UN"));
+    EXPECT_EQ(4, m_mapNumberToString.getKey("TWO"));
+    EXPECT_EQ(0, m_mapNumberToString.getKey("ZERO"));
+    EXPECT_EQ("THREE", m_mapNumberToString.getValue(3));
+    EXPECT_THROW(m_mapNumberToString.getValue(2), std::out_of_range);
+}
+
+static bool isSamePair(const std::pair<int, int> &lhs, const std::pair<const int, int> &rhs)
+{
+    return lhs.first == rhs.first && lhs.second == rhs.second;
+}
+
+TEST_F(SortedVectorBimapTests, findDoesNotThrow)
+{
+    auto itKey = m_mapNumberToString.findByKey(2);
+    ASSERT_NE(m_mapNumberToString.cend(), itKey);
+    EXPECT_EQ("TWO", itKey->second);
+
+    auto itValue = m_mapNumberToString.findByValue("THREE");
+    ASSERT_NE(m_mapNumberToString.cend(), itValue);
+    EXPECT_EQ(3, itValue->first);
+
+    EXPECT_EQ(m_mapNumberToString.cend(), m_mapNumberToString.findByKey(42));
+    EXPECT_EQ(m_mapNumberToString.cend(), m_mapNumberToString.findByValue("FORTY-TWO"));
+
+    EXPECT_TRUE(m_mapNumberToString.containsKey(1));
+    EXPECT_FALSE(m_mapNumberToString.containsKey(42));
+    EXPECT_TRUE(m_mapNumberToString.containsValue("ONE"));
+    EXPECT_FALSE(m_mapNumberToString.containsValue("FORTY-TWO"));
+}
+
+TEST_F(SortedVectorBimapTests, tryInsertNeverReplace)
+{
+    std::string value = "UNO";
+    auto result = m_mapNumberToString.tryInsert(1, std::move(value));
+    EXPECT_FALSE(result.second);
+    EXPECT_EQ("ONE", result.first->second);
+    EXPECT_EQ("UNO", value);
+
+    result = m_mapNumberToString.tryInsert(4, "TWO");
+    EXPECT_FALSE(result.second);
+    EXPECT_EQ(2, result.first->first);
+
+    result = m_mapNumberToString.tryInsert(4, "FOUR");
+    EXPECT_TRUE(result.second);
+    EXPECT_EQ(4, result.first->first);
+    EXPECT_EQ(4, m_mapNumberToString.size());
+    EXPECT_EQ(4, m_mapNumberToString.getKey("FOUR"));
+}
+
+TEST_F(SortedVectorBimapTests, emplaceConstructInPlace)
+{
+    auto result = m_mapNumberToString.emplace(std::piecewise_construct, std::forward_as_tuple(4), std::forward_as_tuple(3, 'X'));
+    EXPECT_TRUE(result.second);
+    EXPECT_EQ("XXX", result.first->second);
+    EXPECT_EQ(4, m_mapNumberToString.getKey("XXX"));
+
+    result = m_mapNumberToString.emplace(5, "ONE");
+    EXPECT_FALSE(result.second);
+    EXPECT_EQ(1, result.first->first);
+    EXPECT_FALSE(m_mapNumberToString.containsKey(5));
+    EXPECT_EQ(4, m_mapNumberToString.size());
+}
+
+TEST_F(SortedVectorBimapTests, insertOrAssignKeepSidesConsistent)
+{
+    auto result = m_mapNumberToString.insertOrAssign(1, "UNO");
+    EXPECT_FALSE(result.second);
+    EXPECT_EQ("UNO", result.first->second);
+    EXPECT_EQ(1, m_mapNumberToString.getKey("UNO"));
+    EXPECT_FALSE(m_mapNumberToString.containsValue("ONE"));
+
+    result = m_mapNumberToString.insertOrAssign(1, "TWO");
+    EXPECT_FALSE(result.second);
+    EXPECT_EQ(1, m_mapNumberToString.getKey("TWO"));
+    EXPECT_FALSE(m_mapNumberToString.containsKey(2));
+    EXPECT_FALSE(m_mapNumberToString.containsValue("UNO"));
+    EXPECT_EQ(2, m_mapNumberToString.size());
+
+    result = m_mapNumberToString.insertOrAssign(4, "THREE");
+    EXPECT_TRUE(result.second);
+    EXPECT_EQ(4, result.first->first);
+    EXPECT_EQ(4, m_mapNumberToString.getKey("THREE"));
+    EXPECT_FALSE(m_mapNumberToString.containsKey(3));
+    EXPECT_EQ(2, m_mapNumberToString.size());
+}
+
+TEST_F(SortedVectorBimapTests, replaceFollowPolicy)
+{
+    auto result = m_mapNumberToString.replace(1, "TWO", cmap::ReplacePolicy::Reject);
+    EXPECT_FALSE(result.second);
+    EXPECT_EQ(1, result.first->first);
+
+    result = m_mapNumberToString.replace(1, "UNO", cmap::ReplacePolicy::OverwriteLeft);
+    EXPECT_FALSE(result.second);
+    EXPECT_EQ("ONE", m_mapNumberToString.getValue(1));
+
+    result = m_mapNumberToString.replace(4, "ONE", cmap::ReplacePolicy::OverwriteRight);
+    EXPECT_FALSE(result.second);
+    EXPECT_EQ(1, result.first->first);
+
+    result = m_mapNumberToString.replace(1, "UNO", cmap::ReplacePolicy::OverwriteRight);
+    EXPECT_TRUE(result.second);
+    EXPECT_EQ("UNO", m_mapNumberToString.getValue(1));
+
+    result = m_mapNumberToString.replace(4, "TWO", cmap::ReplacePolicy::OverwriteLeft);
+    EXPECT_TRUE(result.second);
+    EXPECT_EQ(4, m_mapNumberToString.getKey("TWO"));
+    EXPECT_FALSE(m_mapNumberToString.containsKey(2));
+
+    result = m_mapNumberToString.replace(4, "TWO", cmap::ReplacePolicy::Reject);
+    EXPECT_TRUE(result.second);
+    EXPECT_EQ(3, m_mapNumberToString.size());
+}
+
+TEST(SortedVectorBimapBulkTests, rangeConstructorRejectDuplicates)
+{
+    const std::vector<std::pair<int, int>> duplicatedKeys = {{2, 20}, {1, 10}, {2, 30}};
+    const std::vector<std::pair<int, int>> duplicatedValues = {{2, 20}, {1, 10}, {3, 20}};
+
+    using TypeBimap = cmap::SortedVectorBimap<int, int>;
+    EXPECT_THROW(TypeBimap(duplicatedKeys.cbegin(), duplicatedKeys.cend()), std::invalid_argument);
+    EXPECT_THROW(TypeBimap(duplicatedValues.cbegin(), duplicatedValues.cend()), std::invalid_argument);
+}
+
+TEST(SortedVectorBimapBulkTests, rangeConstructorMatchReference)
+{
+    std::vector<std::pair<int, int>> pairs;
+    std::map<int, int> refKeys;
+
+    std::mt19937 rng(42);
+    for(int i = 0; i < 5000; ++i){
+        pairs.emplace_back(i, static_cast<int>(rng()));
+    }
+    std::shuffle(pairs.begin(), pairs.end(), rng);
+    pairs.erase(std::unique(pairs.begin(), pairs.end(), [](const std::pair<int, int> &lhs, const std::pair<int, int> &rhs){
+        return lhs.second == rhs.second;
+    }), pairs.end());
+    refKeys.insert(pairs.cbegin(), pairs.cend());
+
+    cmap::SortedVectorBimap<int, int> bimap(pairs.cbegin(), pairs.cend());
+    ASSERT_EQ(refKeys.size(), bimap.size());
+    EXPECT_TRUE(std::equal(bimap.cbegin(), bimap.cend(), refKeys.cbegin(), isSamePair));
+    for(const auto &pair : pairs){
+        EXPECT_EQ(pair.first, bimap.getKey(pair.second));
+    }
+
+    for(int i = 0; i < 5000; i += 2){
+        bimap.erase(i);
+        refKeys.erase(i);
+    }
+    EXPECT_TRUE(std::equal(bimap.cbegin(), bimap.cend(), refKeys.cbegin(), isSamePair));
+    for(const auto &pair : refKeys){
+        EXPECT_EQ(pair.first, bimap.getKey(pair.second));
+    }
+}
+
+TEST(SortedVectorBimapDiagnosticsTests, reportMemoryUsage)
+{
+    cmap::SortedVectorBimap<int, int> bimap;
+    bimap.reserve(100);
+    for(int i = 0; i < 10; ++i){
+        bimap.insert(i, -i);
+    }
+
+    const cmap::BimapMemoryUsage usage = bimap.memoryUsage();
+    EXPECT_EQ(0, usage.indexKey);
+    EXPECT_EQ(10 * sizeof(std::uint32_t), usage.indexValue);
+    EXPECT_EQ(10 * sizeof(std::pair<int, int>), usage.payload);
+    EXPECT_GE(usage.unused, 90 * sizeof(std::pair<int, int>));
+
+    bimap.shrinkToFit();
+    EXPECT_EQ(0, bimap.memoryUsage().unused);
+}
+
+TEST(SortedVectorBimapBatchTests, batchedLookupsMatchSingleLookups)
+{
+    const std::size_t sizes[] = {0, 1, 2, 3, 15, 16, 17, 100, 1000};
+    for(std::size_t size : sizes){
+        cmap::SortedVectorBimap<int, int> bimap;
+        for(std::size_t i = 0; i < size; ++i){
+            bimap.insert(static_cast<int>(3 * i), static_cast<int>(5 * i + 1));
+        }
+
+        /* Probe hits and misses, including around bounds */
+        std::vector<int> probes;
+        for(int i = -2; i < static_cast<int>(5 * size + 4); ++i){
+            probes.push_back(i);
+        }
+
+        std::vector<int> results(probes.size(), -1);
+        std::unique_ptr<bool[]> found(new bool[probes.size()]);
+
+        EXPECT_EQ(std::count_if(probes.cbegin(), probes.cend(), [&bimap](int key){ return bimap.containsKey(key); }),
+                  bimap.getValues(probes.data(), probes.size(), results.data(), found.get()));
+        for(std::size_t i = 0; i < probes.size(); ++i){
+            auto it = bimap.findByKey(probes[i]);
+            ASSERT_EQ(it != bimap.cend(), found[i]);
+            EXPECT_EQ(it != bimap.cend() ? it->second : -1, results[i]);
+        }
+
+        std::fill(results.begin(), results.end(), -1);
+        EXPECT_EQ(std::count_if(probes.cbegin(), probes.cend(), [&bimap](int value){ return bimap.containsValue(value); }),
+                  bimap.getKeys(probes.data(), probes.size(), results.data(), nullptr));
+        for(std::size_t i = 0; i < probes.size(); ++i){
+            auto it = bimap.findByValue(probes[i]);
+            EXPECT_EQ(it != bimap.cend() ? it->first : -1, results[i]);
+        }
+    }
+}
+
+TEST(SortedVectorBimapTransparentTests, searchWithoutTemporaryKey)
+{
+    const std::vector<std::pair<Id, std::string>> pairs = {{Id(2), "TWO"}, {Id(1), "ONE"}};
+    cmap::SortedVectorBimap<Id, std::string, IdLess> bimap(pairs.cbegin(), pairs.cend());
+
+    EXPECT_EQ("TWO", bimap.getValue(2));
+    EXPECT_THROW(bimap.getValue(3), std::out_of_range);
+    EXPECT_TRUE(bimap.containsKey(1));
+    EXPECT_FALSE(bimap.containsKey(3));
+    EXPECT_EQ(bimap.cend(), bimap.findByKey(3));
+#if BIMAP_HAS_CPP14
+    EXPECT_EQ(1, bimap.getKey("ONE").value);
+#endif
+}
+
+/*****************************/
+/* End                       */
+/*****************************/
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "staticbimap.h"
+
+#if BIMAP_HAS_CPP17
+#include <string_view>
+
+/*****************************/
+/* Namespace instructions    */
+/*****************************/
+
+using namespace std::literals;
+
+/*****************************/
+/* Classes aliases           */
+/*****************************/
+
+enum class StaticColor
+{
+    Red,
+    Green,
+    Blue,
+    Black
+};
+
+/* Pairs are voluntarily not sorted */
+constexpr auto colorNames = cmap::makeStaticBimap<StaticColor, std::string_view>({
+    {StaticColor::Green, "GREEN"},
+    {StaticColor::Black, "BLACK"},
+    {StaticColor::Red, "RED"},
+    {StaticColor::Blue, "BLUE"}
+});
+
+/* Lookups are evaluated at compile-time */
+static_assert(colorNames.size() == 4);
+static_assert(colorNames.getValue(StaticColor::Blue) == "BLUE");
+static_assert(colorNames.getKey("RED") == StaticColor::Red);
+static_assert(colorNames.containsValue("BLACK"sv));
+static_assert(!colorNames.containsValue("WHITE"sv));
+static_assert(colorNames.findByKey(StaticColor::Green)->second == "GREEN");
+
+/*****************************/
+/* Defines test routines
+ * (using TEST())            */
+/*****************************/
+
+TEST(StaticBimapTests, searchByItems)
+{
+    EXPECT_EQ("GREEN", colorNames.getValue(StaticColor::Green));
+    EXPECT_EQ(StaticColor::Black, colorNames.getKey("BLACK"));
+    EXPECT_EQ(StaticColor::Blue, colorNames.getKey(std::string("BLUE")));
+
+    EXPECT_THROW(colorNames.getKey("WHITE"), std::out_of_range);
+    EXPECT_EQ(colorNames.cend(), colorNames.findByValue("WHITE"sv));
+}
+
+TEST(StaticBimapTests, iterateSortedByKeys)
+{
+    std::vector<StaticColor> keys;
+    for(const auto &pair : colorNames){
+        keys.push_back(pair.first);
+        EXPECT_EQ(pair.first, colorNames.getKey(pair.second));
+    }
+
+    const std::vector<StaticColor> expected = {StaticColor::Red, StaticColor::Green, StaticColor::Blue, StaticColor::Black};
+    EXPECT_EQ(expected, keys);
+}
+
+TEST(StaticBimapTests, allSizesMatchLinearSearch)
+{
+    constexpr std::pair<int, int> pairs[] = {
+        {7, 70}, {3, 31}, {9, 2}, {1, 45}, {12, 8}, {5, 99}, {0, 13}, {4, 61}, {10, 27}
+    };
+
+    const auto check = [&pairs](const auto &bimap, std::size_t size){
+        for(int probe = -1; probe < 101; ++probe){
+            bool hasKey = false;
+            bool hasValue = false;
+            for(std::size_t i = 0; i < size; ++i){
+                hasKey |= pairs[i].first == probe;
+                hasValue |= pairs[i].second == probe;
+            }
+
+            EXPECT_EQ(hasKey, bimap.containsKey(probe));
+            EXPECT_EQ(hasValue, bimap.containsValue(probe));
+        }
+        for(std::size_t i = 0; i < size; ++i){
+            EXPECT_EQ(pairs[i].second, bimap.getValue(pairs[i].first));
+            EXPECT_EQ(pairs[i].first, bimap.getKey(pairs[i].second));
+        }
+    };
+
+    check(cmap::makeStaticBimap<int, int>({{7, 70}}), 1);
+    check(cmap::makeStaticBimap<int, int>({{7, 70}, {3, 31}}), 2);
+    check(cmap::makeStaticBimap<int, int>({{7, 70}, {3, 31}, {9, 2}}), 3);
+    check(cmap::StaticBimap<int, int, 9>(pairs), 9);
+}
+
+TEST(StaticBimapTests, duplicatesAreRejected)
+{
+    const auto duplicatedKey = [](){ return cmap::makeStaticBimap<int, int>({{1, 10}, {2, 20}, {1, 30}}); };
+    const auto duplicatedValue = [](){ return cmap::makeStaticBimap<int, int>({{1, 10}, {2, 20}, {3, 10}}); };
+
+    EXPECT_THROW(duplicatedKey(), std::invalid_argument);
+    EXPECT_THROW(duplicatedValue(), std::invalid_argument);
+}
+
+#endif // BIMAP_HAS_CPP17
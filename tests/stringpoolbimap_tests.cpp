@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "stringpoolbimap.h"
+
+#if BIMAP_HAS_CPP17
+#include <string_view>
+
+/*****************************/
+/* Namespace instructions    */
+/*****************************/
+
+using namespace std::literals;
+
+/*****************************/
+/* Define test classes       */
+/*****************************/
+
+class StringPoolBimapTests : public testing::Test
+{
+
+protected:
+    cmap::StringPoolBimap<> m_symbols = {"main", "printf", "malloc", "free"};
+};
+
+/*****************************/
+/* Defines test fixtures routines
+ * (using TEST_F())            */
+/*****************************/
+
+TEST_F(StringPoolBimapTests, internAssignDenseIds)
+{
+    EXPECT_EQ(4, m_symbols.size());
+    EXPECT_EQ(2u, m_symbols.intern("malloc"));
+    EXPECT_EQ(4u, m_symbols.intern("exit"));
+    EXPECT_EQ(0u, m_symbols.intern(std::string("main")));
+
+    const std::pair<std::uint32_t, bool> res = m_symbols.insert("realloc");
+    EXPECT_EQ(5u, res.first);
+    EXPECT_TRUE(res.second);
+    EXPECT_FALSE(m_symbols.insert("free").second);
+    EXPECT_EQ(6, m_symbols.size());
+    EXPECT_EQ(31, m_symbols.arenaSize());
+}
+
+TEST_F(StringPoolBimapTests, searchByItems)
+{
+    EXPECT_EQ("printf"sv, m_symbols.getValue(1));
+    EXPECT_EQ(3u, m_symbols.getKey("free"));
+    EXPECT_THROW(m_symbols.getValue(4), std::out_of_range);
+    EXPECT_THROW(m_symbols.getKey("exit"), std::out_of_range);
+
+    EXPECT_TRUE(m_symbols.containsKey(3));
+    EXPECT_FALSE(m_symbols.containsKey(4));
+    EXPECT_TRUE(m_symbols.containsValue("main"));
+    EXPECT_FALSE(m_symbols.containsValue("mai"));
+
+    std::uint32_t id = 42;
+    EXPECT_FALSE(m_symbols.tryGetKey("exit", id));
+    EXPECT_EQ(42u, id);
+    EXPECT_TRUE(m_symbols.tryGetKey("malloc", id));
+    EXPECT_EQ(2u, id);
+
+    std::vector<std::string_view> strings;
+    m_symbols.forEach([&strings](std::uint32_t id, std::string_view str){
+        EXPECT_EQ(strings.size(), id);
+        strings.push_back(str);
+    });
+    EXPECT_EQ((std::vector<std::string_view>{"main", "printf", "malloc", "free"}), strings);
+}
+
+TEST_F(StringPoolBimapTests, copyAndMoveKeepIds)
+{
+    const std::string_view view = m_symbols.getValue(1);
+
+    cmap::StringPoolBimap<> copy(m_symbols);
+    copy.intern("exit");
+    EXPECT_EQ(5, copy.size());
+    EXPECT_EQ(4, m_symbols.size());
+    EXPECT_EQ(3u, copy.getKey("free"));
+    EXPECT_NE(view.data(), copy.getValue(1).data());
+
+    /* Views follow moved strings */
+    cmap::StringPoolBimap<> moved(std::move(m_symbols));
+    EXPECT_TRUE(m_symbols.empty());
+    EXPECT_EQ(view.data(), moved.getValue(1).data());
+
+    m_symbols = copy;
+    EXPECT_EQ(4u, m_symbols.getKey("exit"));
+
+    m_symbols.clear();
+    EXPECT_TRUE(m_symbols.empty());
+    EXPECT_EQ(0, m_symbols.arenaSize());
+    EXPECT_EQ(0u, m_symbols.intern("free"));
+}
+
+/*****************************/
+/* Defines test routines
+ * (using TEST())            */
+/*****************************/
+
+TEST(StringPoolBimapArenaTests, viewsStayValidWhileGrowing)
+{
+    using Pool = cmap::StringPoolBimap<>;
+    Pool pool;
+
+    const std::string_view first = pool.getValue(pool.intern("first"));
+    const std::string large(3 * Pool::BlockSize + 17, 'x');
+    const std::string block(Pool::BlockSize, 'y');
+
+    EXPECT_EQ(1u, pool.intern(""));
+    EXPECT_EQ(2u, pool.intern(large));
+    EXPECT_EQ(3u, pool.intern(block));
+    for(int i = 0; i < 20000; ++i){
+        pool.intern("symbol_" + std::to_string(i));
+    }
+    EXPECT_EQ(20004u, pool.intern("after"s + large));
+
+    EXPECT_EQ(20005, pool.size());
+    EXPECT_EQ("first"sv, first);
+    EXPECT_EQ(first.data(), pool.getValue(0).data());
+    EXPECT_TRUE(pool.getValue(1).empty());
+    EXPECT_EQ(1u, pool.getKey(""));
+    EXPECT_EQ(large, pool.getValue(2));
+    EXPECT_EQ(block, pool.getValue(3));
+    EXPECT_EQ(20004u, pool.getKey("after"s + large));
+
+    const cmap::BimapMemoryUsage usage = pool.memoryUsage();
+    EXPECT_EQ(pool.arenaSize(), usage.payload);
+    EXPECT_EQ(pool.size() * 2 * sizeof(std::uint32_t), usage.indexKey);
+    EXPECT_LT(usage.unused, usage.total());
+}
+
+TEST(StringPoolBimapArenaTests, matchReferenceMap)
+{
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> length(0, 12);
+    std::uniform_int_distribution<int> letter('a', 'd');
+
+    cmap::StringPoolBimap<std::uint16_t> pool(16);
+    std::unordered_map<std::string, std::uint16_t> reference;
+    std::vector<std::string> strings;
+
+    for(int i = 0; i < 5000; ++i){
+        std::string str(length(rng), ' ');
+        for(char &c : str){
+            c = static_cast<char>(letter(rng));
+        }
+
+        const auto res = reference.emplace(str, static_cast<std::uint16_t>(strings.size()));
+        if(res.second){
+            strings.push_back(str);
+        }
+        EXPECT_EQ(res.first->second, pool.intern(str));
+    }
+
+    ASSERT_EQ(strings.size(), pool.size());
+    for(std::size_t id = 0; id < strings.size(); ++id){
+        EXPECT_EQ(strings[id], pool.getValue(static_cast<std::uint16_t>(id)));
+    }
+
+    /* Identifiers must fit in their type */
+    cmap::StringPoolBimap<std::uint8_t> small;
+    EXPECT_EQ(256, small.maxSize());
+    for(int i = 0; i < 256; ++i){
+        small.intern(std::to_string(i));
+    }
+    EXPECT_EQ(255u, small.getKey("255"));
+    EXPECT_THROW(small.intern("256"), std::length_error);
+    EXPECT_EQ(0u, small.intern("0"));
+}
+
+#endif // BIMAP_HAS_CPP17
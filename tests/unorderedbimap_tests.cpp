@@ -0,0 +1,550 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "bimapcommon.h"
+#if BIMAP_HAS_PMR
+#include <memory_resource>
+#endif
+
+#include "bimapallocator.h"
+#include "unorderedbimap.h"
+
+/*****************************/
+/* Namespace instructions    */
+/*****************************/
+
+/*****************************/
+/* Classes aliases           */
+/*****************************/
+
+/*!
+ * \brief Key only constructible explicitly, used to
+ * check heterogeneous lookups
+ */
+struct Id
+{
+    explicit Id(int v) : value(v) {}
+    int value;
+};
+
+struct IdHash
+{
+    using is_transparent = void;
+
+    std::size_t operator()(const Id &id) const { return std::hash<int>()(id.value); }
+    std::size_t operator()(int id) const { return std::hash<int>()(id); }
+};
+
+struct IdEqual
+{
+    using is_transparent = void;
+
+    bool operator()(const Id &lhs, const Id &rhs) const { return lhs.value == rhs.value; }
+    bool operator()(const Id &lhs, int rhs) const { return lhs.value == rhs; }
+};
+
+/*!
+ * \brief Hash sending every element into the same bucket
+ */
+struct CollidingHash
+{
+    std::size_t operator()(int) const { return 0; }
+};
+
+/*****************************/
+/* Define test classes       */
+/*****************************/
+
+class UnorderedBimapTests : public testing::Test
+{
+
+protected:
+    cmap::UnorderedBimap<int, std::string> m_mapNumberToString =
+    {
+        {1, "ONE"},
+        {2, "TWO"},
+        {3, "THREE"}
+    };
+};
+
+/*****************************/
+/* Defines test fixtures routines
+ * (using TEST_F())            */
+/*****************************/
+
+TEST_F(UnorderedBimapTests, sizeIsCorrect)
+{
+    EXPECT_FALSE(m_mapNumberToString.empty());
+    EXPECT_EQ(3, m_mapNumberToString.size());
+}
+
+TEST_F(UnorderedBimapTests, searchByValidItems)
+{
+    EXPECT_EQ("TWO", m_mapNumberToString.getValue(2));
+    EXPECT_EQ(3, m_mapNumberToString.getKey("THREE"));
+    EXPECT_THROW(m_mapNumberToString.getValue(42), std::out_of_range);
+    EXPECT_THROW(m_mapNumberToString.getKey("FORTY-TWO"), std::out_of_range);
+}
+
+TEST_F(UnorderedBimapTests, insertExistingItemsKeepSidesConsistent)
+{
+    m_mapNumberToString.insert(1, "UN");
+    m_mapNumberToString.insert(4, "TWO");
+
+    EXPECT_EQ(3, m_mapNumberToString.size());
+    EXPECT_EQ(1, m_mapNumberToString.getKey("UN"));
+    EXPECT_EQ(4, m_mapNumberToString.getKey("TWO"));
+    EXPECT_THROW(m_mapNumberToString.getValue(2), std::out_of_range);
+}
+
+TEST_F(UnorderedBimapTests, iterateInInsertionOrder)
+{
+    m_mapNumberToString.erase(2);
+    m_mapNumberToString.insert(0, "ZERO");
+
+    std::vector<int> keys;
+    for(auto it = m_mapNumberToString.cbegin(); it != m_mapNumberToString.cend(); ++it){
+        keys.push_back(it->first);
+    }
+    EXPECT_EQ(std::vector<int>({1, 3, 0}), keys);
+}
+
+TEST_F(UnorderedBimapTests, reserveAvoidRehash)
+{
+    cmap::UnorderedBimap<int, int> bimap;
+    bimap.reserve(1000);
+
+    const std::size_t buckets = bimap.bucketCount();
+    EXPECT_GE(buckets * bimap.maxLoadFactor(), 1000);
+
+    for(int i = 0; i < 1000; ++i){
+        bimap.insert(i, -i);
+    }
+    EXPECT_EQ(buckets, bimap.bucketCount());
+    EXPECT_LE(bimap.loadFactor(), bimap.maxLoadFactor());
+
+    bimap.rehash(4 * buckets);
+    EXPECT_EQ(4 * buckets, bimap.bucketCount());
+    EXPECT_EQ(-500, bimap.getValue(500));
+    EXPECT_EQ(500, bimap.getKey(-500));
+}
+
+TEST_F(UnorderedBimapTests, findDoesNotThrow)
+{
+    auto itKey = m_mapNumberToString.findByKey(2);
+    ASSERT_NE(m_mapNumberToString.cend(), itKey);
+    EXPECT_EQ("TWO", itKey->second);
+
+    auto itValue = m_mapNumberToString.findByValue("THREE");
+    ASSERT_NE(m_mapNumberToString.cend(), itValue);
+    EXPECT_EQ(3, itValue->first);
+
+    EXPECT_EQ(m_mapNumberToString.cend(), m_mapNumberToString.findByKey(42));
+    EXPECT_EQ(m_mapNumberToString.cend(), m_mapNumberToString.findByValue("FORTY-TWO"));
+
+    EXPECT_TRUE(m_mapNumberToString.containsKey(1));
+    EXPECT_FALSE(m_mapNumberToString.containsKey(42));
+    EXPECT_TRUE(m_mapNumberToString.containsValue("ONE"));
+    EXPECT_FALSE(m_mapNumberToString.containsValue("FORTY-TWO"));
+}
+
+TEST_F(UnorderedBimapTests, tryInsertNeverReplace)
+{
+    std::string value = "UNO";
+    auto result = m_mapNumberToString.tryInsert(1, std::move(value));
+    EXPECT_FALSE(result.second);
+    EXPECT_EQ("ONE", result.first->second);
+    EXPECT_EQ("UNO", value);
+
+    result = m_mapNumberToString.tryInsert(4, "TWO");
+    EXPECT_FALSE(result.second);
+    EXPECT_EQ(2, result.first->first);
+
+    result = m_mapNumberToString.tryInsert(4, "FOUR");
+    EXPECT_TRUE(result.second);
+    EXPECT_EQ(4, result.first->first);
+    EXPECT_EQ(4, m_mapNumberToString.size());
+    EXPECT_EQ(4, m_mapNumberToString.getKey("FOUR"));
+}
+
+TEST_F(UnorderedBimapTests, emplaceConstructInPlace)
+{
+    auto result = m_mapNumberToString.emplace(std::piecewise_construct, std::forward_as_tuple(4), std::forward_as_tuple(3, 'X'));
+    EXPECT_TRUE(result.second);
+    EXPECT_EQ("XXX", result.first->second);
+    EXPECT_EQ(4, m_mapNumberToString.getKey("XXX"));
+
+    result = m_mapNumberToString.emplace(5, "ONE");
+    EXPECT_FALSE(result.second);
+    EXPECT_EQ(1, result.first->first);
+    EXPECT_FALSE(m_mapNumberToString.containsKey(5));
+    EXPECT_EQ(4, m_mapNumberToString.size());
+}
+
+TEST_F(UnorderedBimapTests, insertOrAssignKeepSidesConsistent)
+{
+    auto result = m_mapNumberToString.insertOrAssign(1, "UNO");
+    EXPECT_FALSE(result.second);
+    EXPECT_EQ("UNO", result.first->second);
+    EXPECT_EQ(1, m_mapNumberToString.getKey("UNO"));
+    EXPECT_FALSE(m_mapNumberToString.containsValue("ONE"));
+
+    result = m_mapNumberToString.insertOrAssign(1, "TWO");
+    EXPECT_FALSE(result.second);
+    EXPECT_EQ(1, m_mapNumberToString.getKey("TWO"));
+    EXPECT_FALSE(m_mapNumberToString.containsKey(2));
+    EXPECT_FALSE(m_mapNumberToString.containsValue("UNO"));
+    EXPECT_EQ(2, m_mapNumberToString.size());
+
+    result = m_mapNumberToString.insertOrAssign(4, "THREE");
+    EXPECT_TRUE(result.second);
+    EXPECT_EQ(4, result.first->first);
+    EXPECT_EQ(4, m_mapNumberToString.getKey("THREE"));
+    EXPECT_FALSE(m_mapNumberToString.containsKey(3));
+    EXPECT_EQ(2, m_mapNumberToString.size());
+}
+
+TEST_F(UnorderedBimapTests, replaceFollowPolicy)
+{
+    auto result = m_mapNumberToString.replace(1, "TWO", cmap::ReplacePolicy::Reject);
+    EXPECT_FALSE(result.second);
+    EXPECT_EQ(1, result.first->first);
+
+    result = m_mapNumberToString.replace(1, "UNO", cmap::ReplacePolicy::OverwriteLeft);
+    EXPECT_FALSE(result.second);
+    EXPECT_EQ("ONE", m_mapNumberToString.getValue(1));
+
+    result = m_mapNumberToString.replace(4, "ONE", cmap::ReplacePolicy::OverwriteRight);
+    EXPECT_FALSE(result.second);
+    EXPECT_EQ(1, result.first->first);
+
+    result = m_mapNumberToString.replace(1, "UNO", cmap::ReplacePolicy::OverwriteRight);
+    EXPECT_TRUE(result.second);
+    EXPECT_EQ("UNO", m_mapNumberToString.getValue(1));
+
+    result = m_mapNumberToString.replace(4, "TWO", cmap::ReplacePolicy::OverwriteLeft);
+    EXPECT_TRUE(result.second);
+    EXPECT_EQ(4, m_mapNumberToString.getKey("TWO"));
+    EXPECT_FALSE(m_mapNumberToString.containsKey(2));
+
+    result = m_mapNumberToString.replace(4, "TWO", cmap::ReplacePolicy::Reject);
+    EXPECT_TRUE(result.second);
+    EXPECT_EQ(3, m_mapNumberToString.size());
+}
+
+TEST(UnorderedBimapStressTests, matchReferenceMaps)
+{
+    cmap::UnorderedBimap<int, int> bimap;
+    std::unordered_map<int, int> refKeys;
+    std::unordered_map<int, int> refValues;
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> dist(0, 512);
+    for(int i = 0; i < 20000; ++i){
+        const int key = dist(rng);
+        const int value = dist(rng);
+
+        auto itKey = refKeys.find(key);
+        if(itKey != refKeys.end()){
+            refValues.erase(itKey->second);
+            refKeys.erase(itKey);
+        }
+
+        if(rng() % 3 == 0){
+            bimap.erase(key);
+            continue;
+        }
+
+        auto itValue = refValues.find(value);
+        if(itValue != refValues.end()){
+            refKeys.erase(itValue->second);
+            refValues.erase(itValue);
+        }
+        refKeys[key] = value;
+        refValues[value] = key;
+        if(rng() % 2 == 0){
+            bimap.insert(key, value);
+        }else{
+            bimap.insertOrAssign(key, value);
+        }
+    }
+
+    ASSERT_EQ(refKeys.size(), bimap.size());
+    for(const auto &pair : refKeys){
+        EXPECT_EQ(pair.second, bimap.getValue(pair.first));
+        EXPECT_EQ(pair.first, bimap.getKey(pair.second));
+    }
+}
+
+TEST(UnorderedBimapRehashTests, incrementalRehashMigrateBoundedBuckets)
+{
+    cmap::UnorderedBimap<int, int> bimap(64);
+    bimap.setRehashStep(4);
+    EXPECT_EQ(4, bimap.rehashStep());
+    for(int i = 0; i < 64; ++i){
+        bimap.insert(i, -i);
+    }
+    EXPECT_FALSE(bimap.isRehashing());
+
+    /* Growth only allocates new buckets */
+    bimap.insert(64, -64);
+    EXPECT_TRUE(bimap.isRehashing());
+    EXPECT_EQ(128, bimap.bucketCount());
+
+    /* Elements are found in both buckets during migration */
+    for(int i = 0; i <= 64; ++i){
+        EXPECT_EQ(-i, bimap.getValue(i));
+        EXPECT_EQ(i, bimap.getKey(-i));
+    }
+    std::vector<int> keys = {0, 10, 64, 100};
+    std::vector<int> values(keys.size(), 1);
+    EXPECT_EQ(3, bimap.getValues(keys.data(), keys.size(), values.data()));
+    EXPECT_EQ((std::vector<int>{0, -10, -64, 1}), values);
+
+    /* 64 old buckets, migrated 4 by 4 */
+    for(int i = 65; i < 79; ++i){
+        bimap.insert(i, -i);
+        EXPECT_TRUE(bimap.isRehashing());
+    }
+    bimap.erase(3);
+    EXPECT_TRUE(bimap.isRehashing());
+    bimap.insert(3, -3);
+    EXPECT_FALSE(bimap.isRehashing());
+    EXPECT_EQ(79, bimap.size());
+
+    const std::vector<std::size_t> histogram = bimap.probeHistogramKey();
+    EXPECT_EQ(79, std::accumulate(histogram.cbegin(), histogram.cend(), std::size_t(0)));
+
+    /* Disabling incremental rehash finishes migration */
+    for(int i = 1000; i < 1050; ++i){
+        bimap.insert(i, i);
+    }
+    EXPECT_TRUE(bimap.isRehashing());
+    EXPECT_EQ(256, bimap.bucketCount());
+    bimap.setRehashStep(0);
+    EXPECT_FALSE(bimap.isRehashing());
+    EXPECT_EQ(1049, bimap.getKey(1049));
+}
+
+TEST(UnorderedBimapRehashTests, incrementalRehashEndBeforeNextGrowth)
+{
+    cmap::UnorderedBimap<int, int> bimap;
+    bimap.setMaxLoadFactor(0.5f);
+    bimap.setRehashStep(1);
+
+    /* Fewer insertions than old buckets are allowed between growths */
+    std::size_t growths = 0;
+    for(int i = 0; i < 5000; ++i){
+        const std::size_t buckets = bimap.bucketCount();
+        const bool rehashing = bimap.isRehashing();
+        bimap.insert(i, -i);
+        if(bimap.bucketCount() != buckets){
+            EXPECT_FALSE(rehashing);
+            ++growths;
+        }
+    }
+    EXPECT_LT(2, growths);
+    EXPECT_GE(0.5f, bimap.loadFactor());
+    EXPECT_EQ(-4999, bimap.getValue(4999));
+}
+
+TEST(UnorderedBimapRehashTests, incrementalRehashMatchReferenceMaps)
+{
+    cmap::UnorderedBimap<int, int> bimap;
+    bimap.setRehashStep(1);
+    std::unordered_map<int, int> refKeys;
+    std::unordered_map<int, int> refValues;
+
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> dist(0, 4096);
+    for(int i = 0; i < 30000; ++i){
+        const int key = dist(rng);
+        const int value = dist(rng);
+
+        auto itKey = refKeys.find(key);
+        if(itKey != refKeys.end()){
+            refValues.erase(itKey->second);
+            refKeys.erase(itKey);
+        }
+
+        if(rng() % 4 == 0){
+            bimap.erase(key);
+            continue;
+        }
+
+        auto itValue = refValues.find(value);
+        if(itValue != refValues.end()){
+            refKeys.erase(itValue->second);
+            refValues.erase(itValue);
+        }
+        refKeys[key] = value;
+        refValues[value] = key;
+        switch(rng() % 3){
+            case 0: bimap.insert(key, value); break;
+            case 1: bimap.insertOrAssign(key, value); break;
+            default: bimap.replace(key, value, cmap::ReplacePolicy::OverwriteLeft); bimap.insert(key, value); break;
+        }
+
+        /* Copies and clears never keep a migration */
+        if(i % 5000 == 4999){
+            const cmap::UnorderedBimap<int, int> copy(bimap);
+            EXPECT_FALSE(copy.isRehashing());
+            EXPECT_EQ(bimap.size(), copy.size());
+        }
+    }
+
+    ASSERT_EQ(refKeys.size(), bimap.size());
+    for(const auto &pair : refKeys){
+        EXPECT_EQ(pair.second, bimap.getValue(pair.first));
+        EXPECT_EQ(pair.first, bimap.getKey(pair.second));
+    }
+
+    bimap.clear();
+    EXPECT_FALSE(bimap.isRehashing());
+    EXPECT_FALSE(bimap.containsKey(0));
+}
+
+TEST(UnorderedBimapDiagnosticsTests, reportMemoryAndProbeLengths)
+{
+    cmap::UnorderedBimap<int, int> bimap;
+    for(int i = 0; i < 1000; ++i){
+        bimap.insert(i, -i);
+    }
+
+    const cmap::BimapMemoryUsage usage = bimap.memoryUsage();
+    EXPECT_EQ(1000 * sizeof(std::pair<const int, int>), usage.payload);
+    EXPECT_GE(usage.indexKey, bimap.bucketCount() * sizeof(void*));
+    EXPECT_EQ(usage.indexKey, usage.indexValue);
+    EXPECT_GT(usage.overhead, 0);
+    EXPECT_EQ(usage.indexKey + usage.indexValue + usage.payload + usage.overhead + usage.unused, usage.total());
+
+    const std::vector<std::size_t> histogram = bimap.probeHistogramKey();
+    ASSERT_FALSE(histogram.empty());
+    EXPECT_EQ(1000, std::accumulate(histogram.cbegin(), histogram.cend(), std::size_t(0)));
+    EXPECT_LT(histogram.size(), 10);
+
+    /* All elements are chained in the same bucket */
+    cmap::UnorderedBimap<int, int, CollidingHash, std::equal_to<int>, CollidingHash> colliding;
+    for(int i = 0; i < 50; ++i){
+        colliding.insert(i, -i);
+    }
+    EXPECT_EQ(std::vector<std::size_t>(50, 1), colliding.probeHistogramValue());
+}
+
+TEST(UnorderedBimapBatchTests, batchedLookupsMatchSingleLookups)
+{
+    const std::size_t sizes[] = {0, 1, 2, 3, 15, 16, 17, 100, 1000};
+    for(std::size_t size : sizes){
+        cmap::UnorderedBimap<int, int> bimap;
+        for(std::size_t i = 0; i < size; ++i){
+            bimap.insert(static_cast<int>(3 * i), static_cast<int>(5 * i + 1));
+        }
+
+        /* Probe hits and misses, including around bounds */
+        std::vector<int> probes;
+        for(int i = -2; i < static_cast<int>(5 * size + 4); ++i){
+            probes.push_back(i);
+        }
+
+        std::vector<int> results(probes.size(), -1);
+        std::unique_ptr<bool[]> found(new bool[probes.size()]);
+
+        EXPECT_EQ(std::count_if(probes.cbegin(), probes.cend(), [&bimap](int key){ return bimap.containsKey(key); }),
+                  bimap.getValues(probes.data(), probes.size(), results.data(), found.get()));
+        for(std::size_t i = 0; i < probes.size(); ++i){
+            auto it = bimap.findByKey(probes[i]);
+            ASSERT_EQ(it != bimap.cend(), found[i]);
+            EXPECT_EQ(it != bimap.cend() ? it->second : -1, results[i]);
+        }
+
+        std::fill(results.begin(), results.end(), -1);
+        EXPECT_EQ(std::count_if(probes.cbegin(), probes.cend(), [&bimap](int value){ return bimap.containsValue(value); }),
+                  bimap.getKeys(probes.data(), probes.size(), results.data(), nullptr));
+        for(std::size_t i = 0; i < probes.size(); ++i){
+            auto it = bimap.findByValue(probes[i]);
+            EXPECT_EQ(it != bimap.cend() ? it->first : -1, results[i]);
+        }
+    }
+}
+
+TEST(UnorderedBimapTransparentTests, searchWithoutTemporaryKey)
+{
+    cmap::UnorderedBimap<Id, std::string, IdHash, IdEqual> bimap;
+    bimap.insert(Id(1), "ONE");
+    bimap.insert(Id(2), "TWO");
+
+    EXPECT_EQ("TWO", bimap.getValue(2));
+    EXPECT_THROW(bimap.getValue(3), std::out_of_range);
+    EXPECT_TRUE(bimap.containsKey(1));
+    EXPECT_FALSE(bimap.containsKey(3));
+    EXPECT_EQ(bimap.cend(), bimap.findByKey(3));
+}
+
+#if BIMAP_HAS_CPP17
+TEST(UnorderedBimapTransparentTests, searchByStringView)
+{
+    cmap::UnorderedBimap<int, std::string, std::hash<int>, std::equal_to<int>, cmap::StringHash, std::equal_to<>> bimap;
+    bimap.insert(1, "ONE");
+    bimap.insert(2, "TWO");
+
+    EXPECT_EQ(2, bimap.getKey(std::string_view("TWO")));
+    EXPECT_EQ(1, bimap.getKey("ONE"));
+    EXPECT_THROW(bimap.getKey(std::string_view("THREE")), std::out_of_range);
+}
+#endif
+
+TEST(UnorderedBimapAllocatorTests, nodesAreAllocatedFromPool)
+{
+    cmap::NodePool pool(64);
+    cmap::UnorderedBimap<int, int, std::hash<int>, std::equal_to<int>, std::hash<int>, std::equal_to<int>, cmap::PoolAllocator<std::pair<const int, int>>> bimap(pool);
+    for(int i = 0; i < 1000; ++i){
+        bimap.insert(i, -i);
+    }
+    EXPECT_EQ(16, pool.chunkCount());
+
+    /* Released nodes are reused */
+    bimap.clear();
+    for(int i = 0; i < 1000; ++i){
+        bimap.insert(i, i);
+    }
+    EXPECT_EQ(16, pool.chunkCount());
+
+    auto copy = bimap;
+    EXPECT_EQ(&pool, copy.getAllocator().pool());
+    EXPECT_EQ(32, pool.chunkCount());
+    EXPECT_EQ(999, copy.getKey(999));
+}
+
+#if BIMAP_HAS_PMR
+TEST(UnorderedBimapAllocatorTests, nodesAreAllocatedFromMemoryResource)
+{
+    std::pmr::monotonic_buffer_resource arena;
+    std::pmr::monotonic_buffer_resource other;
+
+    cmap::pmr::UnorderedBimap<int, std::string> bimap(&arena);
+    bimap.insert(1, "ONE");
+    bimap.insert(2, "TWO");
+    EXPECT_EQ(&arena, bimap.getAllocator().resource());
+
+    /* Polymorphic allocators doesn't propagate on assignment */
+    cmap::pmr::UnorderedBimap<int, std::string> copy(&other);
+    copy = bimap;
+    EXPECT_EQ(&other, copy.getAllocator().resource());
+    EXPECT_EQ(2, copy.getKey("TWO"));
+
+    copy = std::move(bimap);
+    EXPECT_EQ(&other, copy.getAllocator().resource());
+    EXPECT_EQ("ONE", copy.getValue(1));
+}
+#endif
+
+/*****************************/
+/* End                       */
+/*****************************/
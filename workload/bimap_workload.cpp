@@ -0,0 +1,307 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "workloadengine.h"
+
+/*****************************/
+/* Namespace instructions    */
+/*****************************/
+
+using namespace workload;
+
+/*****************************/
+/* Types definitions         */
+/*****************************/
+
+/*!
+ * \brief Engine available to replays
+ * \details
+ * Engines with \c denseKeys are skipped when keys of
+ * trace are too sparse for them.
+ */
+struct EngineEntry
+{
+    const char *name;
+    RunResult (*run)(const std::string &name, const Trace &trace, std::size_t threads, std::size_t sampleRate);
+    bool denseKeys;
+};
+
+struct Options
+{
+    std::string pathTrace;
+    std::string pathOutput;
+    std::vector<std::string> engines;
+    std::size_t threads = 0;
+    std::size_t sampleRate = 8;
+    GeneratorOptions generator;
+};
+
+/*****************************/
+/* Constants definitions     */
+/*****************************/
+
+/*!
+ * \brief Highest key accepted by engines with dense keys
+ */
+static const std::uint64_t DenseKeyMax = (std::uint64_t(1) << 24) - 1;
+
+/*****************************/
+/* Functions definitions     */
+/*****************************/
+
+static std::vector<EngineEntry> listEngines()
+{
+    using K = std::uint64_t;
+    using V = std::uint64_t;
+
+    return {
+        {"cmap::Bimap", &runEngine<EngineCmap<cmap::Bimap<K, V>>>, false},
+        {"cmap::UnorderedBimap", &runEngine<EngineCmapReserve<cmap::UnorderedBimap<K, V>>>, false},
+        {"cmap::FlatBimap", &runEngine<EngineCmapReserve<cmap::FlatBimap<K, V>>>, false},
+        {"cmap::SortedVectorBimap", &runEngine<EngineCmapSorted<cmap::SortedVectorBimap<K, V>>>, false},
+        {"cmap::DenseKeyBimap", &runEngine<EngineCmap<cmap::DenseKeyBimap<K, V>>>, true},
+        {"cmap::ConcurrentBimap", &runEngine<EngineConcurrent<cmap::ConcurrentBimap<K, V>>>, false}
+    };
+}
+
+static void printUsage(const char *program)
+{
+    std::cout
+        << "Usage: " << program << " [options] [trace]\n"
+        << "Replay a trace of operations against bimap engines, with one then several threads.\n"
+        << "A synthetic trace (Zipfian keys) is generated when no trace is given.\n\n"
+        << "Options:\n"
+        << "  --engines LIST     Comma-separated engines to run (default: all)\n"
+        << "  --threads N        Threads of multi-threaded runs (default: hardware threads, at least 2)\n"
+        << "  --sample N         Measure latency of one operation out of N (default: 8)\n"
+        << "  --keys N           Synthetic trace: number of keys (default: 100000)\n"
+        << "  --ops N            Synthetic trace: number of operations (default: 1000000)\n"
+        << "  --skew S           Synthetic trace: Zipfian skew (default: 0.99)\n"
+        << "  --mix I,E,K,V      Synthetic trace: weights of insert, erase, lookups by key and by value (default: 5,1,74,20)\n"
+        << "  --seed N           Synthetic trace: random seed (default: 42)\n"
+        << "  --write-trace FILE Write synthetic trace to FILE and exit\n"
+        << "  --help             Print this help\n\n"
+        << "Engines:";
+    for(const EngineEntry &engine : listEngines()){
+        std::cout << " " << engine.name;
+    }
+    std::cout << "\n";
+}
+
+static std::vector<std::string> splitList(const std::string &list)
+{
+    std::vector<std::string> items;
+    std::istringstream stream(list);
+    for(std::string item; std::getline(stream, item, ',');){
+        items.push_back(item);
+    }
+
+    return items;
+}
+
+static std::uint64_t parseNumber(const std::string &option, const std::string &arg)
+{
+    std::size_t end = 0;
+    std::uint64_t number = 0;
+    try{
+        number = std::stoull(arg, &end);
+    }catch(const std::exception&){
+        end = 0;
+    }
+
+    if(end == 0 || end != arg.size()){
+        throw std::invalid_argument("workload: invalid number \"" + arg + "\" for option " + option);
+    }
+
+    return number;
+}
+
+/*!
+ * \brief Parse command line
+ * \return
+ * Returns \c false if program must exit without replaying.
+ */
+static bool parseOptions(int argc, char **argv, Options &options)
+{
+    for(int i = 1; i < argc; ++i){
+        const std::string option = argv[i];
+        if(option == "--help"){
+            printUsage(argv[0]);
+            return false;
+        }
+
+        if(option.compare(0, 2, "--") != 0){
+            options.pathTrace = option;
+            continue;
+        }
+
+        if(i + 1 >= argc){
+            throw std::invalid_argument("workload: missing argument of option " + option);
+        }
+        const std::string arg = argv[++i];
+
+        if(option == "--engines"){
+            options.engines = splitList(arg);
+        }else if(option == "--threads"){
+            options.threads = static_cast<std::size_t>(parseNumber(option, arg));
+        }else if(option == "--sample"){
+            options.sampleRate = static_cast<std::size_t>(parseNumber(option, arg));
+        }else if(option == "--keys"){
+            options.generator.keys = static_cast<std::size_t>(parseNumber(option, arg));
+        }else if(option == "--ops"){
+            options.generator.operations = static_cast<std::size_t>(parseNumber(option, arg));
+        }else if(option == "--skew"){
+            options.generator.skew = std::atof(arg.c_str());
+        }else if(option == "--seed"){
+            options.generator.seed = parseNumber(option, arg);
+        }else if(option == "--mix"){
+            const std::vector<std::string> shares = splitList(arg);
+            if(shares.size() != 4){
+                throw std::invalid_argument("workload: option --mix needs four weights");
+            }
+            options.generator.shareInsert = static_cast<unsigned>(parseNumber(option, shares[0]));
+            options.generator.shareErase = static_cast<unsigned>(parseNumber(option, shares[1]));
+            options.generator.shareGetValue = static_cast<unsigned>(parseNumber(option, shares[2]));
+            options.generator.shareGetKey = static_cast<unsigned>(parseNumber(option, shares[3]));
+        }else if(option == "--write-trace"){
+            options.pathOutput = arg;
+        }else{
+            throw std::invalid_argument("workload: unknown option " + option);
+        }
+    }
+
+    const std::vector<EngineEntry> engines = listEngines();
+    for(const std::string &name : options.engines){
+        bool known = false;
+        for(const EngineEntry &engine : engines){
+            known |= name == engine.name || "cmap::" + name == engine.name;
+        }
+        if(!known){
+            throw std::invalid_argument("workload: unknown engine " + name);
+        }
+    }
+
+    if(options.threads == 0){
+        options.threads = std::max(2u, std::thread::hardware_concurrency());
+    }
+
+    return true;
+}
+
+static std::string formatMiB(std::uint64_t bytes)
+{
+    std::ostringstream stream;
+    stream << std::fixed << std::setprecision(2) << static_cast<double>(bytes) / (1024.0 * 1024.0);
+    return stream.str();
+}
+
+static void printTable(const std::vector<RunResult> &results, std::size_t lookups)
+{
+    std::cout << std::left << std::setw(26) << "Engine" << std::right
+              << std::setw(8) << "Threads"
+              << std::setw(10) << "Mops/s"
+              << std::setw(10) << "p50 (ns)"
+              << std::setw(10) << "p99 (ns)"
+              << std::setw(8) << "Hits %"
+              << std::setw(12) << "Allocs"
+              << std::setw(14) << "Alloc (MiB)"
+              << std::setw(13) << "Heap (MiB)" << "\n";
+
+    std::cout << std::fixed;
+    for(const RunResult &result : results){
+        const double mops = result.seconds > 0.0 ? static_cast<double>(result.operations) / result.seconds / 1e6 : 0.0;
+        const double hits = lookups > 0 ? 100.0 * static_cast<double>(result.hits) / static_cast<double>(lookups) : 0.0;
+
+        std::cout << std::left << std::setw(26) << result.engine << std::right
+                  << std::setw(8) << result.threads
+                  << std::setw(10) << std::setprecision(2) << mops
+                  << std::setw(10) << std::setprecision(0) << result.p50
+                  << std::setw(10) << std::setprecision(0) << result.p99
+                  << std::setw(8) << std::setprecision(1) << hits
+                  << std::setw(12) << result.allocations.count
+                  << std::setw(14) << formatMiB(result.allocations.bytes)
+                  << std::setw(13) << formatMiB(result.allocations.peak) << "\n";
+    }
+}
+
+/*****************************/
+/* Main entry point          */
+/*****************************/
+
+int main(int argc, char **argv)
+{
+    try{
+        Options options;
+        if(!parseOptions(argc, argv, options)){
+            return 0;
+        }
+
+        Trace trace;
+        if(options.pathTrace.empty()){
+            trace = generateTrace(options.generator);
+        }else{
+            std::ifstream file(options.pathTrace);
+            if(!file){
+                throw std::runtime_error("workload: unable to open trace " + options.pathTrace);
+            }
+            trace = readTrace(file);
+        }
+
+        if(!options.pathOutput.empty()){
+            std::ofstream file(options.pathOutput);
+            writeTrace(file, trace);
+            if(!file){
+                throw std::runtime_error("workload: unable to write trace " + options.pathOutput);
+            }
+            return 0;
+        }
+
+        std::size_t lookups = 0;
+        for(const Operation &op : trace.operations){
+            lookups += (op.code == OpCode::GetValue || op.code == OpCode::GetKey) ? 1 : 0;
+        }
+        std::cout << "Trace: " << trace.preload.size() << " preloaded pairs, "
+                  << trace.operations.size() << " operations (" << lookups << " lookups)\n\n";
+
+        std::vector<RunResult> results;
+        const std::vector<EngineEntry> engines = listEngines();
+        for(const EngineEntry &engine : engines){
+            bool selected = options.engines.empty();
+            for(const std::string &name : options.engines){
+                selected |= name == engine.name || "cmap::" + name == engine.name;
+            }
+            if(!selected){
+                continue;
+            }
+
+            if(engine.denseKeys && trace.maxKey > DenseKeyMax){
+                std::cout << "Skip " << engine.name << ": keys of trace are too sparse\n";
+                continue;
+            }
+
+            results.push_back(engine.run(engine.name, trace, 1, options.sampleRate));
+            results.push_back(engine.run(engine.name, trace, options.threads, options.sampleRate));
+        }
+
+        printTable(results, lookups);
+
+        const std::uint64_t rss = peakResidentBytes();
+        if(rss > 0){
+            std::cout << "\nPeak resident set size of process: " << formatMiB(rss) << " MiB\n";
+        }
+    }catch(const std::exception &e){
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
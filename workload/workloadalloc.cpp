@@ -0,0 +1,179 @@
+#include "workloadalloc.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+/*****************************/
+/* Local definitions         */
+/*****************************/
+
+namespace{
+
+std::atomic<std::uint64_t> g_count(0);
+std::atomic<std::uint64_t> g_bytes(0);
+std::atomic<std::uint64_t> g_live(0);
+std::atomic<std::uint64_t> g_peak(0);
+std::atomic<std::uint64_t> g_base(0);
+
+/*!
+ * \brief Header stored right before each block
+ * \details
+ * Size is needed to track live bytes, and raw pointer
+ * to release over-aligned blocks.
+ */
+struct BlockHeader
+{
+    std::size_t size;
+    void *raw;
+};
+
+void* allocateBlock(std::size_t size, std::size_t alignment) noexcept
+{
+    if(alignment < alignof(std::max_align_t)){
+        alignment = alignof(std::max_align_t);
+    }
+
+    void *raw = std::malloc(size + sizeof(BlockHeader) + alignment);
+    if(!raw){
+        return nullptr;
+    }
+
+    const std::uintptr_t first = reinterpret_cast<std::uintptr_t>(raw) + sizeof(BlockHeader);
+    void *ptr = reinterpret_cast<void*>((first + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1));
+
+    BlockHeader *header = static_cast<BlockHeader*>(ptr) - 1;
+    header->size = size;
+    header->raw = raw;
+
+    g_count.fetch_add(1, std::memory_order_relaxed);
+    g_bytes.fetch_add(size, std::memory_order_relaxed);
+
+    const std::uint64_t live = g_live.fetch_add(size, std::memory_order_relaxed) + size;
+    std::uint64_t peak = g_peak.load(std::memory_order_relaxed);
+    while(live > peak && !g_peak.compare_exchange_weak(peak, live, std::memory_order_relaxed)){}
+
+    return ptr;
+}
+
+void releaseBlock(void *ptr) noexcept
+{
+    if(!ptr){
+        return;
+    }
+
+    const BlockHeader *header = static_cast<BlockHeader*>(ptr) - 1;
+    g_live.fetch_sub(header->size, std::memory_order_relaxed);
+    std::free(header->raw);
+}
+
+void* allocateOrThrow(std::size_t size, std::size_t alignment)
+{
+    for(;;){
+        void *ptr = allocateBlock(size, alignment);
+        if(ptr){
+            return ptr;
+        }
+
+        std::new_handler handler = std::get_new_handler();
+        if(!handler){
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+} // Anonymous namespace
+
+/*****************************/
+/* Replaced global operators */
+/*****************************/
+
+void* operator new(std::size_t size) { return allocateOrThrow(size, 0); }
+void* operator new[](std::size_t size) { return allocateOrThrow(size, 0); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return allocateBlock(size, 0); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return allocateBlock(size, 0); }
+
+void operator delete(void *ptr) noexcept { releaseBlock(ptr); }
+void operator delete[](void *ptr) noexcept { releaseBlock(ptr); }
+void operator delete(void *ptr, const std::nothrow_t&) noexcept { releaseBlock(ptr); }
+void operator delete[](void *ptr, const std::nothrow_t&) noexcept { releaseBlock(ptr); }
+
+#if defined(__cpp_sized_deallocation)
+void operator delete(void *ptr, std::size_t) noexcept { releaseBlock(ptr); }
+void operator delete[](void *ptr, std::size_t) noexcept { releaseBlock(ptr); }
+#endif
+
+#if defined(__cpp_aligned_new)
+void* operator new(std::size_t size, std::align_val_t alignment) { return allocateOrThrow(size, static_cast<std::size_t>(alignment)); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return allocateOrThrow(size, static_cast<std::size_t>(alignment)); }
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return allocateBlock(size, static_cast<std::size_t>(alignment)); }
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return allocateBlock(size, static_cast<std::size_t>(alignment)); }
+
+void operator delete(void *ptr, std::align_val_t) noexcept { releaseBlock(ptr); }
+void operator delete[](void *ptr, std::align_val_t) noexcept { releaseBlock(ptr); }
+void operator delete(void *ptr, std::size_t, std::align_val_t) noexcept { releaseBlock(ptr); }
+void operator delete[](void *ptr, std::size_t, std::align_val_t) noexcept { releaseBlock(ptr); }
+void operator delete(void *ptr, std::align_val_t, const std::nothrow_t&) noexcept { releaseBlock(ptr); }
+void operator delete[](void *ptr, std::align_val_t, const std::nothrow_t&) noexcept { releaseBlock(ptr); }
+#endif
+
+namespace workload{
+
+/*****************************/
+/* Functions definitions     */
+/*****************************/
+
+/*!
+ * \brief Reset counters of allocations
+ * \details
+ * Peak of live bytes restart from current live bytes.
+ */
+void resetAllocationStats()
+{
+    const std::uint64_t live = g_live.load();
+
+    g_count.store(0);
+    g_bytes.store(0);
+    g_base.store(live);
+    g_peak.store(live);
+}
+
+/*!
+ * \brief Returns counters of allocations since last call
+ * to resetAllocationStats()
+ */
+AllocationStats allocationStats()
+{
+    AllocationStats stats;
+    stats.count = g_count.load();
+    stats.bytes = g_bytes.load();
+    stats.peak = g_peak.load() - g_base.load();
+
+    return stats;
+}
+
+/*!
+ * \brief Returns peak resident set size of process, in bytes
+ * \details
+ * Returns \c 0 when unavailable on platform.
+ */
+std::uint64_t peakResidentBytes()
+{
+#if defined(__APPLE__)
+    struct rusage usage;
+    return getrusage(RUSAGE_SELF, &usage) == 0 ? static_cast<std::uint64_t>(usage.ru_maxrss) : 0;
+#elif defined(__unix__)
+    struct rusage usage;
+    return getrusage(RUSAGE_SELF, &usage) == 0 ? static_cast<std::uint64_t>(usage.ru_maxrss) * 1024 : 0;
+#else
+    return 0;
+#endif
+}
+
+} // Namespace workload
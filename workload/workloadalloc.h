@@ -0,0 +1,45 @@
+#ifndef LCH_WORKLOADALLOC_H
+#define LCH_WORKLOADALLOC_H
+
+/*****************************/
+/* File documentations       */
+/*****************************/
+
+/*!
+   \file workloadalloc.h
+   \brief Counters of allocations made by workload application.
+
+   Global <tt>operator new</tt> and <tt>operator delete</tt> are replaced
+   (see workloadalloc.cpp), so every allocation of the process goes
+   through counters, whatever allocator a container uses. \n
+   Counters are atomics, so they can be updated by all threads
+   replaying a trace.
+*/
+
+#include <cstdint>
+
+namespace workload{
+
+/*****************************/
+/* Types definitions         */
+/*****************************/
+
+struct AllocationStats
+{
+    std::uint64_t count = 0;    /*!< Number of allocations */
+    std::uint64_t bytes = 0;    /*!< Number of bytes allocated */
+    std::uint64_t peak = 0;     /*!< Peak of live bytes, relative to live bytes at resetAllocationStats() */
+};
+
+/*****************************/
+/* Functions declarations    */
+/*****************************/
+
+void resetAllocationStats();
+AllocationStats allocationStats();
+
+std::uint64_t peakResidentBytes();
+
+} // Namespace workload
+
+#endif // LCH_WORKLOADALLOC_H
@@ -0,0 +1,329 @@
+#ifndef LCH_WORKLOADENGINE_H
+#define LCH_WORKLOADENGINE_H
+
+/*****************************/
+/* File documentations       */
+/*****************************/
+
+/*!
+   \file workloadengine.h
+   \brief Engines replaying traces and measures of replays.
+
+   Each container is driven through an engine providing the same set
+   of static operations, so replay is written once for every container. \n
+   Containers not safe for concurrent updates are guarded by a shared
+   mutex when a trace is replayed by several threads (lookups share it,
+   updates lock it exclusively), as an application sharing such a
+   container would do. \c cmap::ConcurrentBimap is used as is.
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bimap.h"
+#include "concurrentbimap.h"
+#include "densekeybimap.h"
+#include "flatbimap.h"
+#include "sortedvectorbimap.h"
+#include "unorderedbimap.h"
+
+#include "workloadalloc.h"
+#include "workloadtrace.h"
+
+namespace workload{
+
+/*****************************/
+/* Types definitions         */
+/*****************************/
+
+/*!
+ * \brief Measures of a replay
+ * \details
+ * Latencies are sampled (one operation out of \c sampleRate)
+ * and include cost of reading clock. \n
+ * Allocations are counted during replay only, peak of live
+ * bytes is measured from construction of container.
+ */
+struct RunResult
+{
+    std::string engine;
+    std::size_t threads = 0;
+    std::size_t operations = 0;
+    std::size_t hits = 0;   /*!< Number of lookups which found their element */
+
+    double seconds = 0.0;
+    double p50 = 0.0;   /*!< Median latency, in nanoseconds */
+    double p99 = 0.0;   /*!< 99th percentile latency, in nanoseconds */
+
+    AllocationStats allocations;
+};
+
+/*****************************/
+/* Engines of containers     */
+/*****************************/
+
+/*!
+ * \brief Engine of \c cmap containers
+ * \details
+ * apply() returns \c true when a lookup finds its element,
+ * updates always return \c false.
+ */
+template<class Container>
+struct EngineCmap
+{
+    using TypeContainer = Container;
+
+    static constexpr bool concurrent = false;
+
+    static void preload(Container &container, const Trace &trace)
+    {
+        for(const auto &pair : trace.preload){
+            container.insert(pair.first, pair.second);
+        }
+    }
+
+    static bool apply(Container &container, const Operation &op)
+    {
+        switch(op.code){
+            case OpCode::Insert:    container.insert(op.key, op.value); return false;
+            case OpCode::Erase:     container.erase(op.key); return false;
+            case OpCode::GetValue:  return container.findByKey(op.key) != container.cend();
+            case OpCode::GetKey:    return container.findByValue(op.value) != container.cend();
+        }
+        return false;
+    }
+};
+
+/*!
+ * \brief Engine of \c cmap containers providing reserve()
+ */
+template<class Container>
+struct EngineCmapReserve : EngineCmap<Container>
+{
+    static void preload(Container &container, const Trace &trace)
+    {
+        container.reserve(trace.preload.size());
+        EngineCmap<Container>::preload(container, trace);
+    }
+};
+
+/*!
+ * \brief Engine of \c cmap::SortedVectorBimap
+ * \details
+ * Preloaded pairs are built at once, insertions
+ * and erasures of trace remain linear.
+ */
+template<class Container>
+struct EngineCmapSorted : EngineCmap<Container>
+{
+    static void preload(Container &container, const Trace &trace)
+    {
+        container.assign(trace.preload.cbegin(), trace.preload.cend());
+    }
+};
+
+/*!
+ * \brief Engine of \c cmap::ConcurrentBimap
+ */
+template<class Container>
+struct EngineConcurrent
+{
+    using TypeContainer = Container;
+
+    static constexpr bool concurrent = true;
+
+    static void preload(Container &container, const Trace &trace)
+    {
+        for(const auto &pair : trace.preload){
+            container.insert(pair.first, pair.second);
+        }
+    }
+
+    static bool apply(Container &container, const Operation &op)
+    {
+        std::uint64_t item = 0;
+        switch(op.code){
+            case OpCode::Insert:    container.insert(op.key, op.value); return false;
+            case OpCode::Erase:     container.erase(op.key); return false;
+            case OpCode::GetValue:  return container.tryGetValue(op.key, item);
+            case OpCode::GetKey:    return container.tryGetKey(op.value, item);
+        }
+        return false;
+    }
+};
+
+template<class Container>
+constexpr bool EngineCmap<Container>::concurrent;
+template<class Container>
+constexpr bool EngineConcurrent<Container>::concurrent;
+
+/*****************************/
+/* Functions definitions     */
+/*****************************/
+
+namespace detail{
+
+/*!
+ * \brief Container shared by replaying threads, guarded when
+ * engine isn't safe for concurrent updates
+ */
+template<class Engine, bool concurrent = Engine::concurrent>
+struct SharedContainer
+{
+    typename Engine::TypeContainer container;
+
+    bool apply(const Operation &op, bool guarded)
+    {
+        if(!guarded){
+            return Engine::apply(container, op);
+        }
+
+        if(op.code == OpCode::GetValue || op.code == OpCode::GetKey){
+            cmap::detail::BimapSharedGuard guard(mutex);
+            return Engine::apply(container, op);
+        }
+
+        std::lock_guard<cmap::detail::BimapSharedMutex> guard(mutex);
+        return Engine::apply(container, op);
+    }
+
+    cmap::detail::BimapSharedMutex mutex;
+};
+
+template<class Engine>
+struct SharedContainer<Engine, true>
+{
+    typename Engine::TypeContainer container;
+
+    bool apply(const Operation &op, bool)
+    {
+        return Engine::apply(container, op);
+    }
+};
+
+inline double percentile(std::vector<double> &samples, double ratio)
+{
+    if(samples.empty()){
+        return 0.0;
+    }
+
+    const std::size_t index = std::min(samples.size() - 1, static_cast<std::size_t>(ratio * static_cast<double>(samples.size())));
+    std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+    return samples[index];
+}
+
+} // Namespace detail
+
+/*!
+ * \brief Replay operations of a trace with an engine
+ * \details
+ * Container is preloaded by calling thread, then each of the
+ * \c threads replays one operation out of \c threads (in order of trace),
+ * so operations of all threads follow same distribution. \n
+ * Only replay is timed and its allocations counted, but peak of
+ * heap includes preloaded container. Container is destroyed
+ * after measures.
+ *
+ * \param name
+ * Name of engine, copied in result.
+ * \param trace
+ * Trace to replay.
+ * \param threads
+ * Number of replaying threads.
+ * \param sampleRate
+ * One operation out of \c sampleRate has its latency measured.
+ */
+template<class Engine>
+RunResult runEngine(const std::string &name, const Trace &trace, std::size_t threads, std::size_t sampleRate)
+{
+    using Clock = std::chrono::steady_clock;
+
+    threads = std::max<std::size_t>(threads, 1);
+    sampleRate = std::max<std::size_t>(sampleRate, 1);
+
+    const std::vector<Operation> &ops = trace.operations;
+    std::vector<std::vector<double>> latencies(threads);
+    for(auto &samples : latencies){
+        samples.reserve(ops.size() / threads / sampleRate + 1);
+    }
+
+    resetAllocationStats();
+    std::unique_ptr<detail::SharedContainer<Engine>> shared(new detail::SharedContainer<Engine>());
+    Engine::preload(shared->container, trace);
+
+    std::atomic<std::size_t> nbReady(0);
+    std::atomic<bool> start(false);
+    std::atomic<std::size_t> nbHits(0);
+
+    const bool guarded = threads > 1;
+    const auto worker = [&](std::size_t idThread){
+        std::vector<double> &samples = latencies[idThread];
+        std::size_t hits = 0;
+
+        nbReady.fetch_add(1);
+        while(!start.load()){
+            std::this_thread::yield();
+        }
+
+        for(std::size_t i = idThread, n = 0; i < ops.size(); i += threads, ++n){
+            if(n % sampleRate != 0){
+                hits += shared->apply(ops[i], guarded) ? 1 : 0;
+                continue;
+            }
+
+            const Clock::time_point before = Clock::now();
+            hits += shared->apply(ops[i], guarded) ? 1 : 0;
+            const Clock::time_point after = Clock::now();
+            samples.push_back(std::chrono::duration<double, std::nano>(after - before).count());
+        }
+
+        nbHits.fetch_add(hits);
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    for(std::size_t i = 0; i < threads; ++i){
+        workers.emplace_back(worker, i);
+    }
+    while(nbReady.load() < threads){
+        std::this_thread::yield();
+    }
+
+    const AllocationStats setup = allocationStats();
+    const Clock::time_point begin = Clock::now();
+    start.store(true);
+    for(std::thread &thread : workers){
+        thread.join();
+    }
+    const Clock::time_point end = Clock::now();
+
+    RunResult result;
+    result.allocations = allocationStats();
+    result.allocations.count -= setup.count;
+    result.allocations.bytes -= setup.bytes;
+    result.engine = name;
+    result.threads = threads;
+    result.operations = ops.size();
+    result.hits = nbHits.load();
+    result.seconds = std::chrono::duration<double>(end - begin).count();
+
+    std::vector<double> samples;
+    for(const auto &samplesThread : latencies){
+        samples.insert(samples.end(), samplesThread.cbegin(), samplesThread.cend());
+    }
+    result.p50 = detail::percentile(samples, 0.50);
+    result.p99 = detail::percentile(samples, 0.99);
+
+    return result;
+}
+
+} // Namespace workload
+
+#endif // LCH_WORKLOADENGINE_H
@@ -0,0 +1,309 @@
+#ifndef LCH_WORKLOADTRACE_H
+#define LCH_WORKLOADTRACE_H
+
+/*****************************/
+/* File documentations       */
+/*****************************/
+
+/*!
+   \file workloadtrace.h
+   \brief Traces of operations replayed by workload application.
+
+   A trace is a text file, one operation per line, keys and values
+   being unsigned 64 bits integers:
+   - <tt>p key value</tt>: preload pair, applied before measures start
+   - <tt>i key value</tt>: insert pair (replacing conflicting pairs)
+   - <tt>e key</tt>: erase pair of key
+   - <tt>k key</tt>: lookup value of key
+   - <tt>v value</tt>: lookup key of value
+
+   Empty lines and lines starting with \c # are ignored. \n
+   Synthetic traces can be generated with generateTrace(),
+   keys being picked with a Zipfian distribution.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "bimap.h"
+
+namespace workload{
+
+/*****************************/
+/* Types definitions         */
+/*****************************/
+
+enum class OpCode : std::uint8_t
+{
+    Insert,
+    Erase,
+    GetValue,
+    GetKey
+};
+
+/*!
+ * \brief Operation of a trace
+ * \details
+ * \c key is unused by \c OpCode::GetKey, \c value is only
+ * used by \c OpCode::Insert and \c OpCode::GetKey.
+ */
+struct Operation
+{
+    OpCode code;
+    std::uint64_t key;
+    std::uint64_t value;
+};
+
+/*!
+ * \brief Trace to replay
+ * \details
+ * Preloaded pairs are free of conflicts (conflicting \c p lines
+ * are resolved like insertions, last one wins), so they
+ * can be used to construct a container at once.
+ */
+struct Trace
+{
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> preload;
+    std::vector<Operation> operations;
+    std::uint64_t maxKey = 0;
+};
+
+/*!
+ * \brief Options of synthetic traces
+ * \details
+ * Shares of operations are relative weights, they don't have
+ * to sum to 100.
+ */
+struct GeneratorOptions
+{
+    std::size_t keys = 100000;
+    std::size_t operations = 1000000;
+    double skew = 0.99;
+
+    unsigned shareInsert = 5;
+    unsigned shareErase = 1;
+    unsigned shareGetValue = 74;
+    unsigned shareGetKey = 20;
+
+    std::uint64_t seed = 42;
+};
+
+/*****************************/
+/* Class definitions         */
+/*****************************/
+
+/*!
+ * \brief Zipfian distribution of ranks in <tt>[0, n)</tt>
+ * \details
+ * Rank \c 0 is the most frequent one, probability of rank \c r
+ * is proportional to <tt>1 / (r + 1)^skew</tt>. \n
+ * Cumulative distribution is computed once, so each draw is
+ * a binary search in it.
+ */
+class ZipfDistribution
+{
+
+public:
+    ZipfDistribution(std::size_t n, double skew);
+
+    template<class Rng>
+    std::size_t operator()(Rng &rng) const;
+
+private:
+    std::vector<double> m_cdf;
+};
+
+inline ZipfDistribution::ZipfDistribution(std::size_t n, double skew)
+{
+    if(n == 0){
+        throw std::invalid_argument("workload: Zipfian distribution needs at least one rank");
+    }
+
+    m_cdf.resize(n);
+    double sum = 0.0;
+    for(std::size_t i = 0; i < n; ++i){
+        sum += 1.0 / std::pow(static_cast<double>(i + 1), skew);
+        m_cdf[i] = sum;
+    }
+    for(double &cdf : m_cdf){
+        cdf /= sum;
+    }
+}
+
+template<class Rng>
+std::size_t ZipfDistribution::operator()(Rng &rng) const
+{
+    const double draw = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+    const std::size_t rank = static_cast<std::size_t>(std::upper_bound(m_cdf.cbegin(), m_cdf.cend(), draw) - m_cdf.cbegin());
+
+    return std::min(rank, m_cdf.size() - 1);
+}
+
+/*****************************/
+/* Functions definitions     */
+/*****************************/
+
+/*!
+ * \brief Bijective mix of an integer, used to derive values from keys
+ */
+inline std::uint64_t mixValue(std::uint64_t index)
+{
+    index += 0x9E3779B97F4A7C15ULL;
+    index = (index ^ (index >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    index = (index ^ (index >> 27)) * 0x94D049BB133111EBULL;
+    return index ^ (index >> 31);
+}
+
+/*!
+ * \brief Resolve conflicts of preloaded pairs
+ */
+inline void resolvePreload(Trace &trace)
+{
+    cmap::Bimap<std::uint64_t, std::uint64_t> pairs;
+    for(const auto &pair : trace.preload){
+        pairs.insert(pair.first, pair.second);
+    }
+
+    trace.preload.assign(pairs.cbegin(), pairs.cend());
+}
+
+/*!
+ * \brief Read a trace
+ *
+ * \throw std::runtime_error
+ * Throw if a line is invalid.
+ */
+inline Trace readTrace(std::istream &input)
+{
+    Trace trace;
+
+    std::string line;
+    for(std::size_t nbLine = 1; std::getline(input, line); ++nbLine){
+        std::istringstream fields(line);
+
+        char code = '\0';
+        if(!(fields >> code) || code == '#'){
+            continue;
+        }
+
+        Operation op = {OpCode::Insert, 0, 0};
+        bool valid = false;
+        switch(code){
+            case 'p':
+            case 'i':   valid = static_cast<bool>(fields >> op.key >> op.value); break;
+            case 'e':   op.code = OpCode::Erase; valid = static_cast<bool>(fields >> op.key); break;
+            case 'k':   op.code = OpCode::GetValue; valid = static_cast<bool>(fields >> op.key); break;
+            case 'v':   op.code = OpCode::GetKey; valid = static_cast<bool>(fields >> op.value); break;
+            default:    break;
+        }
+
+        std::string extra;
+        if(!valid || fields >> extra){
+            throw std::runtime_error("workload: invalid operation at line " + std::to_string(nbLine) + " of trace");
+        }
+
+        if(code == 'p'){
+            trace.preload.emplace_back(op.key, op.value);
+        }else{
+            trace.operations.push_back(op);
+        }
+        trace.maxKey = std::max(trace.maxKey, op.key);
+    }
+
+    resolvePreload(trace);
+    return trace;
+}
+
+/*!
+ * \brief Write a trace, using format read by readTrace()
+ */
+inline void writeTrace(std::ostream &output, const Trace &trace)
+{
+    output << "# Preloaded pairs: " << trace.preload.size() << ", operations: " << trace.operations.size() << "\n";
+    for(const auto &pair : trace.preload){
+        output << "p " << pair.first << ' ' << pair.second << "\n";
+    }
+
+    for(const Operation &op : trace.operations){
+        switch(op.code){
+            case OpCode::Insert:    output << "i " << op.key << ' ' << op.value << "\n"; break;
+            case OpCode::Erase:     output << "e " << op.key << "\n"; break;
+            case OpCode::GetValue:  output << "k " << op.key << "\n"; break;
+            case OpCode::GetKey:    output << "v " << op.value << "\n"; break;
+        }
+    }
+}
+
+/*!
+ * \brief Generate a synthetic trace
+ * \details
+ * All keys of <tt>[0, keys)</tt> are preloaded, then keys of operations
+ * are drawn with a Zipfian distribution (hottest keys being scattered
+ * in key range). \n
+ * Value of a key is one of four \em generations, so insertions
+ * either keep or reassign it, and lookups by value miss when
+ * value of key has been reassigned.
+ */
+inline Trace generateTrace(const GeneratorOptions &options)
+{
+    const unsigned shareTotal = options.shareInsert + options.shareErase + options.shareGetValue + options.shareGetKey;
+    if(shareTotal == 0){
+        throw std::invalid_argument("workload: shares of operations are all null");
+    }
+
+    std::mt19937_64 rng(options.seed);
+    const ZipfDistribution zipf(options.keys, options.skew);
+    std::uniform_int_distribution<unsigned> distShare(0, shareTotal - 1);
+    std::uniform_int_distribution<std::uint64_t> distGeneration(0, 3);
+
+    const std::uint64_t keys = options.keys;
+    const auto valueOf = [keys](std::uint64_t key, std::uint64_t generation){
+        return mixValue(key + keys * generation);
+    };
+
+    /* Scatter hot keys */
+    std::vector<std::uint64_t> ranks(options.keys);
+    for(std::size_t i = 0; i < ranks.size(); ++i){
+        ranks[i] = i;
+    }
+    std::shuffle(ranks.begin(), ranks.end(), rng);
+
+    Trace trace;
+    trace.maxKey = keys - 1;
+    trace.preload.reserve(options.keys);
+    for(std::uint64_t key = 0; key < keys; ++key){
+        trace.preload.emplace_back(key, valueOf(key, 0));
+    }
+
+    trace.operations.reserve(options.operations);
+    for(std::size_t i = 0; i < options.operations; ++i){
+        const std::uint64_t key = ranks[zipf(rng)];
+        const unsigned share = distShare(rng);
+
+        Operation op = {OpCode::GetValue, key, 0};
+        if(share < options.shareInsert){
+            op.code = OpCode::Insert;
+            op.value = valueOf(key, distGeneration(rng));
+        }else if(share < options.shareInsert + options.shareErase){
+            op.code = OpCode::Erase;
+        }else if(share >= options.shareInsert + options.shareErase + options.shareGetValue){
+            op.code = OpCode::GetKey;
+            op.value = valueOf(key, 0);
+        }
+        trace.operations.push_back(op);
+    }
+
+    return trace;
+}
+
+} // Namespace workload
+
+#endif // LCH_WORKLOADTRACE_H